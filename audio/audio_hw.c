@@ -31,9 +31,13 @@
 #include <pthread.h>
 #include <stdint.h>
 #include <sys/time.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <dlfcn.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
 
 #include <cutils/log.h>
 #include <cutils/str_parms.h>
@@ -294,6 +298,13 @@ static int amplifier_close(void)
     return 0;
 }
 
+static int64_t get_time_us(void)
+{
+    struct timespec t = { .tv_sec = 0, .tv_nsec = 0 };
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (t.tv_sec * 1000000000LL + t.tv_nsec) / 1000;
+}
+
 struct timespec time_spec_diff(struct timespec time1, struct timespec time0) {
     struct timespec ret;
     int xsec = 0;
@@ -834,39 +845,104 @@ static int64_t render_latency(audio_usecase_t usecase)
     return 0;
 }
 
-static int enable_snd_device(struct audio_device *adev,
-                             struct audio_usecase *uc_info,
-                             snd_device_t snd_device)
-{
+/*
+ * Queues a command for the routing thread and returns its sequence number,
+ * 0 if it could not be queued. uc_info may be NULL for commands that do not
+ * touch a mixer path.
+ */
+static unsigned int send_route_cmd(struct audio_device *adev,
+                                   struct audio_usecase *uc_info,
+                                   int command,
+                                   audio_usecase_t usecase,
+                                   snd_device_t snd_device,
+                                   snd_device_t snd_device_out)
+{
+    struct route_cmd *cmd = (struct route_cmd *)calloc(1, sizeof(struct route_cmd));
     struct mixer_card *mixer_card;
     struct listnode *node;
-    const char *snd_device_name = get_snd_device_name(snd_device);
-#ifdef DSP_POWEROFF_DELAY
-    struct timespec activation_time;
-    struct timespec elapsed_time;
-#endif /* DSP_POWEROFF_DELAY */
+    unsigned int seq;
 
-    if (snd_device_name == NULL)
-        return -EINVAL;
-
-    if (snd_device == SND_DEVICE_OUT_SPEAKER_AND_HEADPHONES) {
-        ALOGV("Request to enable combo device: enable individual devices\n");
-        enable_snd_device(adev, uc_info, SND_DEVICE_OUT_SPEAKER);
-        enable_snd_device(adev, uc_info, SND_DEVICE_OUT_HEADPHONES);
+    if (cmd == NULL) {
+        ALOGE("%s: cannot queue command %d for snd_device(%d)", __func__, command, snd_device);
         return 0;
     }
-    adev->snd_dev_ref_cnt[snd_device]++;
-    if (adev->snd_dev_ref_cnt[snd_device] > 1) {
-        ALOGV("%s: snd_device(%d: %s) is already active",
-              __func__, snd_device, snd_device_name);
-        return 0;
+
+    cmd->cmd = command;
+    cmd->usecase = usecase;
+    cmd->snd_device = snd_device;
+    cmd->snd_device_out = snd_device_out;
+    if (uc_info != NULL) {
+        list_for_each(node, &uc_info->mixer_list) {
+            mixer_card = node_to_item(node, struct mixer_card, uc_list_node[uc_info->id]);
+            if (cmd->num_cards == ROUTE_MAX_CARDS) {
+                ALOGE("%s: usecase(%d) uses more than %d cards", __func__,
+                      uc_info->id, ROUTE_MAX_CARDS);
+                break;
+            }
+            cmd->cards[cmd->num_cards++] = mixer_card;
+        }
     }
 
-    ALOGV("%s: snd_device(%d: %s)", __func__,
-          snd_device, snd_device_name);
+    pthread_mutex_lock(&adev->route_lock);
+    seq = ++adev->route_queued_seq;
+    cmd->seq = seq;
+    list_add_tail(&adev->route_cmd_list, &cmd->node);
+    pthread_cond_signal(&adev->route_cond);
+    pthread_mutex_unlock(&adev->route_lock);
+
+    return seq;
+}
+
+/*
+ * Waits until the routing thread has applied every command queued so far.
+ * Only for callers that must not return before the mixer is updated. The
+ * write/read paths only wait on standby exit, after dropping adev->lock,
+ * so the PCM never starts on a stale path.
+ */
+static void route_flush(struct audio_device *adev)
+{
+    unsigned int seq;
+
+    pthread_mutex_lock(&adev->route_lock);
+    seq = adev->route_queued_seq;
+    while ((int)(adev->route_done_seq - seq) < 0)
+        pthread_cond_wait(&adev->route_done_cond, &adev->route_lock);
+    pthread_mutex_unlock(&adev->route_lock);
+}
+
+/* must be called with adev->lock locked */
+static void route_publish_l(struct audio_device *adev,
+                            audio_usecase_t usecase,
+                            snd_device_t out_snd_device,
+                            snd_device_t in_snd_device)
+{
+    send_route_cmd(adev, NULL, ROUTE_CMD_PUBLISH, usecase, in_snd_device, out_snd_device);
+}
+
+/* Lockless read of the routing state of every usecase */
+static void route_snapshot(struct audio_device *adev, struct route_state *state)
+{
+    int32_t seq;
+
+    do {
+        while ((seq = android_atomic_acquire_load(&adev->route_state_seq)) & 1)
+            sched_yield();
+        memcpy(state, adev->route_state, sizeof(adev->route_state));
+    } while (android_atomic_release_load(&adev->route_state_seq) != seq);
+}
+
+static void route_apply_enable(struct route_cmd *cmd)
+{
+    const char *snd_device_name = get_snd_device_name(cmd->snd_device);
+    struct mixer_card *mixer_card;
+    unsigned int i;
+#ifdef DSP_POWEROFF_DELAY
+    struct timespec activation_time;
+    struct timespec elapsed_time;
+#endif /* DSP_POWEROFF_DELAY */
 
-    list_for_each(node, &uc_info->mixer_list) {
-        mixer_card = node_to_item(node, struct mixer_card, uc_list_node[uc_info->id]);
+    for (i = 0; i < cmd->num_cards; i++) {
+        mixer_card = cmd->cards[i];
 
 #ifdef DSP_POWEROFF_DELAY
         clock_gettime(CLOCK_MONOTONIC, &activation_time);
@@ -882,10 +958,168 @@ static int enable_snd_device(struct audio_device *adev,
         }
 #endif /* DSP_POWEROFF_DELAY */
 
-        amplifier_enable_devices(snd_device, true);
+        amplifier_enable_devices(cmd->snd_device, true);
 
         audio_route_apply_and_update_path(mixer_card->audio_route, snd_device_name);
     }
+}
+
+static void route_apply_disable(struct route_cmd *cmd)
+{
+    const char *snd_device_name = get_snd_device_name(cmd->snd_device);
+    struct mixer_card *mixer_card;
+    unsigned int i;
+
+    for (i = 0; i < cmd->num_cards; i++) {
+        mixer_card = cmd->cards[i];
+
+        audio_route_reset_and_update_path(mixer_card->audio_route, snd_device_name);
+        if (cmd->snd_device > SND_DEVICE_IN_BEGIN && cmd->snd_device_out != SND_DEVICE_NONE) {
+            /*
+             * Cycle the rx device to eliminate routing conflicts.
+             * This prevents issues when an input route shares mixer controls with an output
+             * route.
+             */
+            audio_route_apply_and_update_path(mixer_card->audio_route,
+                                              get_snd_device_name(cmd->snd_device_out));
+        }
+
+        amplifier_enable_devices(cmd->snd_device, false);
+#ifdef DSP_POWEROFF_DELAY
+        clock_gettime(CLOCK_MONOTONIC, &(mixer_card->dsp_poweroff_time));
+#endif /* DSP_POWEROFF_DELAY */
+    }
+}
+
+static void route_apply_publish(struct audio_device *adev, struct route_cmd *cmd)
+{
+    android_atomic_inc(&adev->route_state_seq);
+    adev->route_state[cmd->usecase].out_snd_device = cmd->snd_device_out;
+    adev->route_state[cmd->usecase].in_snd_device = cmd->snd_device;
+    android_atomic_inc(&adev->route_state_seq);
+}
+
+static void *route_thread_loop(void *context)
+{
+    struct audio_device *adev = (struct audio_device *)context;
+    struct listnode *item;
+
+    setpriority(PRIO_PROCESS, 0, ANDROID_PRIORITY_AUDIO);
+    set_sched_policy(0, SP_FOREGROUND);
+    prctl(PR_SET_NAME, (unsigned long)"Audio Routing", 0, 0, 0);
+
+    pthread_mutex_lock(&adev->route_lock);
+    for (;;) {
+        struct route_cmd *cmd;
+        int64_t start_us;
+        int64_t apply_us;
+
+        if (list_empty(&adev->route_cmd_list)) {
+            pthread_cond_wait(&adev->route_cond, &adev->route_lock);
+            continue;
+        }
+
+        item = list_head(&adev->route_cmd_list);
+        cmd = node_to_item(item, struct route_cmd, node);
+        list_remove(item);
+
+        if (cmd->cmd == ROUTE_CMD_EXIT) {
+            adev->route_done_seq = cmd->seq;
+            free(cmd);
+            break;
+        }
+        pthread_mutex_unlock(&adev->route_lock);
+
+        ALOGVV("%s: cmd %d seq %u snd_device(%d)", __func__, cmd->cmd, cmd->seq, cmd->snd_device);
+        start_us = get_time_us();
+        switch (cmd->cmd) {
+        case ROUTE_CMD_ENABLE:
+            route_apply_enable(cmd);
+            break;
+        case ROUTE_CMD_DISABLE:
+            route_apply_disable(cmd);
+            break;
+        case ROUTE_CMD_AMPLIFIER:
+            /* Rely on amplifier_set_devices to distinguish between in/out devices */
+            amplifier_set_input_devices(cmd->snd_device);
+            amplifier_set_output_devices(cmd->snd_device_out);
+            break;
+        case ROUTE_CMD_PUBLISH:
+            route_apply_publish(adev, cmd);
+            break;
+        default:
+            ALOGE("%s unknown command received: %d", __func__, cmd->cmd);
+            break;
+        }
+        apply_us = get_time_us() - start_us;
+
+        pthread_mutex_lock(&adev->route_lock);
+        adev->route_done_seq = cmd->seq;
+        adev->route_cmd_count++;
+        if (apply_us > adev->route_max_apply_us)
+            adev->route_max_apply_us = apply_us;
+        pthread_cond_broadcast(&adev->route_done_cond);
+        free(cmd);
+    }
+
+    pthread_cond_broadcast(&adev->route_done_cond);
+    pthread_mutex_unlock(&adev->route_lock);
+
+    return NULL;
+}
+
+static void create_route_thread(struct audio_device *adev)
+{
+    pthread_mutex_init(&adev->route_lock, (const pthread_mutexattr_t *) NULL);
+    pthread_cond_init(&adev->route_cond, (const pthread_condattr_t *) NULL);
+    pthread_cond_init(&adev->route_done_cond, (const pthread_condattr_t *) NULL);
+    list_init(&adev->route_cmd_list);
+    pthread_create(&adev->route_thread, (const pthread_attr_t *) NULL,
+                   route_thread_loop, adev);
+}
+
+/* Applies every queued path update before exiting */
+static void destroy_route_thread(struct audio_device *adev)
+{
+    send_route_cmd(adev, NULL, ROUTE_CMD_EXIT, USECASE_INVALID,
+                   SND_DEVICE_NONE, SND_DEVICE_NONE);
+    pthread_join(adev->route_thread, (void **) NULL);
+    pthread_cond_destroy(&adev->route_done_cond);
+    pthread_cond_destroy(&adev->route_cond);
+    pthread_mutex_destroy(&adev->route_lock);
+}
+
+/*
+ * enable_snd_device() and disable_snd_device() only update the reference
+ * counts, with adev->lock held. The mixer path is applied later by the
+ * routing thread, so no caller ever blocks on a mixer update.
+ */
+static int enable_snd_device(struct audio_device *adev,
+                             struct audio_usecase *uc_info,
+                             snd_device_t snd_device)
+{
+    const char *snd_device_name = get_snd_device_name(snd_device);
+
+    if (snd_device_name == NULL)
+        return -EINVAL;
+
+    if (snd_device == SND_DEVICE_OUT_SPEAKER_AND_HEADPHONES) {
+        ALOGV("Request to enable combo device: enable individual devices\n");
+        enable_snd_device(adev, uc_info, SND_DEVICE_OUT_SPEAKER);
+        enable_snd_device(adev, uc_info, SND_DEVICE_OUT_HEADPHONES);
+        return 0;
+    }
+    adev->snd_dev_ref_cnt[snd_device]++;
+    if (adev->snd_dev_ref_cnt[snd_device] > 1) {
+        ALOGV("%s: snd_device(%d: %s) is already active",
+              __func__, snd_device, snd_device_name);
+        return 0;
+    }
+
+    ALOGV("%s: snd_device(%d: %s)", __func__,
+          snd_device, snd_device_name);
+
+    send_route_cmd(adev, uc_info, ROUTE_CMD_ENABLE, uc_info->id, snd_device, SND_DEVICE_NONE);
 
     return 0;
 }
@@ -894,11 +1128,8 @@ int disable_snd_device(struct audio_device *adev,
                               struct audio_usecase *uc_info,
                               snd_device_t snd_device)
 {
-    struct mixer_card *mixer_card;
-    struct listnode *node;
     struct audio_usecase *out_uc_info = get_usecase_from_type(adev, PCM_PLAYBACK);
     const char *snd_device_name = get_snd_device_name(snd_device);
-    const char *out_snd_device_name = NULL;
 
     if (snd_device_name == NULL)
         return -EINVAL;
@@ -918,24 +1149,8 @@ int disable_snd_device(struct audio_device *adev,
     if (adev->snd_dev_ref_cnt[snd_device] == 0) {
         ALOGV("%s: snd_device(%d: %s)", __func__,
               snd_device, snd_device_name);
-        list_for_each(node, &uc_info->mixer_list) {
-            mixer_card = node_to_item(node, struct mixer_card, uc_list_node[uc_info->id]);
-            audio_route_reset_and_update_path(mixer_card->audio_route, snd_device_name);
-            if (snd_device > SND_DEVICE_IN_BEGIN && out_uc_info != NULL) {
-                /*
-                 * Cycle the rx device to eliminate routing conflicts.
-                 * This prevents issues when an input route shares mixer controls with an output
-                 * route.
-                 */
-                out_snd_device_name = get_snd_device_name(out_uc_info->out_snd_device);
-                audio_route_apply_and_update_path(mixer_card->audio_route, out_snd_device_name);
-            }
-
-            amplifier_enable_devices(snd_device, false);
-#ifdef DSP_POWEROFF_DELAY
-            clock_gettime(CLOCK_MONOTONIC, &(mixer_card->dsp_poweroff_time));
-#endif /* DSP_POWEROFF_DELAY */
-        }
+        send_route_cmd(adev, uc_info, ROUTE_CMD_DISABLE, uc_info->id, snd_device,
+                       out_uc_info != NULL ? out_uc_info->out_snd_device : SND_DEVICE_NONE);
     }
     return 0;
 }
@@ -996,6 +1211,8 @@ static void check_and_route_usecases(struct audio_device *adev,
                     usecase->out_snd_device = snd_device;
                 else
                     usecase->in_snd_device = snd_device;
+                route_publish_l(adev, usecase->id, usecase->out_snd_device,
+                                usecase->in_snd_device);
             }
         }
     }
@@ -1109,9 +1326,8 @@ static int select_devices(struct audio_device *adev,
     usecase->in_snd_device = in_snd_device;
     usecase->out_snd_device = out_snd_device;
 
-    /* Rely on amplifier_set_devices to distinguish between in/out devices */
-    amplifier_set_input_devices(in_snd_device);
-    amplifier_set_output_devices(out_snd_device);
+    send_route_cmd(adev, NULL, ROUTE_CMD_AMPLIFIER, uc_id, in_snd_device, out_snd_device);
+    route_publish_l(adev, uc_id, out_snd_device, in_snd_device);
 
     return 0;
 }
@@ -1994,6 +2210,7 @@ static int stop_input_stream(struct stream_in *in)
 
     /* Disable the tx device */
     disable_snd_device(adev, uc_info, uc_info->in_snd_device);
+    route_publish_l(adev, uc_info->id, SND_DEVICE_NONE, SND_DEVICE_NONE);
 
     list_remove(&uc_info->adev_list_node);
     free(uc_info);
@@ -2170,6 +2387,130 @@ void lock_output_stream(struct stream_out *out)
     pthread_mutex_unlock(&out->pre_lock);
 }
 
+/* returns the time spent blocked, in us */
+static int64_t stream_stats_lock(pthread_mutex_t *lock)
+{
+    const int64_t start = get_time_us();
+    pthread_mutex_lock(lock);
+    return get_time_us() - start;
+}
+
+/* must be called with stream mutex locked */
+static void stream_stats_standby_l(struct stream_stats *stats)
+{
+    if (stats->last_time_us != 0)
+        stats->standbys++;
+    /* the next transfer restarts the pcm, its period is meaningless */
+    stats->last_time_us = 0;
+}
+
+/* must be called with stream mutex locked */
+static void stream_stats_record_l(struct stream_stats *stats,
+                                  const struct pcm_config *config,
+                                  unsigned int rate,
+                                  size_t frames,
+                                  int64_t lock_wait_us,
+                                  int64_t dev_lock_wait_us,
+                                  int status)
+{
+    struct stream_stats_sample *sample = &stats->ring[stats->next];
+    const int64_t now = get_time_us();
+    int64_t buffer_us = 0;
+
+    sample->time_us = now;
+    sample->period_us = stats->last_time_us == 0 ? 0 : now - stats->last_time_us;
+    sample->nominal_us = rate == 0 ? 0 : frames * 1000000LL / rate;
+    sample->lock_wait_us = lock_wait_us;
+    sample->dev_lock_wait_us = dev_lock_wait_us;
+    sample->frames = status == 0 ? frames : 0;
+
+    if (config->rate != 0)
+        buffer_us = (int64_t)config->period_size * config->period_count * 1000000LL /
+                    config->rate;
+    if (buffer_us > 0 && sample->period_us > buffer_us)
+        stats->xruns++;
+    if (status != 0)
+        stats->errors++;
+    if (lock_wait_us > stats->max_lock_wait_us)
+        stats->max_lock_wait_us = lock_wait_us;
+    if (dev_lock_wait_us > stats->max_dev_lock_wait_us)
+        stats->max_dev_lock_wait_us = dev_lock_wait_us;
+
+    stats->last_time_us = now;
+    stats->next = (stats->next + 1) % STREAM_STATS_RING_SIZE;
+    stats->count++;
+}
+
+/*
+ * Summarizes the samples still in the ring, along with the lifetime
+ * counters, as comma separated key:value pairs.
+ */
+static void stream_stats_format(const struct stream_stats *stats, char *buf, size_t size)
+{
+    unsigned int num = stats->count < STREAM_STATS_RING_SIZE ?
+                       (unsigned int)stats->count : STREAM_STATS_RING_SIZE;
+    unsigned int i, periods = 0;
+    int64_t jitter_sum = 0, jitter_max = 0, lock_sum = 0, frames_sum = 0;
+    uint32_t frames_min = UINT32_MAX, frames_max = 0;
+
+    for (i = 0; i < num; i++) {
+        const struct stream_stats_sample *sample = &stats->ring[i];
+
+        if (sample->period_us != 0) {
+            int64_t jitter = sample->period_us - sample->nominal_us;
+            if (jitter < 0)
+                jitter = -jitter;
+            jitter_sum += jitter;
+            if (jitter > jitter_max)
+                jitter_max = jitter;
+            periods++;
+        }
+        lock_sum += sample->lock_wait_us + sample->dev_lock_wait_us;
+        frames_sum += sample->frames;
+        if (sample->frames < frames_min)
+            frames_min = sample->frames;
+        if (sample->frames > frames_max)
+            frames_max = sample->frames;
+    }
+    if (num == 0)
+        frames_min = 0;
+
+    snprintf(buf, size,
+             "count:%llu,xruns:%u,errors:%u,standbys:%u,"
+             "jitter_avg_us:%lld,jitter_max_us:%lld,"
+             "lock_wait_avg_us:%lld,lock_wait_max_us:%lld,dev_lock_wait_max_us:%lld,"
+             "frames_min:%u,frames_avg:%lld,frames_max:%u",
+             (unsigned long long)stats->count, stats->xruns, stats->errors, stats->standbys,
+             (long long)(periods ? jitter_sum / periods : 0), (long long)jitter_max,
+             (long long)(num ? lock_sum / num : 0), (long long)stats->max_lock_wait_us,
+             (long long)stats->max_dev_lock_wait_us,
+             frames_min, (long long)(num ? frames_sum / num : 0), frames_max);
+}
+
+static void stream_stats_dump(const struct stream_stats *stats, int fd)
+{
+    unsigned int num = stats->count < STREAM_STATS_RING_SIZE ?
+                       (unsigned int)stats->count : STREAM_STATS_RING_SIZE;
+    unsigned int i;
+    char summary[512];
+
+    stream_stats_format(stats, summary, sizeof(summary));
+    dprintf(fd, "      stats: %s\n", summary);
+    dprintf(fd, "      %-14s %10s %10s %10s %10s %8s\n",
+            "time_us", "period_us", "nominal_us", "lock_us", "devlock_us", "frames");
+
+    /* oldest first */
+    for (i = 0; i < num; i++) {
+        unsigned int index = (stats->next + STREAM_STATS_RING_SIZE - num + i) %
+                             STREAM_STATS_RING_SIZE;
+        const struct stream_stats_sample *sample = &stats->ring[index];
+
+        dprintf(fd, "      %-14lld %10d %10d %10d %10d %8u\n",
+                (long long)sample->time_us, sample->period_us, sample->nominal_us,
+                sample->lock_wait_us, sample->dev_lock_wait_us, sample->frames);
+    }
+}
+
 static int uc_release_pcm_devices(struct audio_usecase *usecase)
 {
     struct stream_out *out = (struct stream_out *)usecase->stream;
@@ -2281,6 +2622,7 @@ int disable_output_path_l(struct stream_out *out)
         return -EINVAL;
     }
     disable_snd_device(adev, uc_info, uc_info->out_snd_device);
+    route_publish_l(adev, uc_info->id, SND_DEVICE_NONE, SND_DEVICE_NONE);
     uc_release_pcm_devices(uc_info);
     list_remove(&uc_info->adev_list_node);
     free(uc_info);
@@ -2395,6 +2737,9 @@ int stop_voice_call(struct audio_device *adev)
 
     disable_snd_device(adev, uc_info, uc_info->out_snd_device);
     disable_snd_device(adev, uc_info, uc_info->in_snd_device);
+    route_publish_l(adev, uc_info->id, SND_DEVICE_NONE, SND_DEVICE_NONE);
+    /* the modem must not be left routed to the call devices */
+    route_flush(adev);
 
     list_remove(&uc_info->adev_list_node);
     free(uc_info);
@@ -2437,6 +2782,8 @@ int start_voice_call(struct audio_device *adev)
     list_add_tail(&adev->usecase_list, &uc_info->adev_list_node);
 
     select_devices(adev, USECASE_VOICE_CALL);
+    /* the call paths must be up before the voice session starts */
+    route_flush(adev);
 
     start_voice_session(adev->voice.session);
 
@@ -2554,6 +2901,7 @@ static int do_out_standby_l(struct stream_out *out)
     int status = 0;
 
     out->standby = true;
+    stream_stats_standby_l(&out->stats);
     if (out->usecase != USECASE_AUDIO_PLAYBACK_OFFLOAD) {
         out_close_pcm_devices(out);
 #ifdef PREPROCESSING_ENABLED
@@ -2606,8 +2954,21 @@ static int out_standby(struct audio_stream *stream)
 
 static int out_dump(const struct audio_stream *stream, int fd)
 {
-    (void)stream;
-    (void)fd;
+    struct stream_out *out = (struct stream_out *)stream;
+    struct stream_stats stats;
+    struct route_state state[AUDIO_USECASE_MAX];
+
+    lock_output_stream(out);
+    stats = out->stats;
+    pthread_mutex_unlock(&out->lock);
+
+    route_snapshot(out->dev, state);
+
+    dprintf(fd, "    out %p: usecase %s, rate %u, period %u x %u, standby %d, routed to %s\n",
+            out, use_case_table[out->usecase], out->config.rate,
+            out->config.period_size, out->config.period_count, out->standby,
+            get_snd_device_display_name(state[out->usecase].out_snd_device));
+    stream_stats_dump(&stats, fd);
 
     return 0;
 }
@@ -2680,6 +3041,8 @@ static int out_set_parameters(struct audio_stream *stream, const char *kvpairs)
                     if (out->usecase == USECASE_AUDIO_PLAYBACK_OFFLOAD)
                         out_set_offload_parameters(adev, uc_info);
                     select_devices(adev, out->usecase);
+                    /* routing requests complete before returning, as before */
+                    route_flush(adev);
                 }
             }
 
@@ -2750,7 +3113,21 @@ static char* out_get_parameters(const struct audio_stream *stream, const char *k
     size_t i, j;
     int ret;
     bool first = true;
+    bool replied = false;
     ALOGV("%s: enter: keys - %s", __func__, keys);
+    ret = str_parms_get_str(query, AUDIO_PARAMETER_STREAM_STATS, value, sizeof(value));
+    if (ret >= 0) {
+        struct stream_stats stats;
+        char summary[512];
+
+        lock_output_stream(out);
+        stats = out->stats;
+        pthread_mutex_unlock(&out->lock);
+
+        stream_stats_format(&stats, summary, sizeof(summary));
+        str_parms_add_str(reply, AUDIO_PARAMETER_STREAM_STATS, summary);
+        replied = true;
+    }
     ret = str_parms_get_str(query, AUDIO_PARAMETER_STREAM_SUP_CHANNELS, value, sizeof(value));
     if (ret >= 0) {
         value[0] = '\0';
@@ -2769,6 +3146,9 @@ static char* out_get_parameters(const struct audio_stream *stream, const char *k
             i++;
         }
         str_parms_add_str(reply, AUDIO_PARAMETER_STREAM_SUP_CHANNELS, value);
+        replied = true;
+    }
+    if (replied) {
         str = str_parms_to_str(reply);
     } else {
         str = strdup(keys);
@@ -2845,8 +3225,12 @@ static ssize_t out_write(struct audio_stream_out *stream, const void *buffer,
     size_t out_frames = in_frames;
     struct stream_in *in = NULL;
 #endif
+    int64_t lock_wait_us;
+    int64_t dev_lock_wait_us = 0;
+    const int64_t lock_start_us = get_time_us();
 
     lock_output_stream(out);
+    lock_wait_us = get_time_us() - lock_start_us;
 
 #if SUPPORTS_IRQ_AFFINITY
     if (out->usecase == USECASE_AUDIO_PLAYBACK && !out->is_fastmixer_affinity_set) {
@@ -2872,7 +3256,7 @@ static ssize_t out_write(struct audio_stream_out *stream, const void *buffer,
             goto false_alarm;
         }
 #endif
-        pthread_mutex_lock(&adev->lock);
+        dev_lock_wait_us += stream_stats_lock(&adev->lock);
         ret = start_output_stream(out);
         if (ret == 0) {
             amplifier_output_stream_start(stream, out->usecase == USECASE_AUDIO_PLAYBACK_OFFLOAD);
@@ -2898,6 +3282,8 @@ static ssize_t out_write(struct audio_stream_out *stream, const void *buffer,
         }
 #endif
         pthread_mutex_unlock(&adev->lock);
+        /* the first write starts the PCM, the path must be up by then */
+        route_flush(adev);
 #ifdef PREPROCESSING_ENABLED
         if (!in) {
             /* Leave mutex locked iff in != NULL */
@@ -2916,7 +3302,7 @@ false_alarm:
 #ifdef PREPROCESSING_ENABLED
         if (android_atomic_acquire_load(&adev->echo_reference_generation)
                 != out->echo_reference_generation) {
-            pthread_mutex_lock(&adev->lock);
+            dev_lock_wait_us += stream_stats_lock(&adev->lock);
             if (out->echo_reference != NULL) {
                 ALOGV("%s: release_echo_reference %p", __func__, out->echo_reference);
                 release_echo_reference(out->echo_reference);
@@ -2958,6 +3344,10 @@ false_alarm:
     }
 
 exit:
+    if (out->usecase != USECASE_AUDIO_PLAYBACK_OFFLOAD)
+        stream_stats_record_l(&out->stats, &out->config, out_get_sample_rate(&stream->common),
+                              bytes / audio_stream_out_frame_size(stream),
+                              lock_wait_us, dev_lock_wait_us, ret);
     pthread_mutex_unlock(&out->lock);
 
     if (ret != 0) {
@@ -3239,6 +3629,7 @@ static int do_in_standby_l(struct stream_in *in)
     }
 
     in->last_read_time_us = 0;
+    stream_stats_standby_l(&in->stats);
 
     return 0;
 }
@@ -3274,8 +3665,17 @@ static int in_standby(struct audio_stream *stream)
 
 static int in_dump(const struct audio_stream *stream, int fd)
 {
-    (void)stream;
-    (void)fd;
+    struct stream_in *in = (struct stream_in *)stream;
+    struct stream_stats stats;
+
+    lock_input_stream(in);
+    stats = in->stats;
+    pthread_mutex_unlock(&in->lock);
+
+    dprintf(fd, "    in %p: usecase %s, rate %u, period %u x %u, standby %d\n",
+            in, use_case_table[in->usecase], in->config.rate,
+            in->config.period_size, in->config.period_count, in->standby);
+    stream_stats_dump(&stats, fd);
 
     return 0;
 }
@@ -3351,10 +3751,30 @@ static int in_set_parameters(struct audio_stream *stream, const char *kvpairs)
 static char* in_get_parameters(const struct audio_stream *stream,
                                const char *keys)
 {
-    (void)stream;
-    (void)keys;
+    struct stream_in *in = (struct stream_in *)stream;
+    struct str_parms *query = str_parms_create_str(keys);
+    struct str_parms *reply = str_parms_create();
+    char value[32];
+    char *str;
+    int ret;
 
-    return strdup("");
+    ret = str_parms_get_str(query, AUDIO_PARAMETER_STREAM_STATS, value, sizeof(value));
+    if (ret >= 0) {
+        struct stream_stats stats;
+        char summary[512];
+
+        lock_input_stream(in);
+        stats = in->stats;
+        pthread_mutex_unlock(&in->lock);
+
+        stream_stats_format(&stats, summary, sizeof(summary));
+        str_parms_add_str(reply, AUDIO_PARAMETER_STREAM_STATS, summary);
+    }
+    str = str_parms_to_str(reply);
+
+    str_parms_destroy(query);
+    str_parms_destroy(reply);
+    return str;
 }
 
 static int in_set_gain(struct audio_stream_in *stream, float gain)
@@ -3375,9 +3795,13 @@ static ssize_t in_read(struct audio_stream_in *stream, void *buffer,
     int read_and_process_successful = false;
 
     size_t frames_rq = bytes / audio_stream_in_frame_size(stream);
+    int64_t lock_wait_us;
+    int64_t dev_lock_wait_us = 0;
+    const int64_t lock_start_us = get_time_us();
 
     /* no need to acquire adev->lock_inputs because API contract prevents a close */
     lock_input_stream(in);
+    lock_wait_us = get_time_us() - lock_start_us;
 
 #if SUPPORTS_IRQ_AFFINITY
     if (in->usecase == USECASE_AUDIO_CAPTURE && !in->is_fastcapture_affinity_set) {
@@ -3400,7 +3824,7 @@ static ssize_t in_read(struct audio_stream_in *stream, void *buffer,
             pthread_mutex_unlock(&adev->lock_inputs);
             goto false_alarm;
         }
-        pthread_mutex_lock(&adev->lock);
+        dev_lock_wait_us += stream_stats_lock(&adev->lock);
         ret = start_input_stream(in);
         if (ret == 0) {
             amplifier_input_stream_start(stream);
@@ -3411,6 +3835,8 @@ static ssize_t in_read(struct audio_stream_in *stream, void *buffer,
         if (ret != 0) {
             goto exit;
         }
+        /* the first read starts the PCM, the path must be up by then */
+        route_flush(adev);
         in->standby = 0;
     }
 false_alarm:
@@ -3435,6 +3861,9 @@ false_alarm:
         memset(buffer, 0, bytes);
 
 exit:
+    stream_stats_record_l(&in->stats, &in->config, in_get_sample_rate(&stream->common),
+                          frames_rq, lock_wait_us, dev_lock_wait_us,
+                          read_and_process_successful ? 0 : -EIO);
     pthread_mutex_unlock(&in->lock);
 
     if (read_and_process_successful == false) {
@@ -4166,8 +4595,31 @@ static void adev_close_input_stream(struct audio_hw_device *dev,
 
 static int adev_dump(const audio_hw_device_t *device, int fd)
 {
-    (void)device;
-    (void)fd;
+    struct audio_device *adev = (struct audio_device *)device;
+    struct route_state state[AUDIO_USECASE_MAX];
+    unsigned int queued, done, count;
+    int64_t max_apply_us;
+    int i;
+
+    pthread_mutex_lock(&adev->route_lock);
+    queued = adev->route_queued_seq;
+    done = adev->route_done_seq;
+    count = adev->route_cmd_count;
+    max_apply_us = adev->route_max_apply_us;
+    pthread_mutex_unlock(&adev->route_lock);
+
+    route_snapshot(adev, state);
+
+    dprintf(fd, "  routing: %u commands applied, %u pending, max apply %lld us\n",
+            count, queued - done, (long long)max_apply_us);
+    for (i = 0; i < AUDIO_USECASE_MAX; i++) {
+        if (state[i].out_snd_device == SND_DEVICE_NONE &&
+            state[i].in_snd_device == SND_DEVICE_NONE)
+            continue;
+        dprintf(fd, "    %s: out %s, in %s\n", use_case_table[i],
+                get_snd_device_display_name(state[i].out_snd_device),
+                get_snd_device_display_name(state[i].in_snd_device));
+    }
 
     return 0;
 }
@@ -4175,6 +4627,7 @@ static int adev_dump(const audio_hw_device_t *device, int fd)
 static int adev_close(hw_device_t *device)
 {
     struct audio_device *adev = (struct audio_device *)device;
+    destroy_route_thread(adev);
     voice_session_deinit(adev->voice.session);
     audio_device_ref_count--;
     if (audio_device_ref_count == 0) {
@@ -4306,6 +4759,8 @@ static int adev_open(const hw_module_t *module, const char *name,
         ALOGE("Amplifier initialization failed");
     }
 
+    create_route_thread(adev);
+
     *device = &adev->device.common;
 
     audio_device_ref_count++;
@@ -207,6 +207,14 @@ enum {
     OFFLOAD_CMD_WAIT_FOR_BUFFER,    /* wait for buffer released by DSP */
 };
 
+enum {
+    ROUTE_CMD_EXIT,                 /* exit routing thread loop */
+    ROUTE_CMD_ENABLE,               /* apply a sound device path */
+    ROUTE_CMD_DISABLE,              /* reset a sound device path */
+    ROUTE_CMD_AMPLIFIER,            /* set amplifier input and output devices */
+    ROUTE_CMD_PUBLISH,              /* publish the routing state of a usecase */
+};
+
 enum {
     OFFLOAD_STATE_IDLE,
     OFFLOAD_STATE_PLAYING,
@@ -227,6 +235,33 @@ struct offload_cmd {
     int             data[];
 };
 
+#define ROUTE_MAX_CARDS 2
+
+struct mixer_card;
+
+/*
+ * Mixer path update queued by the audio_device bookkeeping (done with
+ * adev->lock held) for the routing thread. Everything the thread needs
+ * is copied in, as the usecase may be gone by the time it runs.
+ */
+struct route_cmd {
+    struct listnode     node;
+    int                 cmd;
+    unsigned int        seq;
+    audio_usecase_t     usecase;
+    snd_device_t        snd_device;     /* enable/disable, amplifier input, published input */
+    snd_device_t        snd_device_out; /* rx device to re-apply after disabling a tx device,
+                                           amplifier output, published output */
+    unsigned int        num_cards;
+    struct mixer_card*  cards[ROUTE_MAX_CARDS];
+};
+
+/* sound devices a usecase is routed to, as applied to the mixer */
+struct route_state {
+    snd_device_t        out_snd_device;
+    snd_device_t        in_snd_device;
+};
+
 struct pcm_device_profile {
     struct pcm_config config;
     int               card;
@@ -242,6 +277,37 @@ struct pcm_device {
     int                        status;
 };
 
+/*
+ * Per-stream timing telemetry, reported by out_dump()/in_dump() and the
+ * AUDIO_PARAMETER_STREAM_STATS get_parameters() key. Samples are recorded
+ * with the stream mutex held, once per successful or failed pcm transfer.
+ */
+#define AUDIO_PARAMETER_STREAM_STATS "stream_stats"
+#define STREAM_STATS_RING_SIZE 64
+
+struct stream_stats_sample {
+    int64_t  time_us;           /* when the transfer finished */
+    int32_t  period_us;         /* since the previous transfer, 0 after standby */
+    int32_t  nominal_us;        /* duration of the frames transferred */
+    int32_t  lock_wait_us;      /* blocked on the stream mutex */
+    int32_t  dev_lock_wait_us;  /* blocked on the audio_device mutex */
+    uint32_t frames;
+};
+
+struct stream_stats {
+    struct stream_stats_sample ring[STREAM_STATS_RING_SIZE];
+    unsigned int               next;
+    uint64_t                   count;
+    /* transfer took longer than the whole pcm buffer: it must have run dry */
+    uint32_t                   xruns;
+    /* pcm_write()/pcm_read() errors */
+    uint32_t                   errors;
+    uint32_t                   standbys;
+    int64_t                    last_time_us;
+    int64_t                    max_lock_wait_us;
+    int64_t                    max_dev_lock_wait_us;
+};
+
 struct stream_out {
     struct audio_stream_out     stream;
     pthread_mutex_t             lock; /* see note below on mutex acquisition order */
@@ -291,6 +357,8 @@ struct stream_out {
     bool                         is_fastmixer_affinity_set;
 
     int64_t                      last_write_time_us;
+
+    struct stream_stats          stats;
 };
 
 struct stream_in {
@@ -341,6 +409,8 @@ struct stream_in {
     int64_t                             last_read_time_us;
     int64_t                             frames_read; /* total frames read, not cleared when
                                                         entering standby */
+
+    struct stream_stats                 stats;
 };
 
 struct mixer_card {
@@ -409,6 +479,30 @@ struct audio_device {
 
     pthread_mutex_t         lock_inputs; /* see note below on mutex acquisition order */
     amplifier_device_t      *amp;
+
+    /*
+     * Routing thread: the only thread touching the mixer paths and the
+     * amplifier devices once the device is open. route_lock only protects
+     * the command queue and is never held while applying a path, so it can
+     * be taken with or without adev->lock.
+     */
+    pthread_t               route_thread;
+    pthread_mutex_t         route_lock;
+    pthread_cond_t          route_cond;
+    pthread_cond_t          route_done_cond;
+    struct listnode         route_cmd_list;
+    unsigned int            route_queued_seq;
+    unsigned int            route_done_seq;
+    unsigned int            route_cmd_count;
+    int64_t                 route_max_apply_us;
+
+    /*
+     * Per-usecase routing state, written by the routing thread only and
+     * read without locks through route_snapshot(): an odd route_state_seq
+     * means an update is in progress.
+     */
+    volatile int32_t        route_state_seq;
+    struct route_state      route_state[AUDIO_USECASE_MAX];
 };
 
 /*
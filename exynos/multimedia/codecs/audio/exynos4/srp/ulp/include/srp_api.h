@@ -26,6 +26,12 @@ int SRP_IsOpen(void);
 #define SRP_INIT_BLOCK_MODE                  0
 #define SRP_INIT_NONBLOCK_MODE               1
 
+/* SRP_GetParams ids answered by the library, not the driver */
+#define SRP_WBUF_FILL_LEVEL                  (0x40000)
+#define SRP_WBUF_SIZE                        (0x40001)
+#define SRP_DECODE_ERROR_COUNT               (0x40002)
+#define SRP_LAST_DECODE_ERROR                (0x40003)
+
 #define SRP_PENDING_STATE_RUNNING            0
 #define SRP_PENDING_STATE_PENDING            1
 
@@ -9,6 +9,7 @@
 #include <string.h>
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "srp_api.h"
 
@@ -35,19 +36,33 @@ static int srp_block_mode = SRP_INIT_BLOCK_MODE;
 
 static unsigned char *wbuf;
 static int wbuf_size;
-static int wbuf_pos;
+static int wbuf_rd;         /* start of the next IBUF chunk to send */
+static int wbuf_fill;       /* bytes buffered from wbuf_rd on, may wrap */
+
+static unsigned long srp_decode_errors;
+static unsigned long srp_last_error;
 
 #ifdef _DUMP_TO_FILE_
 static FILE *fp_dump = NULL;
 #endif
 
 #ifdef _USE_WBUF_
+/*
+ * wbuf is a ring of WBUF_LEN_MUL IBUF-sized chunks. Chunks are sent to
+ * the RP driver from chunk boundaries only, so every write() is one
+ * contiguous IBUF and only the incoming data has to wrap.
+ */
 static int WriteBuff_Init(void)
 {
     if (wbuf == NULL) {
         wbuf_size = srp_ibuf_size * WBUF_LEN_MUL;
-        wbuf_pos = 0;
+        wbuf_rd = 0;
+        wbuf_fill = 0;
         wbuf = (unsigned char *)malloc(wbuf_size);
+        if (wbuf == NULL) {
+            ALOGE("%s: WriteBuffer %dbytes allocation fail", __func__, wbuf_size);
+            return -1;
+        }
         ALOGD("%s: WriteBuffer %dbytes allocated", __func__, wbuf_size);
         return 0;
     }
@@ -61,6 +76,7 @@ static int WriteBuff_Deinit(void)
     if (wbuf != NULL) {
         free(wbuf);
         wbuf = NULL;
+        wbuf_fill = 0;
         return 0;
     }
 
@@ -70,31 +86,55 @@ static int WriteBuff_Deinit(void)
 
 static int WriteBuff_Write(unsigned char *buff, int size_byte)
 {
-    int write_byte;
+    int wr;
+    int part;
 
-    if ((wbuf_pos + size_byte) < wbuf_size) {
-        memcpy(&wbuf[wbuf_pos], buff, size_byte);
-        wbuf_pos += size_byte;
-    } else {
-        ALOGE("%s: WriteBuffer is filled [%d], ignoring write [%d]", __func__, wbuf_pos, size_byte);
+    if (wbuf_fill + size_byte > wbuf_size) {
+        ALOGE("%s: WriteBuffer is filled [%d], ignoring write [%d]", __func__, wbuf_fill, size_byte);
         return -1;    /* Insufficient buffer */
     }
 
-    return wbuf_pos;
+    wr = wbuf_rd + wbuf_fill;
+    if (wr >= wbuf_size)
+        wr -= wbuf_size;
+
+    part = wbuf_size - wr;
+    if (part > size_byte)
+        part = size_byte;
+
+    memcpy(&wbuf[wr], buff, part);
+    memcpy(wbuf, buff + part, size_byte - part);
+    wbuf_fill += size_byte;
+
+    return wbuf_fill;
+}
+
+static unsigned char *WriteBuff_Chunk(void)
+{
+    return &wbuf[wbuf_rd];
 }
 
 static void WriteBuff_Consume(void)
 {
-    memcpy(wbuf, &wbuf[srp_ibuf_size], srp_ibuf_size * (WBUF_LEN_MUL - 1));
-    wbuf_pos -= srp_ibuf_size;
+    wbuf_rd += srp_ibuf_size;
+    if (wbuf_rd >= wbuf_size)
+        wbuf_rd = 0;
+    wbuf_fill -= srp_ibuf_size;
 }
 
 static void WriteBuff_Flush(void)
 {
-    wbuf_pos = 0;
+    wbuf_rd = 0;
+    wbuf_fill = 0;
 }
 #endif
 
+static void SRP_Count_Error(int err_code)
+{
+    srp_decode_errors++;
+    srp_last_error = err_code;
+}
+
 int SRP_Create(int block_mode)
 {
     if (srp_dev == -1) {
@@ -119,6 +159,8 @@ int SRP_Init(unsigned int ibuf_size)
 
     if (srp_dev != -1) {
         srp_ibuf_size = ibuf_size;
+        srp_decode_errors = 0;
+        srp_last_error = 0;
         ret = ioctl(srp_dev, SRP_INIT, srp_ibuf_size); /* Initialize IBUF size (4KB ~ 18KB) */
 
 #ifdef _DUMP_TO_FILE_
@@ -162,10 +204,10 @@ int SRP_Decode(void *buff, int size_byte)
 
     if (srp_dev != -1) {
         /* Check wbuf before writing buff */
-        while (wbuf_pos >= srp_ibuf_size) { /* Write_Buffer filled? (IBUF Size)*/
+        while (wbuf_fill >= srp_ibuf_size) { /* Write_Buffer filled? (IBUF Size)*/
             ALOGD("%s: Write Buffer is full, Send data to RP", __func__);
 
-            ret = write(srp_dev, wbuf, srp_ibuf_size); /* Write Buffer to RP Driver */
+            ret = write(srp_dev, WriteBuff_Chunk(), srp_ibuf_size); /* Write Buffer to RP Driver */
             if (ret == -1) { /* Fail? */
                 ioctl(srp_dev, SRP_ERROR_STATE, &val);
                 if (!val) {    /* Write error? */
@@ -173,12 +215,13 @@ int SRP_Decode(void *buff, int size_byte)
                     return -1;
                 } else {       /* Write OK, but RP decode error? */
                     err_code = val;
+                    SRP_Count_Error(err_code);
                     ALOGE("%s: RP decode error [0x%05X]", __func__, err_code);
                 }
             }
 #ifdef _DUMP_TO_FILE_
             if (fp_dump)
-                fwrite(wbuf, srp_ibuf_size, 1, fp_dump);
+                fwrite(WriteBuff_Chunk(), srp_ibuf_size, 1, fp_dump);
 #endif
             WriteBuff_Consume();
         }
@@ -187,7 +230,7 @@ int SRP_Decode(void *buff, int size_byte)
         if (ret == -1)
             return -1;  /* Buffering error */
 
-        ALOGD("%s: Write Buffer remain [%d]", __func__, wbuf_pos);
+        ALOGD("%s: Write Buffer remain [%d]", __func__, wbuf_fill);
         return err_code;  /* Write Success */
     }
 
@@ -202,33 +245,35 @@ int SRP_Send_EOS(void)
 
     if (srp_dev != -1) {
         /* Check wbuf before writing buff */
-        while (wbuf_pos) { /* Write_Buffer ramain?*/
-            if (wbuf_pos < srp_ibuf_size) {
-                memset(wbuf + wbuf_pos, 0xFF, srp_ibuf_size - wbuf_pos); /* Fill dummy data */
-                wbuf_pos = srp_ibuf_size;
+        while (wbuf_fill) { /* Write_Buffer ramain?*/
+            if (wbuf_fill < srp_ibuf_size) {
+                /* the chunk starts on a boundary, so its tail does not wrap */
+                memset(WriteBuff_Chunk() + wbuf_fill, 0xFF, srp_ibuf_size - wbuf_fill); /* Fill dummy data */
+                wbuf_fill = srp_ibuf_size;
             }
 
-            ret = write(srp_dev, wbuf, srp_ibuf_size); /* Write Buffer to RP Driver */
+            ret = write(srp_dev, WriteBuff_Chunk(), srp_ibuf_size); /* Write Buffer to RP Driver */
             if (ret == -1) {  /* Fail? */
                 ret = ioctl(srp_dev, SRP_ERROR_STATE, &val);
                 if (!val) {   /* Write error? */
                     ALOGE("%s: IBUF write fail", __func__);
                     return -1;
                 } else {      /* RP decoe error? */
+                    SRP_Count_Error(val);
                     ALOGE("%s: RP decode error [0x%05X]", __func__, val);
                     return -1;
                 }
             } else {          /* Success? */
 #ifdef _DUMP_TO_FILE_
                 if (fp_dump)
-                    fwrite(wbuf, srp_ibuf_size, 1, fp_dump);
+                    fwrite(WriteBuff_Chunk(), srp_ibuf_size, 1, fp_dump);
 #endif
                 WriteBuff_Consume();
             }
         }
 
-        memset(wbuf, 0xFF, srp_ibuf_size);      /* Fill dummy data */
-        write(srp_dev, wbuf, srp_ibuf_size); /* Write Buffer to RP Driver */
+        memset(WriteBuff_Chunk(), 0xFF, srp_ibuf_size);      /* Fill dummy data */
+        write(srp_dev, WriteBuff_Chunk(), srp_ibuf_size); /* Write Buffer to RP Driver */
 
         /* Wait until RP decoding over */
         return ioctl(srp_dev, SRP_WAIT_EOS);
@@ -254,6 +299,7 @@ int SRP_Decode(void *buff, int size_byte)
                 return -1;
             } else {      /* Write OK, but RP decode error? */
                 err_code = val;
+                SRP_Count_Error(err_code);
                 ALOGE("%s: RP decode error [0x%05X]", __func__, err_code);
             }
         }
@@ -328,8 +374,32 @@ int SRP_SetParams(int id, unsigned long val)
 
 int SRP_GetParams(int id, unsigned long *pval)
 {
-    if (srp_dev != -1)
-        return ioctl(srp_dev, id, pval);
+    if (srp_dev != -1) {
+        switch (id) {
+        case SRP_WBUF_FILL_LEVEL:
+#ifdef _USE_WBUF_
+            *pval = wbuf_fill;
+#else
+            *pval = 0;
+#endif
+            return 0;
+        case SRP_WBUF_SIZE:
+#ifdef _USE_WBUF_
+            *pval = wbuf_size;
+#else
+            *pval = 0;
+#endif
+            return 0;
+        case SRP_DECODE_ERROR_COUNT:
+            *pval = srp_decode_errors;
+            return 0;
+        case SRP_LAST_DECODE_ERROR:
+            *pval = srp_last_error;
+            return 0;
+        default:
+            return ioctl(srp_dev, id, pval);
+        }
+    }
 
     return -1;    /* device is not created */
 }
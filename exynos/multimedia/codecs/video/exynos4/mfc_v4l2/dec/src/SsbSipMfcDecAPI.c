@@ -221,6 +221,8 @@ void *SsbSipMfcDecOpen(void)
     }
 
     pCTX->v4l2_dec.mfc_num_src_bufs   = reqbuf.count;
+    if (pCTX->v4l2_dec.mfc_num_src_bufs > MFC_DEC_NUM_SRC_BUFS)
+        pCTX->v4l2_dec.mfc_num_src_bufs = MFC_DEC_NUM_SRC_BUFS;
 
     for (i = 0; i < pCTX->v4l2_dec.mfc_num_src_bufs; ++i) {
         memset(&(buf), 0, sizeof (buf));
@@ -442,8 +442,7 @@ OMX_ERRORTYPE SEC_SRP_Mp3Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
 
     FunctionIn();
 
-    SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-    SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+    SEC_OMX_Timestamp_Reset(&pSECComponent->timestampQueue);
     pSECComponent->bUseFlagEOF = OMX_TRUE; /* Mp3 extractor should parse into frame unit. */
     pSECComponent->bSaveFlagEOS = OMX_FALSE;
     pMp3Dec->hSRPMp3Handle.bConfiguredSRP = OMX_FALSE;
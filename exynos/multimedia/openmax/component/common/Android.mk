@@ -5,7 +5,8 @@ LOCAL_MODULE_TAGS := optional
 
 LOCAL_SRC_FILES := \
 	SEC_OMX_Basecomponent.c \
-	SEC_OMX_Baseport.c
+	SEC_OMX_Baseport.c \
+	SEC_OMX_Timestamp.c
 
 LOCAL_MODULE := libsecbasecomponent
 
@@ -41,3 +42,20 @@ LOCAL_C_INCLUDES := $(SEC_OMX_INC)/khronos \
 	$(SEC_OMX_TOP)/osal
 
 include $(BUILD_SHARED_LIBRARY)
+
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	SEC_OMX_Timestamp.c \
+	SEC_OMX_Timestamp_Test.c
+
+LOCAL_MODULE := SEC_OMX_Timestamp_Test
+
+LOCAL_C_INCLUDES := $(SEC_OMX_INC)/khronos \
+	$(SEC_OMX_INC)/sec \
+	$(SEC_OMX_TOP)/osal
+
+include $(BUILD_HOST_EXECUTABLE)
@@ -1445,6 +1445,8 @@ OMX_ERRORTYPE SEC_OMX_BaseComponent_Constructor(
     }
     SEC_OSAL_Memset(pSECComponent, 0, sizeof(SEC_OMX_BASECOMPONENT));
     pOMXComponent->pComponentPrivate = (OMX_PTR)pSECComponent;
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_TAG, OMX_FALSE);
 
     ret = SEC_OSAL_SemaphoreCreate(&pSECComponent->msgSemaphoreHandle);
     if (ret != OMX_ErrorNone) {
@@ -32,6 +32,7 @@
 #include "OMX_Component.h"
 #include "SEC_OSAL_Queue.h"
 #include "SEC_OMX_Baseport.h"
+#include "SEC_OMX_Timestamp.h"
 
 
 typedef struct _SEC_OMX_MESSAGE
@@ -117,13 +118,10 @@ typedef struct _SEC_OMX_BASECOMPONENT
     OMX_CALLBACKTYPE        *pCallbacks;
     OMX_PTR                  callbackData;
 
-    /* Save Timestamp */
-    OMX_TICKS                timeStamp[MAX_TIMESTAMP];
+    /* Save Timestamp and Flags */
+    SEC_OMX_TIMESTAMP_QUEUE  timestampQueue;
     SEC_OMX_TIMESTAMP        checkTimeStamp;
 
-    /* Save Flags */
-    OMX_U32                  nFlags[MAX_FLAGS];
-
     OMX_BOOL                 getAllDelayBuffer;
     OMX_BOOL                 remainOutputData;
     OMX_BOOL                 reInputData;
@@ -43,12 +43,38 @@
 #include "SEC_OSAL_Log.h"
 
 
+/* hands a flushed buffer back to its owner and frees its message */
+static void SEC_OMX_ReturnFlushedBuffer(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 portIndex,
+                                        SEC_OMX_MESSAGE *message)
+{
+    SEC_OMX_BASECOMPONENT *pSECComponent = (SEC_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    SEC_OMX_BASEPORT      *pSECPort = &pSECComponent->pSECPort[portIndex];
+    OMX_BUFFERHEADERTYPE  *bufferHeader = (OMX_BUFFERHEADERTYPE *)message->pCmdData;
+
+    bufferHeader->nFilledLen = 0;
+
+    if (CHECK_PORT_TUNNELED(pSECPort)) {
+        if (portIndex) {
+            OMX_EmptyThisBuffer(pSECPort->tunneledComponent, bufferHeader);
+        } else {
+            OMX_FillThisBuffer(pSECPort->tunneledComponent, bufferHeader);
+        }
+    } else {
+        if (portIndex == OUTPUT_PORT_INDEX) {
+            pSECComponent->pCallbacks->FillBufferDone(pOMXComponent, pSECComponent->callbackData, bufferHeader);
+        } else {
+            pSECComponent->pCallbacks->EmptyBufferDone(pOMXComponent, pSECComponent->callbackData, bufferHeader);
+        }
+    }
+
+    SEC_OSAL_Free(message);
+}
+
 OMX_ERRORTYPE SEC_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 portIndex)
 {
     OMX_ERRORTYPE          ret = OMX_ErrorNone;
     SEC_OMX_BASECOMPONENT *pSECComponent = (SEC_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
     SEC_OMX_BASEPORT      *pSECPort = NULL;
-    OMX_BUFFERHEADERTYPE  *bufferHeader = NULL;
     SEC_OMX_MESSAGE       *message = NULL;
     OMX_U32                flushNum = 0;
     OMX_S32                semValue = 0;
@@ -64,32 +90,14 @@ OMX_ERRORTYPE SEC_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 portIn
 
         message = (SEC_OMX_MESSAGE *)SEC_OSAL_Dequeue(&pSECPort->bufferQ);
         if (message != NULL) {
-            bufferHeader = (OMX_BUFFERHEADERTYPE *)message->pCmdData;
-            bufferHeader->nFilledLen = 0;
-
-            if (CHECK_PORT_TUNNELED(pSECPort) && !CHECK_PORT_BUFFER_SUPPLIER(pSECPort)) {
-                if (portIndex) {
-                    OMX_EmptyThisBuffer(pSECPort->tunneledComponent, bufferHeader);
-                } else {
-                    OMX_FillThisBuffer(pSECPort->tunneledComponent, bufferHeader);
-                }
-                SEC_OSAL_Free(message);
-                message = NULL;
-            } else if (CHECK_PORT_TUNNELED(pSECPort) && CHECK_PORT_BUFFER_SUPPLIER(pSECPort)) {
+            if (CHECK_PORT_TUNNELED(pSECPort) && CHECK_PORT_BUFFER_SUPPLIER(pSECPort)) {
                 SEC_OSAL_Log(SEC_LOG_ERROR, "Tunneled mode is not working, Line:%d", __LINE__);
                 ret = OMX_ErrorNotImplemented;
                 SEC_OSAL_Queue(&pSECPort->bufferQ, pSECPort);
                 goto EXIT;
-            } else {
-                if (portIndex == OUTPUT_PORT_INDEX) {
-                    pSECComponent->pCallbacks->FillBufferDone(pOMXComponent, pSECComponent->callbackData, bufferHeader);
-                } else {
-                    pSECComponent->pCallbacks->EmptyBufferDone(pOMXComponent, pSECComponent->callbackData, bufferHeader);
-                }
-
-                SEC_OSAL_Free(message);
-                message = NULL;
             }
+            SEC_OMX_ReturnFlushedBuffer(pOMXComponent, portIndex, message);
+            message = NULL;
         }
     }
 
@@ -114,7 +122,8 @@ OMX_ERRORTYPE SEC_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 portIn
             SEC_OSAL_SemaphoreWait(pSECComponent->pSECPort[portIndex].bufferSemID);
         }
         if (SEC_OSAL_GetElemNum(&pSECPort->bufferQ) != (int)pSECPort->assignedBufferNum)
-            SEC_OSAL_SetElemNum(&pSECPort->bufferQ, pSECPort->assignedBufferNum);
+            SEC_OSAL_Log(SEC_LOG_ERROR, "%s: port %d holds %d buffers, %d assigned", __func__, (int)portIndex,
+                         SEC_OSAL_GetElemNum(&pSECPort->bufferQ), (int)pSECPort->assignedBufferNum);
     } else {
         while(1) {
             OMX_S32 cnt = 0;
@@ -123,7 +132,9 @@ OMX_ERRORTYPE SEC_OMX_FlushPort(OMX_COMPONENTTYPE *pOMXComponent, OMX_S32 portIn
                 break;
             SEC_OSAL_SemaphoreWait(pSECComponent->pSECPort[portIndex].bufferSemID);
         }
-        SEC_OSAL_SetElemNum(&pSECPort->bufferQ, 0);
+        /* buffers queued while flushing go back to the client as well */
+        while ((message = (SEC_OMX_MESSAGE *)SEC_OSAL_Dequeue(&pSECPort->bufferQ)) != NULL)
+            SEC_OMX_ReturnFlushedBuffer(pOMXComponent, portIndex, message);
     }
 
     pSECComponent->processData[portIndex].dataLen       = 0;
@@ -193,8 +204,7 @@ OMX_ERRORTYPE SEC_OMX_BufferFlushProcess(OMX_COMPONENTTYPE *pOMXComponent, OMX_S
         if (portIndex == INPUT_PORT_INDEX) {
             pSECComponent->checkTimeStamp.needSetStartTimeStamp = OMX_TRUE;
             pSECComponent->checkTimeStamp.needCheckStartTimeStamp = OMX_FALSE;
-            SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-            SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+            SEC_OMX_Timestamp_Reset(&pSECComponent->timestampQueue);
             pSECComponent->getAllDelayBuffer = OMX_FALSE;
             pSECComponent->bSaveFlagEOS = OMX_FALSE;
             pSECComponent->reInputData = OMX_FALSE;
@@ -265,8 +275,7 @@ OMX_ERRORTYPE SEC_OMX_BufferFlushProcessNoEvent(OMX_COMPONENTTYPE *pOMXComponent
         if (portIndex == INPUT_PORT_INDEX) {
             pSECComponent->checkTimeStamp.needSetStartTimeStamp = OMX_TRUE;
             pSECComponent->checkTimeStamp.needCheckStartTimeStamp = OMX_FALSE;
-            SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-            SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+            SEC_OMX_Timestamp_Reset(&pSECComponent->timestampQueue);
             pSECComponent->getAllDelayBuffer = OMX_FALSE;
             pSECComponent->bSaveFlagEOS = OMX_FALSE;
             pSECComponent->remainOutputData = OMX_FALSE;
@@ -484,8 +493,7 @@ OMX_ERRORTYPE SEC_OMX_PortDisableProcess(OMX_COMPONENTTYPE *pOMXComponent, OMX_S
         if (portIndex == INPUT_PORT_INDEX) {
             pSECComponent->checkTimeStamp.needSetStartTimeStamp = OMX_TRUE;
             pSECComponent->checkTimeStamp.needCheckStartTimeStamp = OMX_FALSE;
-            SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-            SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+            SEC_OMX_Timestamp_Reset(&pSECComponent->timestampQueue);
             pSECComponent->getAllDelayBuffer = OMX_FALSE;
             pSECComponent->bSaveFlagEOS = OMX_FALSE;
             pSECComponent->reInputData = OMX_FALSE;
@@ -772,7 +780,7 @@ OMX_ERRORTYPE SEC_OMX_Port_Constructor(OMX_HANDLETYPE hComponent)
     /* Input Port */
     pSECInputPort = &pSECPort[INPUT_PORT_INDEX];
 
-    SEC_OSAL_QueueCreate(&pSECInputPort->bufferQ);
+    SEC_OSAL_QueueCreateDepth(&pSECInputPort->bufferQ, MAX_BUFFER_NUM);
 
     pSECInputPort->bufferHeader = SEC_OSAL_Malloc(sizeof(OMX_BUFFERHEADERTYPE*) * MAX_BUFFER_NUM);
     if (pSECInputPort->bufferHeader == NULL) {
@@ -846,7 +854,7 @@ OMX_ERRORTYPE SEC_OMX_Port_Constructor(OMX_HANDLETYPE hComponent)
     /* Output Port */
     pSECOutputPort = &pSECPort[OUTPUT_PORT_INDEX];
 
-    SEC_OSAL_QueueCreate(&pSECOutputPort->bufferQ);
+    SEC_OSAL_QueueCreateDepth(&pSECOutputPort->bufferQ, MAX_BUFFER_NUM);
 
     pSECOutputPort->bufferHeader = SEC_OSAL_Malloc(sizeof(OMX_BUFFERHEADERTYPE*) * MAX_BUFFER_NUM);
     if (pSECOutputPort->bufferHeader == NULL) {
@@ -0,0 +1,206 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file       SEC_OMX_Timestamp.c
+ * @brief      Timestamp/flag bookkeeping between codec input and output
+ * @version    1.0
+ * @history
+ *    2012.5.2 : Create
+ */
+
+/*
+ * Every input handed to the codec is tagged with a running number; the
+ * tag selects its slot (tag & (depth - 1)) and is kept in the slot, so a
+ * lookup is O(1) and a tag that wrapped or was flushed is detected
+ * instead of silently returning another frame's timestamp.
+ *
+ * Put stores the next input under the next tag without consuming it, so
+ * an input that has to be fed again reuses its slot; Commit advances the
+ * tag once the codec has really taken the input.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SEC_OMX_Timestamp.h"
+
+#undef  SEC_LOG_TAG
+#define SEC_LOG_TAG    "SEC_TIMESTAMP"
+#define SEC_LOG_OFF
+#include "SEC_OSAL_Log.h"
+
+
+static SEC_OMX_TIMESTAMP_SLOT *Timestamp_Slot(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_S32 nTag)
+{
+    SEC_OMX_TIMESTAMP_SLOT *pSlot;
+
+    if ((nTag < 0) || (pQueue->nDepth == 0))
+        return NULL;
+
+    pSlot = &pQueue->slot[nTag & (pQueue->nDepth - 1)];
+    if ((pSlot->bValid != OMX_TRUE) || (pSlot->nTag != nTag))
+        return NULL;
+
+    return pSlot;
+}
+
+/* an uncommitted slot belongs to an input the codec has not taken yet */
+static OMX_BOOL Timestamp_Committed(SEC_OMX_TIMESTAMP_QUEUE *pQueue, SEC_OMX_TIMESTAMP_SLOT *pSlot)
+{
+    return ((pSlot->bValid == OMX_TRUE) && (pSlot->nTag != pQueue->nNextTag)) ? OMX_TRUE : OMX_FALSE;
+}
+
+void SEC_OMX_Timestamp_Init(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_U32 nDepth,
+                            SEC_TIMESTAMP_ORDER eOrder, OMX_BOOL bMonotonic)
+{
+    OMX_U32 depth = 1;
+
+    while ((depth < nDepth) && (depth < SEC_TIMESTAMP_MAX_DEPTH))
+        depth <<= 1;
+
+    memset(pQueue, 0, sizeof(SEC_OMX_TIMESTAMP_QUEUE));
+    pQueue->nDepth = depth;
+    pQueue->eOrder = eOrder;
+    pQueue->bMonotonic = bMonotonic;
+}
+
+void SEC_OMX_Timestamp_Reset(SEC_OMX_TIMESTAMP_QUEUE *pQueue)
+{
+    OMX_U32 i;
+
+    if (pQueue->nOverwritten || pQueue->nUnknownTag || pQueue->nClamped || pQueue->nDiscarded)
+        SEC_OSAL_Log(SEC_LOG_TRACE, "reset: overwritten %u, unknown %u, clamped %u, discarded %u",
+                     pQueue->nOverwritten, pQueue->nUnknownTag, pQueue->nClamped, pQueue->nDiscarded);
+
+    /* nNextTag keeps running so outputs tagged before the reset are rejected */
+    for (i = 0; i < pQueue->nDepth; i++)
+        pQueue->slot[i].bValid = OMX_FALSE;
+
+    pQueue->bLastValid = OMX_FALSE;
+}
+
+OMX_S32 SEC_OMX_Timestamp_Put(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_TICKS timeStamp, OMX_U32 nFlags)
+{
+    SEC_OMX_TIMESTAMP_SLOT *pSlot = &pQueue->slot[pQueue->nNextTag & (pQueue->nDepth - 1)];
+
+    if ((pSlot->bValid == OMX_TRUE) && (pSlot->nTag != pQueue->nNextTag))
+        pQueue->nOverwritten++;
+
+    pSlot->nTag = pQueue->nNextTag;
+    pSlot->bValid = OMX_TRUE;
+    pSlot->bTimeStamp = OMX_TRUE;
+    pSlot->timeStamp = timeStamp;
+    pSlot->nFlags = nFlags;
+
+    return pQueue->nNextTag;
+}
+
+void SEC_OMX_Timestamp_Commit(SEC_OMX_TIMESTAMP_QUEUE *pQueue)
+{
+    pQueue->nNextTag = (pQueue->nNextTag + 1) & SEC_TIMESTAMP_TAG_MASK;
+}
+
+OMX_BOOL SEC_OMX_Timestamp_Peek(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_S32 nTag,
+                                OMX_TICKS *pTimeStamp, OMX_U32 *pFlags)
+{
+    SEC_OMX_TIMESTAMP_SLOT *pSlot = Timestamp_Slot(pQueue, nTag);
+
+    if (pSlot == NULL)
+        return OMX_FALSE;
+
+    *pTimeStamp = pSlot->timeStamp;
+    *pFlags = pSlot->nFlags;
+    return OMX_TRUE;
+}
+
+/*
+ * Takes the output tagged nTag. Flags always follow the tag, so EOS and
+ * sync flags stay with their frame. In SEC_TIMESTAMP_ORDER_SORTED the
+ * timestamp is the smallest one still pending (O(depth)); a sync frame
+ * keeps its own and drops the pending values below it.
+ */
+OMX_BOOL SEC_OMX_Timestamp_Get(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_S32 nTag, OMX_BOOL bSync,
+                               OMX_TICKS *pTimeStamp, OMX_U32 *pFlags)
+{
+    SEC_OMX_TIMESTAMP_SLOT *pSlot = Timestamp_Slot(pQueue, nTag);
+    SEC_OMX_TIMESTAMP_SLOT *pMin = NULL;
+    OMX_TICKS               timeStamp;
+    OMX_U32                 i;
+
+    if (pSlot == NULL) {
+        pQueue->nUnknownTag++;
+        return OMX_FALSE;
+    }
+
+    if ((pQueue->eOrder == SEC_TIMESTAMP_ORDER_SORTED) &&
+        ((bSync != OMX_TRUE) || (pSlot->bTimeStamp != OMX_TRUE))) {
+        for (i = 0; i < pQueue->nDepth; i++) {
+            SEC_OMX_TIMESTAMP_SLOT *pCur = &pQueue->slot[i];
+
+            if ((Timestamp_Committed(pQueue, pCur) == OMX_TRUE) && (pCur->bTimeStamp == OMX_TRUE) &&
+                ((pMin == NULL) || (pCur->timeStamp < pMin->timeStamp)))
+                pMin = pCur;
+        }
+        if ((pMin == NULL) && (pSlot->bTimeStamp == OMX_TRUE))
+            pMin = pSlot;
+        if (pMin == NULL) {
+            pSlot->bValid = OMX_FALSE;
+            pQueue->nUnknownTag++;
+            return OMX_FALSE;
+        }
+
+        timeStamp = pMin->timeStamp;
+        if (pMin != pSlot) {
+            /* the value taken from pMin is replaced by this frame's own */
+            if (pSlot->bTimeStamp == OMX_TRUE)
+                pMin->timeStamp = pSlot->timeStamp;
+            else
+                pMin->bTimeStamp = OMX_FALSE;
+        }
+    } else {
+        timeStamp = pSlot->timeStamp;
+        if ((pQueue->eOrder == SEC_TIMESTAMP_ORDER_SORTED) && (bSync == OMX_TRUE)) {
+            for (i = 0; i < pQueue->nDepth; i++) {
+                SEC_OMX_TIMESTAMP_SLOT *pCur = &pQueue->slot[i];
+
+                if ((pCur != pSlot) && (Timestamp_Committed(pQueue, pCur) == OMX_TRUE) &&
+                    (pCur->bTimeStamp == OMX_TRUE) && (pCur->timeStamp < timeStamp)) {
+                    pCur->bTimeStamp = OMX_FALSE;
+                    pQueue->nDiscarded++;
+                }
+            }
+        }
+    }
+
+    *pFlags = pSlot->nFlags;
+    pSlot->bValid = OMX_FALSE;
+
+    if ((pQueue->bMonotonic == OMX_TRUE) && (pQueue->bLastValid == OMX_TRUE) &&
+        (timeStamp < pQueue->lastTimeStamp) &&
+        (pQueue->lastTimeStamp - timeStamp <= SEC_TIMESTAMP_MAX_BACKSTEP)) {
+        timeStamp = pQueue->lastTimeStamp;
+        pQueue->nClamped++;
+    }
+
+    pQueue->lastTimeStamp = timeStamp;
+    pQueue->bLastValid = OMX_TRUE;
+    *pTimeStamp = timeStamp;
+
+    return OMX_TRUE;
+}
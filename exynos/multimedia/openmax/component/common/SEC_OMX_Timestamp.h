@@ -0,0 +1,96 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file       SEC_OMX_Timestamp.h
+ * @brief      Timestamp/flag bookkeeping between codec input and output
+ * @version    1.0
+ * @history
+ *    2012.5.2 : Create
+ */
+
+#ifndef SEC_OMX_TIMESTAMP_REORDER
+#define SEC_OMX_TIMESTAMP_REORDER
+
+
+#include "OMX_Types.h"
+
+
+#define SEC_TIMESTAMP_MAX_DEPTH        64
+#define SEC_TIMESTAMP_DEFAULT_DEPTH    32
+
+/* MFC frame tags are returned as non-negative OMX_S32 */
+#define SEC_TIMESTAMP_TAG_MASK         0x7FFFFFFF
+
+/* backward steps larger than this (us) are a discontinuity, not jitter */
+#define SEC_TIMESTAMP_MAX_BACKSTEP     1000000
+
+typedef enum _SEC_TIMESTAMP_ORDER
+{
+    /* an output carries the timestamp of the input it was tagged with */
+    SEC_TIMESTAMP_ORDER_TAG,
+    /* an output carries the smallest pending timestamp, resynced on sync frames */
+    SEC_TIMESTAMP_ORDER_SORTED
+} SEC_TIMESTAMP_ORDER;
+
+typedef struct _SEC_OMX_TIMESTAMP_SLOT
+{
+    OMX_S32   nTag;
+    OMX_BOOL  bValid;
+    OMX_BOOL  bTimeStamp;   /* OMX_FALSE once the value was handed to another output */
+    OMX_TICKS timeStamp;
+    OMX_U32   nFlags;
+} SEC_OMX_TIMESTAMP_SLOT;
+
+typedef struct _SEC_OMX_TIMESTAMP_QUEUE
+{
+    SEC_OMX_TIMESTAMP_SLOT slot[SEC_TIMESTAMP_MAX_DEPTH];
+    OMX_U32                nDepth;      /* power of two */
+    SEC_TIMESTAMP_ORDER    eOrder;
+    OMX_BOOL               bMonotonic;
+    OMX_S32                nNextTag;
+
+    OMX_BOOL               bLastValid;
+    OMX_TICKS              lastTimeStamp;
+
+    /* statistics, cleared by SEC_OMX_Timestamp_Init */
+    OMX_U32                nOverwritten; /* slot reused before its output came back */
+    OMX_U32                nUnknownTag;  /* output tag that was never put or already taken */
+    OMX_U32                nClamped;     /* output moved forward to stay monotonic */
+    OMX_U32                nDiscarded;   /* pending value dropped by a sync frame */
+} SEC_OMX_TIMESTAMP_QUEUE;
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void     SEC_OMX_Timestamp_Init(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_U32 nDepth,
+                                SEC_TIMESTAMP_ORDER eOrder, OMX_BOOL bMonotonic);
+void     SEC_OMX_Timestamp_Reset(SEC_OMX_TIMESTAMP_QUEUE *pQueue);
+OMX_S32  SEC_OMX_Timestamp_Put(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_TICKS timeStamp, OMX_U32 nFlags);
+void     SEC_OMX_Timestamp_Commit(SEC_OMX_TIMESTAMP_QUEUE *pQueue);
+OMX_BOOL SEC_OMX_Timestamp_Peek(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_S32 nTag,
+                                OMX_TICKS *pTimeStamp, OMX_U32 *pFlags);
+OMX_BOOL SEC_OMX_Timestamp_Get(SEC_OMX_TIMESTAMP_QUEUE *pQueue, OMX_S32 nTag, OMX_BOOL bSync,
+                               OMX_TICKS *pTimeStamp, OMX_U32 *pFlags);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file       SEC_OMX_Timestamp_Test.c
+ * @brief      Host test of the timestamp queue against synthetic reordering
+ * @version    1.0
+ * @history
+ *    2012.5.2 : Create
+ */
+
+/*
+ * A decoder is modelled as a few frames of pipeline latency followed by a
+ * reorder buffer that releases the smallest presentation time. Streams
+ * are built in decode order (anchor, then the B frames shown before it),
+ * fed through SEC_OMX_Timestamp_Put/Commit, and every output must come
+ * back with its display order timestamp, monotonic.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "SEC_OMX_Timestamp.h"
+#include "SEC_OSAL_Log.h"
+
+#define TEST_FRAMES       20000
+#define TEST_FRAME_STEP   33333
+#define TEST_GOP          30
+
+typedef struct _TEST_FRAME
+{
+    OMX_TICKS pts;
+    OMX_BOOL  bKey;
+    OMX_BOOL  bDrop;      /* decoded but never displayed */
+    OMX_S32   nTag;
+} TEST_FRAME;
+
+typedef struct _TEST_DECODER
+{
+    TEST_FRAME reorder[SEC_TIMESTAMP_MAX_DEPTH];
+    int        nReorder;
+    TEST_FRAME pipe[8];
+    int        nPipe;
+    int        nReorderDepth;
+    int        nLatency;
+} TEST_DECODER;
+
+typedef struct _TEST_RESULT
+{
+    int nWrong;
+    int nNonMonotonic;
+} TEST_RESULT;
+
+static TEST_FRAME stream[TEST_FRAMES];
+static int        failures;
+
+#define CHECK(cond, name)                                       \
+    do {                                                        \
+        if (!(cond)) {                                          \
+            failures++;                                         \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, name); \
+        }                                                       \
+    } while (0)
+
+/* the queue logs through the OSAL; the host build has no liblog */
+void _SEC_OSAL_Log(SEC_LOG_LEVEL logLevel, const char *tag, const char *msg, ...)
+{
+    va_list argptr;
+
+    if (logLevel != SEC_LOG_ERROR)
+        return;
+
+    va_start(argptr, msg);
+    fprintf(stderr, "%s: ", tag);
+    vfprintf(stderr, msg, argptr);
+    fprintf(stderr, "\n");
+    va_end(argptr);
+}
+
+/* returns 1 and the next frame in display order once one is released */
+static int Decoder_Push(TEST_DECODER *pDec, TEST_FRAME frame, TEST_FRAME *pOut)
+{
+    int i, min = 0;
+
+    pDec->pipe[pDec->nPipe++] = frame;
+    if (pDec->nPipe <= pDec->nLatency)
+        return 0;
+
+    frame = pDec->pipe[0];
+    memmove(pDec->pipe, pDec->pipe + 1, --pDec->nPipe * sizeof(TEST_FRAME));
+
+    pDec->reorder[pDec->nReorder++] = frame;
+    if (pDec->nReorder <= pDec->nReorderDepth)
+        return 0;
+
+    for (i = 1; i < pDec->nReorder; i++) {
+        if (pDec->reorder[i].pts < pDec->reorder[min].pts)
+            min = i;
+    }
+    *pOut = pDec->reorder[min];
+    pDec->reorder[min] = pDec->reorder[--pDec->nReorder];
+    return 1;
+}
+
+/* decode order: I, then each anchor followed by the nB frames shown before it */
+static void Build_Stream(int nB)
+{
+    int i = 0, disp = 1, b;
+
+    memset(stream, 0, sizeof(stream));
+    stream[i].pts = 0;
+    stream[i].bKey = OMX_TRUE;
+    i++;
+
+    while (i < TEST_FRAMES) {
+        int anchor = disp + nB;
+
+        stream[i].pts = (OMX_TICKS)anchor * TEST_FRAME_STEP;
+        stream[i].bKey = ((anchor % TEST_GOP) == 0) ? OMX_TRUE : OMX_FALSE;
+        i++;
+        for (b = 0; (b < nB) && (i < TEST_FRAMES); b++, i++)
+            stream[i].pts = (OMX_TICKS)(disp + b) * TEST_FRAME_STEP;
+        disp = anchor + 1;
+    }
+}
+
+/*
+ * bDtsInput feeds decode order timestamps (as some demuxers do), which
+ * only the sorted order can turn back into display order. nDrop is the
+ * index of a frame the decoder swallows, or -1.
+ */
+static void Run_Stream(SEC_OMX_TIMESTAMP_QUEUE *pQueue, int nReorder, int nLatency, int nB,
+                       OMX_U32 nDepth, SEC_TIMESTAMP_ORDER eOrder, OMX_BOOL bDtsInput,
+                       int nDrop, TEST_RESULT *pResult)
+{
+    TEST_DECODER dec;
+    TEST_FRAME   out;
+    OMX_TICKS    last = -1;
+    OMX_TICKS    timeStamp;
+    OMX_U32      nFlags;
+    int          i;
+
+    memset(&dec, 0, sizeof(dec));
+    dec.nReorderDepth = nReorder;
+    dec.nLatency = nLatency;
+    memset(pResult, 0, sizeof(*pResult));
+
+    Build_Stream(nB);
+    SEC_OMX_Timestamp_Init(pQueue, nDepth, eOrder, OMX_TRUE);
+
+    for (i = 0; i < TEST_FRAMES; i++) {
+        OMX_TICKS in = bDtsInput ? (OMX_TICKS)i * TEST_FRAME_STEP : stream[i].pts;
+
+        stream[i].nTag = SEC_OMX_Timestamp_Put(pQueue, in, 0);
+        SEC_OMX_Timestamp_Commit(pQueue);
+        stream[i].bDrop = (i == nDrop) ? OMX_TRUE : OMX_FALSE;
+
+        if (!Decoder_Push(&dec, stream[i], &out) || out.bDrop)
+            continue;
+
+        if (SEC_OMX_Timestamp_Get(pQueue, out.nTag, out.bKey, &timeStamp, &nFlags) != OMX_TRUE) {
+            pResult->nWrong++;
+            continue;
+        }
+        if (timeStamp != out.pts)
+            pResult->nWrong++;
+        if (timeStamp < last)
+            pResult->nNonMonotonic++;
+        last = timeStamp;
+    }
+}
+
+static void Test_Reorder(void)
+{
+    SEC_OMX_TIMESTAMP_QUEUE queue;
+    TEST_RESULT result;
+
+    Run_Stream(&queue, 2, 1, 2, SEC_TIMESTAMP_DEFAULT_DEPTH, SEC_TIMESTAMP_ORDER_TAG,
+               OMX_FALSE, -1, &result);
+    CHECK(result.nWrong == 0 && result.nNonMonotonic == 0, "tag: IBBP");
+
+    Run_Stream(&queue, 16, 2, 7, SEC_TIMESTAMP_DEFAULT_DEPTH, SEC_TIMESTAMP_ORDER_TAG,
+               OMX_FALSE, -1, &result);
+    CHECK(result.nWrong == 0 && result.nNonMonotonic == 0, "tag: B pyramid, reorder 16");
+
+    /* a queue shallower than the decoder must notice, not mix up frames */
+    Run_Stream(&queue, 16, 2, 7, 16, SEC_TIMESTAMP_ORDER_TAG, OMX_FALSE, -1, &result);
+    CHECK(queue.nOverwritten > 0 && queue.nUnknownTag > 0, "tag: overwrite detected");
+
+    Run_Stream(&queue, 2, 1, 2, SEC_TIMESTAMP_DEFAULT_DEPTH, SEC_TIMESTAMP_ORDER_SORTED,
+               OMX_TRUE, -1, &result);
+    CHECK(result.nWrong == 0 && result.nNonMonotonic == 0, "sorted: dts input");
+
+    Run_Stream(&queue, 16, 2, 7, SEC_TIMESTAMP_DEFAULT_DEPTH, SEC_TIMESTAMP_ORDER_SORTED,
+               OMX_TRUE, -1, &result);
+    CHECK(result.nWrong == 0 && result.nNonMonotonic == 0, "sorted: dts input, reorder 16");
+
+    /* an undisplayed frame shifts the sorted values until the next sync frame */
+    Run_Stream(&queue, 2, 1, 2, SEC_TIMESTAMP_DEFAULT_DEPTH, SEC_TIMESTAMP_ORDER_SORTED,
+               OMX_FALSE, 1000, &result);
+    CHECK(result.nNonMonotonic == 0 && result.nWrong < TEST_GOP + 10, "sorted: resync after drop");
+}
+
+static void Test_Queue(void)
+{
+    SEC_OMX_TIMESTAMP_QUEUE queue;
+    OMX_TICKS timeStamp;
+    OMX_U32   nFlags;
+    OMX_S32   nTag, nTag2;
+
+    SEC_OMX_Timestamp_Init(&queue, SEC_TIMESTAMP_DEFAULT_DEPTH, SEC_TIMESTAMP_ORDER_TAG, OMX_TRUE);
+
+    /* outputs tagged before a flush are rejected */
+    nTag = SEC_OMX_Timestamp_Put(&queue, 100, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    SEC_OMX_Timestamp_Reset(&queue);
+    CHECK(SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags) == OMX_FALSE,
+          "stale tag after reset");
+
+    nTag = SEC_OMX_Timestamp_Put(&queue, 200, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    CHECK(SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags) == OMX_TRUE &&
+          timeStamp == 200, "tag after reset");
+    CHECK(SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags) == OMX_FALSE,
+          "tag taken twice");
+    CHECK(SEC_OMX_Timestamp_Get(&queue, -1, OMX_FALSE, &timeStamp, &nFlags) == OMX_FALSE,
+          "negative tag");
+
+    /* peek does not consume, flags follow the tag */
+    nTag = SEC_OMX_Timestamp_Put(&queue, 300, 0x1);
+    SEC_OMX_Timestamp_Commit(&queue);
+    CHECK(SEC_OMX_Timestamp_Peek(&queue, nTag, &timeStamp, &nFlags) == OMX_TRUE &&
+          timeStamp == 300 && nFlags == 0x1, "peek");
+    CHECK(SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags) == OMX_TRUE &&
+          nFlags == 0x1, "get after peek");
+
+    /* an input fed again before Commit keeps its slot */
+    nTag = SEC_OMX_Timestamp_Put(&queue, 400, 0);
+    nTag2 = SEC_OMX_Timestamp_Put(&queue, 410, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    CHECK(nTag == nTag2 &&
+          SEC_OMX_Timestamp_Get(&queue, nTag2, OMX_FALSE, &timeStamp, &nFlags) == OMX_TRUE &&
+          timeStamp == 410, "put again before commit");
+
+    /* small backsteps are clamped, large ones are a discontinuity */
+    nTag = SEC_OMX_Timestamp_Put(&queue, 405, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    CHECK(SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags) == OMX_TRUE &&
+          timeStamp == 410 && queue.nClamped == 1, "clamp");
+    nTag = SEC_OMX_Timestamp_Put(&queue, 410 + 5 * SEC_TIMESTAMP_MAX_BACKSTEP, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags);
+    nTag = SEC_OMX_Timestamp_Put(&queue, 1000, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    CHECK(SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags) == OMX_TRUE &&
+          timeStamp == 1000, "discontinuity");
+
+    /* tags wrap at the mask and stay non-negative */
+    queue.nNextTag = SEC_TIMESTAMP_TAG_MASK;
+    nTag = SEC_OMX_Timestamp_Put(&queue, 2000, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    nTag2 = SEC_OMX_Timestamp_Put(&queue, 2001, 0);
+    SEC_OMX_Timestamp_Commit(&queue);
+    CHECK(nTag2 == 0 &&
+          SEC_OMX_Timestamp_Get(&queue, nTag, OMX_FALSE, &timeStamp, &nFlags) == OMX_TRUE &&
+          timeStamp == 2000, "tag wrap");
+}
+
+int main(void)
+{
+    Test_Reorder();
+    Test_Queue();
+
+    printf("%s (%d failures)\n", failures ? "FAILED" : "PASS", failures);
+    return failures ? 1 : 0;
+}
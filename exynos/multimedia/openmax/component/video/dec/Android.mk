@@ -2,7 +2,8 @@ LOCAL_PATH := $(call my-dir)
 include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES := \
-	SEC_OMX_Vdec.c
+	SEC_OMX_Vdec.c \
+	SEC_OMX_VdecStartCode.c
 
 LOCAL_MODULE := libSEC_OMX_Vdec
 LOCAL_ARM_MODE := arm
@@ -23,3 +24,21 @@ endif
 LOCAL_CFLAGS += -Wno-error
 
 include $(BUILD_STATIC_LIBRARY)
+
+# SEC_OMX_VdecStartCode against the byte loops it replaced, on the host
+include $(CLEAR_VARS)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	SEC_OMX_VdecStartCode.c \
+	SEC_OMX_VdecStartCode_Bench.c
+
+LOCAL_MODULE := SEC_OMX_VdecStartCode_Bench
+
+LOCAL_CFLAGS := -O2
+
+LOCAL_C_INCLUDES := $(SEC_OMX_INC)/khronos \
+	$(SEC_OMX_COMPONENT)/video/dec
+
+include $(BUILD_HOST_EXECUTABLE)
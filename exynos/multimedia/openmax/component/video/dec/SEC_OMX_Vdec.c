@@ -707,6 +707,17 @@ OMX_BOOL SEC_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent)
         if (pSECComponent->bUseFlagEOF == OMX_TRUE) {
             flagEOF = OMX_TRUE;
             checkedSize = checkInputStreamLen;
+        } else if ((inputUseBuffer->nFlags & OMX_BUFFERFLAG_ENDOFFRAME) &&
+                   !(inputUseBuffer->nFlags & OMX_BUFFERFLAG_CODECCONFIG) &&
+                   (inputUseBuffer->usedDataLen == 0) &&
+                   (previousFrameEOF == OMX_TRUE)) {
+            /*
+             * The client already delivers one frame per buffer, so the frame
+             * goes to the stream buffer in a single copy without a scan.
+             * Codec config still goes through the checker, which parses it.
+             */
+            flagEOF = OMX_TRUE;
+            checkedSize = checkInputStreamLen;
         } else {
             pSECComponent->bUseFlagEOF = OMX_FALSE;
             checkedSize = pSECComponent->sec_checkInputFrame(checkInputStream, checkInputStreamLen, inputUseBuffer->nFlags, previousFrameEOF, &flagEOF);
@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        SEC_OMX_VdecStartCode.c
+ * @brief       Start code scanner shared by the frame checkers
+ *   Every start code begins with two zero bytes, so the stream is read a
+ *   machine word at a time and only words holding two adjacent zero bytes
+ *   are looked at byte by byte.
+ * @version     1.1.0
+ */
+
+#include <string.h>
+#include "SEC_OMX_VdecStartCode.h"
+
+typedef unsigned long SCAN_WORD;
+
+#define SCAN_WORD_SIZE  (sizeof(SCAN_WORD))
+#define SCAN_HIGHS      ((SCAN_WORD)-1 / 0xFF * 0x80)
+
+/* high bit set in exactly the bytes of w that are zero */
+#define SCAN_ZEROS(w) (~((((w) & ~SCAN_HIGHS) + ~SCAN_HIGHS) | (w) | ~SCAN_HIGHS))
+
+OMX_U32 SEC_OMX_FindZeroPair(OMX_U8 *pStream, OMX_U32 streamSize)
+{
+    OMX_U32 i = 0;
+
+    if (streamSize < 2)
+        return streamSize;
+
+    /* bytewise up to word alignment */
+    while ((i < streamSize - 1) && (((unsigned long)(pStream + i)) & (SCAN_WORD_SIZE - 1))) {
+        if ((pStream[i] == 0) && (pStream[i + 1] == 0))
+            return i;
+        i++;
+    }
+
+    /*
+     * Two adjacent zero bytes are adjacent in significance too, whatever
+     * the byte order, so zeros & (zeros << 8) spots a pair inside the word.
+     * Only the pair straddling into the next word needs a byte compare,
+     * and lone zeros in payload don't send the word to the byte loop.
+     */
+    while (i + SCAN_WORD_SIZE < streamSize) {
+        SCAN_WORD w, zeros;
+
+        memcpy(&w, pStream + i, SCAN_WORD_SIZE);
+        zeros = SCAN_ZEROS(w);
+
+        /* one branch for both tests, lone zeros are too common to predict */
+        if ((zeros & (zeros << 8)) |
+            ((pStream[i + SCAN_WORD_SIZE - 1] | pStream[i + SCAN_WORD_SIZE]) == 0)) {
+            OMX_U32 j;
+            for (j = i; j < i + SCAN_WORD_SIZE; j++) {
+                if ((pStream[j] == 0) && (pStream[j + 1] == 0))
+                    return j;
+            }
+        }
+        i += SCAN_WORD_SIZE;
+    }
+
+    while (i < streamSize - 1) {
+        if ((pStream[i] == 0) && (pStream[i + 1] == 0))
+            return i;
+        i++;
+    }
+
+    return streamSize;
+}
+
+OMX_U32 SEC_OMX_FindStartCode(OMX_U8 *pStream, OMX_U32 streamSize)
+{
+    OMX_U32 pos = 0;
+
+    while (pos + 3 <= streamSize) {
+        pos += SEC_OMX_FindZeroPair(pStream + pos, streamSize - pos);
+        if (pos + 3 > streamSize)
+            break;
+
+        if (pStream[pos + 2] == 0x01)
+            return pos;
+
+        /* 00 00 00 may still end in a start code one byte later */
+        pos++;
+    }
+
+    return streamSize;
+}
+
+OMX_U32 SEC_OMX_FindStartCodeId(OMX_U8 *pStream, OMX_U32 streamSize, OMX_U8 id)
+{
+    OMX_U32 pos = 0;
+
+    while (pos + 4 <= streamSize) {
+        pos += SEC_OMX_FindStartCode(pStream + pos, streamSize - pos);
+        if (pos + 4 > streamSize)
+            break;
+
+        if (pStream[pos + 3] == id)
+            return pos;
+
+        pos += 3;
+    }
+
+    return streamSize;
+}
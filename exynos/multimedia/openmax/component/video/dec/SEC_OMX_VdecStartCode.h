@@ -0,0 +1,51 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file        SEC_OMX_VdecStartCode.h
+ * @brief       Start code scanner shared by the frame checkers
+ * @version     1.1.0
+ */
+
+#ifndef SEC_OMX_VIDEO_DECODE_STARTCODE
+#define SEC_OMX_VIDEO_DECODE_STARTCODE
+
+#include "OMX_Types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * All functions return the offset of the first byte of the first match,
+ * or streamSize if the whole pattern does not occur in the stream.
+ */
+
+/* 00 00 */
+OMX_U32 SEC_OMX_FindZeroPair(OMX_U8 *pStream, OMX_U32 streamSize);
+
+/* 00 00 01 */
+OMX_U32 SEC_OMX_FindStartCode(OMX_U8 *pStream, OMX_U32 streamSize);
+
+/* 00 00 01 id */
+OMX_U32 SEC_OMX_FindStartCodeId(OMX_U8 *pStream, OMX_U32 streamSize, OMX_U8 id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,295 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file       SEC_OMX_VdecStartCode_Bench.c
+ * @brief      Host benchmark of SEC_OMX_VdecStartCode.c against the shift
+ *             register loops the frame checkers used before, in GB/s of
+ *             bitstream scanned. Every start code of the corpus is found
+ *             the way the checkers walk a buffer. Also checks that both
+ *             return the same offsets on random zero heavy streams.
+ *             The corpus is the given files, or two 16 MiB sets of
+ *             generated NAL units with emulation prevention: entropy coded
+ *             payload, and payload where one byte in 16 is zero.
+ *             Usage: SEC_OMX_VdecStartCode_Bench [iterations] [stream files]
+ * @version    1.1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "SEC_OMX_VdecStartCode.h"
+
+#define BENCH_CORPUS_SIZE   (16 * 1024 * 1024)
+#define BENCH_CHECK_RUNS    200000
+#define BENCH_CHECK_SIZE    64
+
+/*
+ * The frame checkers before SEC_OMX_VdecStartCode.c, one byte at a time.
+ * The shift register is 32 bit as on the device, OMX_U32 is long.
+ */
+static OMX_U32 ref_FindZeroPair(OMX_U8 *pStream, OMX_U32 streamSize)
+{
+    unsigned int code = 0xFFFFFFFF;
+    OMX_U32 i;
+
+    for (i = 0; i < streamSize; i++) {
+        code = (code << 8) | pStream[i];
+        if ((code & 0xFFFF) == 0)
+            return i - 1;
+    }
+    return streamSize;
+}
+
+static OMX_U32 ref_FindStartCode(OMX_U8 *pStream, OMX_U32 streamSize)
+{
+    unsigned int code = 0xFFFFFFFF;
+    OMX_U32 i;
+
+    for (i = 0; i < streamSize; i++) {
+        code = (code << 8) | pStream[i];
+        if ((code & 0xFFFFFF) == 0x000001)
+            return i - 2;
+    }
+    return streamSize;
+}
+
+static OMX_U32 ref_FindStartCodeId(OMX_U8 *pStream, OMX_U32 streamSize, OMX_U8 id)
+{
+    unsigned int code = 0xFFFFFFFF;
+    OMX_U32 i;
+
+    for (i = 0; i < streamSize; i++) {
+        code = (code << 8) | pStream[i];
+        if (code == (0x100U | id))
+            return i - 3;
+    }
+    return streamSize;
+}
+
+typedef struct {
+    const char *name;
+    OMX_U32   (*find)(OMX_U8 *pStream, OMX_U32 streamSize, OMX_U8 id);
+    OMX_U32     skip;   /* bytes of a match to step over */
+    OMX_U8      id;
+} SCANNER;
+
+static OMX_U32 new_pair(OMX_U8 *p, OMX_U32 n, OMX_U8 id) { return SEC_OMX_FindZeroPair(p, n); }
+static OMX_U32 new_code(OMX_U8 *p, OMX_U32 n, OMX_U8 id) { return SEC_OMX_FindStartCode(p, n); }
+static OMX_U32 new_id(OMX_U8 *p, OMX_U32 n, OMX_U8 id) { return SEC_OMX_FindStartCodeId(p, n, id); }
+static OMX_U32 ref_pair(OMX_U8 *p, OMX_U32 n, OMX_U8 id) { return ref_FindZeroPair(p, n); }
+static OMX_U32 ref_code(OMX_U8 *p, OMX_U32 n, OMX_U8 id) { return ref_FindStartCode(p, n); }
+static OMX_U32 ref_id(OMX_U8 *p, OMX_U32 n, OMX_U8 id) { return ref_FindStartCodeId(p, n, id); }
+
+/* pairs of old and new, as used by Check_H263_Frame, _H264_Frame, _Mpeg4_Frame, _Wmv_Frame */
+static const SCANNER scanners[][2] = {
+    { { "00 00, old", ref_pair, 2, 0 },            { "00 00, new", new_pair, 2, 0 } },
+    { { "00 00 01, old", ref_code, 3, 0 },         { "00 00 01, new", new_code, 3, 0 } },
+    { { "00 00 01 b6, old", ref_id, 4, 0xB6 },     { "00 00 01 b6, new", new_id, 4, 0xB6 } },
+    { { "00 00 01 0d, old", ref_id, 4, 0x0D },     { "00 00 01 0d, new", new_id, 4, 0x0D } },
+};
+
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/*
+ * NAL units of 500 to 50000 bytes with emulation prevention, so only start
+ * codes hold 00 00 0x. One payload byte in zero_rate is forced to zero.
+ */
+static OMX_U32 make_corpus(OMX_U8 *buf, OMX_U32 size, unsigned int zero_rate)
+{
+    static const OMX_U8 types[] = { 0x09, 0x67, 0x68, 0x65, 0x41, 0x41, 0x41, 0xB6, 0x0D };
+    unsigned int seed = 1;
+    OMX_U32 pos = 0;
+
+    while (pos + 5 < size) {
+        OMX_U32 len = 500 + rand_r(&seed) % 49500;
+        int zeros = 0;
+
+        buf[pos++] = 0x00;
+        buf[pos++] = 0x00;
+        buf[pos++] = 0x00;
+        buf[pos++] = 0x01;
+        buf[pos++] = types[rand_r(&seed) % sizeof(types)];
+
+        while (len-- && pos < size) {
+            OMX_U8 b = (OMX_U8)rand_r(&seed);
+
+            if (zero_rate && (rand_r(&seed) % zero_rate) == 0)
+                b = 0x00;
+
+            if (zeros >= 2 && b <= 0x03) {
+                buf[pos++] = 0x03;
+                zeros = 0;
+                if (pos == size)
+                    break;
+            }
+            buf[pos++] = b;
+            zeros = b ? 0 : zeros + 1;
+        }
+    }
+
+    return pos;
+}
+
+static OMX_U32 load_corpus(OMX_U8 *buf, int argc, char **argv)
+{
+    OMX_U32 pos = 0;
+    int i;
+
+    for (i = 0; i < argc && pos < BENCH_CORPUS_SIZE; i++) {
+        FILE *f = fopen(argv[i], "rb");
+
+        if (f == NULL) {
+            perror(argv[i]);
+            exit(2);
+        }
+        pos += fread(buf + pos, 1, BENCH_CORPUS_SIZE - pos, f);
+        fclose(f);
+    }
+
+    return pos;
+}
+
+static OMX_U32 count_matches(const SCANNER *s, OMX_U8 *buf, OMX_U32 size)
+{
+    OMX_U32 pos = 0, count = 0;
+
+    for (;;) {
+        OMX_U32 off = s->find(buf + pos, size - pos, s->id);
+
+        if (off == size - pos)
+            break;
+        count++;
+        pos += off + s->skip;
+    }
+
+    return count;
+}
+
+/* both scanners must agree at every alignment on streams full of 00 and 01 */
+static int check(void)
+{
+    static const OMX_U8 alphabet[] = { 0x00, 0x00, 0x00, 0x01, 0x03, 0x0D, 0xB6, 0xFF };
+    OMX_U8 buf[BENCH_CHECK_SIZE + 16];
+    unsigned int seed = 7;
+    int run, failed = 0;
+    size_t s;
+
+    for (run = 0; run < BENCH_CHECK_RUNS; run++) {
+        OMX_U32 offset = rand_r(&seed) % 8;
+        OMX_U32 size = rand_r(&seed) % (BENCH_CHECK_SIZE + 1);
+        OMX_U32 i;
+
+        for (i = 0; i < sizeof(buf); i++)
+            buf[i] = alphabet[rand_r(&seed) % sizeof(alphabet)];
+
+        for (s = 0; s < sizeof(scanners) / sizeof(scanners[0]); s++) {
+            const SCANNER *ref = &scanners[s][0];
+            const SCANNER *opt = &scanners[s][1];
+            OMX_U32 a = ref->find(buf + offset, size, ref->id);
+            OMX_U32 b = opt->find(buf + offset, size, opt->id);
+
+            if (a != b) {
+                if (!failed)
+                    printf("%s: %lu, %s: %lu (size %lu, offset %lu)\n",
+                           ref->name, (unsigned long)a, opt->name, (unsigned long)b,
+                           (unsigned long)size, (unsigned long)offset);
+                failed = 1;
+            }
+        }
+    }
+
+    return failed;
+}
+
+static int run(OMX_U8 *buf, OMX_U32 size, int iterations)
+{
+    OMX_U32 expected = 0;
+    int failed = 0;
+    size_t s, k;
+    int i;
+
+    for (s = 0; s < sizeof(scanners) / sizeof(scanners[0]); s++) {
+        for (k = 0; k < 2; k++) {
+            const SCANNER *sc = &scanners[s][k];
+            OMX_U32 count = 0;
+            double t0, ms;
+
+            t0 = now_ms();
+            for (i = 0; i < iterations; i++)
+                count = count_matches(sc, buf, size);
+            ms = (now_ms() - t0) / iterations;
+
+            printf("  %-20s %8lu found %8.3f ms %6.2f GB/s\n",
+                   sc->name, (unsigned long)count, ms, size / ms / 1e6);
+
+            if (k == 0) {
+                expected = count;
+            } else if (count != expected) {
+                printf("  %s found %lu, %s %lu\n", scanners[s][0].name,
+                       (unsigned long)expected, sc->name, (unsigned long)count);
+                failed = 1;
+            }
+        }
+    }
+
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 10;
+    OMX_U8 *buf;
+    OMX_U32 size;
+    int failed;
+
+    if (iterations < 1)
+        iterations = 1;
+
+    failed = check();
+    printf("random streams: %s\n", failed ? "old and new differ" : "old and new agree");
+
+    buf = (OMX_U8 *)malloc(BENCH_CORPUS_SIZE);
+    if (buf == NULL)
+        return 2;
+
+    if (argc > 2) {
+        size = load_corpus(buf, argc - 2, argv + 2);
+        printf("%lu bytes of streams\n", (unsigned long)size);
+        failed |= run(buf, size, iterations);
+    } else {
+        size = make_corpus(buf, BENCH_CORPUS_SIZE, 0);
+        printf("entropy coded payload, %lu bytes\n", (unsigned long)size);
+        failed |= run(buf, size, iterations);
+
+        size = make_corpus(buf, BENCH_CORPUS_SIZE, 16);
+        printf("payload with 1/16 zero bytes, %lu bytes\n", (unsigned long)size);
+        failed |= run(buf, size, iterations);
+    }
+
+    free(buf);
+
+    return failed;
+}
@@ -32,6 +32,7 @@
 #include "SEC_OMX_Basecomponent.h"
 #include "SEC_OMX_Baseport.h"
 #include "SEC_OMX_Vdec.h"
+#include "SEC_OMX_VdecStartCode.h"
 #include "SEC_OSAL_ETC.h"
 #include "SEC_OSAL_Semaphore.h"
 #include "SEC_OSAL_Thread.h"
@@ -109,11 +110,10 @@ SEC_OMX_VIDEO_PROFILELEVEL supportedAVCProfileLevels[] ={
 
 static int Check_H264_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag, OMX_BOOL bPreviousFrameEOF, OMX_BOOL *pbEndOfFrame)
 {
-    OMX_U32  preFourByte       = (OMX_U32)-1;
-    int      accessUnitSize    = 0;
-    int      frameTypeBoundary = 0;
-    int      nextNaluSize      = 0;
-    int      naluStart         = 0;
+    OMX_U32  startCodePos = 0;
+    OMX_U32  naluPos      = 0;
+    OMX_U32  searchPos    = 0;
+    int      naluStart    = 0;
 
     if (bPreviousFrameEOF == OMX_TRUE)
         naluStart = 0;
@@ -121,64 +121,54 @@ static int Check_H264_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag
         naluStart = 1;
 
     while (1) {
-        int inputOneByte = 0;
+        int naluType = 0;
 
-        if (accessUnitSize == (int)buffSize)
+        startCodePos = searchPos + SEC_OMX_FindStartCode(pInputStream + searchPos, buffSize - searchPos);
+        naluPos = startCodePos + 3;
+        if (naluPos >= buffSize)
             goto EXIT;
 
-        inputOneByte = *(pInputStream++);
-        accessUnitSize += 1;
+        naluType = pInputStream[naluPos] & 0x1F;
 
-        if (preFourByte == 0x00000001 || (preFourByte << 8) == 0x00000100) {
-            int naluType = inputOneByte & 0x1F;
-
-            SEC_OSAL_Log(SEC_LOG_TRACE, "NaluType : %d", naluType);
-            if (naluStart == 0) {
+        SEC_OSAL_Log(SEC_LOG_TRACE, "NaluType : %d", naluType);
+        if (naluStart == 0) {
 #ifdef ADD_SPS_PPS_I_FRAME
-                if (naluType == 1 || naluType == 5)
+            if (naluType == 1 || naluType == 5)
 #else
-                if (naluType == 1 || naluType == 5 || naluType == 7 || naluType == 8)
+            if (naluType == 1 || naluType == 5 || naluType == 7 || naluType == 8)
 #endif
-                    naluStart = 1;
-            } else {
-#ifdef OLD_DETECT
-                frameTypeBoundary = (8 - naluType) & (naluType - 10); //AUD(9)
-#else
-                if (naluType == 9)
-                    frameTypeBoundary = -2;
-#endif
-                if (naluType == 1 || naluType == 5) {
-                    if (accessUnitSize == (int)buffSize) {
-                        accessUnitSize--;
-                        goto EXIT;
-                    }
-                    inputOneByte = *pInputStream++;
-                    accessUnitSize += 1;
+                naluStart = 1;
+        } else {
+            if (naluType == 9) /* AUD */
+                break;
 
-                    if (inputOneByte >= 0x80)
-                        frameTypeBoundary = -1;
+            if (naluType == 1 || naluType == 5) {
+                if (naluPos + 1 == buffSize) {
+                    *pbEndOfFrame = OMX_FALSE;
+                    return buffSize - 1;
                 }
-                if (frameTypeBoundary < 0) {
+
+                /* first_mb_in_slice == 0 */
+                if (pInputStream[naluPos + 1] >= 0x80)
                     break;
-                }
             }
-
         }
-        preFourByte = (preFourByte << 8) + inputOneByte;
+
+        searchPos = naluPos;
     }
 
     *pbEndOfFrame = OMX_TRUE;
-    nextNaluSize = -5;
-    if (frameTypeBoundary == -1)
-        nextNaluSize = -6;
-    if (preFourByte != 0x00000001)
-        nextNaluSize++;
-    return (accessUnitSize + nextNaluSize);
+
+    /* include the leading zero of a four byte start code in the next frame */
+    if ((startCodePos > 0) && (pInputStream[startCodePos - 1] == 0x00))
+        startCodePos--;
+
+    return startCodePos;
 
 EXIT:
     *pbEndOfFrame = OMX_FALSE;
 
-    return accessUnitSize;
+    return buffSize;
 }
 
 OMX_BOOL Check_H264_StartCode(OMX_U8 *pInputStream, OMX_U32 streamSize)
@@ -876,10 +866,14 @@ OMX_ERRORTYPE SEC_MFC_H264Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     pSECComponent->processData[INPUT_PORT_INDEX].dataBuffer = pVideoDec->MFCDecInputBuffer[0].VirAddr;
     pSECComponent->processData[INPUT_PORT_INDEX].allocSize = pVideoDec->MFCDecInputBuffer[0].bufferSize;
 
-    SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-    SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+#ifdef NEED_TIMESTAMP_REORDER
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_SORTED, OMX_TRUE);
+#else
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_TAG, OMX_TRUE);
+#endif
     pH264Dec->hMFCH264Handle.indexTimestamp = 0;
-    pH264Dec->hMFCH264Handle.outputIndexTimestamp = 0;
 
     pSECComponent->getAllDelayBuffer = OMX_FALSE;
 
@@ -1095,13 +1089,13 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
         pSECComponent->bUseFlagEOF = OMX_TRUE;
 #endif
 
-    pSECComponent->timeStamp[pH264Dec->hMFCH264Handle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pH264Dec->hMFCH264Handle.indexTimestamp] = pInputData->nFlags;
+    pH264Dec->hMFCH264Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
 
     if ((pH264Dec->hMFCH264Handle.returnCodec == MFC_RET_OK) &&
         (pVideoDec->bFirstFrame == OMX_FALSE)) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         /* wait for mfc decode done */
         if (pVideoDec->NBDecThread.bDecoderRun == OMX_TRUE) {
@@ -1225,35 +1219,31 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
         }
 #endif
 
-        if ((SsbSipMfcDecGetConfig(pH264Dec->hMFCH264Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+        if (SsbSipMfcDecGetConfig(pH264Dec->hMFCH264Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+            indexTimestamp = -1;
+
+        /* For timestamp correction. if mfc support frametype detect */
+        SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+        if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+            (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+            bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                               ((outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ||
+                                                (pH264Dec->hMFCH264Handle.bFlashPlayerMode == OMX_TRUE)) ? OMX_TRUE : OMX_FALSE,
+                                               &pOutputData->timeStamp, &pOutputData->nFlags);
+        } else {
+            bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                &pOutputData->timeStamp, &pOutputData->nFlags);
+        }
+
+        if (bTimestamp != OMX_TRUE) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            /* For timestamp correction. if mfc support frametype detect */
-            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-            if ((outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ||
-                (pH264Dec->hMFCH264Handle.bFlashPlayerMode == OMX_TRUE)) {
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                pH264Dec->hMFCH264Handle.outputIndexTimestamp = indexTimestamp;
-            } else {
-                pOutputData->timeStamp = pSECComponent->timeStamp[pH264Dec->hMFCH264Handle.outputIndexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[pH264Dec->hMFCH264Handle.outputIndexTimestamp];
-            }
-#else
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
-            SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
         }
+        SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
 
         if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
             (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
             outputDataValid = OMX_TRUE;
-            pH264Dec->hMFCH264Handle.outputIndexTimestamp++;
-            pH264Dec->hMFCH264Handle.outputIndexTimestamp %= MAX_TIMESTAMP;
         }
         if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
             outputDataValid = OMX_FALSE;
@@ -1330,8 +1320,7 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
         ((pOutputData->nFlags & OMX_BUFFERFLAG_EOS) != OMX_BUFFERFLAG_EOS)) {
         if ((ret != OMX_ErrorInputDataDecodeYet) || (pSECComponent->getAllDelayBuffer == OMX_TRUE)) {
             SsbSipMfcDecSetConfig(pH264Dec->hMFCH264Handle.hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pH264Dec->hMFCH264Handle.indexTimestamp));
-            pH264Dec->hMFCH264Handle.indexTimestamp++;
-            pH264Dec->hMFCH264Handle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
         }
 
         SsbSipMfcDecSetInBuf(pH264Dec->hMFCH264Handle.hMFCHandle,
@@ -1423,22 +1412,23 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
             case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
 #ifdef USE_CSC_FIMC
                 if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pH264Dec->hFIMCHandle != NULL)) {
-                    void *pPhys[3];
-                    SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                    pYUVBuf[0] = outputInfo.YPhyAddr;
-                    pYUVBuf[1] = outputInfo.CPhyAddr;
-                    csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
-                                        pYUVBuf, actualWidth, actualHeight,
-                                        OMX_COLOR_FormatYUV420SemiPlanar);
-                    break;
+                    void *pPhys[3] = {NULL, NULL, NULL};
+                    if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                        pYUVBuf[0] = outputInfo.YPhyAddr;
+                        pYUVBuf[1] = outputInfo.CPhyAddr;
+                        csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
+                                            pYUVBuf, actualWidth, actualHeight,
+                                            OMX_COLOR_FormatYUV420SemiPlanar);
+                        break;
+                    }
                 }
 #endif
-                csc_tiled_to_linear_y_neon(
+                csc_tiled_to_linear_y_mt(
                     (unsigned char *)pYUVBuf[0],
                     (unsigned char *)outputInfo.YVirAddr,
                     actualWidth,
                     actualHeight);
-                csc_tiled_to_linear_uv_neon(
+                csc_tiled_to_linear_uv_mt(
                     (unsigned char *)pYUVBuf[1],
                     (unsigned char *)outputInfo.CVirAddr,
                     actualWidth,
@@ -1455,22 +1445,23 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
             default:
 #ifdef USE_CSC_FIMC
                 if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pH264Dec->hFIMCHandle != NULL)) {
-                    void *pPhys[3];
-                    SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                    pYUVBuf[0] = outputInfo.YPhyAddr;
-                    pYUVBuf[1] = outputInfo.CPhyAddr;
-                    csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
-                                        pYUVBuf, actualWidth, actualHeight,
-                                        OMX_COLOR_FormatYUV420Planar);
-                    break;
+                    void *pPhys[3] = {NULL, NULL, NULL};
+                    if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                        pYUVBuf[0] = outputInfo.YPhyAddr;
+                        pYUVBuf[1] = outputInfo.CPhyAddr;
+                        csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
+                                            pYUVBuf, actualWidth, actualHeight,
+                                            OMX_COLOR_FormatYUV420Planar);
+                        break;
+                    }
                 }
 #endif
-                csc_tiled_to_linear_y_neon(
+                csc_tiled_to_linear_y_mt(
                     (unsigned char *)pYUVBuf[0],
                     (unsigned char *)outputInfo.YVirAddr,
                     actualWidth,
                     actualHeight);
-                csc_tiled_to_linear_uv_deinterleave_neon(
+                csc_tiled_to_linear_uv_deinterleave_mt(
                     (unsigned char *)pYUVBuf[1],
                     (unsigned char *)pYUVBuf[2],
                     (unsigned char *)outputInfo.CVirAddr,
@@ -1622,8 +1613,7 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
 #endif
 
     if (Check_H264_StartCode(pInputData->dataBuffer, pInputData->dataLen) == OMX_TRUE) {
-        pSECComponent->timeStamp[pH264Dec->hMFCH264Handle.indexTimestamp] = pInputData->timeStamp;
-        pSECComponent->nFlags[pH264Dec->hMFCH264Handle.indexTimestamp] = pInputData->nFlags;
+        pH264Dec->hMFCH264Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
         SsbSipMfcDecSetConfig(pH264Dec->hMFCH264Handle.hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pH264Dec->hMFCH264Handle.indexTimestamp));
 
         returnCodec = SsbSipMfcDecExe(pH264Dec->hMFCH264Handle.hMFCHandle, oneFrameSize);
@@ -1640,6 +1630,7 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
     if (returnCodec == MFC_RET_OK) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         status = SsbSipMfcDecGetOutBuf(pH264Dec->hMFCH264Handle.hMFCHandle, &outputInfo);
         bufWidth =    (outputInfo.img_width + 15) & (~15);
@@ -1648,33 +1639,30 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
         FrameBufferUVSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height/2));
 
         if (status != MFC_GETOUTBUF_DISPLAY_ONLY) {
-            pH264Dec->hMFCH264Handle.indexTimestamp++;
-            pH264Dec->hMFCH264Handle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
+        }
+
+        if (SsbSipMfcDecGetConfig(pH264Dec->hMFCH264Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+            indexTimestamp = -1;
+
+        /* For timestamp correction. if mfc support frametype detect */
+        SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+        if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+            (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+            bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                               ((outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ||
+                                                (pH264Dec->hMFCH264Handle.bFlashPlayerMode != OMX_FALSE)) ? OMX_TRUE : OMX_FALSE,
+                                               &pOutputData->timeStamp, &pOutputData->nFlags);
+        } else {
+            bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                &pOutputData->timeStamp, &pOutputData->nFlags);
         }
 
-        if ((SsbSipMfcDecGetConfig(pH264Dec->hMFCH264Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+        if (bTimestamp != OMX_TRUE) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            /* For timestamp correction. if mfc support frametype detect */
-            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-            if ((outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ||
-                (pH264Dec->hMFCH264Handle.bFlashPlayerMode != OMX_FALSE)) {
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                pH264Dec->hMFCH264Handle.outputIndexTimestamp = indexTimestamp;
-            } else {
-                pOutputData->timeStamp = pSECComponent->timeStamp[pH264Dec->hMFCH264Handle.outputIndexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[pH264Dec->hMFCH264Handle.outputIndexTimestamp];
-            }
-#else
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
-            SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
         }
+        SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
 
         if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
             (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
@@ -1720,22 +1708,23 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
                 case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
 #ifdef USE_CSC_FIMC
                     if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pH264Dec->hFIMCHandle != NULL)) {
-                        void *pPhys[3];
-                        SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                        pYUVBuf[0] = outputInfo.YPhyAddr;
-                        pYUVBuf[1] = outputInfo.CPhyAddr;
-                        csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
-                                            pYUVBuf, actualWidth, actualHeight,
-                                            OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
-                        break;
+                        void *pPhys[3] = {NULL, NULL, NULL};
+                        if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                            pYUVBuf[0] = outputInfo.YPhyAddr;
+                            pYUVBuf[1] = outputInfo.CPhyAddr;
+                            csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
+                                                pYUVBuf, actualWidth, actualHeight,
+                                                OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
+                            break;
+                        }
                     }
 #endif
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         actualWidth,
                         actualHeight);
-                    csc_tiled_to_linear_uv_neon(
+                    csc_tiled_to_linear_uv_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)outputInfo.CVirAddr,
                         actualWidth,
@@ -1745,22 +1734,23 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
                 default:
 #ifdef USE_CSC_FIMC
                     if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pH264Dec->hFIMCHandle != NULL)) {
-                        void *pPhys[3];
-                        SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                        pYUVBuf[0] = outputInfo.YPhyAddr;
-                        pYUVBuf[1] = outputInfo.CPhyAddr;
-                        csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
-                                            pYUVBuf, actualWidth, actualHeight,
-                                            OMX_COLOR_FormatYUV420Planar);
-                        break;
+                        void *pPhys[3] = {NULL, NULL, NULL};
+                        if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                            pYUVBuf[0] = outputInfo.YPhyAddr;
+                            pYUVBuf[1] = outputInfo.CPhyAddr;
+                            csc_fimc_convert_nv12t(pH264Dec->hFIMCHandle, pPhys,
+                                                pYUVBuf, actualWidth, actualHeight,
+                                                OMX_COLOR_FormatYUV420Planar);
+                            break;
+                        }
                     }
 #endif
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         actualWidth,
                         actualHeight);
-                    csc_tiled_to_linear_uv_deinterleave_neon(
+                    csc_tiled_to_linear_uv_deinterleave_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)pYUVBuf[2],
                         (unsigned char *)outputInfo.CVirAddr,
@@ -1775,8 +1765,6 @@ OMX_ERRORTYPE SEC_MFC_H264_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
                 SEC_OSAL_UnlockANB(pOutputData->dataBuffer);
             }
 #endif
-            pH264Dec->hMFCH264Handle.outputIndexTimestamp++;
-            pH264Dec->hMFCH264Handle.outputIndexTimestamp %= MAX_TIMESTAMP;
         }
         if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
             pOutputData->dataLen = 0;
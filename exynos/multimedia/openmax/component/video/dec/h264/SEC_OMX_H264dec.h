@@ -41,7 +41,6 @@ typedef struct _SEC_MFC_H264DEC_HANDLE
     OMX_PTR  pMFCStreamBuffer;
     OMX_PTR  pMFCStreamPhyBuffer;
     OMX_U32  indexTimestamp;
-    OMX_U32  outputIndexTimestamp;
     OMX_BOOL bConfiguredMFC;
     OMX_BOOL bFlashPlayerMode;
 #ifdef S3D_SUPPORT
@@ -32,6 +32,7 @@
 #include "SEC_OMX_Basecomponent.h"
 #include "SEC_OMX_Baseport.h"
 #include "SEC_OMX_Vdec.h"
+#include "SEC_OMX_VdecStartCode.h"
 #include "SEC_OSAL_ETC.h"
 #include "SEC_OSAL_Semaphore.h"
 #include "SEC_OSAL_Thread.h"
@@ -123,8 +124,6 @@ static OMX_BOOL gbFIMV1 = OMX_FALSE;
 static int Check_Mpeg4_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag, OMX_BOOL bPreviousFrameEOF, OMX_BOOL *pbEndOfFrame)
 {
     OMX_U32 len;
-    int readStream;
-    unsigned startCode;
     OMX_BOOL bFrameStart;
 
     len = 0;
@@ -157,50 +156,57 @@ static int Check_Mpeg4_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 fla
     if (bPreviousFrameEOF == OMX_FALSE)
         bFrameStart = OMX_TRUE;
 
-    startCode = 0xFFFFFFFF;
     if (bFrameStart == OMX_FALSE) {
         /* find VOP start code */
-        while(startCode != 0x1B6) {
-            readStream = *(pInputStream + len);
-            startCode = (startCode << 8) | readStream;
-            len++;
-            if (len > buffSize)
-                goto EXIT;
-        }
+        len = SEC_OMX_FindStartCodeId(pInputStream, buffSize, 0xB6);
+        if (len == buffSize)
+            goto EXIT;
+        len += 4;
     }
 
     /* find next VOP start code */
-    startCode = 0xFFFFFFFF;
-    while ((startCode != 0x1B6)) {
-        readStream = *(pInputStream + len);
-        startCode = (startCode << 8) | readStream;
-        len++;
-        if (len > buffSize)
-            goto EXIT;
-    }
+    len += SEC_OMX_FindStartCodeId(pInputStream + len, buffSize - len, 0xB6);
+    if (len == buffSize)
+        goto EXIT;
 
     *pbEndOfFrame = OMX_TRUE;
 
-    SEC_OSAL_Log(SEC_LOG_TRACE, "1. Check_Mpeg4_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, len - 4, buffSize);
+    SEC_OSAL_Log(SEC_LOG_TRACE, "1. Check_Mpeg4_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, len, buffSize);
 
-    return len - 4;
+    return len;
 
 EXIT :
     *pbEndOfFrame = OMX_FALSE;
 
-    SEC_OSAL_Log(SEC_LOG_TRACE, "2. Check_Mpeg4_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, len - 1, buffSize);
+    SEC_OSAL_Log(SEC_LOG_TRACE, "2. Check_Mpeg4_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, buffSize, buffSize);
+
+    return buffSize;
+}
+
+/* PSC(Picture Start Code) : 0000 0000 0000 0000 1000 00, followed by PTYPE bits 1 0 */
+static OMX_U32 Find_H263_PSC(OMX_U8 *pInputStream, OMX_U32 buffSize)
+{
+    OMX_U32 pos = 0;
+
+    while (pos + 4 <= buffSize) {
+        pos += SEC_OMX_FindZeroPair(pInputStream + pos, buffSize - pos);
+        if (pos + 4 > buffSize)
+            break;
+
+        if (((pInputStream[pos + 2] & 0xFC) == 0x80) &&
+            ((pInputStream[pos + 3] & 0x03) == 0x02))
+            return pos;
 
-    return --len;
+        pos++;
+    }
+
+    return buffSize;
 }
 
 static int Check_H263_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag, OMX_BOOL bPreviousFrameEOF, OMX_BOOL *pbEndOfFrame)
 {
     OMX_U32 len;
-    int readStream;
-    unsigned startCode;
     OMX_BOOL bFrameStart = 0;
-    unsigned pTypeMask = 0x03;
-    unsigned pType = 0;
 
     len = 0;
     bFrameStart = OMX_FALSE;
@@ -208,50 +214,32 @@ static int Check_H263_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag
     if (bPreviousFrameEOF == OMX_FALSE)
         bFrameStart = OMX_TRUE;
 
-    startCode = 0xFFFFFFFF;
     if (bFrameStart == OMX_FALSE) {
-        /* find PSC(Picture Start Code) : 0000 0000 0000 0000 1000 00 */
-        while (((startCode << 8 >> 10) != 0x20) || (pType != 0x02)) {
-            readStream = *(pInputStream + len);
-            startCode = (startCode << 8) | readStream;
-
-            readStream = *(pInputStream + len + 1);
-            pType = readStream & pTypeMask;
-
-            len++;
-            if (len > buffSize)
-                goto EXIT;
-        }
+        /* find PSC */
+        len = Find_H263_PSC(pInputStream, buffSize);
+        if (len == buffSize)
+            goto EXIT;
+        len += 3;
     }
 
     /* find next PSC */
-    startCode = 0xFFFFFFFF;
-    pType = 0;
-    while (((startCode << 8 >> 10) != 0x20) || (pType != 0x02)) {
-        readStream = *(pInputStream + len);
-        startCode = (startCode << 8) | readStream;
-
-        readStream = *(pInputStream + len + 1);
-        pType = readStream & pTypeMask;
-
-        len++;
-        if (len > buffSize)
-            goto EXIT;
-    }
+    len += Find_H263_PSC(pInputStream + len, buffSize - len);
+    if (len == buffSize)
+        goto EXIT;
 
     *pbEndOfFrame = OMX_TRUE;
 
-    SEC_OSAL_Log(SEC_LOG_TRACE, "1. Check_H263_Frame returned EOF = %d, len = %d, iBuffSize = %d", *pbEndOfFrame, len - 3, buffSize);
+    SEC_OSAL_Log(SEC_LOG_TRACE, "1. Check_H263_Frame returned EOF = %d, len = %d, iBuffSize = %d", *pbEndOfFrame, len, buffSize);
 
-    return len - 3;
+    return len;
 
 EXIT :
 
     *pbEndOfFrame = OMX_FALSE;
 
-    SEC_OSAL_Log(SEC_LOG_TRACE, "2. Check_H263_Frame returned EOF = %d, len = %d, iBuffSize = %d", *pbEndOfFrame, len - 1, buffSize);
+    SEC_OSAL_Log(SEC_LOG_TRACE, "2. Check_H263_Frame returned EOF = %d, len = %d, iBuffSize = %d", *pbEndOfFrame, buffSize, buffSize);
 
-    return --len;
+    return buffSize;
 }
 
 OMX_BOOL Check_Stream_PrefixCode(OMX_U8 *pInputStream, OMX_U32 streamSize, CODEC_TYPE codecType)
@@ -1017,10 +1005,14 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     pSECComponent->processData[INPUT_PORT_INDEX].dataBuffer = pVideoDec->MFCDecInputBuffer[0].VirAddr;
     pSECComponent->processData[INPUT_PORT_INDEX].allocSize = pVideoDec->MFCDecInputBuffer[0].bufferSize;
 
-    SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-    SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+#ifdef NEED_TIMESTAMP_REORDER
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_SORTED, OMX_TRUE);
+#else
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_TAG, OMX_TRUE);
+#endif
     pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp = 0;
-    pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp = 0;
 
     pSECComponent->getAllDelayBuffer = OMX_FALSE;
 
@@ -1204,13 +1196,13 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
         pSECComponent->bUseFlagEOF = OMX_TRUE;
 #endif
 
-    pSECComponent->timeStamp[pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp] = pInputData->nFlags;
+    pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
 
     if ((pMpeg4Dec->hMFCMpeg4Handle.returnCodec == MFC_RET_OK) &&
         (pVideoDec->bFirstFrame == OMX_FALSE)) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         /* wait for mfc decode done */
         if (pVideoDec->NBDecThread.bDecoderRun == OMX_TRUE) {
@@ -1225,33 +1217,29 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
         FrameBufferYSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height));
         FrameBufferUVSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height/2));
 
-        if ((SsbSipMfcDecGetConfig(hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+        if (SsbSipMfcDecGetConfig(hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+            indexTimestamp = -1;
+
+        /* For timestamp correction. if mfc support frametype detect */
+        SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+        if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+            (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+            bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                               (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ? OMX_TRUE : OMX_FALSE,
+                                               &pOutputData->timeStamp, &pOutputData->nFlags);
+        } else {
+            bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                &pOutputData->timeStamp, &pOutputData->nFlags);
+        }
+
+        if (bTimestamp != OMX_TRUE) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            /* For timestamp correction. if mfc support frametype detect */
-            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-            if (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) {
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp = indexTimestamp;
-            } else {
-                pOutputData->timeStamp = pSECComponent->timeStamp[pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp];
-            }
-#else
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
         }
 
         if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
             (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
             outputDataValid = OMX_TRUE;
-            pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp++;
-            pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp %= MAX_TIMESTAMP;
         }
         if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
             outputDataValid = OMX_FALSE;
@@ -1328,8 +1316,7 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
         ((pOutputData->nFlags & OMX_BUFFERFLAG_EOS) != OMX_BUFFERFLAG_EOS)) {
         if ((ret != OMX_ErrorInputDataDecodeYet) || (pSECComponent->getAllDelayBuffer == OMX_TRUE)) {
             SsbSipMfcDecSetConfig(pMpeg4Dec->hMFCMpeg4Handle.hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp));
-            pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp++;
-            pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
         }
 
         SsbSipMfcDecSetInBuf(pMpeg4Dec->hMFCMpeg4Handle.hMFCHandle,
@@ -1409,22 +1396,23 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
             case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
 #ifdef USE_CSC_FIMC
                 if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pMpeg4Dec->hFIMCHandle != NULL)) {
-                    void *pPhys[3];
-                    SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                    pYUVBuf[0] = outputInfo.YPhyAddr;
-                    pYUVBuf[1] = outputInfo.CPhyAddr;
-                    csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
-                                        pYUVBuf, width, height,
-                                        OMX_COLOR_FormatYUV420SemiPlanar);
-                    break;
+                    void *pPhys[3] = {NULL, NULL, NULL};
+                    if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                        pYUVBuf[0] = outputInfo.YPhyAddr;
+                        pYUVBuf[1] = outputInfo.CPhyAddr;
+                        csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
+                                            pYUVBuf, width, height,
+                                            OMX_COLOR_FormatYUV420SemiPlanar);
+                        break;
+                    }
                 }
 #endif
-                csc_tiled_to_linear_y_neon(
+                csc_tiled_to_linear_y_mt(
                     (unsigned char *)pYUVBuf[0],
                     (unsigned char *)outputInfo.YVirAddr,
                     width,
                     height);
-                csc_tiled_to_linear_uv_neon(
+                csc_tiled_to_linear_uv_mt(
                     (unsigned char *)pYUVBuf[1],
                     (unsigned char *)outputInfo.CVirAddr,
                     width,
@@ -1435,22 +1423,23 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
             default:
 #ifdef USE_CSC_FIMC
                 if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pMpeg4Dec->hFIMCHandle != NULL)) {
-                    void *pPhys[3];
-                    SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                    pYUVBuf[0] = outputInfo.YPhyAddr;
-                    pYUVBuf[1] = outputInfo.CPhyAddr;
-                    csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
-                                        pYUVBuf, width, height,
-                                        OMX_COLOR_FormatYUV420Planar);
-                    break;
+                    void *pPhys[3] = {NULL, NULL, NULL};
+                    if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                        pYUVBuf[0] = outputInfo.YPhyAddr;
+                        pYUVBuf[1] = outputInfo.CPhyAddr;
+                        csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
+                                            pYUVBuf, width, height,
+                                            OMX_COLOR_FormatYUV420Planar);
+                        break;
+                    }
                 }
 #endif
-               csc_tiled_to_linear_y_neon(
+               csc_tiled_to_linear_y_mt(
                     (unsigned char *)pYUVBuf[0],
                     (unsigned char *)outputInfo.YVirAddr,
                     width,
                     height);
-                csc_tiled_to_linear_uv_deinterleave_neon(
+                csc_tiled_to_linear_uv_deinterleave_mt(
                     (unsigned char *)pYUVBuf[1],
                     (unsigned char *)pYUVBuf[2],
                     (unsigned char *)outputInfo.CVirAddr,
@@ -1583,8 +1572,7 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
 #endif
 
     if (Check_Stream_PrefixCode(pInputData->dataBuffer, pInputData->dataLen, pMpeg4Dec->hMFCMpeg4Handle.codecType) == OMX_TRUE) {
-        pSECComponent->timeStamp[pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp] = pInputData->timeStamp;
-        pSECComponent->nFlags[pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp] = pInputData->nFlags;
+        pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
         SsbSipMfcDecSetConfig(hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp));
 
         returnCodec = SsbSipMfcDecExe(hMFCHandle, oneFrameSize);
@@ -1601,6 +1589,7 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
     if (returnCodec == MFC_RET_OK) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         status = SsbSipMfcDecGetOutBuf(hMFCHandle, &outputInfo);
         bufWidth =  (outputInfo.img_width + 15) & (~15);
@@ -1609,30 +1598,27 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
         FrameBufferUVSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height/2));
 
         if (status != MFC_GETOUTBUF_DISPLAY_ONLY) {
-            pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp++;
-            pMpeg4Dec->hMFCMpeg4Handle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
+        }
+
+        if (SsbSipMfcDecGetConfig(hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+            indexTimestamp = -1;
+
+        /* For timestamp correction. if mfc support frametype detect */
+        SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+        if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+            (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+            bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                               (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ? OMX_TRUE : OMX_FALSE,
+                                               &pOutputData->timeStamp, &pOutputData->nFlags);
+        } else {
+            bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                &pOutputData->timeStamp, &pOutputData->nFlags);
         }
 
-        if ((SsbSipMfcDecGetConfig(hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+        if (bTimestamp != OMX_TRUE) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            /* For timestamp correction. if mfc support frametype detect */
-            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-            if (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) {
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp = indexTimestamp;
-            } else {
-                pOutputData->timeStamp = pSECComponent->timeStamp[pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp];
-            }
-#else
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
         }
 
         if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
@@ -1679,22 +1665,23 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
                 case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
 #ifdef USE_CSC_FIMC
                     if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pMpeg4Dec->hFIMCHandle != NULL)) {
-                        void *pPhys[3];
-                        SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                        pYUVBuf[0] = outputInfo.YPhyAddr;
-                        pYUVBuf[1] = outputInfo.CPhyAddr;
-                        csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
-                                            pYUVBuf, width, height,
-                                            OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
-                        break;
+                        void *pPhys[3] = {NULL, NULL, NULL};
+                        if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                            pYUVBuf[0] = outputInfo.YPhyAddr;
+                            pYUVBuf[1] = outputInfo.CPhyAddr;
+                            csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
+                                                pYUVBuf, width, height,
+                                                OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
+                            break;
+                        }
                     }
 #endif
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         width,
                         height);
-                    csc_tiled_to_linear_uv_neon(
+                    csc_tiled_to_linear_uv_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)outputInfo.CVirAddr,
                         width,
@@ -1705,22 +1692,23 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
                 default:
 #ifdef USE_CSC_FIMC
                     if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pMpeg4Dec->hFIMCHandle != NULL)) {
-                        void *pPhys[3];
-                        SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                        pYUVBuf[0] = outputInfo.YPhyAddr;
-                        pYUVBuf[1] = outputInfo.CPhyAddr;
-                        csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
-                                            pYUVBuf, width, height,
-                                            OMX_COLOR_FormatYUV420Planar);
-                        break;
+                        void *pPhys[3] = {NULL, NULL, NULL};
+                        if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                            pYUVBuf[0] = outputInfo.YPhyAddr;
+                            pYUVBuf[1] = outputInfo.CPhyAddr;
+                            csc_fimc_convert_nv12t(pMpeg4Dec->hFIMCHandle, pPhys,
+                                                pYUVBuf, width, height,
+                                                OMX_COLOR_FormatYUV420Planar);
+                            break;
+                        }
                     }
 #endif
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         width,
                         height);
-                    csc_tiled_to_linear_uv_deinterleave_neon(
+                    csc_tiled_to_linear_uv_deinterleave_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)pYUVBuf[2],
                         (unsigned char *)outputInfo.CVirAddr,
@@ -1735,8 +1723,6 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
                 SEC_OSAL_UnlockANB(pOutputData->dataBuffer);
             }
 #endif
-            pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp++;
-            pMpeg4Dec->hMFCMpeg4Handle.outputIndexTimestamp %= MAX_TIMESTAMP;
         }
         if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
             pOutputData->dataLen = 0;
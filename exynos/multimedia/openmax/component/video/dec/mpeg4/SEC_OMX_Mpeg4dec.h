@@ -61,7 +61,6 @@ typedef struct _SEC_MFC_MPEG4_HANDLE
     OMX_PTR        pMFCStreamBuffer;
     OMX_PTR        pMFCStreamPhyBuffer;
     OMX_U32        indexTimestamp;
-    OMX_U32        outputIndexTimestamp;
     OMX_BOOL       bConfiguredMFC;
     CODEC_TYPE     codecType;
     OMX_S32        returnCodec;
@@ -34,6 +34,7 @@
 #include "SEC_OMX_Basecomponent.h"
 #include "SEC_OMX_Baseport.h"
 #include "SEC_OMX_Vdec.h"
+#include "SEC_OMX_VdecStartCode.h"
 #include "SEC_OSAL_ETC.h"
 #include "SEC_OSAL_Semaphore.h"
 #include "SEC_OSAL_Thread.h"
@@ -77,8 +78,7 @@ static int Check_Wmv_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag,
 {
     OMX_U32  compressionID;
     OMX_BOOL bFrameStart;
-    OMX_U32  len, readStream;
-    OMX_U32  startCode;
+    OMX_U32  len;
 
     SEC_OSAL_Log(SEC_LOG_TRACE, "buffSize = %d", buffSize);
 
@@ -126,41 +126,32 @@ static int Check_Wmv_Frame(OMX_U8 *pInputStream, OMX_U32 buffSize, OMX_U32 flag,
     if (bPreviousFrameEOF == OMX_FALSE)
         bFrameStart = OMX_TRUE;
 
-    startCode = 0xFFFFFFFF;
     if (bFrameStart == OMX_FALSE) {
         /* find Frame start code */
-        while(startCode != 0x10D) {
-            readStream = *(pInputStream + len);
-            startCode = (startCode << 8) | readStream;
-            len++;
-            if (len > buffSize)
-                goto EXIT;
-        }
+        len = SEC_OMX_FindStartCodeId(pInputStream, buffSize, 0x0D);
+        if (len == buffSize)
+            goto EXIT;
+        len += 4;
     }
 
     /* find next Frame start code */
-    startCode = 0xFFFFFFFF;
-    while ((startCode != 0x10D)) {
-        readStream = *(pInputStream + len);
-        startCode = (startCode << 8) | readStream;
-        len++;
-        if (len > buffSize)
-            goto EXIT;
-    }
+    len += SEC_OMX_FindStartCodeId(pInputStream + len, buffSize - len, 0x0D);
+    if (len == buffSize)
+        goto EXIT;
 
     *pbEndOfFrame = OMX_TRUE;
 
-    SEC_OSAL_Log(SEC_LOG_TRACE, "1. Check_Wmv_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, len - 4, buffSize);
+    SEC_OSAL_Log(SEC_LOG_TRACE, "1. Check_Wmv_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, len, buffSize);
 
-    return len - 4;
+    return len;
 #endif
 
 EXIT :
     *pbEndOfFrame = OMX_FALSE;
 
-    SEC_OSAL_Log(SEC_LOG_TRACE, "2. Check_Wmv_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, len - 1, buffSize);
+    SEC_OSAL_Log(SEC_LOG_TRACE, "2. Check_Wmv_Frame returned EOF = %d, len = %d, buffSize = %d", *pbEndOfFrame, buffSize, buffSize);
 
-    return --len;
+    return buffSize;
 }
 
 OMX_BOOL Check_Stream_PrefixCode(OMX_U8 *pInputStream, OMX_U32 streamSize, WMV_FORMAT wmvFormat)
@@ -877,10 +868,14 @@ OMX_ERRORTYPE SEC_MFC_WmvDec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     pSECComponent->processData[INPUT_PORT_INDEX].dataBuffer = pVideoDec->MFCDecInputBuffer[0].VirAddr;
     pSECComponent->processData[INPUT_PORT_INDEX].allocSize = pVideoDec->MFCDecInputBuffer[0].bufferSize;
 
-    SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-    SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+#ifdef NEED_TIMESTAMP_REORDER
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_SORTED, OMX_TRUE);
+#else
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_TAG, OMX_TRUE);
+#endif
     pWmvDec->hMFCWmvHandle.indexTimestamp = 0;
-    pWmvDec->hMFCWmvHandle.outputIndexTimestamp = 0;
     pSECComponent->getAllDelayBuffer = OMX_FALSE;
 
 #ifdef USE_CSC_FIMC
@@ -1081,12 +1076,12 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
         pSECComponent->bUseFlagEOF = OMX_TRUE;
 #endif
 
-    pSECComponent->timeStamp[pWmvDec->hMFCWmvHandle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pWmvDec->hMFCWmvHandle.indexTimestamp] = pInputData->nFlags;
+    pWmvDec->hMFCWmvHandle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
 
     if ((pWmvDec->hMFCWmvHandle.returnCodec == MFC_RET_OK) && (pVideoDec->bFirstFrame == OMX_FALSE)) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         /* wait for mfc decode done */
         if (pVideoDec->NBDecThread.bDecoderRun == OMX_TRUE) {
@@ -1101,33 +1096,29 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
             FrameBufferYSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height));
             FrameBufferUVSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height/2));
 
-            if ((SsbSipMfcDecGetConfig(pWmvDec->hMFCWmvHandle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-                (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+            if (SsbSipMfcDecGetConfig(pWmvDec->hMFCWmvHandle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+                indexTimestamp = -1;
+
+            /* For timestamp correction. if mfc support frametype detect */
+            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+            if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+                (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+                bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                                   (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ? OMX_TRUE : OMX_FALSE,
+                                                   &pOutputData->timeStamp, &pOutputData->nFlags);
+            } else {
+                bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                    &pOutputData->timeStamp, &pOutputData->nFlags);
+            }
+
+            if (bTimestamp != OMX_TRUE) {
                 pOutputData->timeStamp = pInputData->timeStamp;
                 pOutputData->nFlags = pInputData->nFlags;
-            } else {
-                /* For timestamp correction. if mfc support frametype detect */
-                SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-                if (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) {
-                    pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                    pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                    pWmvDec->hMFCWmvHandle.outputIndexTimestamp = indexTimestamp;
-                } else {
-                    pOutputData->timeStamp = pSECComponent->timeStamp[pWmvDec->hMFCWmvHandle.outputIndexTimestamp];
-                    pOutputData->nFlags = pSECComponent->nFlags[pWmvDec->hMFCWmvHandle.outputIndexTimestamp];
-                }
-#else
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
             }
 
             if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
                 (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
                 outputDataValid = OMX_TRUE;
-                pWmvDec->hMFCWmvHandle.outputIndexTimestamp++;
-                pWmvDec->hMFCWmvHandle.outputIndexTimestamp %= MAX_TIMESTAMP;
             }
             if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
                 outputDataValid = OMX_FALSE;
@@ -1221,8 +1212,7 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
         ((pOutputData->nFlags & OMX_BUFFERFLAG_EOS) != OMX_BUFFERFLAG_EOS)) {
         if ((ret != OMX_ErrorInputDataDecodeYet) || (pSECComponent->getAllDelayBuffer == OMX_TRUE)) {
             SsbSipMfcDecSetConfig(pWmvDec->hMFCWmvHandle.hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pWmvDec->hMFCWmvHandle.indexTimestamp));
-            pWmvDec->hMFCWmvHandle.indexTimestamp++;
-            pWmvDec->hMFCWmvHandle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
         }
 
         SsbSipMfcDecSetInBuf(pWmvDec->hMFCWmvHandle.hMFCHandle,
@@ -1307,22 +1297,23 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
             case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
 #ifdef USE_CSC_FIMC
                 if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pWmvDec->hFIMCHandle != NULL)) {
-                    void *pPhys[3];
-                    SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                    pYUVBuf[0] = outputInfo.YPhyAddr;
-                    pYUVBuf[1] = outputInfo.CPhyAddr;
-                    csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
-                                        pYUVBuf, width, height,
-                                        OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
-                    break;
+                    void *pPhys[3] = {NULL, NULL, NULL};
+                    if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                        pYUVBuf[0] = outputInfo.YPhyAddr;
+                        pYUVBuf[1] = outputInfo.CPhyAddr;
+                        csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
+                                            pYUVBuf, width, height,
+                                            OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
+                        break;
+                    }
                 }
 #endif
-                csc_tiled_to_linear_y_neon(
+                csc_tiled_to_linear_y_mt(
                     (unsigned char *)pYUVBuf[0],
                     (unsigned char *)outputInfo.YVirAddr,
                     width,
                     height);
-                csc_tiled_to_linear_uv_neon(
+                csc_tiled_to_linear_uv_mt(
                     (unsigned char *)pYUVBuf[1],
                     (unsigned char *)outputInfo.CVirAddr,
                     width,
@@ -1333,22 +1324,23 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
             default:
 #ifdef USE_CSC_FIMC
                 if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pWmvDec->hFIMCHandle != NULL)) {
-                    void *pPhys[3];
-                    SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                    pYUVBuf[0] = outputInfo.YPhyAddr;
-                    pYUVBuf[1] = outputInfo.CPhyAddr;
-                    csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
-                                        pYUVBuf, width, height,
-                                        OMX_COLOR_FormatYUV420Planar);
-                    break;
+                    void *pPhys[3] = {NULL, NULL, NULL};
+                    if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                        pYUVBuf[0] = outputInfo.YPhyAddr;
+                        pYUVBuf[1] = outputInfo.CPhyAddr;
+                        csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
+                                            pYUVBuf, width, height,
+                                            OMX_COLOR_FormatYUV420Planar);
+                        break;
+                    }
                 }
 #endif
-                csc_tiled_to_linear_y_neon(
+                csc_tiled_to_linear_y_mt(
                     (unsigned char *)pYUVBuf[0],
                     (unsigned char *)outputInfo.YVirAddr,
                     width,
                     height);
-                csc_tiled_to_linear_uv_deinterleave_neon(
+                csc_tiled_to_linear_uv_deinterleave_mt(
                     (unsigned char *)pYUVBuf[1],
                     (unsigned char *)pYUVBuf[2],
                     (unsigned char *)outputInfo.CVirAddr,
@@ -1517,8 +1509,7 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
     SEC_OSAL_Log(SEC_LOG_TRACE, "SsbSipMfcDecExe oneFrameSize = %d", oneFrameSize);
 
     if (Check_Stream_PrefixCode(pInputData->dataBuffer, pInputData->dataLen, pWmvDec->hMFCWmvHandle.wmvFormat) == OMX_TRUE) {
-        pSECComponent->timeStamp[pWmvDec->hMFCWmvHandle.indexTimestamp] = pInputData->timeStamp;
-        pSECComponent->nFlags[pWmvDec->hMFCWmvHandle.indexTimestamp] = pInputData->nFlags;
+        pWmvDec->hMFCWmvHandle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
         SsbSipMfcDecSetConfig(pWmvDec->hMFCWmvHandle.hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pWmvDec->hMFCWmvHandle.indexTimestamp));
 
 #ifdef WO_START_CODE
@@ -1539,6 +1530,7 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
     if (returnCodec == MFC_RET_OK) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         status = SsbSipMfcDecGetOutBuf(pWmvDec->hMFCWmvHandle.hMFCHandle, &outputInfo);
         bufWidth = (outputInfo.img_width + 15) & (~15);
@@ -1547,30 +1539,27 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
         FrameBufferUVSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height/2));
 
         if (status != MFC_GETOUTBUF_DISPLAY_ONLY) {
-            pWmvDec->hMFCWmvHandle.indexTimestamp++;
-            pWmvDec->hMFCWmvHandle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
+        }
+
+        if (SsbSipMfcDecGetConfig(pWmvDec->hMFCWmvHandle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+            indexTimestamp = -1;
+
+        /* For timestamp correction. if mfc support frametype detect */
+        SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+        if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+            (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+            bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                               (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ? OMX_TRUE : OMX_FALSE,
+                                               &pOutputData->timeStamp, &pOutputData->nFlags);
+        } else {
+            bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                &pOutputData->timeStamp, &pOutputData->nFlags);
         }
 
-        if (SsbSipMfcDecGetConfig(pWmvDec->hMFCWmvHandle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+        if (bTimestamp != OMX_TRUE) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            /* For timestamp correction. if mfc support frametype detect */
-            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-            if (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) {
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                pWmvDec->hMFCWmvHandle.outputIndexTimestamp = indexTimestamp;
-            } else {
-                pOutputData->timeStamp = pSECComponent->timeStamp[pWmvDec->hMFCWmvHandle.outputIndexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[pWmvDec->hMFCWmvHandle.outputIndexTimestamp];
-            }
-#else
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
         }
 
         if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
@@ -1616,22 +1605,23 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
                 case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
 #ifdef USE_CSC_FIMC
                     if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pWmvDec->hFIMCHandle != NULL)) {
-                        void *pPhys[3];
-                        SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                        pYUVBuf[0] = outputInfo.YPhyAddr;
-                        pYUVBuf[1] = outputInfo.CPhyAddr;
-                        csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
-                                            pYUVBuf, width, height,
-                                            OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
-                        break;
+                        void *pPhys[3] = {NULL, NULL, NULL};
+                        if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                            pYUVBuf[0] = outputInfo.YPhyAddr;
+                            pYUVBuf[1] = outputInfo.CPhyAddr;
+                            csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
+                                                pYUVBuf, width, height,
+                                                OMX_SEC_COLOR_FormatANBYUV420SemiPlanar);
+                            break;
+                        }
                     }
 #endif
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         width,
                         height);
-                    csc_tiled_to_linear_uv_neon(
+                    csc_tiled_to_linear_uv_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)outputInfo.CVirAddr,
                         width,
@@ -1642,22 +1632,23 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
                 default:
 #ifdef USE_CSC_FIMC
                     if ((pSECOutputPort->bIsANBEnabled == OMX_TRUE) && (pWmvDec->hFIMCHandle != NULL)) {
-                        void *pPhys[3];
-                        SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys);
-                        pYUVBuf[0] = outputInfo.YPhyAddr;
-                        pYUVBuf[1] = outputInfo.CPhyAddr;
-                        csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
-                                            pYUVBuf, width, height,
-                                            OMX_COLOR_FormatYUV420Planar);
-                        break;
+                        void *pPhys[3] = {NULL, NULL, NULL};
+                        if (SEC_OSAL_GetPhysANB(pOutputData->dataBuffer, pPhys) == OMX_ErrorNone) {
+                            pYUVBuf[0] = outputInfo.YPhyAddr;
+                            pYUVBuf[1] = outputInfo.CPhyAddr;
+                            csc_fimc_convert_nv12t(pWmvDec->hFIMCHandle, pPhys,
+                                                pYUVBuf, width, height,
+                                                OMX_COLOR_FormatYUV420Planar);
+                            break;
+                        }
                     }
 #endif
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         width,
                         height);
-                    csc_tiled_to_linear_uv_deinterleave_neon(
+                    csc_tiled_to_linear_uv_deinterleave_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)pYUVBuf[2],
                         (unsigned char *)outputInfo.CVirAddr,
@@ -1672,8 +1663,6 @@ OMX_ERRORTYPE SEC_MFC_Wmv_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
                 SEC_OSAL_UnlockANB(pOutputData->dataBuffer);
             }
 #endif
-            pWmvDec->hMFCWmvHandle.outputIndexTimestamp++;
-            pWmvDec->hMFCWmvHandle.outputIndexTimestamp %= MAX_TIMESTAMP;
         }
         if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
             pOutputData->dataLen = 0;
@@ -64,7 +64,6 @@ typedef struct _SEC_MFC_WMV_HANDLE
     OMX_PTR        pMFCStreamBuffer;
     OMX_PTR        pMFCStreamPhyBuffer;
     OMX_U32        indexTimestamp;
-    OMX_U32        outputIndexTimestamp;
     OMX_BOOL       bConfiguredMFC;
     WMV_FORMAT     wmvFormat;
     OMX_S32        returnCodec;
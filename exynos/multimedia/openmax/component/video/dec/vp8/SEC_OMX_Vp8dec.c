@@ -635,10 +635,14 @@ OMX_ERRORTYPE SEC_MFC_VP8Dec_Init(OMX_COMPONENTTYPE *pOMXComponent)
     pSECComponent->processData[INPUT_PORT_INDEX].dataBuffer = pVideoDec->MFCDecInputBuffer[0].VirAddr;
     pSECComponent->processData[INPUT_PORT_INDEX].allocSize = pVideoDec->MFCDecInputBuffer[0].bufferSize;
 
-    SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-    SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+#ifdef NEED_TIMESTAMP_REORDER
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_SORTED, OMX_TRUE);
+#else
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_TAG, OMX_TRUE);
+#endif
     pVp8Dec->hMFCVp8Handle.indexTimestamp = 0;
-    pVp8Dec->hMFCVp8Handle.outputIndexTimestamp = 0;
 
     pSECComponent->getAllDelayBuffer = OMX_FALSE;
 
@@ -794,13 +798,13 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
         pSECComponent->bUseFlagEOF = OMX_TRUE;
 #endif
 
-    pSECComponent->timeStamp[pVp8Dec->hMFCVp8Handle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pVp8Dec->hMFCVp8Handle.indexTimestamp] = pInputData->nFlags;
+    pVp8Dec->hMFCVp8Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
 
     if ((pVp8Dec->hMFCVp8Handle.returnCodec == MFC_RET_OK) &&
         (pVideoDec->bFirstFrame == OMX_FALSE)) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         /* wait for mfc decode done */
         if (pVideoDec->NBDecThread.bDecoderRun == OMX_TRUE) {
@@ -815,34 +819,30 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
         FrameBufferYSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height));
         FrameBufferUVSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height/2));
 
-        if ((SsbSipMfcDecGetConfig(pVp8Dec->hMFCVp8Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+        if (SsbSipMfcDecGetConfig(pVp8Dec->hMFCVp8Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+            indexTimestamp = -1;
+
+        /* For timestamp correction. if mfc support frametype detect */
+        SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+        if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+            (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+            bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                               (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ? OMX_TRUE : OMX_FALSE,
+                                               &pOutputData->timeStamp, &pOutputData->nFlags);
+        } else {
+            bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                &pOutputData->timeStamp, &pOutputData->nFlags);
+        }
+
+        if (bTimestamp != OMX_TRUE) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            /* For timestamp correction. if mfc support frametype detect */
-            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-            if (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) {
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                pVp8Dec->hMFCVp8Handle.outputIndexTimestamp = indexTimestamp;
-            } else {
-                pOutputData->timeStamp = pSECComponent->timeStamp[pVp8Dec->hMFCVp8Handle.outputIndexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[pVp8Dec->hMFCVp8Handle.outputIndexTimestamp];
-            }
-#else
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
-            SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
         }
+        SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
 
         if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
             (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
             outputDataValid = OMX_TRUE;
-            pVp8Dec->hMFCVp8Handle.outputIndexTimestamp++;
-            pVp8Dec->hMFCVp8Handle.outputIndexTimestamp %= MAX_TIMESTAMP;
         }
         if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
             outputDataValid = OMX_FALSE;
@@ -919,8 +919,7 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
         ((pOutputData->nFlags & OMX_BUFFERFLAG_EOS) != OMX_BUFFERFLAG_EOS)) {
         if ((ret != OMX_ErrorInputDataDecodeYet) || (pSECComponent->getAllDelayBuffer == OMX_TRUE)) {
             SsbSipMfcDecSetConfig(pVp8Dec->hMFCVp8Handle.hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pVp8Dec->hMFCVp8Handle.indexTimestamp));
-            pVp8Dec->hMFCVp8Handle.indexTimestamp++;
-            pVp8Dec->hMFCVp8Handle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
         }
 
         SsbSipMfcDecSetInBuf(pVp8Dec->hMFCVp8Handle.hMFCHandle,
@@ -998,12 +997,12 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
                 break;
             case OMX_COLOR_FormatYUV420SemiPlanar:
             case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         width,
                         height);
-                    csc_tiled_to_linear_uv_neon(
+                    csc_tiled_to_linear_uv_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)outputInfo.CVirAddr,
                         width,
@@ -1013,12 +1012,12 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC_
             case OMX_COLOR_FormatYUV420Planar:
             case OMX_COLOR_FormatYCbCr420Planar:
             default:
-                csc_tiled_to_linear_y_neon(
+                csc_tiled_to_linear_y_mt(
                     (unsigned char *)pYUVBuf[0],
                     (unsigned char *)outputInfo.YVirAddr,
                     width,
                     height);
-                csc_tiled_to_linear_uv_deinterleave_neon(
+                csc_tiled_to_linear_uv_deinterleave_mt(
                     (unsigned char *)pYUVBuf[1],
                     (unsigned char *)pYUVBuf[2],
                     (unsigned char *)outputInfo.CVirAddr,
@@ -1132,8 +1131,7 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
 #endif
 
     if (Check_VP8_StartCode(pInputData->dataBuffer, pInputData->dataLen) == OMX_TRUE) {
-        pSECComponent->timeStamp[pVp8Dec->hMFCVp8Handle.indexTimestamp] = pInputData->timeStamp;
-        pSECComponent->nFlags[pVp8Dec->hMFCVp8Handle.indexTimestamp] = pInputData->nFlags;
+        pVp8Dec->hMFCVp8Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
         SsbSipMfcDecSetConfig(pVp8Dec->hMFCVp8Handle.hMFCHandle, MFC_DEC_SETCONF_FRAME_TAG, &(pVp8Dec->hMFCVp8Handle.indexTimestamp));
 
         returnCodec = SsbSipMfcDecExe(pVp8Dec->hMFCVp8Handle.hMFCHandle, oneFrameSize);
@@ -1150,6 +1148,7 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
     if (returnCodec == MFC_RET_OK) {
         SSBSIP_MFC_DEC_OUTBUF_STATUS status;
         OMX_S32 indexTimestamp = 0;
+        OMX_BOOL bTimestamp = OMX_FALSE;
 
         status = SsbSipMfcDecGetOutBuf(pVp8Dec->hMFCVp8Handle.hMFCHandle, &outputInfo);
         bufWidth =    (outputInfo.img_width + 15) & (~15);
@@ -1158,32 +1157,29 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
         FrameBufferUVSize = ALIGN_TO_8KB(ALIGN_TO_128B(outputInfo.img_width) * ALIGN_TO_32B(outputInfo.img_height/2));
 
         if (status != MFC_GETOUTBUF_DISPLAY_ONLY) {
-            pVp8Dec->hMFCVp8Handle.indexTimestamp++;
-            pVp8Dec->hMFCVp8Handle.indexTimestamp %= MAX_TIMESTAMP;
+            SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
+        }
+
+        if (SsbSipMfcDecGetConfig(pVp8Dec->hMFCVp8Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK)
+            indexTimestamp = -1;
+
+        /* For timestamp correction. if mfc support frametype detect */
+        SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
+        if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
+            (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
+            bTimestamp = SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp,
+                                               (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) ? OMX_TRUE : OMX_FALSE,
+                                               &pOutputData->timeStamp, &pOutputData->nFlags);
+        } else {
+            bTimestamp = SEC_OMX_Timestamp_Peek(&pSECComponent->timestampQueue, indexTimestamp,
+                                                &pOutputData->timeStamp, &pOutputData->nFlags);
         }
 
-        if ((SsbSipMfcDecGetConfig(pVp8Dec->hMFCVp8Handle.hMFCHandle, MFC_DEC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+        if (bTimestamp != OMX_TRUE) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            /* For timestamp correction. if mfc support frametype detect */
-            SEC_OSAL_Log(SEC_LOG_TRACE, "disp_pic_frame_type: %d", outputInfo.disp_pic_frame_type);
-#ifdef NEED_TIMESTAMP_REORDER
-            if (outputInfo.disp_pic_frame_type == MFC_FRAME_TYPE_I_FRAME) {
-                pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-                pVp8Dec->hMFCVp8Handle.outputIndexTimestamp = indexTimestamp;
-            } else {
-                pOutputData->timeStamp = pSECComponent->timeStamp[pVp8Dec->hMFCVp8Handle.outputIndexTimestamp];
-                pOutputData->nFlags = pSECComponent->nFlags[pVp8Dec->hMFCVp8Handle.outputIndexTimestamp];
-            }
-#else
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
-#endif
-            SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
         }
+        SEC_OSAL_Log(SEC_LOG_TRACE, "timestamp %lld us (%.2f secs)", pOutputData->timeStamp, pOutputData->timeStamp / 1E6);
 
         if ((status == MFC_GETOUTBUF_DISPLAY_DECODING) ||
             (status == MFC_GETOUTBUF_DISPLAY_ONLY)) {
@@ -1227,12 +1223,12 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
                     break;
                 case OMX_COLOR_FormatYUV420SemiPlanar:
                 case OMX_SEC_COLOR_FormatANBYUV420SemiPlanar:
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         width,
                         height);
-                    csc_tiled_to_linear_uv_neon(
+                    csc_tiled_to_linear_uv_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)outputInfo.CVirAddr,
                         width,
@@ -1241,12 +1237,12 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
                 case OMX_COLOR_FormatYUV420Planar:
                 case OMX_COLOR_FormatYCbCr420Planar:
                 default:
-                    csc_tiled_to_linear_y_neon(
+                    csc_tiled_to_linear_y_mt(
                         (unsigned char *)pYUVBuf[0],
                         (unsigned char *)outputInfo.YVirAddr,
                         width,
                         height);
-                    csc_tiled_to_linear_uv_deinterleave_neon(
+                    csc_tiled_to_linear_uv_deinterleave_mt(
                         (unsigned char *)pYUVBuf[1],
                         (unsigned char *)pYUVBuf[2],
                         (unsigned char *)outputInfo.CVirAddr,
@@ -1261,8 +1257,6 @@ OMX_ERRORTYPE SEC_MFC_VP8_Decode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OMX
                 SEC_OSAL_UnlockANB(pOutputData->dataBuffer);
             }
 #endif
-            pVp8Dec->hMFCVp8Handle.outputIndexTimestamp++;
-            pVp8Dec->hMFCVp8Handle.outputIndexTimestamp %= MAX_TIMESTAMP;
         }
         if (pOutputData->nFlags & OMX_BUFFERFLAG_EOS)
             pOutputData->dataLen = 0;
@@ -38,7 +38,6 @@ typedef struct _SEC_MFC_VP8DEC_HANDLE
     OMX_PTR  pMFCStreamBuffer;
     OMX_PTR  pMFCStreamPhyBuffer;
     OMX_U32  indexTimestamp;
-    OMX_U32  outputIndexTimestamp;
     OMX_BOOL bConfiguredMFC;
     OMX_S32  returnCodec;
 } SEC_MFC_VP8DEC_HANDLE;
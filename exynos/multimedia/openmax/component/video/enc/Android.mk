@@ -24,6 +24,17 @@ ifeq ($(BOARD_USE_STOREMETADATA), true)
 LOCAL_CFLAGS += -DUSE_STOREMETADATA
 endif
 
+ifeq ($(BOARD_USE_CSC_FIMC), true)
+ifeq ($(BOARD_USE_V4L2_ION), false)
+LOCAL_CFLAGS += -DUSE_CSC_FIMC
+endif
+endif
+
+# MFC reads metadata input in place, needs the physical address interface
+ifeq ($(BOARD_USE_V4L2), false)
+LOCAL_CFLAGS += -DUSE_MFC_DIRECT_INPUT
+endif
+
 LOCAL_CFLAGS += -Wno-error
 
 include $(BUILD_STATIC_LIBRARY)
@@ -38,10 +38,14 @@
 #include "SEC_OSAL_ETC.h"
 #include "color_space_convertor.h"
 
-#ifdef USE_STOREMETADATA
+#if defined(USE_STOREMETADATA) || defined(USE_METADATABUFFERTYPE)
 #include "SEC_OSAL_Android.h"
 #endif
 
+#ifdef USE_CSC_FIMC
+#include "csc_fimc.h"
+#endif
+
 #undef  SEC_LOG_TAG
 #define SEC_LOG_TAG    "SEC_VIDEO_ENC"
 #define SEC_LOG_OFF
@@ -654,6 +658,117 @@ static OMX_ERRORTYPE SEC_DataReset(OMX_COMPONENTTYPE *pOMXComponent, OMX_U32 por
     return ret;
 }
 
+#ifdef USE_METADATABUFFERTYPE
+/*
+ * Feeds a gralloc buffer to the MFC. In order of preference the MFC reads it
+ * in place, FIMC converts it into the MFC input buffer, or the CPU does.
+ */
+static void SEC_Preprocessor_MetaDataInput(
+    OMX_COMPONENTTYPE *pOMXComponent,
+    SEC_OMX_DATA      *inputData,
+    OMX_U32            width,
+    OMX_U32            height)
+{
+    SEC_OMX_BASECOMPONENT      *pSECComponent = (SEC_OMX_BASECOMPONENT *)pOMXComponent->pComponentPrivate;
+    SEC_OMX_VIDEOENC_COMPONENT *pVideoEnc = (SEC_OMX_VIDEOENC_COMPONENT *)pSECComponent->hComponentHandle;
+    MFC_ENC_INPUT_BUFFER       *pMFCInput = &pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer];
+    SEC_VIDEOENC_INPUT_PATH     path = VIDEOENC_INPUT_COPY;
+    OMX_COLOR_FORMATTYPE        srcFormat = OMX_COLOR_FormatUnused;
+    OMX_U32                     srcStride = 0;
+    OMX_U32                     handle = 0;
+    OMX_PTR                     ppBuf[3] = {NULL, NULL, NULL};
+    OMX_PTR                     pPhys[3] = {NULL, NULL, NULL};
+    OMX_PTR                     pOutBuffer = NULL;
+
+    SEC_OSAL_GetInfoFromMetaData(inputData, ppBuf);
+    handle = (OMX_U32)ppBuf[0];
+    if (handle == 0)
+        return;
+
+    /* the hardware paths need a contiguous buffer without row padding */
+    if ((SEC_OSAL_GetANBHandleFormat(handle, &srcFormat, &srcStride) != OMX_ErrorNone) ||
+        (srcStride != width) ||
+        (SEC_OSAL_GetPhysANBHandle(handle, pPhys) != OMX_ErrorNone))
+        pPhys[0] = NULL;
+
+    if (pPhys[0] != NULL) {
+#ifdef USE_MFC_DIRECT_INPUT
+        if ((srcFormat == OMX_COLOR_FormatYUV420SemiPlanar) &&
+            ((width % 16) == 0) &&
+            (((OMX_U32)pPhys[0] % MFC_ENC_INPUT_ADDR_ALIGN) == 0) &&
+            (((OMX_U32)pPhys[1] % MFC_ENC_INPUT_ADDR_ALIGN) == 0)) {
+            pVideoEnc->directInputAddr.pAddrY = pPhys[0];
+            pVideoEnc->directInputAddr.pAddrC = pPhys[1];
+            pVideoEnc->bDirectInput = OMX_TRUE;
+            path = VIDEOENC_INPUT_DIRECT;
+            goto EXIT;
+        }
+#endif
+#ifdef USE_CSC_FIMC
+        if (pVideoEnc->hFIMCHandle != NULL) {
+            void *pDst[3];
+
+            pDst[0] = pMFCInput->YPhyAddr;
+            pDst[1] = pMFCInput->CPhyAddr;
+            pDst[2] = pMFCInput->CPhyAddr;
+            if (csc_fimc_convert(pVideoEnc->hFIMCHandle, pDst, pPhys, width, height,
+                                 srcFormat, OMX_COLOR_FormatYUV420SemiPlanar) == CSC_FIMC_RET_OK) {
+                path = VIDEOENC_INPUT_FIMC;
+                goto EXIT;
+            }
+            SEC_OSAL_Log(SEC_LOG_WARNING, "%s: FIMC conversion failed, using the CPU", __func__);
+        }
+#endif
+    }
+
+    if (srcFormat == OMX_COLOR_FormatYUV420SemiPlanar) {
+        OMX_U8 **ppAddr;
+        OMX_U32  i;
+
+        if (SEC_OSAL_LockANBHandle(handle, width, height,
+                                   (OMX_COLOR_FORMATTYPE)OMX_SEC_COLOR_FormatANBYUV420SemiPlanar,
+                                   &pOutBuffer) != OMX_ErrorNone)
+            goto EXIT;
+
+        /* locked with YUV addresses, gralloc returns an allocated Y/U/V array */
+        ppAddr = (OMX_U8 **)pOutBuffer;
+        for (i = 0; i < height; i++)
+            SEC_OSAL_Memcpy((OMX_U8 *)pMFCInput->YVirAddr + (i * width), ppAddr[0] + (i * srcStride), width);
+        for (i = 0; i < height / 2; i++)
+            SEC_OSAL_Memcpy((OMX_U8 *)pMFCInput->CVirAddr + (i * width), ppAddr[1] + (i * srcStride), width);
+        free(ppAddr);
+    } else {
+        if (SEC_OSAL_LockANBHandle(handle, width, height, OMX_COLOR_FormatAndroidOpaque,
+                                   &pOutBuffer) != OMX_ErrorNone)
+            goto EXIT;
+
+        csc_ARGB8888_to_YUV420SP_NEON(pMFCInput->YVirAddr, pMFCInput->CVirAddr,
+                                      pOutBuffer, width, height);
+    }
+
+    SEC_OSAL_UnlockANBHandle(handle);
+
+EXIT:
+    pVideoEnc->nInputFrames[path]++;
+    SEC_OSAL_Log(SEC_LOG_TRACE, "%s: format 0x%x, stride %d, path %d", __func__, srcFormat, srcStride, path);
+
+    return;
+}
+#endif
+
+void SEC_VideoEncodeInputPathReport(SEC_OMX_VIDEOENC_COMPONENT *pVideoEnc)
+{
+    if ((pVideoEnc->nInputFrames[VIDEOENC_INPUT_DIRECT] != 0) ||
+        (pVideoEnc->nInputFrames[VIDEOENC_INPUT_FIMC] != 0) ||
+        (pVideoEnc->nInputFrames[VIDEOENC_INPUT_COPY] != 0))
+        SEC_OSAL_Log(SEC_LOG_TRACE, "input frames: direct %d, fimc %d, copy %d",
+                     pVideoEnc->nInputFrames[VIDEOENC_INPUT_DIRECT],
+                     pVideoEnc->nInputFrames[VIDEOENC_INPUT_FIMC],
+                     pVideoEnc->nInputFrames[VIDEOENC_INPUT_COPY]);
+
+    SEC_OSAL_Memset(pVideoEnc->nInputFrames, 0, sizeof(pVideoEnc->nInputFrames));
+}
+
 OMX_BOOL SEC_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent)
 {
     OMX_BOOL               ret = OMX_FALSE;
@@ -761,6 +876,7 @@ OMX_BOOL SEC_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent)
 
                     width = pSECPort->portDefinition.format.video.nFrameWidth;
                     height = pSECPort->portDefinition.format.video.nFrameHeight;
+                    pVideoEnc->bDirectInput = OMX_FALSE;
 
                     SEC_OSAL_Log(SEC_LOG_TRACE, "pVideoEnc->MFCEncInputBuffer[%d].YVirAddr : 0x%x", pVideoEnc->indexInputBuffer, pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YVirAddr);
                     SEC_OSAL_Log(SEC_LOG_TRACE, "pVideoEnc->MFCEncInputBuffer[%d].CVirAddr : 0x%x", pVideoEnc->indexInputBuffer, pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].CVirAddr);
@@ -798,19 +914,8 @@ OMX_BOOL SEC_Preprocessor_InputData(OMX_COMPONENTTYPE *pOMXComponent)
                     }
 #ifdef USE_METADATABUFFERTYPE
                     else {
-                        if (pSECPort->portDefinition.format.video.eColorFormat == OMX_COLOR_FormatAndroidOpaque) {
-                            OMX_PTR ppBuf[3];
-                            OMX_PTR pOutBuffer;
-
-                            SEC_OSAL_GetInfoFromMetaData(inputData, ppBuf);
-                            SEC_OSAL_LockANBHandle((OMX_U32)ppBuf[0], width, height, OMX_COLOR_FormatAndroidOpaque, &pOutBuffer);
-
-                            csc_ARGB8888_to_YUV420SP_NEON(pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YVirAddr,
-                                                    pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].CVirAddr,
-                                                    pOutBuffer, width, height);
-
-                            SEC_OSAL_UnlockANBHandle((OMX_U32)ppBuf[0]);
-                        }
+                        if (pSECPort->portDefinition.format.video.eColorFormat == OMX_COLOR_FormatAndroidOpaque)
+                            SEC_Preprocessor_MetaDataInput(pOMXComponent, inputData, width, height);
                     }
 #endif
                 }
@@ -1542,6 +1647,21 @@ OMX_ERRORTYPE SEC_OMX_VideoEncodeGetConfig(
         }
     }
         break;
+    case OMX_IndexConfigVideoEncInputPath:
+    {
+        SEC_OMX_VIDEO_CONFIG_ENCINPUTPATH *pInputPath = (SEC_OMX_VIDEO_CONFIG_ENCINPUTPATH *)pComponentConfigStructure;
+        SEC_OMX_VIDEOENC_COMPONENT        *pVideoEnc = (SEC_OMX_VIDEOENC_COMPONENT *)pSECComponent->hComponentHandle;
+
+        if (pInputPath->nPortIndex != INPUT_PORT_INDEX) {
+            ret = OMX_ErrorBadPortIndex;
+            goto EXIT;
+        }
+
+        pInputPath->nCopyFrames = pVideoEnc->nInputFrames[VIDEOENC_INPUT_COPY];
+        pInputPath->nDirectFrames = pVideoEnc->nInputFrames[VIDEOENC_INPUT_DIRECT];
+        pInputPath->nFimcFrames = pVideoEnc->nInputFrames[VIDEOENC_INPUT_FIMC];
+    }
+        break;
     default:
         ret = SEC_OMX_SetConfig(hComponent, nIndex, pComponentConfigStructure);
         break;
@@ -1676,6 +1796,11 @@ OMX_ERRORTYPE SEC_OMX_VideoEncodeGetExtensionIndex(
         goto EXIT;
     }
 
+    if (SEC_OSAL_Strcmp(cParameterName, SEC_INDEX_CONFIG_VIDEO_ENC_INPUT_PATH) == 0) {
+        *pIndexType = (OMX_INDEXTYPE) OMX_IndexConfigVideoEncInputPath;
+        goto EXIT;
+    }
+
 #ifdef USE_STOREMETADATA
     if (SEC_OSAL_Strcmp(cParameterName, SEC_INDEX_PARAM_STORE_METADATA_BUFFER) == 0) {
         *pIndexType = (OMX_INDEXTYPE) OMX_IndexParamStoreMetaDataBuffer;
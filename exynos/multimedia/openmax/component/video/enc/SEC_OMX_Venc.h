@@ -62,6 +62,18 @@ typedef struct
     void *pAddrC;
 } MFC_ENC_ADDR_INFO;
 
+/* MFC takes frame addresses in 2KB units */
+#define MFC_ENC_INPUT_ADDR_ALIGN    2048
+
+/* how an input frame got into the MFC */
+typedef enum _SEC_VIDEOENC_INPUT_PATH
+{
+    VIDEOENC_INPUT_COPY = 0,    /* CPU copy/conversion into MFCEncInputBuffer */
+    VIDEOENC_INPUT_DIRECT,      /* MFC reads the client buffer */
+    VIDEOENC_INPUT_FIMC,        /* FIMC conversion into MFCEncInputBuffer */
+    VIDEOENC_INPUT_PATH_MAX
+} SEC_VIDEOENC_INPUT_PATH;
+
 typedef struct _SEC_MFC_NBENC_THREAD
 {
     OMX_HANDLETYPE  hNBEncodeThread;
@@ -96,6 +108,12 @@ typedef struct _SEC_OMX_VIDEOENC_COMPONENT
     OMX_BOOL bFirstFrame;
     MFC_ENC_INPUT_BUFFER MFCEncInputBuffer[MFC_INPUT_BUFFER_NUM_MAX];
     OMX_U32  indexInputBuffer;
+
+    /* metadata input */
+    OMX_PTR  hFIMCHandle;
+    OMX_BOOL bDirectInput;      /* the current frame is read from directInputAddr */
+    MFC_ENC_ADDR_INFO directInputAddr;
+    OMX_U32  nInputFrames[VIDEOENC_INPUT_PATH_MAX];
 } SEC_OMX_VIDEOENC_COMPONENT;
 
 #ifdef __cplusplus
@@ -156,6 +174,7 @@ OMX_ERRORTYPE SEC_OMX_VideoEncodeComponentInit(OMX_IN OMX_HANDLETYPE hComponent)
 OMX_ERRORTYPE SEC_OMX_VideoEncodeComponentDeinit(OMX_IN OMX_HANDLETYPE hComponent);
 OMX_BOOL SEC_Check_BufferProcess_State(SEC_OMX_BASECOMPONENT *pSECComponent);
 void SEC_UpdateFrameSize(OMX_COMPONENTTYPE *pOMXComponent);
+void SEC_VideoEncodeInputPathReport(SEC_OMX_VIDEOENC_COMPONENT *pVideoEnc);
 
 #ifdef __cplusplus
 }
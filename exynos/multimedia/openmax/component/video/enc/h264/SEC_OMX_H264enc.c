@@ -41,6 +41,10 @@
 #include "SsbSipMfcApi.h"
 #include "color_space_convertor.h"
 
+#ifdef USE_CSC_FIMC
+#include "csc_fimc.h"
+#endif
+
 #undef  SEC_LOG_TAG
 #define SEC_LOG_TAG    "SEC_H264_ENC"
 #define SEC_LOG_OFF
@@ -941,6 +945,11 @@ OMX_ERRORTYPE SEC_MFC_H264Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
     pVideoEnc->indexInputBuffer = 0;
 
     pVideoEnc->bFirstFrame = OMX_TRUE;
+    pVideoEnc->bDirectInput = OMX_FALSE;
+#ifdef USE_CSC_FIMC
+    if (pSECInputPort->portDefinition.format.video.eColorFormat == OMX_COLOR_FormatAndroidOpaque)
+        pVideoEnc->hFIMCHandle = csc_fimc_open();
+#endif
 
 #ifdef NONBLOCK_MODE_PROCESS
     pVideoEnc->NBEncThread.bExitEncodeThread = OMX_FALSE;
@@ -953,8 +962,8 @@ OMX_ERRORTYPE SEC_MFC_H264Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
         pH264Enc->hMFCH264Handle.returnCodec = MFC_RET_OK;
     }
 #endif
-    SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-    SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_TAG, OMX_FALSE);
     pH264Enc->hMFCH264Handle.indexTimestamp = 0;
 
 EXIT:
@@ -994,6 +1003,14 @@ OMX_ERRORTYPE SEC_MFC_H264Enc_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
     }
 #endif
 
+#ifdef USE_CSC_FIMC
+    if (pVideoEnc->hFIMCHandle != NULL) {
+        csc_fimc_close(pVideoEnc->hFIMCHandle);
+        pVideoEnc->hFIMCHandle = NULL;
+    }
+#endif
+    SEC_VideoEncodeInputPathReport(pVideoEnc);
+
     hMFCHandle = pH264Enc->hMFCH264Handle.hMFCHandle;
     if (hMFCHandle != NULL) {
         SsbSipMfcEncClose(hMFCHandle);
@@ -1102,6 +1119,11 @@ OMX_ERRORTYPE SEC_MFC_H264_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
             pInputInfo->CPhyAddr = addrInfo.pAddrC;
             break;
         default:
+            if (pVideoEnc->bDirectInput == OMX_TRUE) {
+                pInputInfo->YPhyAddr = pVideoEnc->directInputAddr.pAddrY;
+                pInputInfo->CPhyAddr = pVideoEnc->directInputAddr.pAddrC;
+                break;
+            }
             pInputInfo->YPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YPhyAddr;
             pInputInfo->CPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].CPhyAddr;
             pInputInfo->YVirAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YVirAddr;
@@ -1110,8 +1132,7 @@ OMX_ERRORTYPE SEC_MFC_H264_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
         }
     }
 
-    pSECComponent->timeStamp[pH264Enc->hMFCH264Handle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pH264Enc->hMFCH264Handle.indexTimestamp] = pInputData->nFlags;
+    pH264Enc->hMFCH264Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
 
     if ((pH264Enc->hMFCH264Handle.returnCodec == MFC_RET_OK) &&
         (pVideoEnc->bFirstFrame == OMX_FALSE)) {
@@ -1126,12 +1147,10 @@ OMX_ERRORTYPE SEC_MFC_H264_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
         SEC_OSAL_SleepMillisec(0);
         pH264Enc->hMFCH264Handle.returnCodec = SsbSipMfcEncGetOutBuf(pH264Enc->hMFCH264Handle.hMFCHandle, &outputInfo);
         if ((SsbSipMfcEncGetConfig(pH264Enc->hMFCH264Handle.hMFCHandle, MFC_ENC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))){
+            (SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp, OMX_FALSE,
+                                   &pOutputData->timeStamp, &pOutputData->nFlags) != OMX_TRUE)) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
         }
 
         if (pH264Enc->hMFCH264Handle.returnCodec == MFC_RET_OK) {
@@ -1196,8 +1215,12 @@ OMX_ERRORTYPE SEC_MFC_H264_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SEC
     /* mfc encode start */
     SEC_OSAL_SemaphorePost(pVideoEnc->NBEncThread.hEncFrameStart);
     pVideoEnc->NBEncThread.bEncoderRun = OMX_TRUE;
-    pH264Enc->hMFCH264Handle.indexTimestamp++;
-    pH264Enc->hMFCH264Handle.indexTimestamp %= MAX_TIMESTAMP;
+    if (pVideoEnc->bDirectInput == OMX_TRUE) {
+        /* the client gets its buffer back on return, so the MFC must be done with it */
+        SEC_OSAL_SemaphoreWait(pVideoEnc->NBEncThread.hEncFrameEnd);
+        pVideoEnc->NBEncThread.bEncoderRun = OMX_FALSE;
+    }
+    SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
     pVideoEnc->bFirstFrame = OMX_FALSE;
     SEC_OSAL_SleepMillisec(0);
 
@@ -1297,6 +1320,11 @@ OMX_ERRORTYPE SEC_MFC_H264_Encode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
         pInputInfo->CPhyAddr = addrInfo.pAddrC;
         break;
     default:
+        if (pVideoEnc->bDirectInput == OMX_TRUE) {
+            pInputInfo->YPhyAddr = pVideoEnc->directInputAddr.pAddrY;
+            pInputInfo->CPhyAddr = pVideoEnc->directInputAddr.pAddrC;
+            break;
+        }
         pInputInfo->YPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YPhyAddr;
         pInputInfo->CPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].CPhyAddr;
         pInputInfo->YVirAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YVirAddr;
@@ -1319,25 +1347,21 @@ OMX_ERRORTYPE SEC_MFC_H264_Encode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_OM
         pVideoEnc->configChange = OMX_FALSE;
     }
 
-    pSECComponent->timeStamp[pH264Enc->hMFCH264Handle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pH264Enc->hMFCH264Handle.indexTimestamp] = pInputData->nFlags;
+    pH264Enc->hMFCH264Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
     SsbSipMfcEncSetConfig(pH264Enc->hMFCH264Handle.hMFCHandle, MFC_ENC_SETCONF_FRAME_TAG, &(pH264Enc->hMFCH264Handle.indexTimestamp));
 
     returnCodec = SsbSipMfcEncExe(pH264Enc->hMFCH264Handle.hMFCHandle);
     if (returnCodec == MFC_RET_OK) {
         OMX_S32 indexTimestamp = 0;
 
-        pH264Enc->hMFCH264Handle.indexTimestamp++;
-        pH264Enc->hMFCH264Handle.indexTimestamp %= MAX_TIMESTAMP;
+        SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
 
         returnCodec = SsbSipMfcEncGetOutBuf(pH264Enc->hMFCH264Handle.hMFCHandle, &outputInfo);
         if ((SsbSipMfcEncGetConfig(pH264Enc->hMFCH264Handle.hMFCHandle, MFC_ENC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))){
+            (SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp, OMX_FALSE,
+                                   &pOutputData->timeStamp, &pOutputData->nFlags) != OMX_TRUE)) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
         }
 
         if (returnCodec == MFC_RET_OK) {
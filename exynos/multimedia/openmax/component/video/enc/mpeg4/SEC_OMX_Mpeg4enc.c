@@ -42,6 +42,10 @@
 #include "SsbSipMfcApi.h"
 #include "color_space_convertor.h"
 
+#ifdef USE_CSC_FIMC
+#include "csc_fimc.h"
+#endif
+
 #undef  SEC_LOG_TAG
 #define SEC_LOG_TAG    "SEC_MPEG4_ENC"
 #define SEC_LOG_OFF
@@ -1123,6 +1127,11 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
     pVideoEnc->indexInputBuffer = 0;
 
     pVideoEnc->bFirstFrame = OMX_TRUE;
+    pVideoEnc->bDirectInput = OMX_FALSE;
+#ifdef USE_CSC_FIMC
+    if (pSECInputPort->portDefinition.format.video.eColorFormat == OMX_COLOR_FormatAndroidOpaque)
+        pVideoEnc->hFIMCHandle = csc_fimc_open();
+#endif
 
 #ifdef NONBLOCK_MODE_PROCESS
     pVideoEnc->NBEncThread.bExitEncodeThread = OMX_FALSE;
@@ -1135,8 +1144,8 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4Enc_Init(OMX_COMPONENTTYPE *pOMXComponent)
         pMpeg4Enc->hMFCMpeg4Handle.returnCodec = MFC_RET_OK;
     }
 #endif
-    SEC_OSAL_Memset(pSECComponent->timeStamp, -19771003, sizeof(OMX_TICKS) * MAX_TIMESTAMP);
-    SEC_OSAL_Memset(pSECComponent->nFlags, 0, sizeof(OMX_U32) * MAX_FLAGS);
+    SEC_OMX_Timestamp_Init(&pSECComponent->timestampQueue, SEC_TIMESTAMP_DEFAULT_DEPTH,
+                           SEC_TIMESTAMP_ORDER_TAG, OMX_FALSE);
     pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp = 0;
 
 EXIT:
@@ -1176,6 +1185,14 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4Enc_Terminate(OMX_COMPONENTTYPE *pOMXComponent)
     }
 #endif
 
+#ifdef USE_CSC_FIMC
+    if (pVideoEnc->hFIMCHandle != NULL) {
+        csc_fimc_close(pVideoEnc->hFIMCHandle);
+        pVideoEnc->hFIMCHandle = NULL;
+    }
+#endif
+    SEC_VideoEncodeInputPathReport(pVideoEnc);
+
     hMFCHandle = pMpeg4Enc->hMFCMpeg4Handle.hMFCHandle;
     if (hMFCHandle != NULL) {
         SsbSipMfcEncClose(hMFCHandle);
@@ -1272,6 +1289,11 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
             pInputInfo->CPhyAddr = addrInfo.pAddrC;
             break;
         default:
+            if (pVideoEnc->bDirectInput == OMX_TRUE) {
+                pInputInfo->YPhyAddr = pVideoEnc->directInputAddr.pAddrY;
+                pInputInfo->CPhyAddr = pVideoEnc->directInputAddr.pAddrC;
+                break;
+            }
             pInputInfo->YPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YPhyAddr;
             pInputInfo->CPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].CPhyAddr;
             pInputInfo->YVirAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YVirAddr;
@@ -1280,8 +1302,7 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
         }
     }
 
-    pSECComponent->timeStamp[pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp] = pInputData->nFlags;
+    pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
 
     if ((pMpeg4Enc->hMFCMpeg4Handle.returnCodec == MFC_RET_OK) &&
         (pVideoEnc->bFirstFrame == OMX_FALSE)) {
@@ -1296,12 +1317,10 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
         SEC_OSAL_SleepMillisec(0);
         pMpeg4Enc->hMFCMpeg4Handle.returnCodec = SsbSipMfcEncGetOutBuf(pMpeg4Enc->hMFCMpeg4Handle.hMFCHandle, &outputInfo);
         if ((SsbSipMfcEncGetConfig(pMpeg4Enc->hMFCMpeg4Handle.hMFCHandle, MFC_ENC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))){
+            (SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp, OMX_FALSE,
+                                   &pOutputData->timeStamp, &pOutputData->nFlags) != OMX_TRUE)) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
         }
 
         if (pMpeg4Enc->hMFCMpeg4Handle.returnCodec == MFC_RET_OK) {
@@ -1369,8 +1388,12 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Encode_Nonblock(OMX_COMPONENTTYPE *pOMXComponent, SE
     /* mfc encode start */
     SEC_OSAL_SemaphorePost(pVideoEnc->NBEncThread.hEncFrameStart);
     pVideoEnc->NBEncThread.bEncoderRun = OMX_TRUE;
-    pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp++;
-    pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp %= MAX_TIMESTAMP;
+    if (pVideoEnc->bDirectInput == OMX_TRUE) {
+        /* the client gets its buffer back on return, so the MFC must be done with it */
+        SEC_OSAL_SemaphoreWait(pVideoEnc->NBEncThread.hEncFrameEnd);
+        pVideoEnc->NBEncThread.bEncoderRun = OMX_FALSE;
+    }
+    SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
     pVideoEnc->bFirstFrame = OMX_FALSE;
     SEC_OSAL_SleepMillisec(0);
 
@@ -1457,6 +1480,11 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Encode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
         pInputInfo->CPhyAddr = addrInfo.pAddrC;
         break;
     default:
+        if (pVideoEnc->bDirectInput == OMX_TRUE) {
+            pInputInfo->YPhyAddr = pVideoEnc->directInputAddr.pAddrY;
+            pInputInfo->CPhyAddr = pVideoEnc->directInputAddr.pAddrC;
+            break;
+        }
         pInputInfo->YPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YPhyAddr;
         pInputInfo->CPhyAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].CPhyAddr;
         pInputInfo->YVirAddr = pVideoEnc->MFCEncInputBuffer[pVideoEnc->indexInputBuffer].YVirAddr;
@@ -1482,26 +1510,22 @@ OMX_ERRORTYPE SEC_MFC_Mpeg4_Encode_Block(OMX_COMPONENTTYPE *pOMXComponent, SEC_O
         pVideoEnc->configChange = OMX_FALSE;
     }
 
-    pSECComponent->timeStamp[pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp] = pInputData->timeStamp;
-    pSECComponent->nFlags[pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp] = pInputData->nFlags;
+    pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp = SEC_OMX_Timestamp_Put(&pSECComponent->timestampQueue, pInputData->timeStamp, pInputData->nFlags);
     SsbSipMfcEncSetConfig(hMFCHandle, MFC_ENC_SETCONF_FRAME_TAG, &(pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp));
 
     returnCodec = SsbSipMfcEncExe(hMFCHandle);
     if (returnCodec == MFC_RET_OK) {
         OMX_S32 indexTimestamp = 0;
 
-        pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp++;
-        pMpeg4Enc->hMFCMpeg4Handle.indexTimestamp %= MAX_TIMESTAMP;
+        SEC_OMX_Timestamp_Commit(&pSECComponent->timestampQueue);
 
         returnCodec = SsbSipMfcEncGetOutBuf(hMFCHandle, &outputInfo);
 
         if ((SsbSipMfcEncGetConfig(hMFCHandle, MFC_ENC_GETCONF_FRAME_TAG, &indexTimestamp) != MFC_RET_OK) ||
-            (((indexTimestamp < 0) || (indexTimestamp >= MAX_TIMESTAMP)))) {
+            (SEC_OMX_Timestamp_Get(&pSECComponent->timestampQueue, indexTimestamp, OMX_FALSE,
+                                   &pOutputData->timeStamp, &pOutputData->nFlags) != OMX_TRUE)) {
             pOutputData->timeStamp = pInputData->timeStamp;
             pOutputData->nFlags = pInputData->nFlags;
-        } else {
-            pOutputData->timeStamp = pSECComponent->timeStamp[indexTimestamp];
-            pOutputData->nFlags = pSECComponent->nFlags[indexTimestamp];
         }
 
         if (returnCodec == MFC_RET_OK) {
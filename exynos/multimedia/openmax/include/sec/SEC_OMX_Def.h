@@ -43,9 +43,6 @@
 #define MAX_OMX_COMPONENT_LIBNAME_SIZE     OMX_MAX_STRINGNAME_SIZE * 2
 #define MAX_OMX_MIMETYPE_SIZE              OMX_MAX_STRINGNAME_SIZE
 
-#define MAX_TIMESTAMP        17
-#define MAX_FLAGS            17
-
 #define SEC_OMX_INSTALL_PATH "/system/lib/omx/"
 
 typedef enum _SEC_CODEC_TYPE
@@ -64,12 +61,25 @@ typedef struct _SEC_OMX_PRIORITYMGMTTYPE
     OMX_U32 nGroupID;
 } SEC_OMX_PRIORITYMGMTTYPE;
 
+/* frames of the current encode session per input path, OMX_IndexConfigVideoEncInputPath */
+typedef struct _SEC_OMX_VIDEO_CONFIG_ENCINPUTPATH
+{
+    OMX_U32         nSize;
+    OMX_VERSIONTYPE nVersion;
+    OMX_U32         nPortIndex;
+    OMX_U32         nCopyFrames;    /* copied or converted by the CPU */
+    OMX_U32         nDirectFrames;  /* read by the MFC from the client buffer */
+    OMX_U32         nFimcFrames;    /* converted by FIMC */
+} SEC_OMX_VIDEO_CONFIG_ENCINPUTPATH;
+
 typedef enum _SEC_OMX_INDEXTYPE
 {
 #define SEC_INDEX_PARAM_ENABLE_THUMBNAIL "OMX.SEC.index.ThumbnailMode"
     OMX_IndexVendorThumbnailMode        = 0x7F000001,
 #define SEC_INDEX_CONFIG_VIDEO_INTRAPERIOD "OMX.SEC.index.VideoIntraPeriod"
     OMX_IndexConfigVideoIntraPeriod     = 0x7F000002,
+#define SEC_INDEX_CONFIG_VIDEO_ENC_INPUT_PATH "OMX.SEC.index.VideoEncInputPath"
+    OMX_IndexConfigVideoEncInputPath    = 0x7F000003,
 
     /* for Android Native Window */
 #define SEC_INDEX_PARAM_ENABLE_ANB "OMX.google.android.index.enableAndroidNativeBuffers"
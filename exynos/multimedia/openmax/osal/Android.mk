@@ -42,6 +42,30 @@ LOCAL_C_INCLUDES := $(SEC_OMX_INC)/khronos \
 	$(SEC_OMX_INC)/sec \
 	$(SEC_OMX_TOP)/osal \
 	$(SEC_OMX_COMPONENT)/common \
-	$(SEC_OMX_COMPONENT)/video/dec
+	$(SEC_OMX_COMPONENT)/video/dec \
+	$(TOP)/$(TARGET_HAL_PATH)/include
 
 include $(BUILD_STATIC_LIBRARY)
+
+# SEC_OSAL_Queue against the mutex guarded queue it replaced, on the host
+include $(CLEAR_VARS)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	SEC_OSAL_Queue.c \
+	SEC_OSAL_Memory.c \
+	SEC_OSAL_Queue_Bench.c
+
+LOCAL_MODULE := SEC_OSAL_Queue_Bench
+
+LOCAL_CFLAGS := -O2
+
+LOCAL_C_INCLUDES := $(SEC_OMX_INC)/khronos \
+	$(SEC_OMX_INC)/sec \
+	$(SEC_OMX_TOP)/osal
+
+LOCAL_STATIC_LIBRARIES := libcutils
+LOCAL_LDLIBS += -lpthread
+
+include $(BUILD_HOST_EXECUTABLE)
@@ -37,6 +37,9 @@
 #include <hardware/hardware.h>
 #include <media/hardware/MetadataBufferType.h>
 
+#include "gralloc_priv.h"
+#include "sec_format.h"
+
 #include "SEC_OSAL_Semaphore.h"
 #include "SEC_OMX_Baseport.h"
 #include "SEC_OMX_Basecomponent.h"
@@ -211,18 +214,67 @@ OMX_ERRORTYPE SEC_OSAL_GetPhysANBHandle(
     FunctionIn();
 
     OMX_ERRORTYPE ret = OMX_ErrorNone;
-    GraphicBufferMapper &mapper = GraphicBufferMapper::get();
-    buffer_handle_t bufferHandle = (buffer_handle_t) handle;
+    private_handle_t *hnd = private_handle_t::dynamicCast((buffer_handle_t) handle);
 
     SEC_OSAL_Log(SEC_LOG_TRACE, "%s: handle: 0x%x", __func__, handle);
 
-/*
-    if (mapper.getphys(bufferHandle, paddr) != 0) {
-        SEC_OSAL_Log(SEC_LOG_ERROR, "%s: mapper.getphys() fail", __func__);
+    paddr[0] = NULL;
+    paddr[1] = NULL;
+    paddr[2] = NULL;
+
+    /* gralloc has no getphys hook, read the handle like hwcomposer does */
+    if ((hnd == NULL) || (hnd->paddr == 0)) {
+        SEC_OSAL_Log(SEC_LOG_TRACE, "%s: buffer is not physically contiguous", __func__);
         ret = OMX_ErrorUndefined;
         goto EXIT;
     }
-*/
+
+    paddr[0] = (OMX_PTR)(hnd->paddr + hnd->offset);
+    paddr[1] = (OMX_PTR)(hnd->paddr + hnd->offset + hnd->uoffset);
+    paddr[2] = (OMX_PTR)(hnd->paddr + hnd->offset + hnd->uoffset + hnd->voffset);
+
+EXIT:
+    FunctionOut();
+
+    return ret;
+}
+
+OMX_ERRORTYPE SEC_OSAL_GetANBHandleFormat(
+    OMX_IN OMX_U32 handle,
+    OMX_OUT OMX_COLOR_FORMATTYPE *pFormat,
+    OMX_OUT OMX_U32 *pStride)
+{
+    FunctionIn();
+
+    OMX_ERRORTYPE ret = OMX_ErrorNone;
+    private_handle_t *hnd = private_handle_t::dynamicCast((buffer_handle_t) handle);
+
+    if (hnd == NULL) {
+        ret = OMX_ErrorBadParameter;
+        goto EXIT;
+    }
+
+    switch (hnd->format) {
+    case HAL_PIXEL_FORMAT_YCbCr_420_SP:
+    case HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP:
+        *pFormat = OMX_COLOR_FormatYUV420SemiPlanar;
+        break;
+    case HAL_PIXEL_FORMAT_RGBA_8888:
+    case HAL_PIXEL_FORMAT_RGBX_8888:
+        /* the byte order csc_ARGB8888_to_YUV420SP expects */
+        *pFormat = OMX_COLOR_Format32bitARGB8888;
+        break;
+    case HAL_PIXEL_FORMAT_BGRA_8888:
+        *pFormat = OMX_COLOR_Format32bitBGRA8888;
+        break;
+    default:
+        SEC_OSAL_Log(SEC_LOG_TRACE, "%s: unsupported format 0x%x", __func__, hnd->format);
+        ret = OMX_ErrorUnsupportedSetting;
+        goto EXIT;
+    }
+
+    *pStride = hnd->stride;
+
 EXIT:
     FunctionOut();
 
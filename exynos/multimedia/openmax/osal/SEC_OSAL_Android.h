@@ -68,6 +68,10 @@ OMX_ERRORTYPE SEC_OSAL_UnlockANBHandle(OMX_IN OMX_U32 pBuffer);
 OMX_ERRORTYPE SEC_OSAL_GetPhysANBHandle(OMX_IN OMX_U32 pBuffer,
                                         OMX_OUT OMX_PTR *paddr);
 
+OMX_ERRORTYPE SEC_OSAL_GetANBHandleFormat(OMX_IN OMX_U32 pBuffer,
+                                          OMX_OUT OMX_COLOR_FORMATTYPE *pFormat,
+                                          OMX_OUT OMX_U32 *pStride);
+
 OMX_ERRORTYPE SEC_OSAL_GetInfoFromMetaData(OMX_IN SEC_OMX_DATA *pBuffer,
                                            OMX_OUT OMX_PTR *pOutBuffer);
 
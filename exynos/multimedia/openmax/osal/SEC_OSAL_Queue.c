@@ -22,153 +22,184 @@
  * @version     1.1.0
  * @history
  *   2010.7.15 : Create
+ *   Replace the mutex guarded linked ring with a lock-free bounded ring
  */
 
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <cutils/atomic.h>
 
 #include "SEC_OSAL_Memory.h"
-#include "SEC_OSAL_Mutex.h"
 #include "SEC_OSAL_Queue.h"
 
 
-OMX_ERRORTYPE SEC_OSAL_QueueCreate(SEC_QUEUE *queueHandle)
+static int32_t SEC_OSAL_QueueRoundDepth(int depth)
 {
-    int i = 0;
-    SEC_QElem *newqelem = NULL;
-    SEC_QElem *currentqelem = NULL;
-    SEC_QUEUE *queue = (SEC_QUEUE *)queueHandle;
+    int32_t size = 2;
 
-    OMX_ERRORTYPE ret = OMX_ErrorNone;
+    while (size < depth)
+        size <<= 1;
 
-    if (!queue)
+    return size;
+}
+
+OMX_ERRORTYPE SEC_OSAL_QueueCreateDepth(SEC_QUEUE *queueHandle, int depth)
+{
+    int32_t i = 0;
+    int32_t size = 0;
+    SEC_QUEUE *queue = (SEC_QUEUE *)queueHandle;
+
+    if ((!queue) || (depth <= 0))
         return OMX_ErrorBadParameter;
 
-    ret = SEC_OSAL_MutexCreate(&queue->qMutex);
-    if (ret != OMX_ErrorNone)
-        return ret;
+    size = SEC_OSAL_QueueRoundDepth(depth);
 
-    queue->first = (SEC_QElem *)SEC_OSAL_Malloc(sizeof(SEC_QElem));
-    if (queue->first == NULL)
+    queue->elem = (SEC_QElem *)SEC_OSAL_Malloc(sizeof(SEC_QElem) * size);
+    if (queue->elem == NULL)
         return OMX_ErrorInsufficientResources;
 
-    SEC_OSAL_Memset(queue->first, 0, sizeof(SEC_QElem));
-    currentqelem = queue->last = queue->first;
-    queue->numElem = 0;
-
-    for (i = 0; i < (MAX_QUEUE_ELEMENTS - 2); i++) {
-        newqelem = (SEC_QElem *)SEC_OSAL_Malloc(sizeof(SEC_QElem));
-        if (newqelem == NULL) {
-            while (queue->first != NULL) {
-                currentqelem = queue->first->qNext;
-                SEC_OSAL_Free((OMX_PTR)queue->first);
-                queue->first = currentqelem;
-            }
-            return OMX_ErrorInsufficientResources;
-        } else {
-            SEC_OSAL_Memset(newqelem, 0, sizeof(SEC_QElem));
-            currentqelem->qNext = newqelem;
-            currentqelem = newqelem;
-        }
+    for (i = 0; i < size; i++) {
+        queue->elem[i].seq = i;
+        queue->elem[i].data = NULL;
     }
 
-    currentqelem->qNext = queue->first;
+    queue->mask = size - 1;
+    queue->head = 0;
+    queue->tail = 0;
 
     return OMX_ErrorNone;
 }
 
+OMX_ERRORTYPE SEC_OSAL_QueueCreate(SEC_QUEUE *queueHandle)
+{
+    return SEC_OSAL_QueueCreateDepth(queueHandle, MAX_QUEUE_ELEMENTS);
+}
+
 OMX_ERRORTYPE SEC_OSAL_QueueTerminate(SEC_QUEUE *queueHandle)
 {
-    int i = 0;
-    SEC_QElem *currentqelem = NULL;
     SEC_QUEUE *queue = (SEC_QUEUE *)queueHandle;
-    OMX_ERRORTYPE ret = OMX_ErrorNone;
 
     if (!queue)
         return OMX_ErrorBadParameter;
 
-    for ( i = 0; i < (MAX_QUEUE_ELEMENTS - 2); i++) {
-        currentqelem = queue->first->qNext;
-        SEC_OSAL_Free(queue->first);
-        queue->first = currentqelem;
-    }
-
-    if(queue->first) {
-        SEC_OSAL_Free(queue->first);
-        queue->first = NULL;
+    if (queue->elem) {
+        SEC_OSAL_Free(queue->elem);
+        queue->elem = NULL;
     }
+    queue->mask = 0;
+    queue->head = 0;
+    queue->tail = 0;
 
-    ret = SEC_OSAL_MutexTerminate(queue->qMutex);
-
-    return ret;
+    return OMX_ErrorNone;
 }
 
+/*
+ * The OMX data path has one producer (Empty/FillThisBuffer) and one consumer
+ * (the buffer process thread), but the flush and port-disable paths also
+ * touch the queue from the message handler thread. Slots are therefore
+ * claimed with a compare-and-swap on head/tail, which is uncontended in the
+ * common single-producer/single-consumer case.
+ */
 int SEC_OSAL_Queue(SEC_QUEUE *queueHandle, void *data)
 {
     SEC_QUEUE *queue = (SEC_QUEUE *)queueHandle;
-    if (queue == NULL)
-        return -1;
-
-    SEC_OSAL_MutexLock(queue->qMutex);
+    SEC_QElem *elem = NULL;
+    int32_t    pos = 0;
+    int32_t    diff = 0;
 
-    if ((queue->last->data != NULL) || (queue->numElem >= MAX_QUEUE_ELEMENTS)) {
-        SEC_OSAL_MutexUnlock(queue->qMutex);
+    if ((queue == NULL) || (queue->elem == NULL) || (data == NULL))
         return -1;
+
+    pos = android_atomic_acquire_load(&queue->tail);
+    for (;;) {
+        elem = &queue->elem[pos & queue->mask];
+        diff = (int32_t)((uint32_t)android_atomic_acquire_load(&elem->seq) - (uint32_t)pos);
+        if (diff == 0) {
+            if (android_atomic_acquire_cas(pos, pos + 1, &queue->tail) == 0)
+                break;
+            pos = android_atomic_acquire_load(&queue->tail);
+        } else if (diff < 0) {
+            return -1;
+        } else {
+            pos = android_atomic_acquire_load(&queue->tail);
+        }
     }
-    queue->last->data = data;
-    queue->last = queue->last->qNext;
-    queue->numElem++;
 
-    SEC_OSAL_MutexUnlock(queue->qMutex);
+    elem->data = data;
+    android_atomic_release_store(pos + 1, &elem->seq);
+
     return 0;
 }
 
 void *SEC_OSAL_Dequeue(SEC_QUEUE *queueHandle)
 {
-    void *data = NULL;
+    void      *data = NULL;
     SEC_QUEUE *queue = (SEC_QUEUE *)queueHandle;
-    if (queue == NULL)
-        return NULL;
-
-    SEC_OSAL_MutexLock(queue->qMutex);
+    SEC_QElem *elem = NULL;
+    int32_t    pos = 0;
+    int32_t    diff = 0;
 
-    if ((queue->first->data == NULL) || (queue->numElem <= 0)) {
-        SEC_OSAL_MutexUnlock(queue->qMutex);
+    if ((queue == NULL) || (queue->elem == NULL))
         return NULL;
+
+    pos = android_atomic_acquire_load(&queue->head);
+    for (;;) {
+        elem = &queue->elem[pos & queue->mask];
+        diff = (int32_t)((uint32_t)android_atomic_acquire_load(&elem->seq) - (uint32_t)(pos + 1));
+        if (diff == 0) {
+            if (android_atomic_acquire_cas(pos, pos + 1, &queue->head) == 0)
+                break;
+            pos = android_atomic_acquire_load(&queue->head);
+        } else if (diff < 0) {
+            return NULL;
+        } else {
+            pos = android_atomic_acquire_load(&queue->head);
+        }
     }
-    data = queue->first->data;
-    queue->first->data = NULL;
-    queue->first = queue->first->qNext;
-    queue->numElem--;
 
-    SEC_OSAL_MutexUnlock(queue->qMutex);
+    data = elem->data;
+    elem->data = NULL;
+    android_atomic_release_store(pos + queue->mask + 1, &elem->seq);
+
     return data;
 }
 
 int SEC_OSAL_GetElemNum(SEC_QUEUE *queueHandle)
 {
-    int ElemNum = 0;
+    int32_t    head = 0;
+    int32_t    tail = 0;
+    int32_t    num = 0;
     SEC_QUEUE *queue = (SEC_QUEUE *)queueHandle;
-    if (queue == NULL)
+
+    if ((queue == NULL) || (queue->elem == NULL))
         return -1;
 
-    SEC_OSAL_MutexLock(queue->qMutex);
-    ElemNum = queue->numElem;
-    SEC_OSAL_MutexUnlock(queue->qMutex);
-    return ElemNum;
+    head = android_atomic_acquire_load(&queue->head);
+    tail = android_atomic_acquire_load(&queue->tail);
+    num = (int32_t)((uint32_t)tail - (uint32_t)head);
+
+    if (num < 0)
+        num = 0;
+    if (num > queue->mask + 1)
+        num = queue->mask + 1;
+
+    return num;
 }
 
+/*
+ * The element count is derived from head/tail, so it can not be set
+ * without adding or dropping entries, and entries here are owned by the
+ * caller (messages and buffer headers). The queue is left as it is and the
+ * real count is returned; callers drain it with SEC_OSAL_Dequeue.
+ */
 int SEC_OSAL_SetElemNum(SEC_QUEUE *queueHandle, int ElemNum)
 {
     SEC_QUEUE *queue = (SEC_QUEUE *)queueHandle;
-    if (queue == NULL)
+
+    if ((queue == NULL) || (queue->elem == NULL) || (ElemNum < 0))
         return -1;
 
-    SEC_OSAL_MutexLock(queue->qMutex);
-    queue->numElem = ElemNum; 
-    SEC_OSAL_MutexUnlock(queue->qMutex);
-    return ElemNum;
+    return SEC_OSAL_GetElemNum(queue);
 }
-
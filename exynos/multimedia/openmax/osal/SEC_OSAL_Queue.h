@@ -27,24 +27,37 @@
 #ifndef SEC_OSAL_QUEUE
 #define SEC_OSAL_QUEUE
 
+#include <stdint.h>
+
 #include "OMX_Types.h"
 #include "OMX_Core.h"
 
 
 #define MAX_QUEUE_ELEMENTS    10
+#define QUEUE_CACHE_LINE_SIZE 64
 
+/*
+ * Each slot carries a sequence number so that producer and consumer can
+ * claim it with a single atomic operation instead of a mutex.
+ */
 typedef struct _SEC_QElem
 {
+    volatile int32_t  seq;
     void             *data;
-    struct _SEC_QElem *qNext;
 } SEC_QElem;
 
+/*
+ * Bounded ring of power-of-two depth. head (consumer side) and tail
+ * (producer side) are kept on separate cache lines.
+ */
 typedef struct _SEC_QUEUE
 {
-    SEC_QElem     *first;
-    SEC_QElem     *last;
-    int            numElem;
-    OMX_HANDLETYPE qMutex;
+    volatile int32_t head;
+    char             padHead[QUEUE_CACHE_LINE_SIZE - sizeof(int32_t)];
+    volatile int32_t tail;
+    char             padTail[QUEUE_CACHE_LINE_SIZE - sizeof(int32_t)];
+    SEC_QElem       *elem;
+    int32_t          mask;
 } SEC_QUEUE;
 
 
@@ -53,6 +66,7 @@ extern "C" {
 #endif
 
 OMX_ERRORTYPE SEC_OSAL_QueueCreate(SEC_QUEUE *queueHandle);
+OMX_ERRORTYPE SEC_OSAL_QueueCreateDepth(SEC_QUEUE *queueHandle, int depth);
 OMX_ERRORTYPE SEC_OSAL_QueueTerminate(SEC_QUEUE *queueHandle);
 int           SEC_OSAL_Queue(SEC_QUEUE *queueHandle, void *data);
 void         *SEC_OSAL_Dequeue(SEC_QUEUE *queueHandle);
@@ -0,0 +1,297 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file       SEC_OSAL_Queue_Bench.c
+ * @brief      Host benchmark of SEC_OSAL_Queue against the mutex guarded
+ *             linked ring it replaced: ops/s and enqueue/dequeue call
+ *             latency percentiles, on one thread and with a producer and
+ *             a consumer thread as in the OMX buffer path.
+ *             Usage: SEC_OSAL_Queue_Bench [operations]
+ * @version    1.0
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "SEC_OSAL_Queue.h"
+#include "SEC_OSAL_Log.h"
+
+#define BENCH_DEPTH     10
+#define BENCH_OPS       2000000
+
+/* SEC_OSAL_Memory.c logs through this */
+void _SEC_OSAL_Log(SEC_LOG_LEVEL logLevel, const char *tag, const char *msg, ...)
+{
+    va_list argptr;
+
+    va_start(argptr, msg);
+    fprintf(stderr, "%s: ", tag);
+    vfprintf(stderr, msg, argptr);
+    fprintf(stderr, "\n");
+    va_end(argptr);
+}
+
+/* SEC_OSAL_Queue.c before the ring: a linked ring under one mutex */
+typedef struct _REF_QElem
+{
+    void              *data;
+    struct _REF_QElem *qNext;
+} REF_QElem;
+
+typedef struct _REF_QUEUE
+{
+    REF_QElem       *first;
+    REF_QElem       *last;
+    int              numElem;
+    pthread_mutex_t  qMutex;
+} REF_QUEUE;
+
+static int ref_create(REF_QUEUE *queue)
+{
+    REF_QElem *elem = NULL;
+    int i;
+
+    pthread_mutex_init(&queue->qMutex, NULL);
+    queue->first = (REF_QElem *)calloc(1, sizeof(REF_QElem));
+    if (queue->first == NULL)
+        return -1;
+    elem = queue->last = queue->first;
+    queue->numElem = 0;
+
+    for (i = 0; i < (MAX_QUEUE_ELEMENTS - 2); i++) {
+        elem->qNext = (REF_QElem *)calloc(1, sizeof(REF_QElem));
+        if (elem->qNext == NULL)
+            return -1;
+        elem = elem->qNext;
+    }
+    elem->qNext = queue->first;
+
+    return 0;
+}
+
+static void ref_terminate(REF_QUEUE *queue)
+{
+    REF_QElem *elem = queue->first->qNext;
+
+    while (elem != queue->first) {
+        REF_QElem *next = elem->qNext;
+        free(elem);
+        elem = next;
+    }
+    free(queue->first);
+    pthread_mutex_destroy(&queue->qMutex);
+}
+
+static int ref_queue(REF_QUEUE *queue, void *data)
+{
+    pthread_mutex_lock(&queue->qMutex);
+    if ((queue->last->data != NULL) || (queue->numElem >= MAX_QUEUE_ELEMENTS)) {
+        pthread_mutex_unlock(&queue->qMutex);
+        return -1;
+    }
+    queue->last->data = data;
+    queue->last = queue->last->qNext;
+    queue->numElem++;
+    pthread_mutex_unlock(&queue->qMutex);
+    return 0;
+}
+
+static void *ref_dequeue(REF_QUEUE *queue)
+{
+    void *data = NULL;
+
+    pthread_mutex_lock(&queue->qMutex);
+    if ((queue->first->data == NULL) || (queue->numElem <= 0)) {
+        pthread_mutex_unlock(&queue->qMutex);
+        return NULL;
+    }
+    data = queue->first->data;
+    queue->first->data = NULL;
+    queue->first = queue->first->qNext;
+    queue->numElem--;
+    pthread_mutex_unlock(&queue->qMutex);
+    return data;
+}
+
+typedef struct _BENCH_QUEUE_OPS
+{
+    const char *name;
+    int       (*put)(void *queue, void *data);
+    void     *(*get)(void *queue);
+} BENCH_QUEUE_OPS;
+
+static int ring_put(void *queue, void *data) { return SEC_OSAL_Queue((SEC_QUEUE *)queue, data); }
+static void *ring_get(void *queue) { return SEC_OSAL_Dequeue((SEC_QUEUE *)queue); }
+static int mutex_put(void *queue, void *data) { return ref_queue((REF_QUEUE *)queue, data); }
+static void *mutex_get(void *queue) { return ref_dequeue((REF_QUEUE *)queue); }
+
+static const BENCH_QUEUE_OPS ring_ops = { "ring", ring_put, ring_get };
+static const BENCH_QUEUE_OPS mutex_ops = { "mutex", mutex_put, mutex_get };
+
+typedef struct _BENCH_THREAD
+{
+    const BENCH_QUEUE_OPS *ops;
+    void                  *queue;
+    int                    count;
+    unsigned int          *lat;     /* ns per successful call */
+    int                    errors;
+} BENCH_THREAD;
+
+static inline unsigned long long now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static int cmp_uint(const void *a, const void *b)
+{
+    unsigned int x = *(const unsigned int *)a, y = *(const unsigned int *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void report_latency(const char *what, unsigned int *lat, int count)
+{
+    qsort(lat, count, sizeof(lat[0]), cmp_uint);
+    printf("    %-8s p50 %5u ns  p99 %6u ns  p99.9 %7u ns  max %8u ns\n", what,
+           lat[count / 2], lat[(long long)count * 99 / 100],
+           lat[(long long)count * 999 / 1000], lat[count - 1]);
+}
+
+static void *producer(void *arg)
+{
+    BENCH_THREAD *t = (BENCH_THREAD *)arg;
+    int i;
+
+    for (i = 0; i < t->count; i++) {
+        unsigned long long t0;
+        /* never NULL: the queue rejects it */
+        void *data = (void *)(long)(i + 1);
+
+        for (;;) {
+            t0 = now_ns();
+            if (t->ops->put(t->queue, data) == 0)
+                break;
+            /* full: let the consumer run, as the OMX semaphores would */
+            sched_yield();
+        }
+        t->lat[i] = (unsigned int)(now_ns() - t0);
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    BENCH_THREAD *t = (BENCH_THREAD *)arg;
+    int i;
+
+    for (i = 0; i < t->count; i++) {
+        unsigned long long t0;
+        void *data;
+
+        for (;;) {
+            t0 = now_ns();
+            if ((data = t->ops->get(t->queue)) != NULL)
+                break;
+            sched_yield();
+        }
+        t->lat[i] = (unsigned int)(now_ns() - t0);
+        /* FIFO order is part of the contract */
+        if (data != (void *)(long)(i + 1))
+            t->errors++;
+    }
+    return NULL;
+}
+
+static int run(const BENCH_QUEUE_OPS *ops, void *queue, int count)
+{
+    BENCH_THREAD put, get;
+    pthread_t tput, tget;
+    unsigned long long t0, t1;
+    int i;
+
+    printf("%s\n", ops->name);
+
+    /* one thread, the queue never contended */
+    t0 = now_ns();
+    for (i = 0; i < count; i++) {
+        ops->put(queue, (void *)(long)(i + 1));
+        ops->get(queue);
+    }
+    t1 = now_ns();
+    printf("  1 thread:  %6.1f Mops/s\n", 2.0 * count * 1e3 / (t1 - t0));
+
+    memset(&put, 0, sizeof(put));
+    put.ops = ops;
+    put.queue = queue;
+    put.count = count;
+    put.lat = (unsigned int *)malloc(count * sizeof(unsigned int));
+    get = put;
+    get.lat = (unsigned int *)malloc(count * sizeof(unsigned int));
+    if ((put.lat == NULL) || (get.lat == NULL))
+        return -1;
+
+    t0 = now_ns();
+    pthread_create(&tget, NULL, consumer, &get);
+    pthread_create(&tput, NULL, producer, &put);
+    pthread_join(tput, NULL);
+    pthread_join(tget, NULL);
+    t1 = now_ns();
+
+    printf("  2 threads: %6.1f Mops/s\n", 2.0 * count * 1e3 / (t1 - t0));
+    report_latency("enqueue", put.lat, count);
+    report_latency("dequeue", get.lat, count);
+    if (get.errors)
+        printf("  %d elements out of order\n", get.errors);
+
+    free(put.lat);
+    free(get.lat);
+    return get.errors ? -1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    SEC_QUEUE ring;
+    REF_QUEUE mutex;
+    int count = (argc > 1) ? atoi(argv[1]) : BENCH_OPS;
+    int failed = 0;
+
+    if (count < 1000)
+        count = 1000;
+
+    printf("%d operations, depth %d\n", count, BENCH_DEPTH);
+
+    if ((SEC_OSAL_QueueCreateDepth(&ring, BENCH_DEPTH) != OMX_ErrorNone) ||
+        (ref_create(&mutex) != 0))
+        return 2;
+
+    failed |= run(&mutex_ops, &mutex, count);
+    failed |= run(&ring_ops, &ring, count);
+
+    SEC_OSAL_QueueTerminate(&ring);
+    ref_terminate(&mutex);
+
+    return failed ? 1 : 0;
+}
@@ -1,22 +1,21 @@
 LOCAL_PATH := $(call my-dir)
 
+include $(LOCAL_PATH)/csc_kernels.mk
+
 include $(CLEAR_VARS)
 
 LOCAL_COPY_HEADERS_TO := libsecmm
 LOCAL_COPY_HEADERS := \
 	color_space_convertor.h \
+	csc_kernels.h \
 	csc_fimc.h
 
 LOCAL_MODULE_TAGS := optional
 
 LOCAL_SRC_FILES := \
-	color_space_convertor.c \
-	csc_linear_to_tiled_crop_neon.s \
-	csc_linear_to_tiled_interleave_crop_neon.s \
-	csc_tiled_to_linear_crop_neon.s \
-	csc_tiled_to_linear_deinterleave_crop_neon.s \
-	csc_ARGB8888_to_YUV420SP_NEON.s \
-	csc_interleave_memcpy_neon.s \
+	$(CSC_KERNELS_SRC_FILES) \
+	$(CSC_KERNELS_NEON_SRC_FILES) \
+	csc_tiled_mt.c \
 	csc_fimc.cpp
 
 LOCAL_C_INCLUDES := \
@@ -34,7 +33,7 @@ LOCAL_MODULE := libseccscapi
 
 LOCAL_PRELINK_MODULE := false
 
-LOCAL_CFLAGS :=
+LOCAL_CFLAGS := -DCSC_HAVE_NEON
 
 LOCAL_ARM_MODE := arm
 
@@ -42,3 +41,62 @@ LOCAL_STATIC_LIBRARIES :=
 LOCAL_SHARED_LIBRARIES := liblog libfimc libhwconverter
 
 include $(BUILD_STATIC_LIBRARY)
+
+# C kernels only, for timing csc_yuv422.c against the old camera HAL loops
+include $(CLEAR_VARS)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	$(CSC_KERNELS_SRC_FILES) \
+	csc_tiled_mt.c \
+	csc_bench.c
+
+LOCAL_C_INCLUDES := \
+	$(TOP)/$(TARGET_OMX_PATH)/include/khronos \
+	$(TOP)/$(TARGET_OMX_PATH)/include/sec
+
+LOCAL_CFLAGS += -O2
+
+LOCAL_LDLIBS += -lpthread
+
+LOCAL_MODULE := csc_bench
+
+include $(BUILD_HOST_EXECUTABLE)
+
+# golden image conformance of the C kernels on the host
+include $(CLEAR_VARS)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	$(CSC_KERNELS_SRC_FILES) \
+	csc_conformance.c
+
+LOCAL_C_INCLUDES := \
+	$(TOP)/$(TARGET_OMX_PATH)/include/khronos \
+	$(TOP)/$(TARGET_OMX_PATH)/include/sec
+
+LOCAL_LDLIBS += -lpthread
+
+LOCAL_MODULE := csc_conformance
+
+include $(BUILD_HOST_EXECUTABLE)
+
+# the same suite on the device, where the NEON kernels are checked too
+include $(CLEAR_VARS)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := csc_conformance.c
+
+LOCAL_C_INCLUDES := \
+	$(TOP)/$(TARGET_OMX_PATH)/include/khronos \
+	$(TOP)/$(TARGET_OMX_PATH)/include/sec
+
+LOCAL_STATIC_LIBRARIES := libseccscapi
+LOCAL_SHARED_LIBRARIES := liblog libfimc libhwconverter
+
+LOCAL_MODULE := csc_conformance
+
+include $(BUILD_EXECUTABLE)
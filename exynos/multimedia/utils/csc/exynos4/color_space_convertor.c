@@ -179,7 +179,7 @@ static void csc_interleave_memcpy(
  * @param buttom
  *   Crop size of buttom
  */
-static void csc_tiled_to_linear_crop(
+void csc_tiled_to_linear_crop(
     unsigned char *yuv420_dest,
     unsigned char *nv12t_src,
     unsigned int yuv420_width,
@@ -379,7 +379,7 @@ static void csc_tiled_to_linear_crop(
  * @param buttom
  *   Crop size of buttom
  */
-static void csc_tiled_to_linear_deinterleave_crop(
+void csc_tiled_to_linear_deinterleave_crop(
     unsigned char *yuv420_u_dest,
     unsigned char *yuv420_v_dest,
     unsigned char *nv12t_uv_src,
@@ -634,7 +634,7 @@ static void csc_tiled_to_linear_deinterleave_crop(
  * @param buttom
  *   Crop size of buttom
  */
-static void csc_linear_to_tiled_crop(
+void csc_linear_to_tiled_crop(
     unsigned char *nv12t_dest,
     unsigned char *yuv420_src,
     unsigned int yuv420_width,
@@ -837,7 +837,7 @@ static void csc_linear_to_tiled_crop(
  * @param buttom
  *   Crop size of buttom
  */
-static void csc_linear_to_tiled_interleave_crop(
+void csc_linear_to_tiled_interleave_crop(
     unsigned char *nv12t_uv_dest,
     unsigned char *yuv420_u_src,
     unsigned char *yuv420_v_src,
@@ -1387,6 +1387,7 @@ void csc_linear_to_tiled_uv(
                                         0, 0, 0, 0);
 }
 
+#ifdef CSC_HAVE_NEON
 /*
  * Converts tiled data to linear for mfc 6.x
  * 1. Y of NV12T to Y of YUV420P
@@ -1528,6 +1529,7 @@ void csc_linear_to_tiled_uv_neon(
     csc_linear_to_tiled_interleave_crop_neon(uv_dst, u_src, v_src,
                                              width, height, 0, 0, 0, 0);
 }
+#endif /* CSC_HAVE_NEON */
 
 /*
  * Converts RGB565 to YUV420P
@@ -1675,6 +1677,98 @@ void csc_RGB565_to_YUV420SP(
     }
 }
 
+/*
+ * Converts ARGB8888 to YUV420P
+ *
+ * @param y_dst
+ *   Y plane address of YUV420P[out]
+ *
+ * @param u_dst
+ *   U plane address of YUV420P[out]
+ *
+ * @param v_dst
+ *   V plane address of YUV420P[out]
+ *
+ * @param rgb_src
+ *   Address of ARGB8888[in]
+ *
+ * @param width
+ *   Width of ARGB8888[in]
+ *
+ * @param height
+ *   Height of ARGB8888[in]
+ */
+void csc_ARGB8888_to_YUV420P(
+    unsigned char *y_dst,
+    unsigned char *u_dst,
+    unsigned char *v_dst,
+    unsigned char *rgb_src,
+    unsigned int width,
+    unsigned int height)
+{
+    unsigned int i, j;
+    unsigned int tmp;
+
+    unsigned int R, G, B;
+    unsigned int Y, U, V;
+
+    unsigned int *pSrc = (unsigned int *)rgb_src;
+
+    unsigned char *pDstY = (unsigned char *)y_dst;
+    unsigned char *pDstU = (unsigned char *)u_dst;
+    unsigned char *pDstV = (unsigned char *)v_dst;
+
+    unsigned int yIndex = 0;
+    unsigned int uIndex = 0;
+    unsigned int vIndex = 0;
+
+    for (j = 0; j < height; j++) {
+        for (i = 0; i < width; i++) {
+            tmp = pSrc[j * width + i];
+
+            R = (tmp & 0x00FF0000) >> 16;
+            G = (tmp & 0x0000FF00) >> 8;
+            B = (tmp & 0x000000FF);
+
+            Y = ((66 * R) + (129 * G) + (25 * B) + 128);
+            Y = Y >> 8;
+            Y += 16;
+
+            pDstY[yIndex++] = (unsigned char)Y;
+
+            if ((j % 2) == 0 && (i % 2) == 0) {
+                U = ((-38 * R) - (74 * G) + (112 * B) + 128);
+                U = U >> 8;
+                U += 128;
+                V = ((112 * R) - (94 * G) - (18 * B) + 128);
+                V = V >> 8;
+                V += 128;
+
+                pDstU[uIndex++] = (unsigned char)U;
+                pDstV[vIndex++] = (unsigned char)V;
+            }
+        }
+    }
+}
+
+/*
+ * Converts ARGB8888 to YUV420SP
+ *
+ * @param y_dst
+ *   Y plane address of YUV420SP[out]
+ *
+ * @param uv_dst
+ *   UV plane address of YUV420SP[out]
+ *
+ * @param rgb_src
+ *   Address of ARGB8888[in]
+ *
+ * @param width
+ *   Width of ARGB8888[in]
+ *
+ * @param height
+ *   Height of ARGB8888[in]
+ */
 void csc_ARGB8888_to_YUV420SP(
     unsigned char *y_dst,
     unsigned char *uv_dst,
@@ -1724,3 +1818,56 @@ void csc_ARGB8888_to_YUV420SP(
         }
     }
 }
+
+static const CSC_KERNELS csc_kernels_c = {
+    CSC_KERNEL_C,
+    "c",
+    csc_tiled_to_linear_crop,
+    csc_tiled_to_linear_deinterleave_crop,
+    csc_linear_to_tiled_crop,
+    csc_linear_to_tiled_interleave_crop,
+    csc_ARGB8888_to_YUV420SP,
+    csc_YUY2_to_NV21,
+};
+
+#ifdef CSC_HAVE_NEON
+static const CSC_KERNELS csc_kernels_neon = {
+    CSC_KERNEL_NEON,
+    "neon",
+    csc_tiled_to_linear_crop_neon,
+    csc_tiled_to_linear_deinterleave_crop_neon,
+    csc_linear_to_tiled_crop_neon,
+    csc_linear_to_tiled_interleave_crop_neon,
+    csc_ARGB8888_to_YUV420SP_NEON,
+    csc_YUY2_to_NV21_neon,
+};
+#define CSC_KERNELS_DEFAULT (&csc_kernels_neon)
+#else
+#define CSC_KERNELS_DEFAULT (&csc_kernels_c)
+#endif
+
+static const CSC_KERNELS *csc_kernels = CSC_KERNELS_DEFAULT;
+
+const CSC_KERNELS *csc_get_kernels(void)
+{
+    return csc_kernels;
+}
+
+int csc_set_kernels(CSC_KERNEL_TYPE type)
+{
+    switch (type) {
+    case CSC_KERNEL_AUTO:
+        csc_kernels = CSC_KERNELS_DEFAULT;
+        return 0;
+    case CSC_KERNEL_C:
+        csc_kernels = &csc_kernels_c;
+        return 0;
+#ifdef CSC_HAVE_NEON
+    case CSC_KERNEL_NEON:
+        csc_kernels = &csc_kernels_neon;
+        return 0;
+#endif
+    default:
+        return -1;
+    }
+}
@@ -54,6 +54,12 @@
 #ifndef COLOR_SPACE_CONVERTOR_H_
 #define COLOR_SPACE_CONVERTOR_H_
 
+#include "csc_kernels.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*--------------------------------------------------------------------------------*/
 /* Format Conversion API                                                          */
 /*--------------------------------------------------------------------------------*/
@@ -386,6 +392,35 @@ void csc_RGB565_to_YUV420SP(
     unsigned int width,
     unsigned int height);
 
+/*
+ * Converts ARGB8888 to YUV420P
+ *
+ * @param y_dst
+ *   Y plane address of YUV420P[out]
+ *
+ * @param u_dst
+ *   U plane address of YUV420P[out]
+ *
+ * @param v_dst
+ *   V plane address of YUV420P[out]
+ *
+ * @param rgb_src
+ *   Address of ARGB8888[in]
+ *
+ * @param width
+ *   Width of ARGB8888[in]
+ *
+ * @param height
+ *   Height of ARGB8888[in]
+ */
+void csc_ARGB8888_to_YUV420P(
+    unsigned char *y_dst,
+    unsigned char *u_dst,
+    unsigned char *v_dst,
+    unsigned char *rgb_src,
+    unsigned int width,
+    unsigned int height);
+
 /*
  * Converts ARGB888 to YUV420SP
  *
@@ -418,4 +453,83 @@ void csc_ARGB8888_to_YUV420SP_NEON(
     unsigned int width,
     unsigned int height);
 
+/*
+ * Multi-threaded tiled to linear conversion (csc_tiled_mt.c)
+ * The plane is split into bands of one tile row (32 lines) which are
+ * converted by the caller and a persistent worker pool. Parameters are
+ * the same as the single threaded variants.
+ */
+void csc_tiled_to_linear_y_mt(
+    unsigned char *y_dst,
+    unsigned char *y_src,
+    unsigned int width,
+    unsigned int height);
+
+void csc_tiled_to_linear_uv_mt(
+    unsigned char *uv_dst,
+    unsigned char *uv_src,
+    unsigned int width,
+    unsigned int height);
+
+void csc_tiled_to_linear_uv_deinterleave_mt(
+    unsigned char *u_dst,
+    unsigned char *v_dst,
+    unsigned char *uv_src,
+    unsigned int width,
+    unsigned int height);
+
+/*
+ * Limits the number of threads (caller included) used by the *_mt
+ * conversions. Returns the number actually applied.
+ */
+unsigned int csc_mt_set_num_threads(unsigned int num_threads);
+
+/*
+ * YUY2 (YUYV 4:2:2 packed) kernels (csc_yuv422.c)
+ */
+typedef enum {
+    CSC_SCALE_AUTO = 0,     /* bilinear, box is opt-in */
+    CSC_SCALE_BILINEAR,
+    CSC_SCALE_BOX           /* area average, reads the whole source */
+} CSC_SCALE_FILTER;
+
+/*
+ * Scales rows [top, bottom) of a YUY2 image to any smaller (or larger)
+ * size. Widths must be even. Returns 0 on success, -1 otherwise.
+ */
+int csc_scale_YUY2_rows(
+    unsigned char *dst,
+    unsigned int dst_width,
+    unsigned int dst_height,
+    unsigned char *src,
+    unsigned int src_width,
+    unsigned int src_height,
+    CSC_SCALE_FILTER filter,
+    unsigned int top,
+    unsigned int bottom);
+
+/*
+ * Multi-threaded YUY2 conversions, banded like the tiled ones above.
+ * Widths and, for NV21, heights must be even.
+ */
+void csc_YUY2_to_NV21_mt(
+    unsigned char *y_dst,
+    unsigned char *vu_dst,
+    unsigned char *yuy2_src,
+    unsigned int width,
+    unsigned int height);
+
+int csc_scale_YUY2_mt(
+    unsigned char *dst,
+    unsigned int dst_width,
+    unsigned int dst_height,
+    unsigned char *src,
+    unsigned int src_width,
+    unsigned int src_height,
+    CSC_SCALE_FILTER filter);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /*COLOR_SPACE_CONVERTOR_H_*/
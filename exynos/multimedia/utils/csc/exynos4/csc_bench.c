@@ -0,0 +1,266 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    csc_bench.c
+ *
+ * @brief   Host benchmark of the YUY2 kernels of csc_yuv422.c against the
+ *   loops the camera HAL used before (scaleDownYuv422 decimation and
+ *   YUY2toNV21), in Mpix/s of source, and of the banded tiled to linear
+ *   conversions of csc_tiled_mt.c against the single threaded kernels, in
+ *   MB/s of output. Also checks that the NV21 output is bit-exact with the
+ *   old loop and the banded output with the single threaded one.
+ *   Usage: csc_bench [iterations]
+ *
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "color_space_convertor.h"
+
+#define BENCH_ALIGN(x, a)   (((x) + (a) - 1) & ~((a) - 1))
+
+/* CameraHardwareSec::scaleDownYuv422() before csc_scale_YUY2_mt */
+static void ref_decimate_YUY2(unsigned char *dst, unsigned int dst_width, unsigned int dst_height,
+                              unsigned char *src, unsigned int src_width, unsigned int src_height)
+{
+    unsigned int step_x = src_width / dst_width;
+    unsigned int step_y = src_height / dst_height;
+    unsigned int x, y, dst_pos = 0;
+
+    for (y = 0; y < dst_height; y++) {
+        unsigned int src_y_start_pos = y * step_y * src_width * 2;
+
+        for (x = 0; x < dst_width; x += 2) {
+            unsigned int src_pos = src_y_start_pos + x * step_x * 2;
+
+            dst[dst_pos++] = src[src_pos];
+            dst[dst_pos++] = src[src_pos + 1];
+            dst[dst_pos++] = src[src_pos + 2];
+            dst[dst_pos++] = src[src_pos + 3];
+        }
+    }
+}
+
+/* CameraHardwareSec::YUY2toNV21() before csc_YUY2_to_NV21_mt */
+static void ref_YUY2_to_NV21(unsigned char *dst, unsigned char *src,
+                             unsigned int width, unsigned int height)
+{
+    unsigned int x, y, dst_pos = 0, dst_cbcr_pos = width * height;
+
+    for (y = 0; y < height; y++) {
+        for (x = 0; x < width * 2; x += 2)
+            dst[dst_pos++] = src[y * width * 2 + x];
+    }
+
+    for (y = 0; y < height; y += 2) {
+        for (x = 0; x < width * 2; x += 4) {
+            dst[dst_cbcr_pos++] = src[y * width * 2 + x + 3];
+            dst[dst_cbcr_pos++] = src[y * width * 2 + x + 1];
+        }
+    }
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void report(const char *name, unsigned int width, unsigned int height, double ms)
+{
+    printf("  %-28s %8.3f ms %8.0f Mpix/s\n", name, ms, width * height / ms / 1e3);
+}
+
+static void report_bytes(const char *name, unsigned int bytes, double ms)
+{
+    printf("  %-28s %8.3f ms %8.0f MB/s\n", name, ms, bytes / ms / 1e3);
+}
+
+/*
+ * NV12T planes to linear NV12 and to YUV420P, single threaded and banded
+ * over 1 and all csc threads. Returns 1 if a banded output differs.
+ */
+static int bench_tiled(unsigned int w, unsigned int h, int iterations)
+{
+    unsigned int y_size = BENCH_ALIGN(w, 128) * BENCH_ALIGN(h, 32);
+    unsigned int uv_size = BENCH_ALIGN(w, 128) * BENCH_ALIGN(h / 2, 32);
+    unsigned int max_threads = csc_mt_set_num_threads(~0U);
+    unsigned char *y_src = (unsigned char *)malloc(y_size);
+    unsigned char *uv_src = (unsigned char *)malloc(uv_size);
+    unsigned char *ref = (unsigned char *)malloc(w * h * 3 / 2);
+    unsigned char *out = (unsigned char *)malloc(w * h * 3 / 2);
+    unsigned int n, threads[2];
+    int failed = 0;
+    char name[64];
+    double t0;
+    int i;
+
+    if (!y_src || !uv_src || !ref || !out)
+        exit(2);
+    for (i = 0; i < (int)y_size; i++)
+        y_src[i] = (unsigned char)(i * 5 + (i >> 9) * 3);
+    for (i = 0; i < (int)uv_size; i++)
+        uv_src[i] = (unsigned char)(i * 11 + (i >> 10));
+
+    threads[0] = 1;
+    threads[1] = max_threads;
+
+    printf("%ux%u NV12T\n", w, h);
+
+    t0 = now_ms();
+    for (i = 0; i < iterations; i++) {
+        csc_tiled_to_linear_y(ref, y_src, w, h);
+        csc_tiled_to_linear_uv(ref + w * h, uv_src, w, h / 2);
+    }
+    report_bytes("NV12, single threaded", w * h * 3 / 2, (now_ms() - t0) / iterations);
+
+    for (n = 0; n < 2; n++) {
+        if (n && threads[n] == threads[0])
+            break;
+        csc_mt_set_num_threads(threads[n]);
+
+        t0 = now_ms();
+        for (i = 0; i < iterations; i++) {
+            csc_tiled_to_linear_y_mt(out, y_src, w, h);
+            csc_tiled_to_linear_uv_mt(out + w * h, uv_src, w, h / 2);
+        }
+        snprintf(name, sizeof(name), "NV12, _mt %u thread(s)", threads[n]);
+        report_bytes(name, w * h * 3 / 2, (now_ms() - t0) / iterations);
+
+        if (memcmp(ref, out, w * h * 3 / 2)) {
+            printf("  banded NV12 output differs\n");
+            failed = 1;
+        }
+    }
+
+    t0 = now_ms();
+    for (i = 0; i < iterations; i++)
+        csc_tiled_to_linear_uv_deinterleave(ref, ref + w * h / 4, uv_src, w, h / 2);
+    report_bytes("YUV420P UV, single threaded", w * h / 2, (now_ms() - t0) / iterations);
+
+    for (n = 0; n < 2; n++) {
+        if (n && threads[n] == threads[0])
+            break;
+        csc_mt_set_num_threads(threads[n]);
+
+        t0 = now_ms();
+        for (i = 0; i < iterations; i++)
+            csc_tiled_to_linear_uv_deinterleave_mt(out, out + w * h / 4, uv_src, w, h / 2);
+        snprintf(name, sizeof(name), "YUV420P UV, _mt %u thread(s)", threads[n]);
+        report_bytes(name, w * h / 2, (now_ms() - t0) / iterations);
+
+        if (memcmp(ref, out, w * h / 2)) {
+            printf("  banded YUV420P output differs\n");
+            failed = 1;
+        }
+    }
+
+    csc_mt_set_num_threads(max_threads);
+
+    free(y_src);
+    free(uv_src);
+    free(ref);
+    free(out);
+
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    static const unsigned int sizes[][2] = {
+        { 640, 480 }, { 1280, 720 }, { 1920, 1080 }, { 3264, 2448 },
+    };
+    static const unsigned int thumbs[][2] = {
+        { 320, 240 }, { 160, 120 },
+    };
+    int iterations = (argc > 1) ? atoi(argv[1]) : 20;
+    int failed = 0;
+    unsigned int s, t;
+    int i;
+
+    if (iterations < 1)
+        iterations = 1;
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        unsigned int w = sizes[s][0], h = sizes[s][1];
+        unsigned char *src = (unsigned char *)malloc(w * h * 2);
+        unsigned char *ref = (unsigned char *)malloc(w * h * 2);
+        unsigned char *out = (unsigned char *)malloc(w * h * 2);
+        double t0;
+
+        if (!src || !ref || !out)
+            return 2;
+        for (i = 0; i < (int)(w * h * 2); i++)
+            src[i] = (unsigned char)(i * 7 + (i >> 11) * 13);
+
+        printf("%ux%u YUY2\n", w, h);
+
+        t0 = now_ms();
+        for (i = 0; i < iterations; i++)
+            ref_YUY2_to_NV21(ref, src, w, h);
+        report("NV21, old HAL loop", w, h, (now_ms() - t0) / iterations);
+
+        t0 = now_ms();
+        for (i = 0; i < iterations; i++)
+            csc_YUY2_to_NV21_mt(out, out + w * h, src, w, h);
+        report("NV21, csc_YUY2_to_NV21_mt", w, h, (now_ms() - t0) / iterations);
+
+        if (memcmp(ref, out, w * h * 3 / 2)) {
+            printf("  NV21 output differs from the old HAL loop\n");
+            failed = 1;
+        }
+
+        for (t = 0; t < sizeof(thumbs) / sizeof(thumbs[0]); t++) {
+            unsigned int tw = thumbs[t][0], th = thumbs[t][1];
+            char name[64];
+
+            t0 = now_ms();
+            for (i = 0; i < iterations; i++)
+                ref_decimate_YUY2(out, tw, th, src, w, h);
+            snprintf(name, sizeof(name), "%ux%u, old decimation", tw, th);
+            report(name, w, h, (now_ms() - t0) / iterations);
+
+            t0 = now_ms();
+            for (i = 0; i < iterations; i++)
+                csc_scale_YUY2_mt(out, tw, th, src, w, h, CSC_SCALE_BILINEAR);
+            snprintf(name, sizeof(name), "%ux%u, bilinear", tw, th);
+            report(name, w, h, (now_ms() - t0) / iterations);
+
+            t0 = now_ms();
+            for (i = 0; i < iterations; i++)
+                csc_scale_YUY2_mt(out, tw, th, src, w, h, CSC_SCALE_BOX);
+            snprintf(name, sizeof(name), "%ux%u, box", tw, th);
+            report(name, w, h, (now_ms() - t0) / iterations);
+        }
+
+        free(src);
+        free(ref);
+        free(out);
+
+        if (bench_tiled(w, h, iterations))
+            failed = 1;
+    }
+
+    return failed;
+}
@@ -0,0 +1,224 @@
+/*
+ *
+ * Copyright 2012 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    csc_conformance.c
+ *
+ * @brief   Golden image conformance of the CSC_KERNELS tables. Every case
+ *   converts a fixed pseudo random input and compares an FNV-1a hash of
+ *   the whole output buffer with the value recorded from the per-platform
+ *   C code these kernels replaced (exynos4 libseccscapi and s5pc110
+ *   libseccsc for the uncropped NV12T cases, the camera HAL loop for
+ *   YUY2). Every table the build has is checked, so on ARM the NEON
+ *   kernels have to match the same images.
+ *
+ *   csc_conformance       check, exit status 1 on any mismatch
+ *   csc_conformance -g    print the hashes of the current C kernels
+ *
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csc_kernels.h"
+
+#define CSC_ALIGN(x, a)     (((x) + (a) - 1) & ~((a) - 1))
+
+typedef enum {
+    CASE_TILED_TO_LINEAR,
+    CASE_TILED_TO_LINEAR_DEINTERLEAVE,
+    CASE_LINEAR_TO_TILED,
+    CASE_LINEAR_TO_TILED_INTERLEAVE,
+    CASE_ARGB8888_TO_YUV420SP,
+    CASE_YUY2_TO_NV21
+} CSC_CASE_OP;
+
+typedef struct {
+    CSC_CASE_OP   op;
+    unsigned int  width;
+    unsigned int  height;   /* of the plane, UV planes are half height */
+    unsigned int  left;
+    unsigned int  top;
+    unsigned int  right;
+    unsigned int  bottom;
+    unsigned int  golden;
+} CSC_CASE;
+
+static const char *case_name[] = {
+    "tiled_to_linear",
+    "tiled_to_linear_deinterleave",
+    "linear_to_tiled",
+    "linear_to_tiled_interleave",
+    "ARGB8888_to_YUV420SP",
+    "YUY2_to_NV21",
+};
+
+static const CSC_CASE cases[] = {
+    { CASE_TILED_TO_LINEAR,              176,  144,  0,  0,  0,  0, 0x1b6a0e90 },
+    { CASE_TILED_TO_LINEAR,              720,  480,  0,  0,  0,  0, 0x2b9343f9 },
+    { CASE_TILED_TO_LINEAR,              800,  480,  0,  0,  0,  0, 0xabca6bba },
+    { CASE_TILED_TO_LINEAR,             1920, 1088,  0,  0,  0,  8, 0x5d5330a8 },
+    { CASE_TILED_TO_LINEAR,             1280,  720, 16,  8, 16,  8, 0x6f65dc91 },
+    { CASE_TILED_TO_LINEAR_DEINTERLEAVE, 176,   72,  0,  0,  0,  0, 0x1403219a },
+    { CASE_TILED_TO_LINEAR_DEINTERLEAVE, 720,  240,  0,  0,  0,  0, 0x561952ec },
+    { CASE_TILED_TO_LINEAR_DEINTERLEAVE, 800,  240,  0,  0,  0,  0, 0xf0e7a2b4 },
+    { CASE_TILED_TO_LINEAR_DEINTERLEAVE,1920,  544,  0,  0,  0,  4, 0xc1b47d53 },
+    { CASE_TILED_TO_LINEAR_DEINTERLEAVE,1280,  360, 16,  4, 16,  4, 0x555727ea },
+    { CASE_LINEAR_TO_TILED,              176,  144,  0,  0,  0,  0, 0xe85e59bb },
+    { CASE_LINEAR_TO_TILED,              720,  480,  0,  0,  0,  0, 0x53934254 },
+    { CASE_LINEAR_TO_TILED,              800,  480,  0,  0,  0,  0, 0xf0b44a46 },
+    { CASE_LINEAR_TO_TILED,             1920, 1080,  0,  0,  0,  0, 0xa8a1a37f },
+    { CASE_LINEAR_TO_TILED_INTERLEAVE,   176,   72,  0,  0,  0,  0, 0xbbac60c2 },
+    { CASE_LINEAR_TO_TILED_INTERLEAVE,   720,  240,  0,  0,  0,  0, 0x86c04083 },
+    { CASE_LINEAR_TO_TILED_INTERLEAVE,   800,  240,  0,  0,  0,  0, 0x0a3cbe0b },
+    { CASE_LINEAR_TO_TILED_INTERLEAVE,  1920,  540,  0,  0,  0,  0, 0xb4ff90ad },
+    { CASE_ARGB8888_TO_YUV420SP,         176,  144,  0,  0,  0,  0, 0x03ca3da3 },
+    { CASE_ARGB8888_TO_YUV420SP,         800,  480,  0,  0,  0,  0, 0xd8cf916d },
+    { CASE_YUY2_TO_NV21,                 640,  480,  0,  0,  0,  0, 0x1068aa3e },
+    { CASE_YUY2_TO_NV21,                1920, 1080,  0,  0,  0,  0, 0x6f997e18 },
+};
+
+static unsigned int csc_hash(const unsigned char *buf, size_t size, unsigned int hash)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= buf[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* the same bytes on every host: no rand() */
+static void csc_fill(unsigned char *buf, size_t size, unsigned int seed)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        seed = seed * 1103515245u + 12345u;
+        buf[i] = (unsigned char)(seed >> 16);
+    }
+}
+
+/* runs one case and returns the hash of its output buffers */
+static int csc_run_case(const CSC_KERNELS *k, const CSC_CASE *c, unsigned int *hash)
+{
+    unsigned int w = c->width, h = c->height;
+    size_t tiled_size = (size_t)CSC_ALIGN(w, 128) * CSC_ALIGN(h, 32);
+    size_t size = tiled_size + 4 * (size_t)w * h;
+    unsigned char *src = (unsigned char *)malloc(size);
+    unsigned char *dst = (unsigned char *)calloc(1, size);
+    unsigned char *dst2 = (unsigned char *)calloc(1, size);
+
+    if (src == NULL || dst == NULL || dst2 == NULL) {
+        free(src);
+        free(dst);
+        free(dst2);
+        return -1;
+    }
+
+    csc_fill(src, size, (unsigned int)c->op * 7919u + w * 31u + h);
+    *hash = 2166136261u;
+
+    switch (c->op) {
+    case CASE_TILED_TO_LINEAR:
+        k->tiled_to_linear_crop(dst, src, w, h, c->left, c->top, c->right, c->bottom);
+        *hash = csc_hash(dst, (size_t)w * h, *hash);
+        break;
+    case CASE_TILED_TO_LINEAR_DEINTERLEAVE:
+        k->tiled_to_linear_deinterleave_crop(dst, dst2, src, w, h,
+                                             c->left, c->top, c->right, c->bottom);
+        *hash = csc_hash(dst, (size_t)w * h / 2, *hash);
+        *hash = csc_hash(dst2, (size_t)w * h / 2, *hash);
+        break;
+    case CASE_LINEAR_TO_TILED:
+        k->linear_to_tiled_crop(dst, src, w, h, c->left, c->top, c->right, c->bottom);
+        *hash = csc_hash(dst, tiled_size, *hash);
+        break;
+    case CASE_LINEAR_TO_TILED_INTERLEAVE:
+        k->linear_to_tiled_interleave_crop(dst, src, src + (size_t)w * h / 2, w, h,
+                                           c->left, c->top, c->right, c->bottom);
+        *hash = csc_hash(dst, tiled_size, *hash);
+        break;
+    case CASE_ARGB8888_TO_YUV420SP:
+        k->ARGB8888_to_YUV420SP(dst, dst + (size_t)w * h, src, w, h);
+        *hash = csc_hash(dst, (size_t)w * h * 3 / 2, *hash);
+        break;
+    case CASE_YUY2_TO_NV21:
+        k->YUY2_to_NV21(dst, dst + (size_t)w * h, src, w, h);
+        *hash = csc_hash(dst, (size_t)w * h * 3 / 2, *hash);
+        break;
+    }
+
+    free(src);
+    free(dst);
+    free(dst2);
+    return 0;
+}
+
+static int csc_check_kernels(CSC_KERNEL_TYPE type)
+{
+    const CSC_KERNELS *k;
+    unsigned int i, hash;
+    int failed = 0;
+
+    if (csc_set_kernels(type) < 0)
+        return 0;
+    k = csc_get_kernels();
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const CSC_CASE *c = &cases[i];
+
+        if (csc_run_case(k, c, &hash) < 0) {
+            printf("%s: out of memory\n", k->name);
+            return 1;
+        }
+        if (hash != c->golden) {
+            printf("FAIL %s %s %ux%u crop(%u,%u,%u,%u): 0x%08x, golden 0x%08x\n",
+                   k->name, case_name[c->op], c->width, c->height,
+                   c->left, c->top, c->right, c->bottom, hash, c->golden);
+            failed = 1;
+        }
+    }
+
+    printf("%s kernels: %s\n", k->name, failed ? "FAILED" : "bit-exact");
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int i, hash;
+    int failed = 0;
+
+    if (argc > 1 && !strcmp(argv[1], "-g")) {
+        csc_set_kernels(CSC_KERNEL_C);
+        for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+            if (csc_run_case(csc_get_kernels(), &cases[i], &hash) < 0)
+                return 2;
+            printf("%-30s %4ux%-4u 0x%08x\n", case_name[cases[i].op],
+                   cases[i].width, cases[i].height, hash);
+        }
+        return 0;
+    }
+
+    failed |= csc_check_kernels(CSC_KERNEL_C);
+    failed |= csc_check_kernels(CSC_KERNEL_NEON);
+
+    return failed;
+}
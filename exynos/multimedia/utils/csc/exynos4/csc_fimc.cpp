@@ -118,18 +118,66 @@ CSC_FIMC_ERROR_CODE csc_fimc_convert_nv12t(
         goto EXIT;
     }
 
-    hw_converter->convert(
+    if (hw_converter->convert(
             (void *)src_addr, (void *)dst_addr,
             (OMX_COLOR_FORMATTYPE)OMX_SEC_COLOR_FormatNV12TPhysicalAddress,
-            width, height, omxformat);
-
-    ret = CSC_FIMC_RET_OK;
+            width, height, omxformat) == false)
+        ret = CSC_FIMC_RET_FAIL;
 
 EXIT:
 
     return ret;
 }
 
+/*
+ * convert color space src_omxformat to dst_omxformat
+ *
+ * @param handle
+ *   fimc handle[in]
+ *
+ * @param dst_addr
+ *   y,u,v address of dst_addr[out]
+ *
+ * @param src_addr
+ *   y,u,v address of src_addr. RGB formats use src_addr[0] only[in]
+ *
+ * @param width
+ *   width of src and dst image[in]
+ *
+ * @param height
+ *   height of src and dst image[in]
+ *
+ * @param src_omxformat
+ *   omxformat of src image[in]
+ *
+ * @param dst_omxformat
+ *   omxformat of dst image[in]
+ *
+ * @return
+ *   pass or fail
+ */
+CSC_FIMC_ERROR_CODE csc_fimc_convert(
+    void *handle,
+    void **dst_addr,
+    void **src_addr,
+    unsigned int width,
+    unsigned int height,
+    OMX_COLOR_FORMATTYPE src_omxformat,
+    OMX_COLOR_FORMATTYPE dst_omxformat)
+{
+    HardwareConverter *hw_converter = (HardwareConverter *)handle;
+
+    if (hw_converter == NULL)
+        return CSC_FIMC_RET_FAIL;
+
+    if (hw_converter->convert(
+            (void *)src_addr, (void *)dst_addr,
+            src_omxformat, width, height, dst_omxformat) == false)
+        return CSC_FIMC_RET_FAIL;
+
+    return CSC_FIMC_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -99,6 +99,42 @@ CSC_FIMC_ERROR_CODE csc_fimc_convert_nv12t(
     unsigned int height,
     OMX_COLOR_FORMATTYPE omxformat);
 
+/*
+ * convert color space src_omxformat to dst_omxformat
+ *
+ * @param handle
+ *   fimc handle[in]
+ *
+ * @param dst_addr
+ *   y,u,v address of dst_addr[out]
+ *
+ * @param src_addr
+ *   y,u,v address of src_addr. RGB formats use src_addr[0] only[in]
+ *
+ * @param width
+ *   width of src and dst image[in]
+ *
+ * @param height
+ *   height of src and dst image[in]
+ *
+ * @param src_omxformat
+ *   omxformat of src image[in]
+ *
+ * @param dst_omxformat
+ *   omxformat of dst image[in]
+ *
+ * @return
+ *   error code
+ */
+CSC_FIMC_ERROR_CODE csc_fimc_convert(
+    void *handle,
+    void **dst_addr,
+    void **src_addr,
+    unsigned int width,
+    unsigned int height,
+    OMX_COLOR_FORMATTYPE src_omxformat,
+    OMX_COLOR_FORMATTYPE dst_omxformat);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,223 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    csc_kernels.h
+ * @brief   Color space conversion kernels shared by every Exynos platform.
+ *   The crop kernels below are the only implementations of the NV12T
+ *   tiled <-> linear conversions; platform specific APIs are thin wrappers
+ *   around them. csc_get_kernels() returns the table selected for this
+ *   process (NEON when built with CSC_HAVE_NEON, C otherwise).
+ * @version 1.0
+ */
+
+#ifndef CSC_KERNELS_H_
+#define CSC_KERNELS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    CSC_KERNEL_AUTO = 0,
+    CSC_KERNEL_C,
+    CSC_KERNEL_NEON
+} CSC_KERNEL_TYPE;
+
+typedef struct {
+    CSC_KERNEL_TYPE type;
+    const char     *name;
+
+    /* NV12T Y or UV plane to linear Y or UV plane */
+    void (*tiled_to_linear_crop)(
+        unsigned char *yuv420_dest,
+        unsigned char *nv12t_src,
+        unsigned int yuv420_width,
+        unsigned int yuv420_height,
+        unsigned int left,
+        unsigned int top,
+        unsigned int right,
+        unsigned int buttom);
+
+    /* NV12T UV plane to linear U and V planes */
+    void (*tiled_to_linear_deinterleave_crop)(
+        unsigned char *yuv420_u_dest,
+        unsigned char *yuv420_v_dest,
+        unsigned char *nv12t_uv_src,
+        unsigned int yuv420_width,
+        unsigned int yuv420_uv_height,
+        unsigned int left,
+        unsigned int top,
+        unsigned int right,
+        unsigned int buttom);
+
+    /* linear Y plane to NV12T Y plane */
+    void (*linear_to_tiled_crop)(
+        unsigned char *nv12t_dest,
+        unsigned char *yuv420_src,
+        unsigned int yuv420_width,
+        unsigned int yuv420_height,
+        unsigned int left,
+        unsigned int top,
+        unsigned int right,
+        unsigned int buttom);
+
+    /* linear U and V planes to NV12T UV plane */
+    void (*linear_to_tiled_interleave_crop)(
+        unsigned char *nv12t_uv_dest,
+        unsigned char *yuv420_u_src,
+        unsigned char *yuv420_v_src,
+        unsigned int yuv420_width,
+        unsigned int yuv420_uv_height,
+        unsigned int left,
+        unsigned int top,
+        unsigned int right,
+        unsigned int buttom);
+
+    /* ARGB8888 to YUV420SP */
+    void (*ARGB8888_to_YUV420SP)(
+        unsigned char *y_dst,
+        unsigned char *uv_dst,
+        unsigned char *rgb_src,
+        unsigned int width,
+        unsigned int height);
+
+    /* YUY2 to NV21, width and height even */
+    void (*YUY2_to_NV21)(
+        unsigned char *y_dst,
+        unsigned char *vu_dst,
+        unsigned char *yuy2_src,
+        unsigned int width,
+        unsigned int height);
+} CSC_KERNELS;
+
+/*
+ * Returns the kernel table in use
+ */
+const CSC_KERNELS *csc_get_kernels(void);
+
+/*
+ * Selects the kernel table. CSC_KERNEL_AUTO selects the fastest one built
+ * in. Returns 0 on success, -1 if the requested table is not built in.
+ */
+int csc_set_kernels(CSC_KERNEL_TYPE type);
+
+/* C kernels */
+void csc_tiled_to_linear_crop(
+    unsigned char *yuv420_dest,
+    unsigned char *nv12t_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_tiled_to_linear_deinterleave_crop(
+    unsigned char *yuv420_u_dest,
+    unsigned char *yuv420_v_dest,
+    unsigned char *nv12t_uv_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_uv_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_linear_to_tiled_crop(
+    unsigned char *nv12t_dest,
+    unsigned char *yuv420_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_linear_to_tiled_interleave_crop(
+    unsigned char *nv12t_uv_dest,
+    unsigned char *yuv420_u_src,
+    unsigned char *yuv420_v_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_uv_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_YUY2_to_NV21(
+    unsigned char *y_dst,
+    unsigned char *vu_dst,
+    unsigned char *yuy2_src,
+    unsigned int width,
+    unsigned int height);
+
+/* NEON kernels, only present when built with CSC_HAVE_NEON */
+void csc_tiled_to_linear_crop_neon(
+    unsigned char *yuv420_dest,
+    unsigned char *nv12t_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_tiled_to_linear_deinterleave_crop_neon(
+    unsigned char *yuv420_u_dest,
+    unsigned char *yuv420_v_dest,
+    unsigned char *nv12t_uv_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_uv_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_linear_to_tiled_crop_neon(
+    unsigned char *nv12t_dest,
+    unsigned char *yuv420_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_linear_to_tiled_interleave_crop_neon(
+    unsigned char *nv12t_uv_dest,
+    unsigned char *yuv420_u_src,
+    unsigned char *yuv420_v_src,
+    unsigned int yuv420_width,
+    unsigned int yuv420_uv_height,
+    unsigned int left,
+    unsigned int top,
+    unsigned int right,
+    unsigned int buttom);
+
+void csc_YUY2_to_NV21_neon(
+    unsigned char *y_dst,
+    unsigned char *vu_dst,
+    unsigned char *yuy2_src,
+    unsigned int width,
+    unsigned int height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*CSC_KERNELS_H_*/
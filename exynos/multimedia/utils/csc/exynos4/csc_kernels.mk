@@ -0,0 +1,15 @@
+# Sources behind the CSC_KERNELS table of color_space_convertor.c. Every
+# module that builds the table includes this file, so a kernel added to
+# the table is built everywhere it is referenced.
+
+CSC_KERNELS_SRC_FILES := \
+	color_space_convertor.c \
+	csc_yuv422.c
+
+CSC_KERNELS_NEON_SRC_FILES := \
+	csc_linear_to_tiled_crop_neon.s \
+	csc_linear_to_tiled_interleave_crop_neon.s \
+	csc_tiled_to_linear_crop_neon.s \
+	csc_tiled_to_linear_deinterleave_crop_neon.s \
+	csc_ARGB8888_to_YUV420SP_NEON.s \
+	csc_interleave_memcpy_neon.s
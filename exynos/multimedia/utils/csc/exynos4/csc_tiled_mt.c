@@ -0,0 +1,350 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    csc_tiled_mt.c
+ *
+ * @brief   Row-banded, multi-threaded NV12T to linear conversion.
+ *   A plane is split into bands of one 64x32 tile row. The bands are
+ *   converted by the caller and a small persistent worker pool, each band
+ *   with the crop kernel restricted to its rows. The YUY2 conversion and
+ *   scaler of csc_yuv422.c are banded the same way, over output rows.
+ *
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "color_space_convertor.h"
+
+#define CSC_MT_MAX_THREADS  4
+#define CSC_MT_BAND_HEIGHT  32
+
+typedef enum {
+    CSC_MT_TILED_TO_LINEAR,
+    CSC_MT_TILED_TO_LINEAR_DEINTERLEAVE,
+    CSC_MT_YUY2_TO_NV21,
+    CSC_MT_SCALE_YUY2
+} CSC_MT_OP;
+
+typedef struct {
+    CSC_MT_OP          op;
+    const CSC_KERNELS *kernels;
+    unsigned char     *dst0;
+    unsigned char     *dst1;
+    unsigned char     *src;
+    unsigned int       width;
+    unsigned int       height;
+    unsigned int       src_width;   /* CSC_MT_SCALE_YUY2 only */
+    unsigned int       src_height;
+    CSC_SCALE_FILTER   filter;
+    int                error;
+    unsigned int       num_bands;
+    unsigned int       next_band;
+    unsigned int       done_bands;
+} CSC_MT_JOB;
+
+typedef struct {
+    pthread_mutex_t submit_lock;
+    pthread_mutex_t lock;
+    pthread_cond_t  work_cond;
+    pthread_cond_t  done_cond;
+    pthread_t       worker[CSC_MT_MAX_THREADS - 1];
+    unsigned int    num_workers;
+    unsigned int    num_threads;
+    CSC_MT_JOB     *job;
+} CSC_MT_POOL;
+
+static CSC_MT_POOL g_csc_mt_pool = {
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+};
+static pthread_once_t g_csc_mt_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Converts rows [top, top + CSC_MT_BAND_HEIGHT) of the job with the
+ * selected kernel table.
+ */
+static void csc_mt_run_band(CSC_MT_JOB *job, unsigned int band)
+{
+    const CSC_KERNELS *kernels = job->kernels;
+    unsigned int top = band * CSC_MT_BAND_HEIGHT;
+    unsigned int bottom = top + CSC_MT_BAND_HEIGHT;
+
+    if (bottom > job->height)
+        bottom = job->height;
+
+    switch (job->op) {
+    case CSC_MT_TILED_TO_LINEAR:
+        kernels->tiled_to_linear_crop(job->dst0 + job->width * top, job->src,
+                                      job->width, job->height,
+                                      0, top, 0, job->height - bottom);
+        break;
+    case CSC_MT_TILED_TO_LINEAR_DEINTERLEAVE:
+        kernels->tiled_to_linear_deinterleave_crop(job->dst0 + (job->width * top) / 2,
+                                                   job->dst1 + (job->width * top) / 2,
+                                                   job->src, job->width, job->height,
+                                                   0, top, 0, job->height - bottom);
+        break;
+    case CSC_MT_YUY2_TO_NV21:
+        kernels->YUY2_to_NV21(job->dst0 + job->width * top,
+                              job->dst1 + (job->width * top) / 2,
+                              job->src + job->width * top * 2,
+                              job->width, bottom - top);
+        break;
+    case CSC_MT_SCALE_YUY2:
+        /* bands only ever set it, no lock needed */
+        if (csc_scale_YUY2_rows(job->dst0, job->width, job->height,
+                                job->src, job->src_width, job->src_height,
+                                job->filter, top, bottom) != 0)
+            job->error = -1;
+        break;
+    }
+}
+
+/* Called with pool lock held */
+static int csc_mt_has_work(CSC_MT_POOL *pool, unsigned int index)
+{
+    if (pool->job == NULL)
+        return 0;
+    /* the caller thread counts as thread 0 */
+    if (index + 1 >= pool->num_threads)
+        return 0;
+    return (pool->job->next_band < pool->job->num_bands);
+}
+
+static void *csc_mt_worker(void *arg)
+{
+    CSC_MT_POOL *pool = &g_csc_mt_pool;
+    unsigned int index = (unsigned int)(unsigned long)arg;
+    CSC_MT_JOB *job;
+    unsigned int band;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!csc_mt_has_work(pool, index))
+            pthread_cond_wait(&pool->work_cond, &pool->lock);
+
+        job = pool->job;
+        band = job->next_band++;
+        pthread_mutex_unlock(&pool->lock);
+
+        csc_mt_run_band(job, band);
+
+        pthread_mutex_lock(&pool->lock);
+        job->done_bands++;
+        if (job->done_bands == job->num_bands)
+            pthread_cond_broadcast(&pool->done_cond);
+    }
+
+    return NULL;
+}
+
+static void csc_mt_init_pool(void)
+{
+    CSC_MT_POOL *pool = &g_csc_mt_pool;
+    long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    unsigned int i;
+
+    if (cpus < 1)
+        cpus = 1;
+    if (cpus > CSC_MT_MAX_THREADS)
+        cpus = CSC_MT_MAX_THREADS;
+
+    pool->num_workers = 0;
+    for (i = 0; i < (unsigned int)cpus - 1; i++) {
+        if (pthread_create(&pool->worker[i], NULL, csc_mt_worker,
+                           (void *)(unsigned long)i) != 0)
+            break;
+        pthread_detach(pool->worker[i]);
+        pool->num_workers++;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    if ((pool->num_threads == 0) || (pool->num_threads > pool->num_workers + 1))
+        pool->num_threads = pool->num_workers + 1;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void csc_mt_execute(CSC_MT_JOB *job)
+{
+    CSC_MT_POOL *pool = &g_csc_mt_pool;
+    unsigned int num_threads;
+    unsigned int band;
+
+    job->kernels = csc_get_kernels();
+    job->num_bands = (job->height + CSC_MT_BAND_HEIGHT - 1) / CSC_MT_BAND_HEIGHT;
+    job->next_band = 0;
+    job->done_bands = 0;
+
+    pthread_once(&g_csc_mt_once, csc_mt_init_pool);
+
+    pthread_mutex_lock(&pool->lock);
+    num_threads = pool->num_threads;
+    pthread_mutex_unlock(&pool->lock);
+
+    if ((job->num_bands <= 1) || (num_threads <= 1)) {
+        for (band = 0; band < job->num_bands; band++)
+            csc_mt_run_band(job, band);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->submit_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->job = job;
+    pthread_cond_broadcast(&pool->work_cond);
+
+    while (job->next_band < job->num_bands) {
+        band = job->next_band++;
+        pthread_mutex_unlock(&pool->lock);
+
+        csc_mt_run_band(job, band);
+
+        pthread_mutex_lock(&pool->lock);
+        job->done_bands++;
+    }
+
+    while (job->done_bands < job->num_bands)
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+
+    pool->job = NULL;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->submit_lock);
+}
+
+unsigned int csc_mt_set_num_threads(unsigned int num_threads)
+{
+    CSC_MT_POOL *pool = &g_csc_mt_pool;
+
+    pthread_once(&g_csc_mt_once, csc_mt_init_pool);
+
+    if (num_threads < 1)
+        num_threads = 1;
+    if (num_threads > pool->num_workers + 1)
+        num_threads = pool->num_workers + 1;
+
+    pthread_mutex_lock(&pool->submit_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->num_threads = num_threads;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->submit_lock);
+
+    return num_threads;
+}
+
+void csc_tiled_to_linear_y_mt(
+    unsigned char *y_dst,
+    unsigned char *y_src,
+    unsigned int width,
+    unsigned int height)
+{
+    CSC_MT_JOB job;
+
+    memset(&job, 0, sizeof(job));
+    job.op = CSC_MT_TILED_TO_LINEAR;
+    job.dst0 = y_dst;
+    job.src = y_src;
+    job.width = width;
+    job.height = height;
+    csc_mt_execute(&job);
+}
+
+void csc_tiled_to_linear_uv_mt(
+    unsigned char *uv_dst,
+    unsigned char *uv_src,
+    unsigned int width,
+    unsigned int height)
+{
+    CSC_MT_JOB job;
+
+    memset(&job, 0, sizeof(job));
+    job.op = CSC_MT_TILED_TO_LINEAR;
+    job.dst0 = uv_dst;
+    job.src = uv_src;
+    job.width = width;
+    job.height = height;
+    csc_mt_execute(&job);
+}
+
+void csc_tiled_to_linear_uv_deinterleave_mt(
+    unsigned char *u_dst,
+    unsigned char *v_dst,
+    unsigned char *uv_src,
+    unsigned int width,
+    unsigned int height)
+{
+    CSC_MT_JOB job;
+
+    memset(&job, 0, sizeof(job));
+    job.op = CSC_MT_TILED_TO_LINEAR_DEINTERLEAVE;
+    job.dst0 = u_dst;
+    job.dst1 = v_dst;
+    job.src = uv_src;
+    job.width = width;
+    job.height = height;
+    csc_mt_execute(&job);
+}
+
+void csc_YUY2_to_NV21_mt(
+    unsigned char *y_dst,
+    unsigned char *vu_dst,
+    unsigned char *yuy2_src,
+    unsigned int width,
+    unsigned int height)
+{
+    CSC_MT_JOB job;
+
+    memset(&job, 0, sizeof(job));
+    job.op = CSC_MT_YUY2_TO_NV21;
+    job.dst0 = y_dst;
+    job.dst1 = vu_dst;
+    job.src = yuy2_src;
+    job.width = width;
+    job.height = height;
+    csc_mt_execute(&job);
+}
+
+int csc_scale_YUY2_mt(
+    unsigned char *dst,
+    unsigned int dst_width,
+    unsigned int dst_height,
+    unsigned char *src,
+    unsigned int src_width,
+    unsigned int src_height,
+    CSC_SCALE_FILTER filter)
+{
+    CSC_MT_JOB job;
+
+    memset(&job, 0, sizeof(job));
+    job.op = CSC_MT_SCALE_YUY2;
+    job.dst0 = dst;
+    job.src = src;
+    job.width = dst_width;
+    job.height = dst_height;
+    job.src_width = src_width;
+    job.src_height = src_height;
+    job.filter = filter;
+    csc_mt_execute(&job);
+
+    return job.error;
+}
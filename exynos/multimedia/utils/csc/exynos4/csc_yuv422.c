@@ -0,0 +1,406 @@
+/*
+ *
+ * Copyright 2010 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    csc_yuv422.c
+ *
+ * @brief   YUY2 (YUYV 4:2:2 packed) kernels used by the camera HAL:
+ *   conversion to NV21 and arbitrary ratio down scaling. Both work on a
+ *   range of output rows so csc_tiled_mt.c can split them into bands.
+ *
+ * @version 1.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef CSC_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+#include "color_space_convertor.h"
+
+/*
+ * Converts YUY2 to NV21. Chroma is taken from the even lines, as the
+ * camera HAL always did.
+ *
+ * @param y_dst
+ *   Y plane address of NV21[out]
+ *
+ * @param vu_dst
+ *   VU plane address of NV21[out]
+ *
+ * @param yuy2_src
+ *   Address of YUY2[in]
+ *
+ * @param width
+ *   Width of YUY2, even[in]
+ *
+ * @param height
+ *   Height of YUY2, even[in]
+ */
+void csc_YUY2_to_NV21(
+    unsigned char *y_dst,
+    unsigned char *vu_dst,
+    unsigned char *yuy2_src,
+    unsigned int width,
+    unsigned int height)
+{
+    unsigned int i, j;
+
+    for (j = 0; j < height; j++) {
+        const unsigned char *__restrict src = yuy2_src + j * width * 2;
+        unsigned char *__restrict dst = y_dst + j * width;
+        unsigned char *__restrict vu = vu_dst + (j / 2) * width;
+
+        if ((j % 2) == 0) {
+            for (i = 0; i < width; i += 2) {
+                dst[i]     = src[i * 2];
+                dst[i + 1] = src[i * 2 + 2];
+                vu[i]      = src[i * 2 + 3];
+                vu[i + 1]  = src[i * 2 + 1];
+            }
+        } else {
+            for (i = 0; i < width; i++)
+                dst[i] = src[i * 2];
+        }
+    }
+}
+
+#ifdef CSC_HAVE_NEON
+/*
+ * NEON version of csc_YUY2_to_NV21(), 16 pixels per step.
+ */
+void csc_YUY2_to_NV21_neon(
+    unsigned char *y_dst,
+    unsigned char *vu_dst,
+    unsigned char *yuy2_src,
+    unsigned int width,
+    unsigned int height)
+{
+    unsigned int i, j;
+
+    for (j = 0; j < height; j++) {
+        unsigned char *src = yuy2_src + j * width * 2;
+        unsigned char *dst = y_dst + j * width;
+        unsigned char *vu = vu_dst + (j / 2) * width;
+        int chroma = (j % 2) == 0;
+
+        for (i = 0; i + 16 <= width; i += 16) {
+            /* val[0] Y0, val[1] U, val[2] Y1, val[3] V of 8 pixel pairs */
+            uint8x8x4_t yuyv = vld4_u8(src + i * 2);
+            uint8x8x2_t y;
+
+            y.val[0] = yuyv.val[0];
+            y.val[1] = yuyv.val[2];
+            vst2_u8(dst + i, y);
+
+            if (chroma) {
+                uint8x8x2_t vu_pair;
+
+                vu_pair.val[0] = yuyv.val[3];
+                vu_pair.val[1] = yuyv.val[1];
+                vst2_u8(vu + i, vu_pair);
+            }
+        }
+
+        for (; i < width; i += 2) {
+            dst[i]     = src[i * 2];
+            dst[i + 1] = src[i * 2 + 2];
+            if (chroma) {
+                vu[i]     = src[i * 2 + 3];
+                vu[i + 1] = src[i * 2 + 1];
+            }
+        }
+    }
+}
+#endif
+
+/*
+ * Bilinear taps of one output sample: byte offsets of the two source
+ * samples and the 8 bit weight of the second one.
+ */
+typedef struct {
+    unsigned int  off0;
+    unsigned int  off1;
+    unsigned int  frac;
+} CSC_SCALE_TAP;
+
+/*
+ * Tap of output k of n over src samples spaced pitch bytes apart. Samples
+ * are centre aligned, so 2:1 lands exactly between two source samples.
+ */
+static void csc_scale_tap(CSC_SCALE_TAP *tap, unsigned int k, unsigned int n,
+                          unsigned int src, unsigned int pitch)
+{
+    unsigned int step = (unsigned int)(((unsigned long long)src << 16) / n);
+    unsigned int pos = ((step > 0x10000) ? (step - 0x10000) / 2 : 0) + k * step;
+    unsigned int i, frac;
+
+    /* round to the 8 bit weight */
+    pos = (pos + 0x80) >> 8;
+    i = pos >> 8;
+    frac = pos & 0xff;
+
+    if (i >= src - 1) {
+        tap->off0 = tap->off1 = (src - 1) * pitch;
+        tap->frac = 0;
+    } else {
+        tap->off0 = i * pitch;
+        tap->off1 = (i + 1) * pitch;
+        tap->frac = frac;
+    }
+}
+
+/* t = r0 * (256 - fy) + r1 * fy, n bytes */
+static void csc_scale_blend_line(unsigned short *__restrict t,
+                                 const unsigned char *__restrict r0,
+                                 const unsigned char *__restrict r1,
+                                 unsigned int n, unsigned int fy)
+{
+    unsigned int k = 0;
+
+#ifdef CSC_HAVE_NEON
+    if (fy == 0) {
+        for (; k + 8 <= n; k += 8)
+            vst1q_u16(t + k, vshll_n_u8(vld1_u8(r0 + k), 8));
+    } else {
+        uint8x8_t w0 = vdup_n_u8(256 - fy);
+        uint8x8_t w1 = vdup_n_u8(fy);
+
+        for (; k + 8 <= n; k += 8) {
+            uint16x8_t v = vmull_u8(vld1_u8(r0 + k), w0);
+            vst1q_u16(t + k, vmlal_u8(v, vld1_u8(r1 + k), w1));
+        }
+    }
+#endif
+    for (; k < n; k++)
+        t[k] = (unsigned short)(r0[k] * (256 - fy) + r1[k] * fy);
+}
+
+/* acc += in, n bytes */
+static void csc_scale_acc_line(unsigned int *__restrict acc,
+                               const unsigned char *__restrict in, unsigned int n)
+{
+    unsigned int k = 0;
+
+#ifdef CSC_HAVE_NEON
+    for (; k + 8 <= n; k += 8) {
+        uint16x8_t v = vmovl_u8(vld1_u8(in + k));
+
+        vst1q_u32(acc + k, vaddw_u16(vld1q_u32(acc + k), vget_low_u16(v)));
+        vst1q_u32(acc + k + 4, vaddw_u16(vld1q_u32(acc + k + 4), vget_high_u16(v)));
+    }
+#endif
+    for (; k < n; k++)
+        acc[k] += in[k];
+}
+
+/* one bilinear sample, same rounding as the blended line path */
+static unsigned char csc_scale_sample(const unsigned char *r0, const unsigned char *r1,
+                                      const CSC_SCALE_TAP *tp, unsigned int fy)
+{
+    unsigned int t0 = r0[tp->off0] * (256 - fy) + r1[tp->off0] * fy;
+    unsigned int t1 = r0[tp->off1] * (256 - fy) + r1[tp->off1] * fy;
+
+    return (unsigned char)((t0 * (256 - tp->frac) + t1 * tp->frac + 32768) >> 16);
+}
+
+/*
+ * Blends the two source lines of each output row into a 16 bit line first,
+ * one SIMD pass, then applies the horizontal taps to it. When the output
+ * is narrower than the source that pass costs more than it saves, so each
+ * sample reads its four taps directly and the cost follows the output
+ * size: a 320x240 thumbnail reads 4 bytes per output byte whatever the
+ * source size.
+ *
+ * That is still about 5x the old decimation, which read one byte per
+ * output byte (0.68 against 0.12 ms for a 3264x2448 source on one host
+ * core): every output row pulls in two source lines instead of one and
+ * each sample is filtered. The camera HAL only scales the EXIF thumbnail,
+ * once per still capture, through csc_scale_YUY2_mt() which spreads the
+ * rows over the csc threads, so this is noise next to the JPEG encode.
+ */
+static int csc_scale_YUY2_bilinear(
+    unsigned char *dst, unsigned int dst_width, unsigned int dst_height,
+    unsigned char *src, unsigned int src_width, unsigned int src_height,
+    unsigned int top, unsigned int bottom)
+{
+    unsigned int line = src_width * 2;
+    unsigned int chroma_width = dst_width / 2;
+    CSC_SCALE_TAP *tap_y, *tap_c, tap_v;
+    unsigned short *tmp;
+    unsigned int x, y;
+
+    tmp = (unsigned short *)malloc(line * sizeof(*tmp) +
+                                   (dst_width + chroma_width) * sizeof(CSC_SCALE_TAP));
+    if (tmp == NULL)
+        return -1;
+    tap_y = (CSC_SCALE_TAP *)(tmp + line);
+    tap_c = tap_y + dst_width;
+
+    for (x = 0; x < dst_width; x++)
+        csc_scale_tap(&tap_y[x], x, dst_width, src_width, 2);
+    for (x = 0; x < chroma_width; x++)
+        csc_scale_tap(&tap_c[x], x, chroma_width, src_width / 2, 4);
+
+    for (y = top; y < bottom; y++) {
+        const unsigned short *__restrict t = tmp;
+        unsigned char *__restrict out = dst + y * dst_width * 2;
+
+        csc_scale_tap(&tap_v, y, dst_height, src_height, line);
+
+        if (dst_width < src_width) {
+            const unsigned char *r0 = src + tap_v.off0;
+            const unsigned char *r1 = src + tap_v.off1;
+            unsigned int fy = tap_v.frac;
+
+            for (x = 0; x < dst_width; x++)
+                out[x * 2] = csc_scale_sample(r0, r1, &tap_y[x], fy);
+
+            for (x = 0; x < chroma_width; x++) {
+                out[x * 4 + 1] = csc_scale_sample(r0 + 1, r1 + 1, &tap_c[x], fy);
+                out[x * 4 + 3] = csc_scale_sample(r0 + 3, r1 + 3, &tap_c[x], fy);
+            }
+            continue;
+        }
+
+        csc_scale_blend_line(tmp, src + tap_v.off0, src + tap_v.off1, line, tap_v.frac);
+
+        for (x = 0; x < dst_width; x++) {
+            const CSC_SCALE_TAP *tp = &tap_y[x];
+
+            out[x * 2] = (unsigned char)((t[tp->off0] * (256 - tp->frac) +
+                                          t[tp->off1] * tp->frac + 32768) >> 16);
+        }
+
+        for (x = 0; x < chroma_width; x++) {
+            const CSC_SCALE_TAP *tp = &tap_c[x];
+            unsigned int f = tp->frac;
+
+            /* U */
+            out[x * 4 + 1] = (unsigned char)((t[tp->off0 + 1] * (256 - f) +
+                                              t[tp->off1 + 1] * f + 32768) >> 16);
+            /* V */
+            out[x * 4 + 3] = (unsigned char)((t[tp->off0 + 3] * (256 - f) +
+                                              t[tp->off1 + 3] * f + 32768) >> 16);
+        }
+    }
+
+    free(tmp);
+    return 0;
+}
+
+/*
+ * Averages every source sample an output sample covers. Smoother than
+ * bilinear for ratios of 2 and up, which only looks at 2x2, but it reads
+ * the whole source image.
+ */
+static int csc_scale_YUY2_box(
+    unsigned char *dst, unsigned int dst_width, unsigned int dst_height,
+    unsigned char *src, unsigned int src_width, unsigned int src_height,
+    unsigned int top, unsigned int bottom)
+{
+    unsigned int line = src_width * 2;
+    unsigned int *acc;
+    unsigned int x, y, k;
+
+    acc = (unsigned int *)malloc(line * sizeof(*acc));
+    if (acc == NULL)
+        return -1;
+
+    for (y = top; y < bottom; y++) {
+        unsigned int y0 = (unsigned int)(((unsigned long long)y * src_height) / dst_height);
+        unsigned int y1 = (unsigned int)(((unsigned long long)(y + 1) * src_height) / dst_height);
+        unsigned char *out = dst + y * dst_width * 2;
+        unsigned int rows;
+
+        if (y1 <= y0)
+            y1 = y0 + 1;
+        rows = y1 - y0;
+
+        /* column sums of the source lines, one pass per line */
+        memset(acc, 0, line * sizeof(*acc));
+        for (k = y0; k < y1; k++)
+            csc_scale_acc_line(acc, src + k * line, line);
+
+        for (x = 0; x < dst_width; x++) {
+            unsigned int x0 = (x * src_width) / dst_width;
+            unsigned int x1 = ((x + 1) * src_width) / dst_width;
+            unsigned int sum = 0;
+            unsigned int n;
+
+            if (x1 <= x0)
+                x1 = x0 + 1;
+            for (k = x0; k < x1; k++)
+                sum += acc[k * 2];
+            n = (x1 - x0) * rows;
+            out[x * 2] = (unsigned char)((sum + n / 2) / n);
+        }
+
+        for (x = 0; x < dst_width / 2; x++) {
+            unsigned int x0 = (x * (src_width / 2)) / (dst_width / 2);
+            unsigned int x1 = ((x + 1) * (src_width / 2)) / (dst_width / 2);
+            unsigned int u = 0, v = 0;
+            unsigned int n;
+
+            if (x1 <= x0)
+                x1 = x0 + 1;
+            for (k = x0; k < x1; k++) {
+                u += acc[k * 4 + 1];
+                v += acc[k * 4 + 3];
+            }
+            n = (x1 - x0) * rows;
+            out[x * 4 + 1] = (unsigned char)((u + n / 2) / n);
+            out[x * 4 + 3] = (unsigned char)((v + n / 2) / n);
+        }
+    }
+
+    free(acc);
+    return 0;
+}
+
+/*
+ * Scales output rows [top, bottom) of a YUY2 image. CSC_SCALE_AUTO is
+ * bilinear: box reads every source line and takes over 10 ms for a
+ * 3264x2448 -> 320x240 thumbnail on the host against 0.7 ms.
+ *
+ * @return
+ *   0 on success, -1 on bad sizes or out of memory
+ */
+int csc_scale_YUY2_rows(
+    unsigned char *dst,
+    unsigned int dst_width,
+    unsigned int dst_height,
+    unsigned char *src,
+    unsigned int src_width,
+    unsigned int src_height,
+    CSC_SCALE_FILTER filter,
+    unsigned int top,
+    unsigned int bottom)
+{
+    if ((dst_width < 2) || (dst_height < 1) || (src_width < 2) || (src_height < 1) ||
+        (dst_width % 2) || (src_width % 2))
+        return -1;
+
+    if (filter == CSC_SCALE_BOX)
+        return csc_scale_YUY2_box(dst, dst_width, dst_height,
+                                  src, src_width, src_height, top, bottom);
+
+    return csc_scale_YUY2_bilinear(dst, dst_width, dst_height,
+                                   src, src_width, src_height, top, bottom);
+}
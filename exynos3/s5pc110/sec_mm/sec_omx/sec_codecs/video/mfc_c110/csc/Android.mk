@@ -1,36 +1,63 @@
-
 LOCAL_PATH := $(call my-dir)
+
+# Conversion kernels are shared with exynos4
+SEC_CSC_PATH := $(LOCAL_PATH)
+SEC_CSC_COMMON := $(SAM_ROOT)/exynos/multimedia/utils/csc/exynos4
+
+include $(SEC_CSC_COMMON)/csc_kernels.mk
+
 include $(CLEAR_VARS)
 
+LOCAL_PATH := $(SEC_CSC_COMMON)
+
 LOCAL_MODULE_TAGS := optional
 
+LOCAL_SRC_FILES := $(CSC_KERNELS_SRC_FILES)
+
+LOCAL_CFLAGS :=
+
 ifeq ($(ARCH_ARM_HAVE_NEON),true)
-LOCAL_SRC_FILES := \
-	csc_yuv420_nv12t_y_neon.s \
-	csc_yuv420_nv12t_uv_neon.s \
-	csc_nv12t_yuv420_y_neon.s \
-	csc_nv12t_yuv420_uv_neon.s \
-	csc_interleave_memcpy.s \
-	csc_deinterleave_memcpy.s
-
-else
-LOCAL_SRC_FILES := \
-	color_space_convertor.c
+LOCAL_SRC_FILES += $(CSC_KERNELS_NEON_SRC_FILES)
 
+LOCAL_CFLAGS += -DCSC_HAVE_NEON
 endif
 
-LOCAL_MODULE := libseccsc
+LOCAL_MODULE := libseccsc_kernels
+
+LOCAL_ARM_MODE := arm
+
+LOCAL_C_INCLUDES := \
+	$(SEC_CODECS)/video/mfc_c110/include \
+	$(TOP)/$(SEC_CSC_COMMON)
+
+include $(BUILD_STATIC_LIBRARY)
+
+include $(CLEAR_VARS)
+
+LOCAL_PATH := $(SEC_CSC_PATH)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+	color_space_convertor_c110.c
 
 LOCAL_CFLAGS :=
 
+ifeq ($(ARCH_ARM_HAVE_NEON),true)
+LOCAL_CFLAGS += -DCSC_HAVE_NEON
+endif
+
+LOCAL_MODULE := libseccsc
+
 LOCAL_ARM_MODE := arm
 
 LOCAL_STATIC_LIBRARIES :=
+LOCAL_WHOLE_STATIC_LIBRARIES := libseccsc_kernels
 
 LOCAL_SHARED_LIBRARIES := liblog
 
 LOCAL_C_INCLUDES := \
-	$(SEC_CODECS)/video/mfc_c110/include
+	$(SEC_CODECS)/video/mfc_c110/include \
+	$(TOP)/$(SEC_CSC_COMMON)
 
 include $(BUILD_STATIC_LIBRARY)
-
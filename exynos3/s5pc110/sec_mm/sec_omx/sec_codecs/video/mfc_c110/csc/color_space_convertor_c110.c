@@ -0,0 +1,132 @@
+/*
+ *
+ * Copyright 2011 Samsung Electronics S.LSI Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    color_space_convertor_c110.c
+ * @brief   MFC 5.0 (s5pc110) color space conversion API.
+ *   The conversions are done by the kernels shared with exynos4
+ *   (exynos/multimedia/utils/csc/exynos4/csc_kernels.h), which produce
+ *   identical output for the uncropped s5pc110 layouts.
+ * @author  ShinWon Lee (shinwon.lee@samsung.com)
+ * @version 1.0
+ */
+
+#include "stdlib.h"
+#include "color_space_convertor.h"
+#include "csc_kernels.h"
+
+/*
+ * De-interleaves src to dest1, dest2
+ *
+ * @param dest1
+ *   Address of de-interleaved data[out]
+ *
+ * @param dest2
+ *   Address of de-interleaved data[out]
+ *
+ * @param src
+ *   Address of interleaved data[in]
+ *
+ * @param src_size
+ *   Size of interleaved data[in]
+ */
+void csc_deinterleave_memcpy(char *dest1, char *dest2, char *src, int src_size)
+{
+    int i = 0;
+    for(i=0; i<src_size/2; i++) {
+        dest1[i] = src[i*2];
+        dest2[i] = src[i*2+1];
+    }
+}
+
+/*
+ * Interleaves src1, src2 to dest
+ *
+ * @param dest
+ *   Address of interleaved data[out]
+ *
+ * @param src1
+ *   Address of de-interleaved data[in]
+ *
+ * @param src2
+ *   Address of de-interleaved data[in]
+ *
+ * @param src_size
+ *   Size of de-interleaved data[in]
+ */
+void csc_interleave_memcpy(char *dest, char *src1, char *src2, int src_size)
+{
+    int i = 0;
+    for(i=0; i<src_size; i++) {
+        dest[i*2] = src1[i];
+        dest[i*2+1] = src2[i];
+    }
+}
+
+/*
+ * Converts tiled data to linear
+ * 1. Y of NV12T to Y of YUV420P
+ * 2. Y of NV12T to Y of YUV420S
+ * 3. UV of NV12T to UV of YUV420S
+ */
+void csc_tiled_to_linear(char *yuv420_dest, char *nv12t_src, int yuv420_width, int yuv420_height)
+{
+    csc_get_kernels()->tiled_to_linear_crop((unsigned char *)yuv420_dest,
+                                            (unsigned char *)nv12t_src,
+                                            yuv420_width, yuv420_height,
+                                            0, 0, 0, 0);
+}
+
+/*
+ * Converts and Deinterleaves tiled data to linear
+ * 1. UV of NV12T to UV of YUV420P
+ */
+void csc_tiled_to_linear_deinterleave(char *yuv420_u_dest, char *yuv420_v_dest, char *nv12t_uv_src, int yuv420_width, int yuv420_uv_height)
+{
+    csc_get_kernels()->tiled_to_linear_deinterleave_crop((unsigned char *)yuv420_u_dest,
+                                                         (unsigned char *)yuv420_v_dest,
+                                                         (unsigned char *)nv12t_uv_src,
+                                                         yuv420_width, yuv420_uv_height,
+                                                         0, 0, 0, 0);
+}
+
+/*
+ * Converts linear data to tiled
+ * 1. Y of YUV420P to Y of NV12T
+ * 2. Y of YUV420S to Y of NV12T
+ * 3. UV of YUV420S to UV of NV12T
+ */
+void csc_linear_to_tiled(char *nv12t_dest, char *yuv420_src, int yuv420_width, int yuv420_height)
+{
+    csc_get_kernels()->linear_to_tiled_crop((unsigned char *)nv12t_dest,
+                                            (unsigned char *)yuv420_src,
+                                            yuv420_width, yuv420_height,
+                                            0, 0, 0, 0);
+}
+
+/*
+ * Converts and Interleaves linear to tiled
+ * 1. UV of YUV420P to UV of NV12T
+ */
+void csc_linear_to_tiled_interleave(char *nv12t_uv_dest, char *yuv420_u_src, char *yuv420_v_src, int yuv420_width, int yuv420_uv_height)
+{
+    csc_get_kernels()->linear_to_tiled_interleave_crop((unsigned char *)nv12t_uv_dest,
+                                                       (unsigned char *)yuv420_u_src,
+                                                       (unsigned char *)yuv420_v_src,
+                                                       yuv420_width, yuv420_uv_height,
+                                                       0, 0, 0, 0);
+}
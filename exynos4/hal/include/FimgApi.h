@@ -160,6 +160,49 @@ extern "C"
 #endif
 int FimgApiCheckBoostup(Fimg *curr, Fimg *prev);
 
+/*
+ * Asynchronous blits
+ *
+ * stretchFimgApiAsync() copies cmd (and the images it points to) into a
+ * queue served by a worker thread and returns at once with a ticket for
+ * the blit; it only blocks while FIMG_ASYNC_QUEUE_DEPTH blits are pending.
+ * Blits complete in submission order, so waiting on the last ticket of a
+ * batch waits for the whole batch.
+ */
+#define FIMG_ASYNC_QUEUE_DEPTH      (8)
+#define FIMG_ASYNC_RESULT_DEPTH     (32)
+#define FIMG_ASYNC_NO_TICKET        (0)
+
+#ifdef __cplusplus
+extern "C"
+#endif
+int stretchFimgApiAsync(struct fimg2d_blit *cmd, unsigned int *ticket);
+
+/*
+ * returns 0 when the blit is done, -1 if it failed, -ETIMEDOUT on timeout.
+ * Only the last FIMG_ASYNC_RESULT_DEPTH results are kept: an older ticket,
+ * or one that was never handed out, returns -ENOENT.
+ */
+#ifdef __cplusplus
+extern "C"
+#endif
+int waitFimgApiAsync(unsigned int ticket, int timeout_ms);
+
+/* returns 1 when the blit is done, 0 while it is pending */
+#ifdef __cplusplus
+extern "C"
+#endif
+int isDoneFimgApiAsync(unsigned int ticket);
+
+/*
+ * Runs queued blits on backend instead of /dev/fimg2d, NULL restores the
+ * device. Waits for the queue to drain first.
+ */
+#ifdef __cplusplus
+extern "C"
+#endif
+void setBackendFimgApiAsync(struct FimgApi *backend);
+
 void printDataBlit(char *title, struct fimg2d_blit *cmd);
 void printDataBlitRotate(int rotate);
 void printDataBlitImage(char *title, struct fimg2d_image *image);
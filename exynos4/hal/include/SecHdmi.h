@@ -75,6 +75,48 @@ public :
         HDMI_LAYER_MAX,
     };
 
+    /*
+     * What flush() found different from the layer's last configuration.
+     * Address-only flushes have none. LAYER_MASK changes that keep the
+     * mixer input size are applied to the running layer, other LAYER_MASK
+     * changes restart just the layer on its open node, and the rest
+     * reopen it through m_reset().
+     */
+    enum HDMI_CHANGE {
+        HDMI_CHANGE_SRC_SIZE   = 1 << 0,
+        HDMI_CHANGE_FORMAT     = 1 << 1,
+        HDMI_CHANGE_DST_RECT   = 1 << 2,
+        HDMI_CHANGE_ROTATION   = 1 << 3,   // FIMC rotation of the video layer
+        HDMI_CHANGE_RESOLUTION = 1 << 4,
+        HDMI_CHANGE_OUTPUT     = 1 << 5,   // output mode, resolution, HDCP
+        HDMI_CHANGE_OPEN       = 1 << 6,   // layer node not open yet
+        HDMI_CHANGE_LAYER_MASK = HDMI_CHANGE_SRC_SIZE | HDMI_CHANGE_FORMAT |
+                                 HDMI_CHANGE_DST_RECT | HDMI_CHANGE_ROTATION,
+    };
+
+    enum {
+        HDMI_CHANGE_CAUSES    = 7,
+        HDMI_RECONFIG_BUCKETS = 10,        // <1ms, <2ms, ... <256ms, more
+    };
+
+    enum HDMI_RECONFIG {
+        HDMI_RECONFIG_APPLY   = 0,         // m_applyLayer()
+        HDMI_RECONFIG_LAYER,               // m_resetLayer()
+        HDMI_RECONFIG_RESET,               // m_reset()
+        HDMI_RECONFIG_LEVELS,
+    };
+
+    struct reconfig_stats {
+        unsigned int flushes;
+        unsigned int addr_only;
+        unsigned int causes[HDMI_CHANGE_CAUSES];
+        unsigned int count[HDMI_RECONFIG_LEVELS];
+        unsigned int failed[HDMI_RECONFIG_LEVELS];
+        unsigned int hist[HDMI_RECONFIG_LEVELS][HDMI_RECONFIG_BUCKETS];
+        nsecs_t      sum[HDMI_RECONFIG_LEVELS];
+        nsecs_t      max[HDMI_RECONFIG_LEVELS];
+    };
+
 private :
     class CECThread: public Thread
     {
@@ -166,6 +208,7 @@ private :
     int          mDstHeight[HDMI_LAYER_MAX];
     int          mPrevDstWidth[HDMI_LAYER_MAX];
     int          mPrevDstHeight[HDMI_LAYER_MAX];
+    unsigned int mLayerRotVal[HDMI_LAYER_MAX];
 
     int          mDefaultFBFd;
     int          mDisplayWidth;
@@ -173,6 +216,8 @@ private :
 
     struct v4l2_rect mDstRect;
 
+    struct reconfig_stats mReconfigStats;
+
 public :
 
     SecHdmi();
@@ -200,9 +245,23 @@ public :
     bool        setUIRotation(unsigned int rotVal, unsigned int hwcLayer);
     bool        setDisplaySize(int width, int height);
 
+    void        getReconfigStats(struct reconfig_stats *stats);
+    status_t    dump(int fd);
+
 private:
 
-    bool        m_reset(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer);
+    unsigned int m_layerChanges(int w, int h, int colorFormat, int hdmiLayer);
+    bool        m_reset(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer,
+                        unsigned int change);
+    int         m_reconfigLevel(unsigned int change, int hdmiLayer);
+    bool        m_applyLayer(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer,
+                             unsigned int change);
+    bool        m_resetLayer(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer);
+    bool        m_setFimcParams(int w, int h, int colorFormat);
+    bool        m_setLayerParams(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer);
+    void        m_graphicDstRect(int w, int h, int hwcLayer, struct v4l2_rect *rect);
+    bool        m_setLayerCrop(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer);
+    void        m_addReconfigStat(unsigned int change, int level, bool ok, nsecs_t time);
     bool        m_startHdmi(int hdmiLayer, unsigned int num_of_plane);
     bool        m_startHdmi(int hdmiLayer);
     bool        m_stopHdmi(int hdmiLayer);
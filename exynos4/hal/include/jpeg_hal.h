@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
+#include <poll.h>
+#include <sys/types.h>
 #include "videodev2.h"
 
 #define JPEG_DEC_NODE        "/dev/video11"
 #define JPEG_ENC_NODE        "/dev/video12"
 
 #define JPEG_MAX_PLANE_CNT          3
+#define JPEG_MAX_JOBS               8
 #define JPEG_DEC_OUT_BYTE_ALIGN     8
 
 //#define JPEG_PERF_MEAS
@@ -109,9 +112,52 @@ struct jpeg_config {
     int                         reserved[8];
 };
 
+/*
+ * Buffer pairs for asynchronous jobs on one node. Pair i is in_bufs[i] ->
+ * out_bufs[i]; the node is streamed on by the first job and stays on until
+ * jpeghal_queue_deinit(), and jobs complete in the order they were queued.
+ */
+typedef void (*jpeg_job_cb)(void *cookie, int index, int size);
+
+enum jpeg_pair_state {
+    JPEG_PAIR_FREE,
+    JPEG_PAIR_QUEUED,
+    JPEG_PAIR_ORPHAN,                   // the driver holds the input until the node is reset
+};
+
+struct jpeg_queue {
+    int                 fd;
+    int                 count;
+    struct jpeg_buf     in_bufs[JPEG_MAX_JOBS];
+    struct jpeg_buf     out_bufs[JPEG_MAX_JOBS];
+    enum jpeg_pair_state state[JPEG_MAX_JOBS];
+    int                 queued;         // jobs in flight
+    int                 streaming;
+    int                 orphans;        // pairs in JPEG_PAIR_ORPHAN
+    int                 no_payload;     // driver leaves bytesused at 0, one job in flight at a time
+
+    jpeg_job_cb         cb;             // for jpeghal_poll_jobs()
+    void                *cookie;
+};
+
+/*
+ * Device calls made by libhwjpeg, the system calls by default. Host tests
+ * swap in a fake node with jpeghal_set_dev_ops(); NULL restores the default.
+ */
+struct jpeg_dev_ops {
+    int     (*open)(const char *path, int flags);
+    int     (*close)(int fd);
+    int     (*ioctl)(int fd, unsigned long request, void *arg);
+    int     (*poll)(struct pollfd *fds, nfds_t nfds, int timeout);
+    void   *(*mmap)(void *addr, size_t len, int prot, int flags, int fd, off_t offset);
+    int     (*munmap)(void *addr, size_t len);
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
+void jpeghal_set_dev_ops(const struct jpeg_dev_ops *ops);
+
 int jpeghal_dec_init();
 int jpeghal_enc_init();
 
@@ -128,6 +174,28 @@ int jpeghal_enc_exe(int fd, struct jpeg_buf *in_buf, struct jpeg_buf *out_buf);
 
 int jpeghal_deinit(int fd, struct jpeg_buf *in_buf, struct jpeg_buf *out_buf);
 
+/*
+ * Asynchronous jobs, after jpeghal_enc_setconfig()/jpeghal_dec_setconfig().
+ * USERPTR buffers get their start/length filled in by the caller before
+ * each jpeghal_queue_job(). While the driver holds the input of a pair
+ * without its output, no further job is accepted until the jobs in flight
+ * have been dequeued and the node was reset. A completed job reports the
+ * size of its output, -1 if the device flagged an error or the size is
+ * unknown. A driver that leaves bytesused at 0 limits the queue to one
+ * job in flight from the first such job on. jpeghal_dequeue_job() returns
+ * 1 for a completed job and 0 on timeout, jpeghal_poll_jobs() hands every
+ * completed job to queue->cb and returns how many there were.
+ * jpeghal_queue_deinit() releases the buffers and closes fd, also after a
+ * failed jpeghal_queue_init().
+ */
+int jpeghal_queue_init(struct jpeg_queue *queue, int fd, int count,
+                       struct jpeg_buf_info *in_info, struct jpeg_buf_info *out_info);
+int jpeghal_queue_get_free(struct jpeg_queue *queue);
+int jpeghal_queue_job(struct jpeg_queue *queue, int index);
+int jpeghal_dequeue_job(struct jpeg_queue *queue, int timeout, int *index, int *size);
+int jpeghal_poll_jobs(struct jpeg_queue *queue, int timeout);
+int jpeghal_queue_deinit(struct jpeg_queue *queue);
+
 int jpeghal_s_ctrl(int fd, int cid, int value);
 int jpeghal_g_ctrl(int fd, int id);
 
@@ -8,12 +8,14 @@ include $(CLEAR_VARS)
 LOCAL_MODULE_PATH := $(TARGET_OUT_SHARED_LIBRARIES)/hw
 
 LOCAL_C_INCLUDES += $(LOCAL_PATH)/../include \
-	system/media/camera/include
+	system/media/camera/include \
+	$(TARGET_OUT_HEADERS)/libsecmm
 
 LOCAL_SRC_FILES:= \
 	SecCamera.cpp SecCameraHWInterface.cpp
 
 LOCAL_SHARED_LIBRARIES:= libutils libcutils libbinder liblog libcamera_client libhardware
+LOCAL_STATIC_LIBRARIES := libseccscapi
 
 ifeq ($(TARGET_SOC), exynos4210)
 LOCAL_SHARED_LIBRARIES += libs5pjpeg
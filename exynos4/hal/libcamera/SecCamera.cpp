@@ -95,6 +95,78 @@ static int close_buffers(struct SecBuffer *buffers, int num_of_buf)
     return 0;
 }
 
+#ifndef BOARD_USE_V4L2
+/*
+ * What m.userptr points to for V4L2_MEMORY_USERPTR capture buffers on the
+ * FIMC driver, same layout as its struct fimc_buf: physical plane addresses.
+ */
+struct fimc_userptr_buf {
+    unsigned int base[3];
+    size_t       length[3];
+};
+
+static int fimc_v4l2_reqbufs_userptr(int fp, enum v4l2_buf_type type, int nr_bufs)
+{
+    struct v4l2_requestbuffers req;
+
+    req.count = nr_bufs;
+    req.type = type;
+    req.memory = V4L2_MEMORY_USERPTR;
+
+    if (ioctl(fp, VIDIOC_REQBUFS, &req) < 0) {
+        ALOGE("ERR(%s):VIDIOC_REQBUFS failed", __func__);
+        return -1;
+    }
+
+    return req.count;
+}
+
+static int fimc_v4l2_qbuf_userptr(int fp, struct SecBuffer *buffers, int index)
+{
+    struct v4l2_buffer v4l2_buf;
+    struct fimc_userptr_buf buf;
+    int ret;
+
+    for (int i = 0; i < 3; i++) {
+        buf.base[i] = buffers[index].phys.extP[i];
+        buf.length[i] = buffers[index].size.extS[i];
+    }
+
+    memset(&v4l2_buf, 0, sizeof(v4l2_buf));
+    v4l2_buf.type = V4L2_BUF_TYPE;
+    v4l2_buf.memory = V4L2_MEMORY_USERPTR;
+    v4l2_buf.index = index;
+    v4l2_buf.m.userptr = (unsigned long)&buf;
+    v4l2_buf.length = sizeof(buf);
+
+    ret = ioctl(fp, VIDIOC_QBUF, &v4l2_buf);
+    if (ret < 0) {
+        ALOGE("ERR(%s):VIDIOC_QBUF failed", __func__);
+        return ret;
+    }
+
+    return 0;
+}
+
+static int fimc_v4l2_dqbuf_userptr(int fp)
+{
+    struct v4l2_buffer v4l2_buf;
+    int ret;
+
+    memset(&v4l2_buf, 0, sizeof(v4l2_buf));
+    v4l2_buf.type = V4L2_BUF_TYPE;
+    v4l2_buf.memory = V4L2_MEMORY_USERPTR;
+
+    ret = ioctl(fp, VIDIOC_DQBUF, &v4l2_buf);
+    if (ret < 0) {
+        ALOGE("ERR(%s):VIDIOC_DQBUF failed, dropped frame", __func__);
+        return ret;
+    }
+
+    return v4l2_buf.index;
+}
+#endif
+
 static int get_pixel_depth(unsigned int fmt)
 {
     int depth = 0;
@@ -720,6 +792,10 @@ SecCamera::SecCamera() :
             m_touch_af_start_stop(-1),
             m_postview_offset(0),
             m_auto_focus_state(0)
+#ifndef BOARD_USE_V4L2
+            ,
+            m_preview_userptr(false)
+#endif
 #ifdef ENABLE_ESD_PREVIEW_CHECK
             ,
             m_esd_check_count(0)
@@ -731,6 +807,22 @@ SecCamera::SecCamera() :
     memset(&m_events_c, 0, sizeof(m_events_c));
     memset(&m_events_c2, 0, sizeof(m_events_c2));
     memset(&m_events_c3, 0, sizeof(m_events_c3));
+
+#ifdef SAMSUNG_EXYNOS4210
+    m_jpeg_thumb_buf = NULL;
+    m_jpeg_thumb_buf_size = 0;
+    m_jpeg_opens = 0;
+    m_jpeg_encodes = 0;
+#endif
+#ifdef SAMSUNG_EXYNOS4x12
+    memset(&m_jpeg_main, 0, sizeof(m_jpeg_main));
+    memset(&m_jpeg_thumb, 0, sizeof(m_jpeg_thumb));
+    m_jpeg_main.queue.fd = -1;
+    m_jpeg_thumb.queue.fd = -1;
+    m_jpeg_main_copy = NULL;
+    m_jpeg_main_copy_size = 0;
+    m_jpeg_thumb_deferred = 0;
+#endif
 }
 
 SecCamera::~SecCamera()
@@ -911,6 +1003,8 @@ bool SecCamera::DestroyCamera()
     } else
         ALOGI("%s : already deinitialized", __func__);
 
+    closeJpeg();
+
     return 0;
 }
 
@@ -1049,12 +1143,26 @@ int SecCamera::startPreview(void)
     CHECK(ret);
 #endif
 
+#ifndef BOARD_USE_V4L2
+    if (m_preview_userptr) {
+        /* frames go straight into the buffers set by setUserBufferPhys() */
+        ret = fimc_v4l2_reqbufs_userptr(m_cam_fd, V4L2_BUF_TYPE, MAX_BUFFERS);
+        CHECK(ret);
+    } else {
+        ret = fimc_v4l2_reqbufs(m_cam_fd, V4L2_BUF_TYPE, MAX_BUFFERS);
+        CHECK(ret);
+
+        ret = fimc_v4l2_querybuf(m_cam_fd, m_buffers_preview, V4L2_BUF_TYPE, MAX_BUFFERS, PREVIEW_NUM_PLANE);
+        CHECK(ret);
+    }
+#else
     ret = fimc_v4l2_reqbufs(m_cam_fd, V4L2_BUF_TYPE, MAX_BUFFERS);
     CHECK(ret);
 
 #ifndef BOARD_USE_V4L2_ION
     ret = fimc_v4l2_querybuf(m_cam_fd, m_buffers_preview, V4L2_BUF_TYPE, MAX_BUFFERS, PREVIEW_NUM_PLANE);
     CHECK(ret);
+#endif
 #endif
 
     ALOGV("%s : m_preview_width: %d m_preview_height: %d m_angle: %d",
@@ -1064,6 +1172,11 @@ int SecCamera::startPreview(void)
 
     /* start with all buffers in queue */
     for (int i = 0; i < MAX_BUFFERS; i++) {
+#ifndef BOARD_USE_V4L2
+        if (m_preview_userptr)
+            ret = fimc_v4l2_qbuf_userptr(m_cam_fd, m_buffers_preview, i);
+        else
+#endif
         ret = fimc_v4l2_qbuf(m_cam_fd, m_preview_width, m_preview_height, m_buffers_preview, i, PREVIEW_NUM_PLANE, PREVIEW_MODE);
         CHECK(ret);
     }
@@ -1144,6 +1257,11 @@ int SecCamera::stopPreview(void)
 
     close_buffers(m_buffers_preview, MAX_BUFFERS);
 
+#ifndef BOARD_USE_V4L2
+    if (m_preview_userptr)
+        fimc_v4l2_reqbufs_userptr(m_cam_fd, V4L2_BUF_TYPE, 0);
+    else
+#endif
     fimc_v4l2_reqbufs(m_cam_fd, V4L2_BUF_TYPE, 0);
 
     m_flag_camera_start = 0;
@@ -1453,6 +1571,34 @@ void SecCamera::setUserBufferAddr(void *ptr, int index, int mode)
 }
 #endif
 
+#ifndef BOARD_USE_V4L2
+/*
+ * Capture preview frames into caller-owned, physically contiguous buffers
+ * instead of the driver's own. Only takes effect on the next startPreview().
+ */
+void SecCamera::setPreviewUserPtr(bool enable)
+{
+    if (m_flag_camera_start) {
+        ALOGE("ERR(%s):Preview is running", __func__);
+        return;
+    }
+    m_preview_userptr = enable;
+}
+
+bool SecCamera::getPreviewUserPtr(void)
+{
+    return m_preview_userptr;
+}
+
+void SecCamera::setUserBufferPhys(const SecBuffer *buf, int index)
+{
+    for (int i = 0; i < 3; i++) {
+        m_buffers_preview[index].phys.extP[i] = buf->phys.extP[i];
+        m_buffers_preview[index].size.extS[i] = buf->size.extS[i];
+    }
+}
+#endif
+
 int SecCamera::getPreview(camera_frame_metadata_t *facedata)
 {
     int index;
@@ -1485,6 +1631,11 @@ int SecCamera::getPreview(camera_frame_metadata_t *facedata)
         }
     }
 
+#ifndef BOARD_USE_V4L2
+    if (m_preview_userptr)
+        index = fimc_v4l2_dqbuf_userptr(m_cam_fd);
+    else
+#endif
     index = fimc_v4l2_dqbuf(m_cam_fd, PREVIEW_NUM_PLANE);
     if (!(0 <= index && index < MAX_BUFFERS)) {
         ALOGE("ERR(%s):wrong index = %d", __func__, index);
@@ -1503,6 +1654,13 @@ int SecCamera::getPreview(camera_frame_metadata_t *facedata)
 int SecCamera::setPreviewFrame(int index)
 {
     int ret;
+#ifndef BOARD_USE_V4L2
+    if (m_preview_userptr) {
+        ret = fimc_v4l2_qbuf_userptr(m_cam_fd, m_buffers_preview, index);
+        CHECK(ret);
+        return ret;
+    }
+#endif
     ret = fimc_v4l2_qbuf(m_cam_fd, m_preview_width, m_preview_height, m_buffers_preview, index, PREVIEW_NUM_PLANE, PREVIEW_MODE);
     CHECK(ret);
 
@@ -1751,15 +1909,25 @@ unsigned char* SecCamera::getJpeg(int *jpeg_size,
     return addr;
 }
 
-int SecCamera::getExif(unsigned char *pExifDst, unsigned char *pThumbSrc, int thumbSize)
+#if defined(SAMSUNG_EXYNOS4210) || defined(SAMSUNG_EXYNOS4x12)
+static int jpegQualityLevel(int quality)
 {
+    if (quality >= 90)
+        return QUALITY_LEVEL_1;
+    else if (quality >= 80)
+        return QUALITY_LEVEL_2;
+    else if (quality >= 70)
+        return QUALITY_LEVEL_3;
+    else
+        return QUALITY_LEVEL_4;
+}
+#endif
+
 #ifdef SAMSUNG_EXYNOS4210
-    /* JPEG encode for smdkv310 */
-    if (m_jpeg_fd > 0) {
-        if (api_jpeg_encode_deinit(m_jpeg_fd) != JPEG_OK)
-            ALOGE("ERR(%s):Fail on api_jpeg_encode_deinit", __func__);
-        m_jpeg_fd = 0;
-    }
+int SecCamera::openJpeg(void)
+{
+    if (m_jpeg_fd > 0)
+        return 0;
 
     m_jpeg_fd = api_jpeg_encode_init();
     ALOGV("(%s):JPEG device open ID = %d", __func__, m_jpeg_fd);
@@ -1774,11 +1942,26 @@ int SecCamera::getExif(unsigned char *pExifDst, unsigned char *pThumbSrc, int th
         return -1;
     }
 
+    m_jpeg_opens++;
+    return 0;
+}
+
+/*
+ * Encodes src on the shared libs5pjpeg context. The stream is left in the
+ * context's output buffer, which the next encode overwrites.
+ */
+int SecCamera::runJpeg(unsigned char *src, unsigned int src_size,
+                       int width, int height, int quality,
+                       unsigned char **jpeg_buf)
+{
     if (m_snapshot_v4lformat == V4L2_PIX_FMT_RGB565) {
         ALOGE("ERR(%s):It doesn't support V4L2_PIX_FMT_RGB565", __func__);
         return -1;
     }
 
+    if (openJpeg() < 0)
+        return -1;
+
     struct jpeg_enc_param    enc_param;
     enum jpeg_frame_format inFormat = YUV_422;
     enum jpeg_stream_format outFormat = JPEG_422;
@@ -1801,24 +1984,16 @@ int SecCamera::getExif(unsigned char *pExifDst, unsigned char *pThumbSrc, int th
     }
 
     // set encode parameters //
-    enc_param.width = m_jpeg_thumbnail_width;
-    enc_param.height = m_jpeg_thumbnail_width;
+    memset(&enc_param, 0, sizeof(enc_param));
+    enc_param.width = width;
+    enc_param.height = height;
     enc_param.in_fmt = inFormat; // YCBCR Only
     enc_param.out_fmt = outFormat;
-
-    if (m_jpeg_thumbnail_quality >= 90)
-        enc_param.quality = QUALITY_LEVEL_1;
-    else if (m_jpeg_thumbnail_quality >= 80)
-        enc_param.quality = QUALITY_LEVEL_2;
-    else if (m_jpeg_thumbnail_quality >= 70)
-        enc_param.quality = QUALITY_LEVEL_3;
-    else
-        enc_param.quality = QUALITY_LEVEL_4;
+    enc_param.quality = (enum jpeg_img_quality_level)jpegQualityLevel(quality);
 
     api_jpeg_set_encode_param(&enc_param);
 
-    unsigned int thumbnail_size = m_jpeg_thumbnail_width * m_jpeg_thumbnail_height * 2;
-    unsigned char *pInBuf = (unsigned char *)api_jpeg_get_encode_in_buf(m_jpeg_fd, thumbnail_size);
+    unsigned char *pInBuf = (unsigned char *)api_jpeg_get_encode_in_buf(m_jpeg_fd, src_size);
     if (pInBuf == NULL) {
         ALOGE("ERR(%s):JPEG input buffer is NULL!!", __func__);
         return -1;
@@ -1830,7 +2005,7 @@ int SecCamera::getExif(unsigned char *pExifDst, unsigned char *pThumbSrc, int th
         return -1;
     }
 
-    memcpy(pInBuf, pThumbSrc, thumbnail_size);
+    memcpy(pInBuf, src, src_size);
 
     enum jpeg_ret_type result = api_jpeg_encode_exe(m_jpeg_fd, &enc_param);
     if (result != JPEG_ENCODE_OK) {
@@ -1838,136 +2013,302 @@ int SecCamera::getExif(unsigned char *pExifDst, unsigned char *pThumbSrc, int th
         return -1;
     }
 
-    unsigned int outbuf_size = enc_param.size;
-    unsigned int exifSize;
+    m_jpeg_encodes++;
+    *jpeg_buf = pOutBuf;
+    return enc_param.size;
+}
+#endif
 
-    setExifChangedAttribute();
+#ifdef SAMSUNG_EXYNOS4x12
+/*
+ * Makes sure session is open and configured for this encode. The node is
+ * only reopened when the size, format, quality or input memory type
+ * changes, so a burst at one picture size keeps its buffers mapped and the
+ * node streaming.
+ */
+int SecCamera::openJpegSession(struct jpeg_session *session, int width, int height,
+                               int quality, enum v4l2_memory in_memory, int cacheable)
+{
+    if (m_snapshot_v4lformat == V4L2_PIX_FMT_RGB565) {
+        ALOGE("ERR(%s):It doesn't support V4L2_PIX_FMT_RGB565", __func__);
+        return -1;
+    }
 
-    ALOGV("%s: calling jpgEnc.makeExif, mExifInfo.width set to %d, height to %d",
-         __func__, mExifInfo.width, mExifInfo.height);
+    int outFormat;
+    struct jpeg_buf_info in_info, out_info;
 
-    ALOGV("%s : enableThumb set to true", __func__);
-    mExifInfo.enableThumb = true;
+    switch (m_snapshot_v4lformat) {
+    case V4L2_PIX_FMT_NV12:
+    case V4L2_PIX_FMT_NV21:
+    case V4L2_PIX_FMT_NV12T:
+    case V4L2_PIX_FMT_YUV420:
+        outFormat = V4L2_PIX_FMT_JPEG_420;
+        break;
+    case V4L2_PIX_FMT_YUYV:
+    case V4L2_PIX_FMT_UYVY:
+    case V4L2_PIX_FMT_YUV422P:
+    default:
+        outFormat = V4L2_PIX_FMT_JPEG_422;
+        break;
+    }
 
-    makeExif(pExifDst, pOutBuf, outbuf_size, &mExifInfo, &exifSize, true);
-#endif
+    enum jpeg_quality_level qual = (enum jpeg_quality_level)jpegQualityLevel(quality);
 
-#ifdef SAMSUNG_EXYNOS4x12
-    /* JPEG encode for smdk4x12 */
-    unsigned int exifSize;
+    if (session->queue.fd > 0 &&
+        session->config.width == width &&
+        session->config.height == height &&
+        session->config.enc_qual == qual &&
+        session->config.pix.enc_fmt.in_fmt == m_snapshot_v4lformat &&
+        session->config.pix.enc_fmt.out_fmt == outFormat &&
+        session->queue.in_bufs[0].memory == in_memory)
+        return 0;
 
-    if (m_camera_use_ISP) {
-        ALOGV("%s : m_jpeg_thumbnail_width = %d, height = %d",
-             __func__, m_jpeg_thumbnail_width, m_jpeg_thumbnail_height);
-        m_jpeg_fd = jpeghal_enc_init();
-        ALOGV("(%s):JPEG device open ID = %d", __func__, m_jpeg_fd);
-
-        if (m_jpeg_fd <= 0) {
-            if (m_jpeg_fd < 0) {
-                m_jpeg_fd = 0;
-                ALOGE("ERR(%s):Cannot open a jpeg device file", __func__);
-                return -1;
-            }
-            ALOGE("ERR(%s):JPEG device was closed", __func__);
-            return -1;
-        }
+    closeJpegSession(session);
 
-        if (m_snapshot_v4lformat == V4L2_PIX_FMT_RGB565) {
-            ALOGE("ERR(%s):It doesn't support V4L2_PIX_FMT_RGB565", __func__);
-            return -1;
-        }
+    if (width & (16 - 1)) {
+        ALOGE("ERR(%s): Image width should be multiple of 16", __func__);
+        return -1;
+    }
 
-        struct jpeg_config    enc_config;
-        int outFormat;
+    memset(&session->queue, 0, sizeof(session->queue));
+    session->queue.fd = jpeghal_enc_init();
+    ALOGV("(%s):JPEG device open ID = %d", __func__, session->queue.fd);
 
-        switch (m_snapshot_v4lformat) {
-        case V4L2_PIX_FMT_NV12:
-        case V4L2_PIX_FMT_NV21:
-        case V4L2_PIX_FMT_NV12T:
-        case V4L2_PIX_FMT_YUV420:
-            outFormat = V4L2_PIX_FMT_JPEG_420;
-            break;
-        case V4L2_PIX_FMT_YUYV:
-        case V4L2_PIX_FMT_UYVY:
-        case V4L2_PIX_FMT_YUV422P:
-        default:
-            outFormat = V4L2_PIX_FMT_JPEG_422;
-            break;
-        }
+    if (session->queue.fd <= 0) {
+        session->queue.fd = -1;
+        ALOGE("ERR(%s):Cannot open a jpeg device file", __func__);
+        return -1;
+    }
 
-        // set encode parameters //
-        enc_config.mode = JPEG_ENCODE;
+    // set encode parameters //
+    memset(&session->config, 0, sizeof(session->config));
+    session->config.mode = JPEG_ENCODE;
+    session->config.enc_qual = qual;
+    session->config.width = width;
+    session->config.height = height;
+    session->config.num_planes = 1;
+    session->config.pix.enc_fmt.in_fmt = m_snapshot_v4lformat;
+    session->config.pix.enc_fmt.out_fmt = outFormat;
 
-        if (m_jpeg_thumbnail_quality >= 90)
-            enc_config.enc_qual = QUALITY_LEVEL_1;
-        else if (m_jpeg_thumbnail_quality >= 80)
-            enc_config.enc_qual = QUALITY_LEVEL_2;
-        else if (m_jpeg_thumbnail_quality >= 70)
-            enc_config.enc_qual = QUALITY_LEVEL_3;
-        else
-            enc_config.enc_qual = QUALITY_LEVEL_4;
+    if (jpeghal_enc_setconfig(session->queue.fd, &session->config) < 0) {
+        ALOGE("ERR(%s):Fail to configure JPEG encoder!!", __func__);
+        goto err;
+    }
 
-        enc_config.width = m_jpeg_thumbnail_width;
-        enc_config.height = m_jpeg_thumbnail_height;
-        enc_config.pix.enc_fmt.in_fmt = m_snapshot_v4lformat;
-        enc_config.pix.enc_fmt.out_fmt = outFormat;
+    if (jpeghal_s_ctrl(session->queue.fd, V4L2_CID_CACHEABLE, cacheable) < 0) {
+        ALOGE("ERR(%s):Fail on V4L2_CID_CACHEABLE", __func__);
+        goto err;
+    }
 
-        jpeghal_enc_setconfig(m_jpeg_fd, &enc_config);
+    memset(&in_info, 0, sizeof(in_info));
+    in_info.memory = in_memory;
+    in_info.num_planes = 1;
 
-        jpeghal_s_ctrl(m_jpeg_fd, V4L2_CID_CACHEABLE, 1);
+    memset(&out_info, 0, sizeof(out_info));
+    out_info.memory = V4L2_MEMORY_MMAP;
+    out_info.num_planes = 1;
 
-        struct jpeg_buf    m_jpeg_inbuf;
-        m_jpeg_inbuf.memory = V4L2_MEMORY_MMAP;
-        m_jpeg_inbuf.num_planes = 1;
+    if (jpeghal_queue_init(&session->queue, session->queue.fd, 1, &in_info, &out_info) < 0) {
+        ALOGE("ERR(%s):Fail to set up the JPEG buffers!!", __func__);
+        goto err;
+    }
 
-        if (jpeghal_set_inbuf(m_jpeg_fd, &m_jpeg_inbuf) < 0) {
-            ALOGE("ERR(%s):Fail to JPEG input buffer!!", __func__);
-            return -1;
-        }
+    session->opens++;
+    return 0;
 
-        struct jpeg_buf    m_jpeg_outbuf;
-        m_jpeg_outbuf.memory = V4L2_MEMORY_MMAP;
-        m_jpeg_outbuf.num_planes = 1;
+err:
+    closeJpegSession(session);
+    return -1;
+}
 
-        if (jpeghal_set_outbuf(m_jpeg_fd, &m_jpeg_outbuf) < 0) {
-            ALOGE("ERR(%s):Fail to JPEG output buffer!!", __func__);
-            return -1;
-        }
+// returns the size of the stream left in session->queue.out_bufs[0]
+int SecCamera::runJpegSession(struct jpeg_session *session)
+{
+    int index, size;
 
-        memcpy(m_jpeg_inbuf.start[0], pThumbSrc, m_jpeg_inbuf.length[0]);
+    // the node stays streaming from the first shot until closeJpegSession()
+    if (jpeghal_queue_job(&session->queue, 0) < 0 ||
+        jpeghal_dequeue_job(&session->queue, JPEG_ENCODE_TIMEOUT_MS, &index, &size) != 1 ||
+        size <= 0) {
+        ALOGE("ERR(%s):encode failed", __func__);
+        closeJpegSession(session);
+        return -1;
+    }
 
-        if (jpeghal_enc_exe(m_jpeg_fd, &m_jpeg_inbuf, &m_jpeg_outbuf) < 0) {
-            ALOGE("ERR(%s):encode failed", __func__);
-            return -1;
-        }
+    session->encodes++;
+    return size;
+}
+
+void SecCamera::closeJpegSession(struct jpeg_session *session)
+{
+    if (session->queue.fd > 0) {
+        if (jpeghal_queue_deinit(&session->queue) < 0)
+            ALOGE("ERR(%s):Fail on jpeghal_queue_deinit", __func__);
+    }
+    session->queue.fd = -1;
+}
+#endif
+
+void SecCamera::closeJpeg(void)
+{
+#ifdef SAMSUNG_EXYNOS4210
+    if (m_jpeg_fd > 0) {
+        if (api_jpeg_encode_deinit(m_jpeg_fd) != JPEG_OK)
+            ALOGE("ERR(%s):Fail on api_jpeg_encode_deinit", __func__);
+        m_jpeg_fd = 0;
+    }
+
+    free(m_jpeg_thumb_buf);
+    m_jpeg_thumb_buf = NULL;
+    m_jpeg_thumb_buf_size = 0;
+#endif
+
+#ifdef SAMSUNG_EXYNOS4x12
+    closeJpegSession(&m_jpeg_main);
+    closeJpegSession(&m_jpeg_thumb);
+
+    free(m_jpeg_main_copy);
+    m_jpeg_main_copy = NULL;
+    m_jpeg_main_copy_size = 0;
+#endif
+}
+
+/*
+ * Returns the size of the thumbnail JPEG and points jpeg_buf at it. The
+ * stream stays valid until the next encodeThumbnail() or closeJpeg(), and
+ * on Exynos4x12 may be encoded while encodeSnapshot() runs on another
+ * thread. Exynos4210 has a single encoder context, so there the thumbnail
+ * has to be encoded before the main image. On Exynos4x12, if the second
+ * encoder node can't be opened, JPEG_THUMB_DEFERRED is returned and the
+ * caller encodes the thumbnail with encodeThumbnailAfterSnapshot().
+ */
+int SecCamera::encodeThumbnail(unsigned char *pThumbSrc, int thumbSize,
+                               unsigned char **jpeg_buf)
+{
+#ifdef SAMSUNG_EXYNOS4210
+    unsigned char *pOutBuf;
+    unsigned int thumbnail_size = m_jpeg_thumbnail_width * m_jpeg_thumbnail_height * 2;
+
+    int outbuf_size = runJpeg(pThumbSrc, thumbnail_size,
+                              m_jpeg_thumbnail_width, m_jpeg_thumbnail_height,
+                              m_jpeg_thumbnail_quality, &pOutBuf);
+    if (outbuf_size < 0)
+        return -1;
 
-        int outbuf_size = jpeghal_g_ctrl(m_jpeg_fd, V4L2_CID_CAM_JPEG_ENCODEDSIZE);
-        if (outbuf_size < 0) {
-            ALOGE("ERR(%s): jpeghal_g_ctrl fail on V4L2_CID_CAM_JPEG_ENCODEDSIZE", __func__);
+    // the main image is encoded into the same output buffer
+    if (m_jpeg_thumb_buf_size < (unsigned int)outbuf_size) {
+        free(m_jpeg_thumb_buf);
+        m_jpeg_thumb_buf = (unsigned char *)malloc(outbuf_size);
+        if (m_jpeg_thumb_buf == NULL) {
+            m_jpeg_thumb_buf_size = 0;
+            ALOGE("ERR(%s):Fail to allocate %d bytes", __func__, outbuf_size);
             return -1;
         }
+        m_jpeg_thumb_buf_size = outbuf_size;
+    }
+    memcpy(m_jpeg_thumb_buf, pOutBuf, outbuf_size);
 
-        setExifChangedAttribute();
+    *jpeg_buf = m_jpeg_thumb_buf;
+    return outbuf_size;
+#elif defined(SAMSUNG_EXYNOS4x12)
+    if (!m_camera_use_ISP) {
+        // the sensor already delivers a JPEG thumbnail
+        *jpeg_buf = pThumbSrc;
+        return thumbSize;
+    }
 
-        ALOGV("%s: calling jpgEnc.makeExif, mExifInfo.width set to %d, height to %d",
-             __func__, mExifInfo.width, mExifInfo.height);
+    ALOGV("%s : m_jpeg_thumbnail_width = %d, height = %d",
+         __func__, m_jpeg_thumbnail_width, m_jpeg_thumbnail_height);
 
-        ALOGV("%s : enableThumb set to true", __func__);
-        mExifInfo.enableThumb = true;
+    if (openJpegSession(&m_jpeg_thumb, m_jpeg_thumbnail_width, m_jpeg_thumbnail_height,
+                        m_jpeg_thumbnail_quality, V4L2_MEMORY_MMAP, 1) < 0) {
+        ALOGW("%s: no second JPEG session, thumbnail deferred to the main one", __func__);
+        m_jpeg_thumb_deferred++;
+        return JPEG_THUMB_DEFERRED;
+    }
 
-        makeExif(pExifDst, (unsigned char *)m_jpeg_outbuf.start[0], (unsigned int)outbuf_size, &mExifInfo, &exifSize, true);
+    if (thumbSize > m_jpeg_thumb.queue.in_bufs[0].length[0])
+        thumbSize = m_jpeg_thumb.queue.in_bufs[0].length[0];
+    memcpy(m_jpeg_thumb.queue.in_bufs[0].start[0], pThumbSrc, thumbSize);
 
-        if (m_jpeg_fd > 0) {
-            if (jpeghal_deinit(m_jpeg_fd, &m_jpeg_inbuf, &m_jpeg_outbuf) < 0)
-                ALOGE("ERR(%s):Fail on api_jpeg_encode_deinit", __func__);
-            m_jpeg_fd = 0;
+    int outbuf_size = runJpegSession(&m_jpeg_thumb);
+    if (outbuf_size < 0)
+        return -1;
+
+    *jpeg_buf = (unsigned char *)m_jpeg_thumb.queue.out_bufs[0].start[0];
+    return outbuf_size;
+#else
+    *jpeg_buf = pThumbSrc;
+    return thumbSize;
+#endif
+}
+
+/*
+ * Sequential fallback for JPEG_THUMB_DEFERRED: moves the main stream out of
+ * m_jpeg_main, then encodes the thumbnail on it. On return snapshot_jpeg
+ * points at the moved main stream; both stay valid until the next encode
+ * or closeJpeg(). The main session is reconfigured for the next shot.
+ */
+int SecCamera::encodeThumbnailAfterSnapshot(unsigned char *pThumbSrc, int thumbSize,
+                                            unsigned char **jpeg_buf,
+                                            unsigned char **snapshot_jpeg,
+                                            int snapshot_size)
+{
+#ifdef SAMSUNG_EXYNOS4x12
+    if (snapshot_size <= 0)
+        return -1;
+
+    if (m_jpeg_main_copy_size < (unsigned int)snapshot_size) {
+        free(m_jpeg_main_copy);
+        m_jpeg_main_copy = (unsigned char *)malloc(snapshot_size);
+        if (m_jpeg_main_copy == NULL) {
+            m_jpeg_main_copy_size = 0;
+            ALOGE("ERR(%s):Fail to allocate %d bytes", __func__, snapshot_size);
+            return -1;
         }
-    } else {
-        setExifChangedAttribute();
-        mExifInfo.enableThumb = true;
-        makeExif(pExifDst, pThumbSrc, (unsigned int)thumbSize, &mExifInfo, &exifSize, true);
+        m_jpeg_main_copy_size = snapshot_size;
     }
+    memcpy(m_jpeg_main_copy, *snapshot_jpeg, snapshot_size);
+    *snapshot_jpeg = m_jpeg_main_copy;
+
+    if (openJpegSession(&m_jpeg_main, m_jpeg_thumbnail_width, m_jpeg_thumbnail_height,
+                        m_jpeg_thumbnail_quality, V4L2_MEMORY_MMAP, 1) < 0)
+        return -1;
+
+    if (thumbSize > m_jpeg_main.queue.in_bufs[0].length[0])
+        thumbSize = m_jpeg_main.queue.in_bufs[0].length[0];
+    memcpy(m_jpeg_main.queue.in_bufs[0].start[0], pThumbSrc, thumbSize);
+
+    int outbuf_size = runJpegSession(&m_jpeg_main);
+    if (outbuf_size < 0)
+        return -1;
+
+    *jpeg_buf = (unsigned char *)m_jpeg_main.queue.out_bufs[0].start[0];
+    return outbuf_size;
+#else
+    return -1;
 #endif
+}
+
+/*
+ * Builds the EXIF APP1 segment around an already encoded thumbnail and
+ * returns its size. With pThumbJpeg NULL the last thumbJpegSize bytes are
+ * left for the caller to fill, so the thumbnail can be copied once,
+ * straight into the final picture.
+ */
+int SecCamera::getExif(unsigned char *pExifDst, unsigned char *pThumbJpeg, int thumbJpegSize)
+{
+    unsigned int exifSize;
+
+    setExifChangedAttribute();
+
+    ALOGV("%s: calling jpgEnc.makeExif, mExifInfo.width set to %d, height to %d",
+         __func__, mExifInfo.width, mExifInfo.height);
+
+    ALOGV("%s : enableThumb set to true", __func__);
+    mExifInfo.enableThumb = true;
+
+    makeExif(pExifDst, pThumbJpeg, (unsigned int)thumbJpegSize, &mExifInfo, &exifSize, true);
 
     return exifSize;
 }
@@ -1993,40 +2334,21 @@ int SecCamera::getPostViewOffset(void)
     return m_postview_offset;
 }
 
-int SecCamera::getSnapshotAndJpeg(SecBuffer *yuv_buf, int index, unsigned char *jpeg_buf,
-                                            int *output_size)
+/*
+ * Takes the picture into yuv_buf and returns the capture buffer index. With
+ * ZERO_SHUTTER_LAG and the internal ISP the frame is already in yuv_buf.
+ */
+int SecCamera::captureSnapshot(SecBuffer *yuv_buf, int index)
 {
     ALOGV("%s :", __func__);
 
     int ret = 0;
-    int i;
 
 #ifdef ZERO_SHUTTER_LAG
-    if (!m_camera_use_ISP){
-        startSnapshot(yuv_buf);
-
-        index = getSnapshot();
-        if (index < 0) {
-            ALOGE("ERR(%s): Invalid index!", __func__);
-            return -1;
-        }
-
-#ifndef BOARD_USE_V4L2_ION
-        ret = fimc_v4l2_s_ctrl(m_cap_fd, V4L2_CID_STREAM_PAUSE, 0);
-        CHECK_PTR(ret);
-        ALOGV("snapshot dequeued buffer = %d snapshot_width = %d snapshot_height = %d",
-                index, m_snapshot_width, m_snapshot_height);
-
-        getCaptureAddr(index, yuv_buf);
+    if (m_camera_use_ISP)
+        return index;
 #endif
 
-       if (yuv_buf->virt.extP[0] == NULL) {
-           ALOGE("ERR(%s):Fail on SecCamera getCaptureAddr = %0x ",
-                __func__, yuv_buf->virt.extP[0]);
-           return UNKNOWN_ERROR;
-       }
-    }
-#else
     startSnapshot(yuv_buf);
 
     index = getSnapshot();
@@ -2037,7 +2359,7 @@ int SecCamera::getSnapshotAndJpeg(SecBuffer *yuv_buf, int index, unsigned char *
 
 #ifndef BOARD_USE_V4L2_ION
     ret = fimc_v4l2_s_ctrl(m_cap_fd, V4L2_CID_STREAM_PAUSE, 0);
-    CHECK_PTR(ret);
+    CHECK(ret);
     ALOGV("snapshot dequeued buffer = %d snapshot_width = %d snapshot_height = %d",
             index, m_snapshot_width, m_snapshot_height);
 
@@ -2047,223 +2369,74 @@ int SecCamera::getSnapshotAndJpeg(SecBuffer *yuv_buf, int index, unsigned char *
     if (yuv_buf->virt.extP[0] == NULL) {
         ALOGE("ERR(%s):Fail on SecCamera getCaptureAddr = %0x ",
              __func__, yuv_buf->virt.extP[0]);
-        return UNKNOWN_ERROR;
-    }
-#endif
-
-#ifdef SAMSUNG_EXYNOS4210
-    /* JPEG encode for smdkv310 */
-    if (m_jpeg_fd > 0) {
-        if (api_jpeg_encode_deinit(m_jpeg_fd) != JPEG_OK)
-            ALOGE("ERR(%s):Fail on api_jpeg_encode_deinit", __func__);
-        m_jpeg_fd = 0;
-    }
-
-    m_jpeg_fd = api_jpeg_encode_init();
-    ALOGV("(%s):JPEG device open ID = %d", __func__, m_jpeg_fd);
-
-    if (m_jpeg_fd <= 0) {
-        if (m_jpeg_fd < 0) {
-            m_jpeg_fd = 0;
-            ALOGE("ERR(%s):Cannot open a jpeg device file", __func__);
-            return -1;
-        }
-        ALOGE("ERR(%s):JPEG device was closed", __func__);
         return -1;
     }
 
-    if (m_snapshot_v4lformat == V4L2_PIX_FMT_RGB565) {
-        ALOGE("ERR(%s):It doesn't support V4L2_PIX_FMT_RGB565", __func__);
-        return -1;
-    }
-
-    struct jpeg_enc_param    enc_param;
-    enum jpeg_frame_format inFormat = YUV_422;
-    enum jpeg_stream_format outFormat = JPEG_422;
-
-    switch (m_snapshot_v4lformat) {
-    case V4L2_PIX_FMT_NV12:
-    case V4L2_PIX_FMT_NV21:
-    case V4L2_PIX_FMT_NV12T:
-    case V4L2_PIX_FMT_YUV420:
-        inFormat = YUV_420;
-        outFormat = JPEG_420;
-        break;
-    case V4L2_PIX_FMT_YUYV:
-    case V4L2_PIX_FMT_UYVY:
-    case V4L2_PIX_FMT_YUV422P:
-    default:
-        inFormat = YUV_422;
-        outFormat = JPEG_422;
-        break;
-    }
-
-    // set encode parameters //
-    enc_param.width = m_snapshot_width;
-    enc_param.height = m_snapshot_height;
-    enc_param.in_fmt = inFormat; // YCBCR Only
-    enc_param.out_fmt = outFormat;
+    return index;
+}
 
-    if (m_jpeg_quality >= 90)
-        enc_param.quality = QUALITY_LEVEL_1;
-    else if (m_jpeg_quality >= 80)
-        enc_param.quality = QUALITY_LEVEL_2;
-    else if (m_jpeg_quality >= 70)
-        enc_param.quality = QUALITY_LEVEL_3;
-    else
-        enc_param.quality = QUALITY_LEVEL_4;
+/*
+ * Encodes the captured picture and points jpeg_buf at the stream in the
+ * encoder's output buffer, valid until the next encode or closeJpeg().
+ */
+int SecCamera::encodeSnapshot(SecBuffer *yuv_buf, int index, unsigned char **jpeg_buf,
+                                            int *output_size)
+{
+    ALOGV("%s :", __func__);
 
-    api_jpeg_set_encode_param(&enc_param);
+    int ret = 0;
 
+#ifdef SAMSUNG_EXYNOS4210
+    /* JPEG encode for smdkv310 */
     unsigned int snapshot_size = m_snapshot_width * m_snapshot_height * 2;
-    unsigned char *pInBuf = (unsigned char *)api_jpeg_get_encode_in_buf(m_jpeg_fd, snapshot_size);
-    if (pInBuf == NULL) {
-        ALOGE("ERR(%s):JPEG input buffer is NULL!!", __func__);
-        return -1;
-    }
-
-    unsigned char *pOutBuf = (unsigned char *)api_jpeg_get_encode_out_buf(m_jpeg_fd);
-    if (pOutBuf == NULL) {
-        ALOGE("ERR(%s):JPEG output buffer is NULL!!", __func__);
-        return -1;
-    }
 
-    memcpy(pInBuf, yuv_buf->virt.extP[0], snapshot_size);
-
-    enum jpeg_ret_type result = api_jpeg_encode_exe(m_jpeg_fd, &enc_param);
-    if (result != JPEG_ENCODE_OK) {
-        ALOGE("ERR(%s):encode failed", __func__);
+    ret = runJpeg((unsigned char *)yuv_buf->virt.extP[0], snapshot_size,
+                  m_snapshot_width, m_snapshot_height, m_jpeg_quality, jpeg_buf);
+    if (ret < 0)
         return -1;
-    }
 
-    *output_size = enc_param.size;
-    memcpy(jpeg_buf, pOutBuf, *output_size);
+    *output_size = ret;
 #endif
 
 #ifdef SAMSUNG_EXYNOS4x12
     /* JPEG encode for smdk4x12 */
-    m_jpeg_fd = jpeghal_enc_init();
-    ALOGV("(%s):JPEG device open ID = %d", __func__, m_jpeg_fd);
-
-    if (m_jpeg_fd <= 0) {
-        if (m_jpeg_fd < 0) {
-            m_jpeg_fd = 0;
-            ALOGE("ERR(%s):Cannot open a jpeg device file", __func__);
-            return -1;
-        }
-        ALOGE("ERR(%s):JPEG device was closed", __func__);
-        return -1;
-    }
-
-    if (m_snapshot_v4lformat == V4L2_PIX_FMT_RGB565) {
-        ALOGE("ERR(%s):It doesn't support V4L2_PIX_FMT_RGB565", __func__);
-        return -1;
-    }
-
-    struct jpeg_config    enc_config;
-    int outFormat;
-
-    switch (m_snapshot_v4lformat) {
-    case V4L2_PIX_FMT_NV12:
-    case V4L2_PIX_FMT_NV21:
-    case V4L2_PIX_FMT_NV12T:
-    case V4L2_PIX_FMT_YUV420:
-        outFormat = V4L2_PIX_FMT_JPEG_420;
-        break;
-    case V4L2_PIX_FMT_YUYV:
-    case V4L2_PIX_FMT_UYVY:
-    case V4L2_PIX_FMT_YUV422P:
-    default:
-        outFormat = V4L2_PIX_FMT_JPEG_422;
-        break;
-    }
-
-    // set encode parameters //
-    enc_config.mode = JPEG_ENCODE;
-
-    if (m_jpeg_quality >= 90)
-        enc_config.enc_qual = QUALITY_LEVEL_1;
-    else if (m_jpeg_quality >= 80)
-        enc_config.enc_qual = QUALITY_LEVEL_2;
-    else if (m_jpeg_quality >= 70)
-        enc_config.enc_qual = QUALITY_LEVEL_3;
-    else
-        enc_config.enc_qual = QUALITY_LEVEL_4;
+    int width, height;
 
     if (!m_recording_en) {
-        enc_config.width = m_snapshot_width;
-        enc_config.height = m_snapshot_height;
+        width = m_snapshot_width;
+        height = m_snapshot_height;
     } else {
-        enc_config.width = m_videosnapshot_width;
-        enc_config.height = m_videosnapshot_height;
+        width = m_videosnapshot_width;
+        height = m_videosnapshot_height;
     }
-    enc_config.pix.enc_fmt.in_fmt = m_snapshot_v4lformat;
-    enc_config.pix.enc_fmt.out_fmt = outFormat;
-
-    jpeghal_enc_setconfig(m_jpeg_fd, &enc_config);
 
-    ret = jpeghal_s_ctrl(m_jpeg_fd, V4L2_CID_CACHEABLE, 3);
-    CHECK(ret);
-
-    struct jpeg_buf    m_jpeg_inbuf;
 #ifdef BOARD_USE_V4L2_ION
-    m_jpeg_inbuf.memory = V4L2_MEMORY_MMAP;
-    m_jpeg_inbuf.num_planes = 1;
-#else
-    m_jpeg_inbuf.start[0] = (void *)fimc_v4l2_s_ctrl(m_cap_fd, V4L2_CID_PADDR_Y, index);
-    m_jpeg_inbuf.length[0] = m_capture_buf[index].size.extS[0];
-    m_jpeg_inbuf.memory = V4L2_MEMORY_USERPTR;
-    m_jpeg_inbuf.num_planes = 1;
-#endif
-
-    if (jpeghal_set_inbuf(m_jpeg_fd, &m_jpeg_inbuf) < 0) {
-        ALOGE("ERR(%s):Fail to JPEG input buffer!!", __func__);
+    if (openJpegSession(&m_jpeg_main, width, height, m_jpeg_quality,
+                        V4L2_MEMORY_MMAP, 3) < 0)
         return -1;
-    }
 
-    for (i = 0; i < m_jpeg_inbuf.num_planes; i++) {
-        if ((unsigned int)m_jpeg_inbuf.start[i] & (SIZE_4K - 1)) {
-            ALOGE("ERR(%s): JPEG start address should be aligned to 4 Kbytes", __func__);
-            return -1;
-        } else if ((unsigned int)enc_config.width & (16 - 1)) {
-            ALOGE("ERR(%s): Image width should be multiple of 16", __func__);
-            return -1;
-        }
-    }
-
-    struct jpeg_buf    m_jpeg_outbuf;
-    m_jpeg_outbuf.memory = V4L2_MEMORY_MMAP;
-    m_jpeg_outbuf.num_planes = 1;
-
-    if (jpeghal_set_outbuf(m_jpeg_fd, &m_jpeg_outbuf) < 0) {
-        ALOGE("ERR(%s):Fail to JPEG output buffer!!", __func__);
+    memcpy(m_jpeg_main.queue.in_bufs[0].start[0], yuv_buf->virt.extP[0], m_jpeg_main.queue.in_bufs[0].length[0]);
+#else
+    if (openJpegSession(&m_jpeg_main, width, height, m_jpeg_quality,
+                        V4L2_MEMORY_USERPTR, 3) < 0)
         return -1;
-    }
 
-#ifdef BOARD_USE_V4L2_ION
-    memcpy(m_jpeg_inbuf.start[0], yuv_buf->virt.extP[0], m_jpeg_inbuf.length[0]);
-#endif
+    // the capture buffer is queued by physical address, no copy
+    m_jpeg_main.queue.in_bufs[0].start[0] = (void *)fimc_v4l2_s_ctrl(m_cap_fd, V4L2_CID_PADDR_Y, index);
+    m_jpeg_main.queue.in_bufs[0].length[0] = m_capture_buf[index].size.extS[0];
 
-    if (jpeghal_enc_exe(m_jpeg_fd, &m_jpeg_inbuf, &m_jpeg_outbuf) < 0) {
-        ALOGE("ERR(%s):encode failed", __func__);
+    if ((unsigned int)m_jpeg_main.queue.in_bufs[0].start[0] & (SIZE_4K - 1)) {
+        ALOGE("ERR(%s): JPEG start address should be aligned to 4 Kbytes", __func__);
         return -1;
     }
+#endif
 
-    ret = jpeghal_g_ctrl(m_jpeg_fd, V4L2_CID_CAM_JPEG_ENCODEDSIZE);
-    if (ret < 0) {
-        ALOGE("ERR(%s): jpeghal_g_ctrl fail on V4L2_CID_CAM_JPEG_ENCODEDSIZE", __func__);
+    ret = runJpegSession(&m_jpeg_main);
+    if (ret < 0)
         return -1;
-    } else {
-        *output_size = (unsigned int)ret;
-    }
 
-    memcpy(jpeg_buf, m_jpeg_outbuf.start[0], *output_size);
-
-    if (m_jpeg_fd > 0) {
-        if (jpeghal_deinit(m_jpeg_fd, &m_jpeg_inbuf, &m_jpeg_outbuf) < 0)
-            ALOGE("ERR(%s):Fail on api_jpeg_encode_deinit", __func__);
-        m_jpeg_fd = 0;
-    }
+    *jpeg_buf = (unsigned char *)m_jpeg_main.queue.out_bufs[0].start[0];
+    *output_size = ret;
 #endif
 
     return 0;
@@ -4211,7 +4384,7 @@ int SecCamera::makeExif (unsigned char *exifOut,
     unsigned char *thumbBuf = thumb_buf;
     unsigned int thumbSize = thumb_size;
 
-    if (exifInfo->enableThumb && (thumbBuf != NULL) && (thumbSize > 0)) {
+    if (exifInfo->enableThumb && (thumbSize > 0)) {
         tmp = LongerTagOffest;
         memcpy(pNextIfdOffset, &tmp, OFFSET_SIZE);  // NEXT IFD offset skipped on 0th IFD
 
@@ -4246,7 +4419,9 @@ int SecCamera::makeExif (unsigned char *exifOut,
         memcpy(pCur, &tmp, OFFSET_SIZE); // next IFD offset
         pCur += OFFSET_SIZE;
 
-        memcpy(pIfdStart + LongerTagOffest, thumbBuf, thumbSize);
+        // without thumbBuf the caller copies the thumbnail in afterwards
+        if (thumbBuf != NULL)
+            memcpy(pIfdStart + LongerTagOffest, thumbBuf, thumbSize);
         LongerTagOffest += thumbSize;
     } else {
         tmp = 0;
@@ -4349,6 +4524,24 @@ status_t SecCamera::dump(int fd)
     String8 result;
     snprintf(buffer, 255, "dump(%d)\n", fd);
     result.append(buffer);
+#ifdef SAMSUNG_EXYNOS4210
+    snprintf(buffer, 255, " jpeg encoder open(%s) opens(%u) encodes(%u)\n",
+             m_jpeg_fd > 0 ? "true" : "false", m_jpeg_opens, m_jpeg_encodes);
+    result.append(buffer);
+#endif
+#ifdef SAMSUNG_EXYNOS4x12
+    snprintf(buffer, 255, " jpeg main %dx%d open(%s) opens(%u) encodes(%u)\n",
+             m_jpeg_main.config.width, m_jpeg_main.config.height,
+             m_jpeg_main.queue.fd > 0 ? "true" : "false", m_jpeg_main.opens, m_jpeg_main.encodes);
+    result.append(buffer);
+    snprintf(buffer, 255, " jpeg thumbnail %dx%d open(%s) opens(%u) encodes(%u)\n",
+             m_jpeg_thumb.config.width, m_jpeg_thumb.config.height,
+             m_jpeg_thumb.queue.fd > 0 ? "true" : "false", m_jpeg_thumb.opens, m_jpeg_thumb.encodes);
+    result.append(buffer);
+    snprintf(buffer, 255, " jpeg thumbnails deferred to the main session(%u)\n",
+             m_jpeg_thumb_deferred);
+    result.append(buffer);
+#endif
     ::write(fd, result.string(), result.size());
     return NO_ERROR;
 }
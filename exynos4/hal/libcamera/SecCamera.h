@@ -94,6 +94,11 @@ namespace android {
 #define FRM_RATIO(w, h)                 ((w)*10/(h))
 #define SIZE_4K                         (1 << 12)
 
+/* encodeThumbnail(): no second encoder node, see encodeThumbnailAfterSnapshot() */
+#define JPEG_THUMB_DEFERRED             (-2)
+
+#define JPEG_ENCODE_TIMEOUT_MS          2000
+
 #define JOIN(x, y) JOIN_AGAIN(x, y)
 #define JOIN_AGAIN(x, y) x ## y
 
@@ -512,11 +517,19 @@ public:
                             int *thumb_size,
                             unsigned int *thumb_addr,
                             unsigned int *phyaddr);
-    int             getSnapshotAndJpeg(SecBuffer *yuv_buf,
-                                       int index,
-                                       unsigned char *jpeg_buf,
-                                       int *output_size);
-    int             getExif(unsigned char *pExifDst, unsigned char *pThumbSrc, int thumbSize);
+    int             captureSnapshot(SecBuffer *yuv_buf, int index);
+    int             encodeSnapshot(SecBuffer *yuv_buf,
+                                   int index,
+                                   unsigned char **jpeg_buf,
+                                   int *output_size);
+    int             encodeThumbnail(unsigned char *pThumbSrc, int thumbSize,
+                                    unsigned char **jpeg_buf);
+    int             encodeThumbnailAfterSnapshot(unsigned char *pThumbSrc, int thumbSize,
+                                                 unsigned char **jpeg_buf,
+                                                 unsigned char **snapshot_jpeg,
+                                                 int snapshot_size);
+    int             getExif(unsigned char *pExifDst, unsigned char *pThumbJpeg, int thumbJpegSize);
+    void            closeJpeg(void);
 
     void            getPostViewConfig(int*, int*, int*);
     void            getThumbnailConfig(int *width, int *height, int *size);
@@ -529,6 +542,11 @@ public:
     int             getCaptureAddr(int index, SecBuffer *buffer);
 #ifdef BOARD_USE_V4L2_ION
     void            setUserBufferAddr(void *ptr, int index, int mode);
+#endif
+#ifndef BOARD_USE_V4L2
+    void            setPreviewUserPtr(bool enable);
+    bool            getPreviewUserPtr(void);
+    void            setUserBufferPhys(const SecBuffer *buf, int index);
 #endif
     static void     setJpegRatio(double ratio)
     {
@@ -639,6 +657,34 @@ private:
 
     int             m_postview_offset;
 
+#ifdef SAMSUNG_EXYNOS4210
+    /* libs5pjpeg has one context; kept open from the first shot to DestroyCamera() */
+    unsigned char  *m_jpeg_thumb_buf;
+    unsigned int    m_jpeg_thumb_buf_size;
+    unsigned int    m_jpeg_opens;
+    unsigned int    m_jpeg_encodes;
+#endif
+#ifdef SAMSUNG_EXYNOS4x12
+    /* an encoder node kept open, configured and streaming across shots */
+    struct jpeg_session {
+        struct jpeg_queue   queue;      // one buffer pair
+        struct jpeg_config  config;
+        unsigned int        opens;
+        unsigned int        encodes;
+    };
+
+    struct jpeg_session m_jpeg_main;
+    struct jpeg_session m_jpeg_thumb;
+
+    /* the main stream, moved aside when the thumbnail has to use m_jpeg_main */
+    unsigned char  *m_jpeg_main_copy;
+    unsigned int    m_jpeg_main_copy_size;
+    unsigned int    m_jpeg_thumb_deferred;
+#endif
+
+#ifndef BOARD_USE_V4L2
+    bool            m_preview_userptr;
+#endif
 #ifdef ENABLE_ESD_PREVIEW_CHECK
     int             m_esd_check_count;
 #endif // ENABLE_ESD_PREVIEW_CHECK
@@ -684,6 +730,19 @@ private:
                                         bool useMainbufForThumb);
     void            resetCamera();
 
+#ifdef SAMSUNG_EXYNOS4210
+    int             openJpeg(void);
+    int             runJpeg(unsigned char *src, unsigned int src_size,
+                            int width, int height, int quality,
+                            unsigned char **jpeg_buf);
+#endif
+#ifdef SAMSUNG_EXYNOS4x12
+    int             openJpegSession(struct jpeg_session *session, int width, int height,
+                                    int quality, enum v4l2_memory in_memory, int cacheable);
+    int             runJpegSession(struct jpeg_session *session);
+    void            closeJpegSession(struct jpeg_session *session);
+#endif
+
     static double   jpeg_ratio;
     static int      interleaveDataSize;
     static int      jpegLineLength;
@@ -25,6 +25,8 @@
 #include <sys/mman.h>
 #include <camera/Camera.h>
 #include <media/hardware/MetadataBufferType.h>
+#include <cutils/properties.h>
+#include "color_space_convertor.h"
 
 #define VIDEO_COMMENT_MARKER_H          0xFFBE
 #define VIDEO_COMMENT_MARKER_L          0xFFBF
@@ -95,6 +97,12 @@ CameraHardwareSec::CameraHardwareSec(int cameraId, camera_device_t *dev)
           mCapIndex(0),
           mRecordHint(false),
           mTouched(0),
+#ifndef BOARD_USE_V4L2
+          mPreviewZeroCopy(false),
+#endif
+          mPreviewFrames(0),
+          mPreviewCopyBytes(0),
+          mPreviewLastCopyBytes(0),
           mHalDevice(dev)
 {
     ALOGV("%s :", __func__);
@@ -106,8 +114,22 @@ CameraHardwareSec::CameraHardwareSec(int cameraId, camera_device_t *dev)
 
     mRawHeap = NULL;
     mPreviewHeap = NULL;
+    mThumbSrc = NULL;
+    mThumbSrcWidth = 0;
+    mThumbSrcHeight = 0;
+    mThumbJpeg = NULL;
+    mThumbJpegSize = 0;
+    mExifBuf = NULL;
+    mShotStartTime = 0;
+    mLastShotTime = 0;
+    memset(&mShotLatency, 0, sizeof(mShotLatency));
+    memset(&mShotInterval, 0, sizeof(mShotInterval));
     for(int i = 0; i < BUFFER_COUNT_FOR_ARRAY; i++)
         mRecordHeap[i] = NULL;
+    for(int i = 0; i < MAX_BUFFERS; i++) {
+        mBufferHandle[i] = NULL;
+        mStride[i] = 0;
+    }
 
     if (!mGrallocHal) {
         ret = hw_get_module(GRALLOC_HARDWARE_MODULE_ID, (const hw_module_t **)&mGrallocHal);
@@ -133,6 +155,7 @@ CameraHardwareSec::CameraHardwareSec(int cameraId, camera_device_t *dev)
     mPreviewThread = new PreviewThread(this);
     mAutoFocusThread = new AutoFocusThread(this);
     mPictureThread = new PictureThread(this);
+    mThumbnailThread = new ThumbnailThread(this);
 }
 
 int CameraHardwareSec::getCameraId() const
@@ -444,6 +467,15 @@ status_t CameraHardwareSec::setPreviewWindow(preview_stream_ops *w)
 {
     int min_bufs;
 
+    Mutex::Autolock lock(mPreviewLock);
+
+    /* buffers dequeued from the old window go back to it, not to @w */
+    if (mPreviewRunning && !mPreviewStartDeferred) {
+        ALOGI("stop preview (window change)");
+        stopPreviewInternal();
+    }
+    cancelPreviewBuffers();
+
     mPreviewWindow = w;
     ALOGV("%s: mPreviewWindow %p", __func__, mPreviewWindow);
 
@@ -452,25 +484,36 @@ status_t CameraHardwareSec::setPreviewWindow(preview_stream_ops *w)
         return OK;
     }
 
-    mPreviewLock.lock();
-
-    if (mPreviewRunning && !mPreviewStartDeferred) {
-        ALOGI("stop preview (window change)");
-        stopPreviewInternal();
-    }
-
     if (w->get_min_undequeued_buffer_count(w, &min_bufs)) {
         ALOGE("%s: could not retrieve min undequeued buffer count", __func__);
         return INVALID_OPERATION;
     }
 
-    if (min_bufs >= BUFFER_COUNT_FOR_GRALLOC) {
+    int buffer_count = BUFFER_COUNT_FOR_GRALLOC;
+
+#ifndef BOARD_USE_V4L2
+    char zerocopy[PROPERTY_VALUE_MAX];
+    const char *fmt = mParameters.getPreviewFormat();
+
+    /*
+     * FIMC can only write the YUV420 layouts gralloc uses straight into the
+     * window buffers; RGB previews keep going through the copy below.
+     */
+    property_get("camera.preview.zerocopy", zerocopy, "1");
+    mPreviewZeroCopy = atoi(zerocopy) != 0 &&
+        (!strcmp(fmt, CameraParameters::PIXEL_FORMAT_YUV420SP) ||
+         !strcmp(fmt, CameraParameters::PIXEL_FORMAT_YUV420P));
+    if (mPreviewZeroCopy)
+        buffer_count = BUFFER_COUNT_FOR_GRALLOC_ZERO_COPY;
+#endif
+
+    if (min_bufs >= buffer_count) {
         ALOGE("%s: min undequeued buffer count %d is too high (expecting at most %d)", __func__,
-             min_bufs, BUFFER_COUNT_FOR_GRALLOC - 1);
+             min_bufs, buffer_count - 1);
     }
 
-    ALOGV("%s: setting buffer count to %d", __func__, BUFFER_COUNT_FOR_GRALLOC);
-    if (w->set_buffer_count(w, BUFFER_COUNT_FOR_GRALLOC)) {
+    ALOGV("%s: setting buffer count to %d", __func__, buffer_count);
+    if (w->set_buffer_count(w, buffer_count)) {
         ALOGE("%s: could not set buffer count", __func__);
         return INVALID_OPERATION;
     }
@@ -505,6 +548,10 @@ status_t CameraHardwareSec::setPreviewWindow(preview_stream_ops *w)
 #ifdef USE_EGL
 #ifdef BOARD_USE_V4L2_ION
     if (w->set_usage(w, GRALLOC_USAGE_SW_WRITE_OFTEN | GRALLOC_USAGE_HW_ION)) {
+#elif !defined(BOARD_USE_V4L2)
+    /* zero-copy needs physically contiguous buffers from the FIMC1 region */
+    if (w->set_usage(w, GRALLOC_USAGE_SW_WRITE_OFTEN |
+                     (mPreviewZeroCopy ? GRALLOC_USAGE_HW_FIMC1 : 0))) {
 #else
     if (w->set_usage(w, GRALLOC_USAGE_SW_WRITE_OFTEN)) {
 #endif
@@ -548,7 +595,6 @@ status_t CameraHardwareSec::setPreviewWindow(preview_stream_ops *w)
             mPreviewCondition.signal();
         }
     }
-    mPreviewLock.unlock();
 
     return OK;
 }
@@ -633,6 +679,117 @@ int CameraHardwareSec::previewThreadWrapper()
     }
 }
 
+#ifndef BOARD_USE_V4L2
+/*
+ * Physical plane addresses of a window buffer, laid out the way FIMC writes
+ * YUV420: Y, then the first and second chroma planes at gralloc's uoffset
+ * and voffset. That is also where the copy path in previewThread() puts them.
+ */
+bool CameraHardwareSec::getPreviewBufferPhys(buffer_handle_t *handle, SecBuffer *buf)
+{
+    private_handle_t *hnd = (private_handle_t *)*handle;
+    int width, height, frame_size;
+
+    mSecCamera->getPreviewSize(&width, &height, &frame_size);
+
+    if (!hnd->paddr || (hnd->stride && hnd->stride != width) || hnd->size < frame_size) {
+        ALOGW("%s: buffer paddr(0x%x) stride(%d) size(%d) can't take %dx%d frames",
+             __func__, hnd->paddr, hnd->stride, hnd->size, width, height);
+        return false;
+    }
+
+    memset(buf, 0, sizeof(*buf));
+    buf->phys.extP[0] = hnd->paddr + hnd->offset;
+    buf->size.extS[0] = width * height;
+    buf->phys.extP[1] = buf->phys.extP[0] + hnd->uoffset;
+
+    if (mPreviewFmtPlane == PREVIEW_FMT_3_PLANE) {
+        buf->size.extS[1] = width * height / 4;
+        buf->phys.extP[2] = buf->phys.extP[1] + hnd->voffset;
+        buf->size.extS[2] = width * height / 4;
+    } else {
+        buf->size.extS[1] = width * height / 2;
+    }
+
+    return true;
+}
+
+/*
+ * Dequeues a window buffer into every empty slot and hands it to FIMC. With
+ * qbuf false the slots are only filled, startPreview() queues them itself.
+ */
+status_t CameraHardwareSec::queueZeroCopyBuffers(bool qbuf)
+{
+    SecBuffer buf;
+
+    for (int i = 0; i < MAX_BUFFERS; i++) {
+        if (mBufferHandle[i] != NULL)
+            continue;
+
+        if (0 != mPreviewWindow->dequeue_buffer(mPreviewWindow, &mBufferHandle[i], &mStride[i])) {
+            ALOGE("%s: Could not dequeue gralloc buffer[%d]!!", __func__, i);
+            mBufferHandle[i] = NULL;
+            return INVALID_OPERATION;
+        }
+
+        if (!getPreviewBufferPhys(mBufferHandle[i], &buf)) {
+            mPreviewWindow->cancel_buffer(mPreviewWindow, mBufferHandle[i]);
+            mBufferHandle[i] = NULL;
+            return BAD_VALUE;
+        }
+
+        mSecCamera->setUserBufferPhys(&buf, i);
+
+        if (qbuf && mSecCamera->setPreviewFrame(i) < 0) {
+            ALOGE("%s: Fail qbuf, index(%d)", __func__, i);
+            return UNKNOWN_ERROR;
+        }
+    }
+
+    return NO_ERROR;
+}
+
+/*
+ * Preview callbacks still need the frame in mPreviewHeap, the one copy left
+ * when the window is fed straight from FIMC.
+ */
+uint32_t CameraHardwareSec::copyPreviewCallbackFrame(int index)
+{
+    int width, height, frame_size;
+    void *vaddr[3];
+    uint32_t bytes = 0;
+
+    mSecCamera->getPreviewSize(&width, &height, &frame_size);
+
+    if (mGrallocHal->lock(mGrallocHal, *mBufferHandle[index],
+                          GRALLOC_USAGE_SW_READ_OFTEN | GRALLOC_USAGE_YUV_ADDR,
+                          0, 0, width, height, vaddr)) {
+        ALOGE("%s: could not lock gralloc buffer[%d]", __func__, index);
+        return 0;
+    }
+
+    char *dst = ((char *)mPreviewHeap->data) + (frame_size + mFrameSizeDelta) * index;
+
+    memcpy(dst, vaddr[0], width * height);
+    dst += width * height;
+    bytes += width * height;
+
+    if (mPreviewFmtPlane == PREVIEW_FMT_2_PLANE) {
+        memcpy(dst, vaddr[1], width * height / 2);
+        bytes += width * height / 2;
+    } else if (mPreviewFmtPlane == PREVIEW_FMT_3_PLANE) {
+        memcpy(dst, vaddr[1], width * height / 4);
+        dst += width * height / 4;
+        memcpy(dst, vaddr[2], width * height / 4);
+        bytes += width * height / 2;
+    }
+
+    mGrallocHal->unlock(mGrallocHal, *mBufferHandle[index]);
+
+    return bytes;
+}
+#endif
+
 int CameraHardwareSec::previewThread()
 {
     int index;
@@ -642,6 +799,7 @@ int CameraHardwareSec::previewThread()
     void *virAddr[3];
     camera_frame_metadata_t fdmeta;
     camera_face_t caface[5];
+    uint32_t copyBytes = 0;
 
 #ifdef BOARD_USE_V4L2_ION
     private_handle_t *hnd = NULL;
@@ -700,6 +858,31 @@ int CameraHardwareSec::previewThread()
 
     offset = frame_size * index;
 
+#ifndef BOARD_USE_V4L2
+    if (mSecCamera->getPreviewUserPtr()) {
+        if (mMsgEnabled & CAMERA_MSG_PREVIEW_FRAME)
+            copyBytes = copyPreviewCallbackFrame(index);
+
+        if (mPreviewWindow && mGrallocHal && mPreviewRunning) {
+            if (0 != mPreviewWindow->enqueue_buffer(mPreviewWindow, mBufferHandle[index])) {
+                ALOGE("%s: Could not enqueue gralloc buffer[%d]!!", __func__, index);
+                if (mSecCamera->setPreviewFrame(index) < 0)
+                    ALOGE("%s: Fail qbuf, index(%d)", __func__, index);
+            } else {
+                mBufferHandle[index] = NULL;
+                mStride[index] = 0;
+            }
+
+            /* a slot left empty here is retried on the next frame */
+            if (queueZeroCopyBuffers(true) != NO_ERROR)
+                ALOGW("%s: FIMC running short of window buffers", __func__);
+        } else if (mSecCamera->setPreviewFrame(index) < 0) {
+            ALOGE("%s: Fail qbuf, index(%d)", __func__, index);
+        }
+        goto callbacks;
+    }
+#endif
+
     if (mPreviewWindow && mGrallocHal && mPreviewRunning) {
 #ifdef BOARD_USE_V4L2_ION
         hnd = (private_handle_t*)*mBufferHandle[index];
@@ -753,9 +936,11 @@ int CameraHardwareSec::previewThread()
             // Y
             memcpy(virAddr[0],src, width * height);
             src += width * height;
+            copyBytes = width * height;
 
             if (mPreviewFmtPlane == PREVIEW_FMT_2_PLANE) {
                 memcpy(virAddr[1], src, width * height / 2);
+                copyBytes += width * height / 2;
             } else if (mPreviewFmtPlane == PREVIEW_FMT_3_PLANE) {
                 // U
                 memcpy(virAddr[1], src, width * height / 4);
@@ -763,6 +948,7 @@ int CameraHardwareSec::previewThread()
 
                 // V
                 memcpy(virAddr[2], src, width * height / 4);
+                copyBytes += width * height / 2;
             }
 
             mGrallocHal->unlock(mGrallocHal, **mBufferHandle);
@@ -782,10 +968,17 @@ int CameraHardwareSec::previewThread()
             ALOGE("Could not enqueue gralloc buffer!");
             goto callbacks;
         }
+        /* the window owns it again, cancelPreviewBuffers() must skip it */
+        mBufferHandle[0] = NULL;
+        mStride[0] = 0;
 #endif
     }
 
 callbacks:
+    mPreviewFrames++;
+    mPreviewCopyBytes += copyBytes;
+    mPreviewLastCopyBytes = copyBytes;
+
     // Notify the client of a new frame.
     if (mMsgEnabled & CAMERA_MSG_PREVIEW_FRAME && mPreviewRunning)
         mDataCb(CAMERA_MSG_PREVIEW_FRAME, mPreviewHeap, index, NULL, mCallbackCookie);
@@ -928,11 +1121,31 @@ status_t CameraHardwareSec::startPreviewInternal()
     }
 #endif
 
+#ifndef BOARD_USE_V4L2
+    bool zeroCopy = false;
+
+    mSecCamera->setPreviewUserPtr(false);
+    if (mPreviewZeroCopy && mPreviewWindow && mGrallocHal) {
+        if (queueZeroCopyBuffers(false) == NO_ERROR) {
+            zeroCopy = true;
+        } else {
+            ALOGW("%s: window buffers not usable by FIMC, copying preview frames", __func__);
+            cancelPreviewBuffers();
+            mPreviewZeroCopy = false;
+        }
+    }
+    mSecCamera->setPreviewUserPtr(zeroCopy);
+#endif
+
     int ret  = mSecCamera->startPreview();
     ALOGV("%s : mSecCamera->startPreview() returned %d", __func__, ret);
 
     if (ret < 0) {
         ALOGE("ERR(%s):Fail on mSecCamera->startPreview()", __func__);
+#ifndef BOARD_USE_V4L2
+        if (zeroCopy)
+            cancelPreviewBuffers();
+#endif
         return UNKNOWN_ERROR;
     }
 
@@ -951,7 +1164,8 @@ status_t CameraHardwareSec::startPreviewInternal()
     }
 
 #ifndef BOARD_USE_V4L2
-    mPreviewHeap = mGetMemoryCb((int)mSecCamera->getCameraFd(SecCamera::PREVIEW),
+    /* zero-copy frames live in the window buffers, callbacks get a copy */
+    mPreviewHeap = mGetMemoryCb(zeroCopy ? -1 : (int)mSecCamera->getCameraFd(SecCamera::PREVIEW),
                                 frame_size + mFrameSizeDelta,
                                 MAX_BUFFERS,
                                 0); // no cookie
@@ -966,6 +1180,26 @@ status_t CameraHardwareSec::startPreviewInternal()
     return NO_ERROR;
 }
 
+/*
+ * Returns every dequeued window buffer to mPreviewWindow. The slots are
+ * emptied even when there is no window or it refuses a buffer, so nothing
+ * from an old window is ever queued to FIMC or the next window again.
+ */
+void CameraHardwareSec::cancelPreviewBuffers()
+{
+    for (int i = 0; i < MAX_BUFFERS; i++) {
+        if (mBufferHandle[i] == NULL)
+            continue;
+
+        if (mPreviewWindow &&
+            0 != mPreviewWindow->cancel_buffer(mPreviewWindow, mBufferHandle[i]))
+            ALOGE("%s: Fail to cancel buffer[%d]", __func__, i);
+
+        mBufferHandle[i] = NULL;
+        mStride[i] = 0;
+    }
+}
+
 void CameraHardwareSec::stopPreviewInternal()
 {
     ALOGV("%s :", __func__);
@@ -978,18 +1212,7 @@ void CameraHardwareSec::stopPreviewInternal()
             /* wait until preview thread is stopped */
             mPreviewStoppedCondition.wait(mPreviewLock);
 
-#ifdef BOARD_USE_V4L2_ION
-            for (int i = 0; i < MAX_BUFFERS; i++) {
-                if (mBufferHandle[i] != NULL) {
-                    if (0 != mPreviewWindow->cancel_buffer(mPreviewWindow, mBufferHandle[i])) {
-                        ALOGE("%s: Fail to cancel buffer[%d]", __func__, i);
-                    } else {
-                        mBufferHandle[i] = NULL;
-                        mStride[i] = NULL;
-                    }
-                }
-            }
-#endif
+            cancelPreviewBuffers();
         }
         else
             ALOGV("%s : preview running but deferred, doing nothing", __func__);
@@ -1273,77 +1496,101 @@ void CameraHardwareSec::save_postview(const char *fname, uint8_t *buf, uint32_t
 bool CameraHardwareSec::scaleDownYuv422(char *srcBuf, uint32_t srcWidth, uint32_t srcHeight,
                                         char *dstBuf, uint32_t dstWidth, uint32_t dstHeight)
 {
-    int32_t step_x, step_y;
-    int32_t iXsrc, iXdst;
-    int32_t x, y, src_y_start_pos, dst_pos, src_pos;
-
     if (dstWidth % 2 != 0 || dstHeight % 2 != 0) {
         ALOGE("scale_down_yuv422: invalid width, height for scaling");
         return false;
     }
 
-    step_x = srcWidth / dstWidth;
-    step_y = srcHeight / dstHeight;
+    /* bilinear, reads only the source lines it needs, banded over the csc threads */
+    if (csc_scale_YUY2_mt((unsigned char *)dstBuf, dstWidth, dstHeight,
+                          (unsigned char *)srcBuf, srcWidth, srcHeight,
+                          CSC_SCALE_BILINEAR) < 0) {
+        ALOGE("scale_down_yuv422: Fail on scaling %dx%d to %dx%d",
+             srcWidth, srcHeight, dstWidth, dstHeight);
+        return false;
+    }
 
-    dst_pos = 0;
-    for (uint32_t y = 0; y < dstHeight; y++) {
-        src_y_start_pos = (y * step_y * (srcWidth * 2));
+    return true;
+}
 
-        for (uint32_t x = 0; x < dstWidth; x += 2) {
-            src_pos = src_y_start_pos + (x * (step_x * 2));
+bool CameraHardwareSec::YUY2toNV21(void *srcBuf, void *dstBuf, uint32_t srcWidth, uint32_t srcHeight)
+{
+    unsigned char *dstBufPointer = (unsigned char *)dstBuf;
 
-            dstBuf[dst_pos++] = srcBuf[src_pos    ];
-            dstBuf[dst_pos++] = srcBuf[src_pos + 1];
-            dstBuf[dst_pos++] = srcBuf[src_pos + 2];
-            dstBuf[dst_pos++] = srcBuf[src_pos + 3];
-        }
+    if (srcWidth % 2 != 0 || srcHeight % 2 != 0) {
+        ALOGE("YUY2toNV21: invalid width, height for conversion");
+        return false;
     }
 
+    csc_YUY2_to_NV21_mt(dstBufPointer, dstBufPointer + srcWidth * srcHeight,
+                        (unsigned char *)srcBuf, srcWidth, srcHeight);
+
     return true;
 }
 
-bool CameraHardwareSec::YUY2toNV21(void *srcBuf, void *dstBuf, uint32_t srcWidth, uint32_t srcHeight)
+int CameraHardwareSec::thumbnailThread()
 {
-    int32_t        x, y, src_y_start_pos, dst_cbcr_pos, dst_pos, src_pos;
-    unsigned char *srcBufPointer = (unsigned char *)srcBuf;
-    unsigned char *dstBufPointer = (unsigned char *)dstBuf;
+    int thumb_width, thumb_height, thumb_size;
 
-    dst_pos = 0;
-    dst_cbcr_pos = srcWidth*srcHeight;
-    for (uint32_t y = 0; y < srcHeight; y++) {
-        src_y_start_pos = (y * (srcWidth * 2));
+    mSecCamera->getThumbnailConfig(&thumb_width, &thumb_height, &thumb_size);
 
-        for (uint32_t x = 0; x < (srcWidth * 2); x += 2) {
-            src_pos = src_y_start_pos + x;
+    scaleDownYuv422(mThumbSrc, mThumbSrcWidth, mThumbSrcHeight,
+                    (char *)mThumbnailHeap->base(), thumb_width, thumb_height);
 
-            dstBufPointer[dst_pos++] = srcBufPointer[src_pos];
-        }
+    mThumbJpegSize = mSecCamera->encodeThumbnail((unsigned char *)mThumbnailHeap->base(),
+                                                 thumb_size, &mThumbJpeg);
+    if (mThumbJpegSize < 0 && mThumbJpegSize != JPEG_THUMB_DEFERRED) {
+        ALOGE("ERR(%s):Fail on SecCamera->encodeThumbnail()", __func__);
+        return UNKNOWN_ERROR;
     }
-    for (uint32_t y = 0; y < srcHeight; y += 2) {
-        src_y_start_pos = (y * (srcWidth * 2));
 
-        for (uint32_t x = 0; x < (srcWidth * 2); x += 4) {
-            src_pos = src_y_start_pos + x;
+    return NO_ERROR;
+}
+
+status_t CameraHardwareSec::startThumbnail(char *src, uint32_t srcWidth, uint32_t srcHeight)
+{
+    mThumbSrc = src;
+    mThumbSrcWidth = srcWidth;
+    mThumbSrcHeight = srcHeight;
+    mThumbJpeg = NULL;
+    mThumbJpegSize = -1;
 
-            dstBufPointer[dst_cbcr_pos++] = srcBufPointer[src_pos + 3];
-            dstBufPointer[dst_cbcr_pos++] = srcBufPointer[src_pos + 1];
-        }
+    if (mThumbnailThread->run("CameraThumbnailThread", PRIORITY_DEFAULT) != NO_ERROR) {
+        ALOGW("%s : couldn't run thumbnail thread, encoding in line", __func__);
+        return thumbnailThread();
     }
 
-    return true;
+    return NO_ERROR;
+}
+
+int CameraHardwareSec::waitThumbnail(unsigned char **jpeg)
+{
+    mThumbnailThread->join();
+
+    *jpeg = mThumbJpeg;
+    return mThumbJpegSize;
+}
+
+void CameraHardwareSec::addShotStat(struct shot_stat *stat, nsecs_t value)
+{
+    if (stat->count == 0 || value < stat->min)
+        stat->min = value;
+    if (value > stat->max)
+        stat->max = value;
+    stat->sum += value;
+    stat->last = value;
+    stat->count++;
 }
 
 int CameraHardwareSec::pictureThread()
 {
     ALOGV("%s :", __func__);
 
-    int jpeg_size = 0;
     int ret = NO_ERROR;
     unsigned char *jpeg_data = NULL;
-    int postview_offset = 0;
-    unsigned char *postview_data = NULL;
+    unsigned char *thumb_jpeg = NULL;
+    int thumb_jpeg_size = 0;
 
-    unsigned char *addr = NULL;
     int mPostViewWidth, mPostViewHeight, mPostViewSize;
     int mThumbWidth, mThumbHeight, mThumbSize;
     int cap_width, cap_height, cap_frame_size;
@@ -1352,36 +1599,28 @@ int CameraHardwareSec::pictureThread()
 
     mSecCamera->getPostViewConfig(&mPostViewWidth, &mPostViewHeight, &mPostViewSize);
     mSecCamera->getThumbnailConfig(&mThumbWidth, &mThumbHeight, &mThumbSize);
-    int postviewHeapSize = mPostViewSize;
     if (!mRecordRunning)
         mSecCamera->getSnapshotSize(&cap_width, &cap_height, &cap_frame_size);
     else
         mSecCamera->getVideosnapshotSize(&cap_width, &cap_height, &cap_frame_size);
-    int mJpegHeapSize;
-    if (!mUseInternalISP)
-        mJpegHeapSize = cap_frame_size * SecCamera::getJpegRatio();
-    else
-        mJpegHeapSize = cap_frame_size;
 
     ALOGV("[5B] mPostViewWidth = %d mPostViewHeight = %d\n",mPostViewWidth,mPostViewHeight);
 
-    camera_memory_t *JpegHeap = mGetMemoryCb(-1, mJpegHeapSize, 1, 0);
+    /* the thumbnail and postview heaps are kept from shot to shot */
 #ifdef BOARD_USE_V4L2_ION
-#ifdef ZERO_SHUTTER_LAG
-    mThumbnailHeap = new MemoryHeapBaseIon(mThumbSize);
-#else
-    mPostviewHeap[mCapIndex] = new MemoryHeapBaseIon(mPostViewSize);
-    mThumbnailHeap = new MemoryHeapBaseIon(mThumbSize);
+#ifndef ZERO_SHUTTER_LAG
+    if (mPostviewHeap[mCapIndex] == NULL ||
+            mPostviewHeap[mCapIndex]->getSize() < (size_t)mPostViewSize)
+        mPostviewHeap[mCapIndex] = new MemoryHeapBaseIon(mPostViewSize);
 #endif
+    if (mThumbnailHeap == NULL || mThumbnailHeap->getSize() < (size_t)mThumbSize)
+        mThumbnailHeap = new MemoryHeapBaseIon(mThumbSize);
 #else
-    mThumbnailHeap = new MemoryHeapBase(mThumbSize);
+    if (mThumbnailHeap == NULL || mThumbnailHeap->getSize() < (size_t)mThumbSize)
+        mThumbnailHeap = new MemoryHeapBase(mThumbSize);
 #endif
 
     if (mMsgEnabled & CAMERA_MSG_RAW_IMAGE) {
-        int picture_size, picture_width, picture_height;
-        mSecCamera->getSnapshotSize(&picture_width, &picture_height, &picture_size);
-        int picture_format = mSecCamera->getSnapshotPixelFormat();
-
         unsigned int thumb_addr, phyAddr;
 
         // Modified the shutter sound timing for Jpeg capture
@@ -1391,14 +1630,15 @@ int CameraHardwareSec::pictureThread()
             if (mMsgEnabled & CAMERA_MSG_SHUTTER)
                 mNotifyCb(CAMERA_MSG_SHUTTER, 0, 0, mCallbackCookie);
 
+            /* both stay in the capture buffer until endSnapshot() */
             jpeg_data = mSecCamera->getJpeg(&JpegImageSize, &mThumbSize, &thumb_addr, &phyAddr);
             if (jpeg_data == NULL) {
                 ALOGE("ERR(%s):Fail on SecCamera->getJpeg()", __func__);
                 ret = UNKNOWN_ERROR;
+            } else {
+                thumb_jpeg_size = mSecCamera->encodeThumbnail((unsigned char *)thumb_addr,
+                                                              mThumbSize, &thumb_jpeg);
             }
-
-            memcpy((unsigned char *)mThumbnailHeap->base(), (unsigned char *)thumb_addr, mThumbSize);
-            memcpy(JpegHeap->data, jpeg_data, JpegImageSize);
         } else {
             if (mMsgEnabled & CAMERA_MSG_SHUTTER)
                 mNotifyCb(CAMERA_MSG_SHUTTER, 0, 0, mCallbackCookie);
@@ -1411,32 +1651,51 @@ int CameraHardwareSec::pictureThread()
                      __func__, mCapBuffer.virt.extP[0]);
                 return UNKNOWN_ERROR;
             }
-
-            scaleDownYuv422((char *)mCapBuffer.virt.extP[0], cap_width, cap_height,
-                            (char *)mThumbnailHeap->base(), mThumbWidth, mThumbHeight);
 #else
 #ifdef BOARD_USE_V4L2_ION
             mCapBuffer.virt.extP[0] = (char *)mPostviewHeap[mCapIndex]->base();
 #endif
 #endif
 
-            if (mSecCamera->getSnapshotAndJpeg(&mCapBuffer, mCapIndex,
-                    (unsigned char*)JpegHeap->data, &JpegImageSize) < 0) {
+            int index = mSecCamera->captureSnapshot(&mCapBuffer, mCapIndex);
+            if (index < 0) {
+                mStateLock.lock();
+                mCaptureInProgress = false;
+                mStateLock.unlock();
+                return UNKNOWN_ERROR;
+            }
+
+            startThumbnail((char *)mCapBuffer.virt.extP[0], cap_width, cap_height);
+#ifdef SAMSUNG_EXYNOS4210
+            /* one encoder context and output buffer, so the thumbnail goes first */
+            thumb_jpeg_size = waitThumbnail(&thumb_jpeg);
+#endif
+
+            if (mSecCamera->encodeSnapshot(&mCapBuffer, index, &jpeg_data, &JpegImageSize) < 0) {
+                waitThumbnail(&thumb_jpeg);
                 mStateLock.lock();
                 mCaptureInProgress = false;
                 mStateLock.unlock();
-                JpegHeap->release(JpegHeap);
                 return UNKNOWN_ERROR;
             }
             ALOGI("snapshotandjpeg done");
 
+#ifndef SAMSUNG_EXYNOS4210
+            thumb_jpeg_size = waitThumbnail(&thumb_jpeg);
+            if (thumb_jpeg_size == JPEG_THUMB_DEFERRED) {
+                /* the second encoder node was refused, encode it after the main image */
+                thumb_jpeg_size = mSecCamera->encodeThumbnailAfterSnapshot(
+                        (unsigned char *)mThumbnailHeap->base(), mThumbSize,
+                        &thumb_jpeg, &jpeg_data, JpegImageSize);
+                if (thumb_jpeg_size < 0)
+                    ALOGE("ERR(%s):Fail on SecCamera->encodeThumbnailAfterSnapshot()", __func__);
+            }
+#endif
+
 #ifdef ZERO_SHUTTER_LAG
             if (!mRecordRunning)
                 stopPreview();
             memset(&mCapBuffer, 0, sizeof(struct SecBuffer));
-#else
-            scaleDownYuv422((char *)mCapBuffer.virt.extP[0], cap_width, cap_height,
-                            (char *)mThumbnailHeap->base(), mThumbWidth, mThumbHeight);
 #endif
         }
     }
@@ -1459,51 +1718,62 @@ int CameraHardwareSec::pictureThread()
     mCaptureInProgress = false;
     mStateLock.unlock();
 
-    if (mMsgEnabled & CAMERA_MSG_COMPRESSED_IMAGE) {
-        camera_memory_t *ExifHeap =
-            mGetMemoryCb(-1, EXIF_FILE_SIZE + mThumbSize, 1, 0);
+    if ((mMsgEnabled & CAMERA_MSG_COMPRESSED_IMAGE) && jpeg_data != NULL) {
+        if (thumb_jpeg_size < 0) {
+            ret = UNKNOWN_ERROR;
+            goto out;
+        }
+
+        if (mExifBuf == NULL) {
+            mExifBuf = (unsigned char *)malloc(EXIF_FILE_SIZE);
+            if (mExifBuf == NULL) {
+                ret = NO_MEMORY;
+                goto out;
+            }
+        }
 
-        int JpegExifSize = mSecCamera->getExif((unsigned char *)ExifHeap->data,
-                                           (unsigned char *)mThumbnailHeap->base(),
-                                            mThumbSize);
+        /* the thumbnail is left out of mExifBuf, it is copied once below */
+        int JpegExifSize = mSecCamera->getExif(mExifBuf, NULL, thumb_jpeg_size);
         ALOGV("JpegExifSize=%d", JpegExifSize);
 
-        if (JpegExifSize < 0) {
+        if (JpegExifSize < thumb_jpeg_size) {
             ret = UNKNOWN_ERROR;
             goto out;
         }
 
         int mJpegHeapSize_out = JpegImageSize + JpegExifSize;
         camera_memory_t *JpegHeap_out = mGetMemoryCb(-1, mJpegHeapSize_out, 1, 0);
+        if (!JpegHeap_out || !JpegHeap_out->data) {
+            ALOGE("ERR(%s): JPEG heap creation fail", __func__);
+            ret = NO_MEMORY;
+            goto out;
+        }
 
         unsigned char *ExifStart = (unsigned char *)JpegHeap_out->data + 2;
+        unsigned char *ThumbStart = ExifStart + JpegExifSize - thumb_jpeg_size;
         unsigned char *ImageStart = ExifStart + JpegExifSize;
 
-        memcpy(JpegHeap_out->data, JpegHeap->data, 2);
-        memcpy(ExifStart, ExifHeap->data, JpegExifSize);
-        memcpy(ImageStart, JpegHeap->data + 2, JpegImageSize - 2);
+        /* straight from the encoder buffers, the streams are not staged */
+        memcpy(JpegHeap_out->data, jpeg_data, 2);
+        memcpy(ExifStart, mExifBuf, JpegExifSize - thumb_jpeg_size);
+        memcpy(ThumbStart, thumb_jpeg, thumb_jpeg_size);
+        memcpy(ImageStart, jpeg_data + 2, JpegImageSize - 2);
 
-        mDataCb(CAMERA_MSG_COMPRESSED_IMAGE, JpegHeap_out, 0, NULL, mCallbackCookie);
+        nsecs_t now = systemTime(SYSTEM_TIME_MONOTONIC);
+        addShotStat(&mShotLatency, now - mShotStartTime);
+        if (mLastShotTime)
+            addShotStat(&mShotInterval, now - mLastShotTime);
+        mLastShotTime = now;
 
-        if (ExifHeap) {
-            ExifHeap->release(ExifHeap);
-            ExifHeap = 0;
-        }
+        mDataCb(CAMERA_MSG_COMPRESSED_IMAGE, JpegHeap_out, 0, NULL, mCallbackCookie);
 
-        if (JpegHeap_out) {
-            JpegHeap_out->release(JpegHeap_out);
-            JpegHeap_out = 0;
-        }
+        JpegHeap_out->release(JpegHeap_out);
+        JpegHeap_out = 0;
     }
 
     ALOGV("%s : pictureThread end", __func__);
 
 out:
-    if (JpegHeap) {
-        JpegHeap->release(JpegHeap);
-        JpegHeap = 0;
-    }
-
     if (mRawHeap) {
         mRawHeap->release(mRawHeap);
         mRawHeap = 0;
@@ -1533,6 +1803,7 @@ status_t CameraHardwareSec::takePicture()
         return INVALID_OPERATION;
     }
 
+    mShotStartTime = systemTime(SYSTEM_TIME_MONOTONIC);
     if (mPictureThread->run("CameraPictureThread", PRIORITY_DEFAULT) != NO_ERROR) {
         ALOGE("%s : couldn't run picture thread", __func__);
         return INVALID_OPERATION;
@@ -1794,6 +2065,27 @@ status_t CameraHardwareSec::dump(int fd) const
         mInternalParameters.dump(fd, args);
         snprintf(buffer, 255, " preview running(%s)\n", mPreviewRunning?"true": "false");
         result.append(buffer);
+#ifndef BOARD_USE_V4L2
+        snprintf(buffer, 255, " preview zero-copy(%s)\n",
+                 mSecCamera->getPreviewUserPtr() ? "true" : "false");
+        result.append(buffer);
+#endif
+        snprintf(buffer, 255, " preview frames(%llu) copied(%llu bytes) last(%u bytes) avg(%llu bytes)\n",
+                 (unsigned long long)mPreviewFrames, (unsigned long long)mPreviewCopyBytes,
+                 mPreviewLastCopyBytes,
+                 (unsigned long long)(mPreviewFrames ? mPreviewCopyBytes / mPreviewFrames : 0));
+        result.append(buffer);
+        snprintf(buffer, 255, " shots(%u) latency ms last(%lld) min(%lld) avg(%lld) max(%lld)\n",
+                 mShotLatency.count,
+                 (long long)ns2ms(mShotLatency.last), (long long)ns2ms(mShotLatency.min),
+                 (long long)ns2ms(mShotLatency.count ? mShotLatency.sum / mShotLatency.count : 0),
+                 (long long)ns2ms(mShotLatency.max));
+        result.append(buffer);
+        snprintf(buffer, 255, " shot-to-shot ms last(%lld) min(%lld) avg(%lld) max(%lld)\n",
+                 (long long)ns2ms(mShotInterval.last), (long long)ns2ms(mShotInterval.min),
+                 (long long)ns2ms(mShotInterval.count ? mShotInterval.sum / mShotInterval.count : 0),
+                 (long long)ns2ms(mShotInterval.max));
+        result.append(buffer);
     } else
         result.append("No camera client yet.\n");
     write(fd, result.string(), result.size());
@@ -2940,6 +3232,13 @@ void CameraHardwareSec::release()
         mPictureThread->requestExitAndWait();
         mPictureThread.clear();
     }
+    if (mThumbnailThread != NULL) {
+        mThumbnailThread->requestExitAndWait();
+        mThumbnailThread.clear();
+    }
+
+    free(mExifBuf);
+    mExifBuf = NULL;
 
     if (mRawHeap) {
         mRawHeap->release(mRawHeap);
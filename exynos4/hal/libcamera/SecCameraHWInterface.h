@@ -36,6 +36,12 @@
 #else
 #define  BUFFER_COUNT_FOR_GRALLOC (MAX_BUFFERS)
 #define  BUFFER_COUNT_FOR_ARRAY (1)
+#ifndef BOARD_USE_V4L2
+#include "gralloc_priv.h"
+
+/* zero-copy preview keeps MAX_BUFFERS window buffers queued in FIMC */
+#define  BUFFER_COUNT_FOR_GRALLOC_ZERO_COPY (MAX_BUFFERS + 4)
+#endif
 #endif
 
 namespace android {
@@ -107,6 +113,18 @@ private:
         }
     };
 
+    class ThumbnailThread : public Thread {
+        CameraHardwareSec *mHardware;
+    public:
+        ThumbnailThread(CameraHardwareSec *hw):
+        Thread(false),
+        mHardware(hw) { }
+        virtual bool threadLoop() {
+            mHardware->thumbnailThread();
+            return false;
+        }
+    };
+
     class AutoFocusThread : public Thread {
         CameraHardwareSec *mHardware;
     public:
@@ -126,6 +144,12 @@ private:
     sp<PreviewThread>   mPreviewThread;
             int         previewThread();
             int         previewThreadWrapper();
+            void        cancelPreviewBuffers();
+#ifndef BOARD_USE_V4L2
+            bool        getPreviewBufferPhys(buffer_handle_t *handle, SecBuffer *buf);
+            status_t    queueZeroCopyBuffers(bool qbuf);
+            uint32_t    copyPreviewCallbackFrame(int index);
+#endif
 
     sp<AutoFocusThread> mAutoFocusThread;
             int         autoFocusThread();
@@ -134,6 +158,32 @@ private:
             int         pictureThread();
             bool        mCaptureInProgress;
 
+    /* scales and encodes the thumbnail while pictureThread() encodes the picture */
+    sp<ThumbnailThread> mThumbnailThread;
+            int         thumbnailThread();
+            status_t    startThumbnail(char *src, uint32_t srcWidth, uint32_t srcHeight);
+            int         waitThumbnail(unsigned char **jpeg);
+            char        *mThumbSrc;         // capture frame the thumbnail is scaled from
+            uint32_t    mThumbSrcWidth;
+            uint32_t    mThumbSrcHeight;
+            unsigned char *mThumbJpeg;
+            int         mThumbJpegSize;
+            unsigned char *mExifBuf;        // EXIF header scratch, EXIF_FILE_SIZE
+
+    /* still capture timing, reported by dump() */
+    struct shot_stat {
+            uint32_t    count;
+            nsecs_t     sum;
+            nsecs_t     min;
+            nsecs_t     max;
+            nsecs_t     last;
+    };
+            void        addShotStat(struct shot_stat *stat, nsecs_t value);
+            nsecs_t     mShotStartTime;     // takePicture()
+            nsecs_t     mLastShotTime;      // previous compressed image callback
+    struct shot_stat    mShotLatency;       // takePicture() to compressed image
+    struct shot_stat    mShotInterval;      // compressed image to compressed image
+
             int         save_jpeg(unsigned char *real_jpeg, int jpeg_size);
             void        save_postview(const char *fname, uint8_t *buf,
                                         uint32_t size);
@@ -202,8 +252,17 @@ private:
     camera_frame_metadata_t     *mFaceData;
     camera_memory_t     *mFaceDataHeap;
 
-    buffer_handle_t *mBufferHandle[BUFFER_COUNT_FOR_ARRAY];
-    int mStride[BUFFER_COUNT_FOR_ARRAY];
+    buffer_handle_t *mBufferHandle[MAX_BUFFERS];
+    int mStride[MAX_BUFFERS];
+#ifndef BOARD_USE_V4L2
+    /* preview frames are captured straight into mBufferHandle[index] */
+            bool        mPreviewZeroCopy;
+#endif
+
+    /* preview CPU copies, reported by dump() */
+            uint64_t    mPreviewFrames;
+            uint64_t    mPreviewCopyBytes;
+            uint32_t    mPreviewLastCopyBytes;
 
 
     SecCamera           *mSecCamera;
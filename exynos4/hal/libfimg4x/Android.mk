@@ -6,6 +6,7 @@ LOCAL_MODULE_TAGS := optional
 
 LOCAL_SRC_FILES:= \
 	FimgApi.cpp   \
+	FimgAsync.cpp \
 	FimgExynos4.cpp
 
 LOCAL_C_INCLUDES += \
@@ -19,4 +20,37 @@ LOCAL_PRELINK_MODULE := false
 
 include $(BUILD_SHARED_LIBRARY)
 
+# Host-only copy of the async queue with the memcpy backend, for tests.
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES:= \
+	FimgApi.cpp   \
+	FimgAsync.cpp \
+	FimgExynos4.cpp \
+	FimgMock.cpp
+
+LOCAL_C_INCLUDES += \
+	$(LOCAL_PATH)/../include
+
+LOCAL_MODULE:= libfimg_mock
+
+include $(BUILD_HOST_STATIC_LIBRARY)
+
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES:= FimgAsyncTest.cpp
+
+LOCAL_C_INCLUDES += \
+	$(LOCAL_PATH)/../include
+
+LOCAL_STATIC_LIBRARIES:= libfimg_mock libutils liblog libcutils
+
+LOCAL_LDLIBS += -lpthread
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_MODULE:= fimg_async_test
+
+include $(BUILD_HOST_EXECUTABLE)
+
 endif
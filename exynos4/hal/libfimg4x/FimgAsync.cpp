@@ -0,0 +1,280 @@
+/*
+**
+** Copyright 2009 Samsung Electronics Co, Ltd.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+**
+*/
+
+#define LOG_TAG "FimgAsync"
+#include <utils/Log.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include <utils/threads.h>
+
+#include "FimgApi.h"
+
+namespace android
+{
+
+struct FimgAsyncCmd {
+    struct fimg2d_blit  cmd;
+    struct fimg2d_image src;
+    struct fimg2d_image msk;
+    struct fimg2d_image tmp;
+    struct fimg2d_image dst;
+};
+
+struct FimgAsyncResult {
+    unsigned int ticket;
+    bool         ok;
+};
+
+//---------------------------------------------------------------------------//
+// class FimgAsyncQueue
+//---------------------------------------------------------------------------//
+class FimgAsyncQueue : public Thread
+{
+private :
+    Mutex           m_lock;
+    Condition       m_workCond;
+    Condition       m_doneCond;
+
+    FimgAsyncCmd    m_queue[FIMG_ASYNC_QUEUE_DEPTH];
+    FimgAsyncResult m_result[FIMG_ASYNC_RESULT_DEPTH];
+
+    // last ticket handed out, taken by the worker and completed
+    unsigned int    m_submitted;
+    unsigned int    m_started;
+    unsigned int    m_completed;
+
+    FimgApi        *m_backend;
+
+    static bool     m_After(unsigned int a, unsigned int b) { return (int)(a - b) > 0; }
+    static void     m_CopyCmd(FimgAsyncCmd *dst, const struct fimg2d_blit *cmd);
+
+public:
+    FimgAsyncQueue();
+
+    int             Submit(struct fimg2d_blit *cmd, unsigned int *ticket);
+    int             Wait(unsigned int ticket, int timeoutMs);
+    bool            IsDone(unsigned int ticket);
+    void            SetBackend(FimgApi *backend);
+
+private:
+    virtual bool    threadLoop();
+};
+
+static Mutex              g_fimgAsyncLock;
+static sp<FimgAsyncQueue> g_fimgAsyncQueue;
+
+static sp<FimgAsyncQueue> getFimgAsyncQueue(void)
+{
+    Mutex::Autolock autolock(g_fimgAsyncLock);
+
+    if (g_fimgAsyncQueue == 0) {
+        g_fimgAsyncQueue = new FimgAsyncQueue();
+        g_fimgAsyncQueue->run("FimgAsyncQueue", PRIORITY_URGENT_DISPLAY);
+    }
+
+    return g_fimgAsyncQueue;
+}
+
+FimgAsyncQueue::FimgAsyncQueue()
+         : Thread(false),
+           m_submitted(FIMG_ASYNC_NO_TICKET),
+           m_started(FIMG_ASYNC_NO_TICKET),
+           m_completed(FIMG_ASYNC_NO_TICKET),
+           m_backend(NULL)
+{
+    memset(m_queue, 0, sizeof(m_queue));
+    memset(m_result, 0, sizeof(m_result));
+}
+
+void FimgAsyncQueue::m_CopyCmd(FimgAsyncCmd *dst, const struct fimg2d_blit *cmd)
+{
+    // the caller may reuse its images as soon as Submit() returns
+    dst->cmd = *cmd;
+
+    if (cmd->src) {
+        dst->src = *cmd->src;
+        dst->cmd.src = &dst->src;
+    }
+    if (cmd->msk) {
+        dst->msk = *cmd->msk;
+        dst->cmd.msk = &dst->msk;
+    }
+    if (cmd->tmp) {
+        dst->tmp = *cmd->tmp;
+        dst->cmd.tmp = &dst->tmp;
+    }
+    if (cmd->dst) {
+        dst->dst = *cmd->dst;
+        dst->cmd.dst = &dst->dst;
+    }
+}
+
+int FimgAsyncQueue::Submit(struct fimg2d_blit *cmd, unsigned int *ticket)
+{
+    Mutex::Autolock autolock(m_lock);
+
+    while (m_submitted - m_started >= FIMG_ASYNC_QUEUE_DEPTH)
+        m_doneCond.wait(m_lock);
+
+    m_submitted++;
+    if (m_submitted == FIMG_ASYNC_NO_TICKET)
+        m_submitted++;
+
+    m_CopyCmd(&m_queue[m_submitted % FIMG_ASYNC_QUEUE_DEPTH], cmd);
+
+    if (ticket)
+        *ticket = m_submitted;
+
+    m_workCond.signal();
+
+    return 0;
+}
+
+int FimgAsyncQueue::Wait(unsigned int ticket, int timeoutMs)
+{
+    Mutex::Autolock autolock(m_lock);
+
+    if (ticket == FIMG_ASYNC_NO_TICKET)
+        return 0;
+
+    // a ticket that was never handed out would never complete
+    if (m_After(ticket, m_submitted)) {
+        PRINT("%s::ticket %u was not submitted\n", __func__, ticket);
+        return -ENOENT;
+    }
+
+    while (m_After(ticket, m_completed)) {
+        if (timeoutMs < 0) {
+            m_doneCond.wait(m_lock);
+        } else if (m_doneCond.waitRelative(m_lock, milliseconds(timeoutMs)) == TIMED_OUT) {
+            if (m_After(ticket, m_completed)) {
+                PRINT("%s::ticket %u not done in %d msec\n", __func__, ticket, timeoutMs);
+                return -ETIMEDOUT;
+            }
+        }
+    }
+
+    FimgAsyncResult *result = &m_result[ticket % FIMG_ASYNC_RESULT_DEPTH];
+
+    // only the last FIMG_ASYNC_RESULT_DEPTH results are kept
+    if (result->ticket != ticket) {
+        PRINT("%s::result of ticket %u expired\n", __func__, ticket);
+        return -ENOENT;
+    }
+
+    return result->ok ? 0 : -1;
+}
+
+bool FimgAsyncQueue::IsDone(unsigned int ticket)
+{
+    Mutex::Autolock autolock(m_lock);
+
+    if (ticket == FIMG_ASYNC_NO_TICKET)
+        return true;
+
+    return !m_After(ticket, m_completed);
+}
+
+void FimgAsyncQueue::SetBackend(FimgApi *backend)
+{
+    Mutex::Autolock autolock(m_lock);
+
+    while (m_completed != m_submitted)
+        m_doneCond.wait(m_lock);
+
+    m_backend = backend;
+}
+
+bool FimgAsyncQueue::threadLoop()
+{
+    FimgAsyncCmd  job;
+    FimgApi      *backend;
+    unsigned int  ticket;
+    bool          ok;
+
+    {
+        Mutex::Autolock autolock(m_lock);
+
+        while (m_started == m_submitted)
+            m_workCond.wait(m_lock);
+
+        m_started++;
+        if (m_started == FIMG_ASYNC_NO_TICKET)
+            m_started++;
+
+        ticket = m_started;
+        m_CopyCmd(&job, &m_queue[ticket % FIMG_ASYNC_QUEUE_DEPTH].cmd);
+        backend = m_backend;
+
+        // the slot is free again
+        m_doneCond.broadcast();
+    }
+
+    if (backend)
+        ok = backend->Stretch(&job.cmd);
+    else
+        ok = (stretchFimgApi(&job.cmd) == 0);
+
+    if (ok == false)
+        PRINT("%s::blit %u (seq_no=%x op=%d) fail\n", __func__, ticket, job.cmd.seq_no, job.cmd.op);
+
+    {
+        Mutex::Autolock autolock(m_lock);
+
+        m_result[ticket % FIMG_ASYNC_RESULT_DEPTH].ticket = ticket;
+        m_result[ticket % FIMG_ASYNC_RESULT_DEPTH].ok = ok;
+        m_completed = ticket;
+
+        m_doneCond.broadcast();
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// extern function
+//---------------------------------------------------------------------------//
+extern "C" int stretchFimgApiAsync(struct fimg2d_blit *cmd, unsigned int *ticket)
+{
+    if (cmd == NULL || cmd->dst == NULL) {
+        PRINT("%s::invalid blit\n", __func__);
+        return -1;
+    }
+
+    return getFimgAsyncQueue()->Submit(cmd, ticket);
+}
+
+extern "C" int waitFimgApiAsync(unsigned int ticket, int timeout_ms)
+{
+    return getFimgAsyncQueue()->Wait(ticket, timeout_ms);
+}
+
+extern "C" int isDoneFimgApiAsync(unsigned int ticket)
+{
+    return getFimgAsyncQueue()->IsDone(ticket) ? 1 : 0;
+}
+
+extern "C" void setBackendFimgApiAsync(struct FimgApi *backend)
+{
+    getFimgAsyncQueue()->SetBackend(backend);
+}
+
+}; // namespace android
@@ -0,0 +1,201 @@
+/*
+**
+** Copyright 2009 Samsung Electronics Co, Ltd.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+**
+*/
+
+/*
+ * Host test of the asynchronous blit queue on top of FimgMock:
+ *   fimg_async_test
+ * Exits non-zero on the first failed check.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FimgMock.h"
+
+#define IMG_W       64
+#define IMG_H       64
+#define NUM_BLITS   20
+
+#define CHECK(cond)                                                     \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+            return 1;                                                   \
+        }                                                               \
+    } while (0)
+
+static unsigned int s_src[IMG_W * IMG_H];
+static unsigned int s_dst[NUM_BLITS][IMG_W * IMG_H];
+
+static void setImage(struct fimg2d_image *image, unsigned int *pixels)
+{
+    memset(image, 0, sizeof(*image));
+    image->addr.type = ADDR_USER;
+    image->addr.start = (unsigned long)pixels;
+    image->width = IMG_W;
+    image->height = IMG_H;
+    image->stride = IMG_W * 4;
+    image->fmt = CF_ARGB_8888;
+    image->rect.x2 = IMG_W;
+    image->rect.y2 = IMG_H;
+}
+
+/* queued copies run in order, and the caller may reuse its blit at once */
+static int testCopies(void)
+{
+    struct fimg2d_image src, dst;
+    struct fimg2d_blit cmd;
+    unsigned int ticket[NUM_BLITS];
+    struct FimgApi *mock = createFimgMockApi(2000);
+
+    CHECK(mock != NULL);
+    setBackendFimgApiAsync(mock);
+
+    for (int i = 0; i < IMG_W * IMG_H; i++)
+        s_src[i] = i * 7;
+    memset(s_dst, 0, sizeof(s_dst));
+
+    for (int k = 0; k < NUM_BLITS; k++) {
+        setImage(&src, s_src);
+        setImage(&dst, s_dst[k]);
+        memset(&cmd, 0, sizeof(cmd));
+        cmd.op = BLIT_OP_SRC;
+        cmd.src = &src;
+        cmd.dst = &dst;
+
+        CHECK(stretchFimgApiAsync(&cmd, &ticket[k]) == 0);
+        CHECK(ticket[k] != FIMG_ASYNC_NO_TICKET);
+
+        memset(&src, 0xff, sizeof(src));
+        memset(&dst, 0xff, sizeof(dst));
+    }
+
+    /* the last ticket covers the batch */
+    CHECK(waitFimgApiAsync(ticket[NUM_BLITS - 1], 1000) == 0);
+    for (int k = 0; k < NUM_BLITS; k++) {
+        CHECK(isDoneFimgApiAsync(ticket[k]) == 1);
+        CHECK(memcmp(s_src, s_dst[k], sizeof(s_src)) == 0);
+    }
+    CHECK(countFimgMockApi(mock) == NUM_BLITS);
+
+    setBackendFimgApiAsync(NULL);
+    destroyFimgMockApi(mock);
+    return 0;
+}
+
+/* a blit the backend rejects is reported on its ticket */
+static int testFailure(void)
+{
+    struct fimg2d_image dst;
+    struct fimg2d_blit cmd;
+    unsigned int ticket;
+    struct FimgApi *mock = createFimgMockApi(0);
+
+    CHECK(mock != NULL);
+    setBackendFimgApiAsync(mock);
+
+    setImage(&dst, s_dst[0]);
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.op = BLIT_OP_END;
+    cmd.dst = &dst;
+
+    CHECK(stretchFimgApiAsync(&cmd, &ticket) == 0);
+    CHECK(waitFimgApiAsync(ticket, 1000) == -1);
+
+    setBackendFimgApiAsync(NULL);
+    destroyFimgMockApi(mock);
+    return 0;
+}
+
+/*
+ * A timed out wait leaves the blit running: the hwcomposer keeps its
+ * destination out of rotation until isDoneFimgApiAsync() says so.
+ */
+static int testTimeout(void)
+{
+    struct fimg2d_image src, dst;
+    struct fimg2d_blit cmd;
+    unsigned int ticket;
+    struct FimgApi *mock = createFimgMockApi(200000);
+
+    CHECK(mock != NULL);
+    setBackendFimgApiAsync(mock);
+
+    setImage(&src, s_src);
+    setImage(&dst, s_dst[0]);
+    memset(s_dst[0], 0, sizeof(s_dst[0]));
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.op = BLIT_OP_SRC;
+    cmd.src = &src;
+    cmd.dst = &dst;
+
+    CHECK(stretchFimgApiAsync(&cmd, &ticket) == 0);
+    CHECK(waitFimgApiAsync(ticket, 10) == -ETIMEDOUT);
+    CHECK(isDoneFimgApiAsync(ticket) == 0);
+
+    CHECK(waitFimgApiAsync(ticket, -1) == 0);
+    CHECK(isDoneFimgApiAsync(ticket) == 1);
+    CHECK(memcmp(s_src, s_dst[0], sizeof(s_src)) == 0);
+
+    setBackendFimgApiAsync(NULL);
+    destroyFimgMockApi(mock);
+    return 0;
+}
+
+/* a ticket whose result left the ring, or one never handed out, is unknown */
+static int testExpired(void)
+{
+    struct fimg2d_image src, dst;
+    struct fimg2d_blit cmd;
+    unsigned int first, ticket;
+    struct FimgApi *mock = createFimgMockApi(0);
+
+    CHECK(mock != NULL);
+    setBackendFimgApiAsync(mock);
+
+    setImage(&src, s_src);
+    setImage(&dst, s_dst[0]);
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.op = BLIT_OP_SRC;
+    cmd.src = &src;
+    cmd.dst = &dst;
+
+    CHECK(stretchFimgApiAsync(&cmd, &first) == 0);
+    CHECK(waitFimgApiAsync(first, 1000) == 0);
+    CHECK(waitFimgApiAsync(first + 1, 1000) == -ENOENT);
+
+    for (int k = 0; k < FIMG_ASYNC_RESULT_DEPTH; k++)
+        CHECK(stretchFimgApiAsync(&cmd, &ticket) == 0);
+    CHECK(waitFimgApiAsync(ticket, 1000) == 0);
+    CHECK(waitFimgApiAsync(first, 1000) == -ENOENT);
+
+    setBackendFimgApiAsync(NULL);
+    destroyFimgMockApi(mock);
+    return 0;
+}
+
+int main(void)
+{
+    if (testCopies() || testFailure() || testTimeout() || testExpired())
+        return 1;
+
+    printf("PASS\n");
+    return 0;
+}
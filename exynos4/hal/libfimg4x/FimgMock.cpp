@@ -0,0 +1,183 @@
+/*
+**
+** Copyright 2009 Samsung Electronics Co, Ltd.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+**
+*/
+
+#pragma clang diagnostic ignored "-Wunused-parameter"
+#pragma clang diagnostic ignored "-Wmismatched-tags"
+
+#define LOG_NDEBUG 0
+#define LOG_TAG "FimgMock"
+#include <utils/Log.h>
+
+#include <string.h>
+#include <unistd.h>
+
+#include <utils/threads.h>
+
+#include "FimgMock.h"
+
+namespace android
+{
+
+//---------------------------------------------------------------------------//
+// class FimgMock : a FimgApi without /dev/fimg2d
+//---------------------------------------------------------------------------//
+class FimgMock : public FimgApi
+{
+private :
+    Mutex           m_lock;
+    unsigned int    m_delayUs;
+    unsigned int    m_count;
+
+    static bool     m_Is32bpp(const struct fimg2d_image *image);
+    static bool     m_IsUserImage(const struct fimg2d_image *image);
+    static unsigned char *m_Pixel(const struct fimg2d_image *image, int x, int y);
+
+    void            m_Fill(struct fimg2d_blit *cmd);
+    void            m_Copy(struct fimg2d_blit *cmd);
+
+public:
+    FimgMock(unsigned int delayUs);
+    virtual ~FimgMock() {}
+
+    unsigned int    Count(void);
+
+protected:
+    virtual bool    t_Create(void)  { return true; }
+    virtual bool    t_Destroy(void) { return true; }
+    virtual bool    t_Stretch(struct fimg2d_blit *cmd);
+    virtual bool    t_Sync(void)    { return true; }
+    virtual bool    t_Lock(void)    { m_lock.lock(); return true; }
+    virtual bool    t_UnLock(void)  { m_lock.unlock(); return true; }
+};
+
+FimgMock::FimgMock(unsigned int delayUs)
+         : m_delayUs(delayUs),
+           m_count(0)
+{
+}
+
+unsigned int FimgMock::Count(void)
+{
+    Mutex::Autolock autolock(m_lock);
+    return m_count;
+}
+
+bool FimgMock::m_Is32bpp(const struct fimg2d_image *image)
+{
+    return image->fmt == CF_XRGB_8888 || image->fmt == CF_ARGB_8888;
+}
+
+bool FimgMock::m_IsUserImage(const struct fimg2d_image *image)
+{
+    return image != NULL &&
+           (image->addr.type == ADDR_USER || image->addr.type == ADDR_USER_RSVD) &&
+           image->addr.start != 0 &&
+           m_Is32bpp(image);
+}
+
+unsigned char *FimgMock::m_Pixel(const struct fimg2d_image *image, int x, int y)
+{
+    return (unsigned char *)image->addr.start + y * image->stride + x * 4;
+}
+
+void FimgMock::m_Fill(struct fimg2d_blit *cmd)
+{
+    struct fimg2d_image *dst = cmd->dst;
+    unsigned int color = (unsigned int)cmd->param.solid_color;
+
+    for (int y = dst->rect.y1; y < dst->rect.y2; y++) {
+        unsigned int *p = (unsigned int *)m_Pixel(dst, dst->rect.x1, y);
+        for (int x = dst->rect.x1; x < dst->rect.x2; x++)
+            *p++ = color;
+    }
+}
+
+void FimgMock::m_Copy(struct fimg2d_blit *cmd)
+{
+    struct fimg2d_image *src = cmd->src;
+    struct fimg2d_image *dst = cmd->dst;
+    int w = src->rect.x2 - src->rect.x1;
+    int h = src->rect.y2 - src->rect.y1;
+
+    if (dst->rect.x2 - dst->rect.x1 < w)
+        w = dst->rect.x2 - dst->rect.x1;
+    if (dst->rect.y2 - dst->rect.y1 < h)
+        h = dst->rect.y2 - dst->rect.y1;
+
+    for (int y = 0; y < h; y++)
+        memcpy(m_Pixel(dst, dst->rect.x1, dst->rect.y1 + y),
+               m_Pixel(src, src->rect.x1, src->rect.y1 + y), w * 4);
+}
+
+bool FimgMock::t_Stretch(struct fimg2d_blit *cmd)
+{
+    if (cmd->dst == NULL || cmd->op >= BLIT_OP_END) {
+        PRINT("%s::invalid blit op=%d dst=%p\n", __func__, cmd->op, cmd->dst);
+        return false;
+    }
+
+    if (m_delayUs)
+        usleep(m_delayUs);
+
+    if (cmd->op == BLIT_OP_SOLID_FILL && m_IsUserImage(cmd->dst)) {
+        m_Fill(cmd);
+    } else if (cmd->op == BLIT_OP_SRC &&
+               m_IsUserImage(cmd->src) && m_IsUserImage(cmd->dst) &&
+               cmd->param.scaling.mode == NO_SCALING &&
+               cmd->param.rotate == ORIGIN) {
+        m_Copy(cmd);
+    }
+
+    m_count++;
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// extern function
+//---------------------------------------------------------------------------//
+extern "C" struct FimgApi *createFimgMockApi(unsigned int delay_us)
+{
+    FimgMock *mock = new FimgMock(delay_us);
+
+    if (mock->Create() == false) {
+        delete mock;
+        return NULL;
+    }
+
+    return mock;
+}
+
+extern "C" void destroyFimgMockApi(struct FimgApi *ptrFimgApi)
+{
+    FimgMock *mock = (FimgMock *)ptrFimgApi;
+
+    if (mock == NULL)
+        return;
+
+    mock->Destroy();
+    delete mock;
+}
+
+extern "C" unsigned int countFimgMockApi(struct FimgApi *ptrFimgApi)
+{
+    return ((FimgMock *)ptrFimgApi)->Count();
+}
+
+}; // namespace android
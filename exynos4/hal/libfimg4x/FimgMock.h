@@ -0,0 +1,46 @@
+/*
+**
+** Copyright 2009 Samsung Electronics Co, Ltd.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+**
+*/
+
+#ifndef FIMG_MOCK_H
+#define FIMG_MOCK_H
+
+#include "FimgApi.h"
+
+/*
+ * Software stand-in for the G2D device, host builds only (libfimg_mock).
+ * Blits take delay_us, solid fills and unscaled, unrotated 32bpp copies
+ * between ADDR_USER images are done on the CPU, everything else is only
+ * validated and counted. Hand it to setBackendFimgApiAsync().
+ */
+#ifdef __cplusplus
+extern "C"
+#endif
+struct FimgApi *createFimgMockApi(unsigned int delay_us);
+
+#ifdef __cplusplus
+extern "C"
+#endif
+void destroyFimgMockApi(struct FimgApi *ptrFimgApi);
+
+#ifdef __cplusplus
+extern "C"
+#endif
+unsigned int countFimgMockApi(struct FimgApi *ptrFimgApi);
+
+#endif // FIMG_MOCK_H
@@ -36,7 +36,8 @@ LOCAL_C_INCLUDES += \
 LOCAL_SRC_FILES := \
 	gralloc_module.cpp \
 	alloc_device.cpp \
-	framebuffer_device.cpp
+	framebuffer_device.cpp \
+	partial_flush.cpp
 
 LOCAL_MODULE_TAGS := optional
 LOCAL_VENDOR_MODULE := true
@@ -69,3 +70,17 @@ LOCAL_CFLAGS += -DADVERTISE_GRALLOC1
 endif
 
 include $(BUILD_SHARED_LIBRARY)
+
+# partial flush registry against the list it replaced, on the host
+include $(CLEAR_VARS)
+LOCAL_SRC_FILES := \
+	partial_flush.cpp \
+	partial_flush_bench.cpp
+
+LOCAL_MODULE_TAGS := optional
+LOCAL_MODULE := partial_flush_bench
+LOCAL_CFLAGS := -O2 -DLOG_TAG=\"gralloc\"
+LOCAL_STATIC_LIBRARIES := liblog
+LOCAL_LDLIBS += -lpthread
+
+include $(BUILD_HOST_EXECUTABLE)
@@ -63,6 +63,9 @@
 
 #include "videodev2.h"
 #include "s5p_fimc.h"
+#ifdef USE_PARTIAL_FLUSH
+#include "partial_flush.h"
+#endif
 
 #ifdef SAMSUNG_EXYNOS4x12
 #define PFX_NODE_FIMC0   "/dev/video0"
@@ -88,18 +91,8 @@ static unsigned int gReservedMemAddr = 0;
 static int gReservedMemSize = 0;
 static int gFimc1Fd = 0;
 
-#ifdef USE_PARTIAL_FLUSH
-extern struct private_handle_rect *rect_list;
-extern private_handle_rect *find_rect(int secure_id);
-extern private_handle_rect *find_last_rect(int secure_id);
-extern int release_rect(int secure_id);
-extern int count_rect(int secure_id);
-extern void dump_rect();
-extern void insert_rect_first(private_handle_rect *new_rect);
-extern void insert_rect_last(private_handle_rect *new_rect);
-#endif
-
 extern int get_bpp(int format);
+extern void gralloc_dump_reaper(char *buff, int buff_len);
 
 #define EXYNOS4_ALIGN( value, base ) (((value) + ((base) - 1)) & ~((base) - 1))
 
@@ -269,7 +262,16 @@ static int gralloc_alloc_ion(alloc_device_t *dev, size_t size, int usage,
     } else {
         ALOGD_IF(debug_level > 0, "%s FIMC1 cached", __func__);
         *ump_mem_handle = ump_ref_drv_ion_import(*ion_fd, UMP_REF_DRV_CONSTRAINT_USE_CACHE);
-        ump_cpu_msync_now((ump_handle)*ump_mem_handle, UMP_MSYNC_CLEAN_AND_INVALIDATE, NULL, 0);
+        if (UMP_INVALID_MEMORY_HANDLE != *ump_mem_handle)
+            ump_cpu_msync_now((ump_handle)*ump_mem_handle, UMP_MSYNC_CLEAN_AND_INVALIDATE, NULL, 0);
+    }
+
+    if (UMP_INVALID_MEMORY_HANDLE == *ump_mem_handle) {
+        ALOGE("%s Failed to import ion buffer into UMP", __func__);
+        ion_free(*ion_fd);
+        *ion_fd = 0;
+        *ion_paddr = 0;
+        return -1;
     }
     return 0;
 }
@@ -342,14 +344,10 @@ static int gralloc_alloc_buffer(alloc_device_t* dev, size_t size, int usage,
                         if (debug_partial_flush > 0)
                             dump_rect();
 
-                        private_handle_rect *psRect;
-                        psRect = (private_handle_rect *)calloc(1, sizeof(private_handle_rect));
-                        psRect->handle = (int)hnd->ump_id;
-                        psRect->stride = stride_raw;
                         ALOGD_IF(debug_partial_flush > 0,
-                            "%s: PARTIAL_FLUSH ump_id:%d === insert_rect_last === ump_mem_handle:%08x flags=%x usage=%x count:%d backingstore:%d",
+                            "%s: PARTIAL_FLUSH ump_id:%d === register_rect === ump_mem_handle:%08x flags=%x usage=%x count:%d backingstore:%d",
                             __func__, hnd->ump_id, hnd->ump_mem_handle, hnd->flags, hnd->usage, count_rect(hnd->ump_id), hnd->backing_store);
-                        insert_rect_last(psRect);
+                        register_rect((int)hnd->ump_id, stride_raw, bpp);
 
                         if (debug_partial_flush > 0)
                             dump_rect();
@@ -749,6 +747,11 @@ static int alloc_device_close(struct hw_device_t *device)
     return 0;
 }
 
+static void alloc_device_dump(struct alloc_device_t *dev __unused, char *buff, int buff_len)
+{
+    gralloc_dump_reaper(buff, buff_len);
+}
+
 int alloc_device_open(hw_module_t const* module, const char* name __unused, hw_device_t** device)
 {
     alloc_device_t *dev;
@@ -784,6 +787,7 @@ int alloc_device_open(hw_module_t const* module, const char* name __unused, hw_d
     dev->common.close = alloc_device_close;
     dev->alloc = alloc_device_alloc;
     dev->free = alloc_device_free;
+    dev->dump = alloc_device_dump;
 
     *device = &dev->common;
 
@@ -30,14 +30,19 @@
 
 //#define LOG_NDEBUG 0
 #include <errno.h>
+#include <limits.h>
 #include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <sys/mman.h>
+#include <sys/prctl.h>
 #include <cutils/log.h>
 #include <cutils/atomic.h>
+#include <cutils/list.h>
 #include <cutils/properties.h>
 #include <hardware/hardware.h>
 #include <hardware/gralloc.h>
@@ -55,6 +60,9 @@
 #include "s5p_fimc.h"
 #include "exynos_mem.h"
 #include "graphics.h"
+#ifdef USE_PARTIAL_FLUSH
+#include "partial_flush.h"
+#endif
 static pthread_mutex_t s_map_lock = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t sMapLock = PTHREAD_MUTEX_INITIALIZER;
 
@@ -96,163 +104,6 @@ int get_bpp(int format)
     return bpp;
 }
 
-#ifdef USE_PARTIAL_FLUSH
-static struct private_handle_rect *rect_list;
-static pthread_mutex_t s_rect_lock = PTHREAD_MUTEX_INITIALIZER;
-
-private_handle_rect *find_rect(int secure_id)
-{
-    private_handle_rect *psRect = NULL;
-
-    ALOGD_IF(debug_level > 0, "%s secure_id=%d",__func__,secure_id);
-    pthread_mutex_lock(&s_rect_lock);
-
-    for (psRect = rect_list; psRect; psRect = psRect->next)
-        if (psRect->handle == secure_id)
-            break;
-
-    pthread_mutex_unlock(&s_rect_lock);
-    return psRect;
-}
-
-void insert_rect_first(private_handle_rect *new_rect) {
-    int secure_id = new_rect->handle;
-    private_handle_rect *psRect = NULL;
-    private_handle_rect *psFRect = NULL;
-
-    ALOGD_IF(debug_level > 0, "%s secure_id=%d",__func__,secure_id);
-
-    pthread_mutex_lock(&s_rect_lock);
-    if (rect_list == NULL) {
-        rect_list = (private_handle_rect *)calloc(1, sizeof(private_handle_rect));
-        rect_list->next = new_rect;
-    } else {
-        for (psRect = rect_list; psRect; psRect = psRect->next) {
-            if (psRect->handle == secure_id) {
-                  // Inserts rect before existing
-                  psFRect->next = new_rect;
-                  new_rect->next = psRect;
-                  pthread_mutex_unlock(&s_rect_lock);
-                  return;
-            }
-            psFRect = psRect;
-        }
-        // No match found, just append it
-        psFRect->next = new_rect;
-    }
-    pthread_mutex_unlock(&s_rect_lock);
-}
-
-void insert_rect_last(private_handle_rect *new_rect) {
-    int secure_id = new_rect->handle;
-    private_handle_rect *psRect = NULL;
-    private_handle_rect *psFRect = NULL;
-    private_handle_rect *psMatchRect = NULL;
-
-
-    ALOGD_IF(debug_level > 0, "%s secure_id=%d",__func__,secure_id);
-
-    pthread_mutex_lock(&s_rect_lock);
-    if (rect_list == NULL) {
-        rect_list = (private_handle_rect *)calloc(1, sizeof(private_handle_rect));
-        rect_list->next = new_rect;
-    } else {
-        for (psRect = rect_list; psRect; psRect = psRect->next) {
-            if (psRect->handle == secure_id) {
-                psMatchRect = psRect;
-            } else if (psMatchRect) {
-                psMatchRect->next = new_rect;
-                new_rect->next = psRect;
-                pthread_mutex_unlock(&s_rect_lock);
-                return;
-            }
-            psFRect = psRect;
-        }
-        // No match found, just append it
-        psFRect->next = new_rect;
-    }
-    pthread_mutex_unlock(&s_rect_lock);
-}
-
-private_handle_rect *find_last_rect(int secure_id)
-{
-    private_handle_rect *psRect = NULL;
-    private_handle_rect *psFRect = NULL;
-
-    ALOGD_IF(debug_level > 0, "%s secure_id=%d",__func__, secure_id);
-
-    pthread_mutex_lock(&s_rect_lock);
-    if (rect_list == NULL) {
-        rect_list = (private_handle_rect *)calloc(1, sizeof(private_handle_rect));
-        psFRect = rect_list;
-    } else {
-        for (psRect = rect_list; psRect; psRect = psRect->next) {
-            psFRect = psRect;
-            if (psRect->handle == secure_id)
-                break;
-        }
-    }
-    pthread_mutex_unlock(&s_rect_lock);
-    return psFRect;
-}
-
-int count_rect(int secure_id) {
-    private_handle_rect *psRect;
-    private_handle_rect *next;
-
-    int count = 0;
-    pthread_mutex_lock(&s_rect_lock);
-    for (psRect = rect_list; psRect; psRect = psRect->next) {
-        next = psRect->next;
-        if (next && next->handle == secure_id) {
-            count++;
-        }
-    }
-
-    pthread_mutex_unlock(&s_rect_lock);
-    return count;
-}
-
-void dump_rect() {
-    private_handle_rect *psRect;
-    private_handle_rect *next;
-
-    pthread_mutex_lock(&s_rect_lock);
-    for (psRect = rect_list; psRect; psRect = psRect->next) {
-        ALOGD_IF(debug_partial_flush > 0, "%s:PARTIAL_FLUSH handle/ump_id:%d w:%d h:%d stride:%d, psRect:%08x", __func__, psRect->handle, psRect->w, psRect->h, psRect->stride, psRect);
-        next = psRect->next;
-    }
-
-    pthread_mutex_unlock(&s_rect_lock);
-}
-
-int release_rect(int secure_id)
-{
-    int rc = 0;
-    private_handle_rect *psRect;
-    private_handle_rect *psTRect;
-    private_handle_rect *next;
-
-    ALOGD_IF(debug_level > 0, "%s secure_id=%d",__func__,secure_id);
-
-    pthread_mutex_lock(&s_rect_lock);
-    for (psRect = rect_list; psRect; psRect = psRect->next) {
-        next = psRect->next;
-        if (next && next->handle == secure_id) {
-            psTRect = next->next;
-
-            free(next);
-            psRect->next = psTRect;
-            rc = 1;
-            break;
-        }
-    }
-
-    pthread_mutex_unlock(&s_rect_lock);
-    return rc;
-}
-#endif
-
 static int gralloc_map(gralloc_module_t const* module __unused,
         buffer_handle_t handle, void** vaddr)
 {
@@ -350,6 +201,238 @@ static int gralloc_device_open(const hw_module_t* module, const char* name, hw_d
     return status;
 }
 
+/*
+ * Deferred unregister of GraphicBuffer handles.
+ *
+ * A consumer may still touch a GraphicBuffer shortly after the producer
+ * unregisters it, so its UMP mapping is kept for GRALLOC_REAP_GRACE_MS.
+ * One long-lived reaper thread drains the deferral queue; every entry gets
+ * the same grace period, so appending keeps the queue in deadline order.
+ * A handle registered again for the same ump_id before its deadline takes
+ * over the pending mapping instead of creating a new one.
+ */
+#define GRALLOC_REAP_GRACE_MS   1000
+#define GRALLOC_REAP_HASH_SIZE  32
+
+struct deferred_unregister {
+    struct listnode   node;         /* s_reap_queue, oldest first */
+    struct listnode   hash_node;    /* s_reap_hash[ump_id % GRALLOC_REAP_HASH_SIZE] */
+    private_handle_t* hnd;          /* clone owning the mapping and reference */
+    int64_t           deadline_ns;
+};
+
+static pthread_mutex_t s_reap_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_reap_cond;
+static pthread_t s_reap_thread;
+static int s_reap_started = 0;
+static struct listnode s_reap_queue;
+static struct listnode s_reap_hash[GRALLOC_REAP_HASH_SIZE];
+
+static unsigned int s_reap_threads_created = 0;
+static unsigned int s_reap_deferred = 0;
+static unsigned int s_reap_reaped = 0;
+static unsigned int s_reap_pending = 0;
+static unsigned int s_reap_max_pending = 0;
+static unsigned int s_reap_hits = 0;
+static unsigned int s_reap_misses = 0;
+
+static int unregister_buffer(private_handle_t* hnd);
+
+static int64_t reap_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void reap_unlink_l(struct deferred_unregister *entry)
+{
+    list_remove(&entry->node);
+    list_remove(&entry->hash_node);
+    s_reap_pending--;
+}
+
+static void* gralloc_reaper_thread(void *data __unused)
+{
+    struct deferred_unregister *entry;
+    struct timespec ts;
+
+    prctl(PR_SET_NAME, (unsigned long)"gralloc_reaper", 0, 0, 0);
+
+    pthread_mutex_lock(&s_reap_lock);
+    for (;;) {
+        if (list_empty(&s_reap_queue)) {
+            pthread_cond_wait(&s_reap_cond, &s_reap_lock);
+            continue;
+        }
+
+        entry = node_to_item(list_head(&s_reap_queue), struct deferred_unregister, node);
+        if (entry->deadline_ns > reap_now_ns()) {
+            ts.tv_sec = entry->deadline_ns / 1000000000LL;
+            ts.tv_nsec = entry->deadline_ns % 1000000000LL;
+            pthread_cond_timedwait(&s_reap_cond, &s_reap_lock, &ts);
+            continue;
+        }
+
+        reap_unlink_l(entry);
+        s_reap_reaped++;
+        pthread_mutex_unlock(&s_reap_lock);
+
+        ALOGD_IF(debug_level > 1, "%s: ump_id:%d", __func__, entry->hnd->ump_id);
+        unregister_buffer(entry->hnd);
+        delete entry->hnd;
+        free(entry);
+
+        pthread_mutex_lock(&s_reap_lock);
+    }
+
+    pthread_mutex_unlock(&s_reap_lock);
+    return NULL;
+}
+
+/* called with s_reap_lock held */
+static int reap_start_l(void)
+{
+    pthread_condattr_t cond_attr;
+    pthread_attr_t thread_attr;
+    int i, rc;
+
+    if (s_reap_started)
+        return 0;
+
+    list_init(&s_reap_queue);
+    for (i = 0; i < GRALLOC_REAP_HASH_SIZE; i++)
+        list_init(&s_reap_hash[i]);
+
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&s_reap_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    pthread_attr_init(&thread_attr);
+    pthread_attr_setdetachstate(&thread_attr, PTHREAD_CREATE_DETACHED);
+    rc = pthread_create(&s_reap_thread, &thread_attr, gralloc_reaper_thread, NULL);
+    pthread_attr_destroy(&thread_attr);
+    if (rc != 0) {
+        ALOGE("%s: Unable to create reaper thread (%s)", __func__, strerror(rc));
+        pthread_cond_destroy(&s_reap_cond);
+        return -rc;
+    }
+
+    s_reap_threads_created++;
+    s_reap_started = 1;
+    return 0;
+}
+
+/*
+ * Queues a clone of hnd for unregistration after the grace period.
+ * Returns 0 on success; the caller unregisters synchronously otherwise.
+ */
+static int reap_defer(private_handle_t* clone)
+{
+    struct deferred_unregister *entry;
+
+    entry = (struct deferred_unregister *)calloc(1, sizeof(*entry));
+    if (entry == NULL)
+        return -ENOMEM;
+
+    entry->hnd = clone;
+
+    pthread_mutex_lock(&s_reap_lock);
+    if (reap_start_l() < 0) {
+        pthread_mutex_unlock(&s_reap_lock);
+        free(entry);
+        return -EAGAIN;
+    }
+
+    entry->deadline_ns = reap_now_ns() + GRALLOC_REAP_GRACE_MS * 1000000LL;
+    list_add_tail(&s_reap_queue, &entry->node);
+    list_add_tail(&s_reap_hash[(unsigned int)clone->ump_id % GRALLOC_REAP_HASH_SIZE],
+                  &entry->hash_node);
+
+    s_reap_deferred++;
+    if (++s_reap_pending > s_reap_max_pending)
+        s_reap_max_pending = s_reap_pending;
+
+    pthread_cond_signal(&s_reap_cond);
+    pthread_mutex_unlock(&s_reap_lock);
+    return 0;
+}
+
+/*
+ * Hands a pending mapping for hnd->ump_id over to hnd.
+ * Called with s_map_lock held. Returns 1 on a hit, 0 otherwise.
+ */
+static int reap_reuse(private_handle_t* hnd)
+{
+    struct deferred_unregister *entry = NULL;
+    struct listnode *node;
+
+    pthread_mutex_lock(&s_reap_lock);
+    if (s_reap_started) {
+        list_for_each(node, &s_reap_hash[(unsigned int)hnd->ump_id % GRALLOC_REAP_HASH_SIZE]) {
+            struct deferred_unregister *e =
+                node_to_item(node, struct deferred_unregister, hash_node);
+            if ((e->hnd->flags & private_handle_t::PRIV_FLAGS_USES_UMP) &&
+                e->hnd->ump_id == hnd->ump_id) {
+                entry = e;
+                break;
+            }
+        }
+    }
+
+    if (entry) {
+        reap_unlink_l(entry);
+        s_reap_hits++;
+    } else {
+        s_reap_misses++;
+    }
+    pthread_mutex_unlock(&s_reap_lock);
+
+    if (entry == NULL)
+        return 0;
+
+    ALOGD_IF(debug_level > 1, "%s: ump_id:%d ump_mem_handle:%08x", __func__,
+             hnd->ump_id, entry->hnd->ump_mem_handle);
+
+    hnd->ump_mem_handle = entry->hnd->ump_mem_handle;
+    hnd->base = entry->hnd->base;
+    hnd->writeOwner = 0;
+    hnd->lockState = 0;
+
+#ifdef USE_PARTIAL_FLUSH
+    /* the new registration already added its own rect */
+    if (!release_rect((int)hnd->ump_id))
+        ALOGE("%s: PARTIAL_FLUSH ump_id:%d, release error", __func__, (int)hnd->ump_id);
+#endif
+
+    delete entry->hnd;
+    free(entry);
+    return 1;
+}
+
+void gralloc_dump_reaper(char *buff, int buff_len)
+{
+    unsigned int lookups;
+
+    if (buff == NULL || buff_len <= 0)
+        return;
+
+    pthread_mutex_lock(&s_reap_lock);
+    lookups = s_reap_hits + s_reap_misses;
+    snprintf(buff, buff_len,
+             "gralloc deferred unregister (grace %d ms):\n"
+             "  reaper threads created: %u\n"
+             "  deferred: %u reaped: %u pending: %u (max %u)\n"
+             "  mapping reuse: %u hits / %u lookups (%u%%)\n",
+             GRALLOC_REAP_GRACE_MS,
+             s_reap_threads_created,
+             s_reap_deferred, s_reap_reaped, s_reap_pending, s_reap_max_pending,
+             s_reap_hits, lookups, lookups ? s_reap_hits * 100 / lookups : 0);
+    pthread_mutex_unlock(&s_reap_lock);
+}
+
 static int gralloc_register_buffer(gralloc_module_t const* module, buffer_handle_t handle)
 {
     int err = 0;
@@ -376,14 +459,10 @@ static int gralloc_register_buffer(gralloc_module_t const* module, buffer_handle
             __func__, hnd->ump_id, hnd->ump_mem_handle, hnd->flags, hnd->usage, count_rect(hnd->ump_id), hnd->backing_store);
         if (debug_partial_flush > 0)
             dump_rect();
-        private_handle_rect *psRect;
-        psRect = (private_handle_rect *)calloc(1, sizeof(private_handle_rect));
-        psRect->handle = (int)hnd->ump_id;
-        psRect->stride = (int) (hnd->stride * get_bpp(hnd->format));
         ALOGD_IF(debug_partial_flush > 0,
-            "%s: PARTIAL_FLUSH ump_id:%d === insert_rect_last === ump_mem_handle:%08x flags=%x usage=%x count:%d backingstore:%d",
+            "%s: PARTIAL_FLUSH ump_id:%d === register_rect === ump_mem_handle:%08x flags=%x usage=%x count:%d backingstore:%d",
             __func__, hnd->ump_id, hnd->ump_mem_handle, hnd->flags, hnd->usage, count_rect(hnd->ump_id), hnd->backing_store);
-        insert_rect_last(psRect);
+        register_rect((int)hnd->ump_id, (int)(hnd->stride * get_bpp(hnd->format)), get_bpp(hnd->format));
         if (debug_partial_flush > 0)
             dump_rect();
         ALOGD_IF(debug_partial_flush > 0,
@@ -426,6 +505,11 @@ sd
    if (hnd->flags & private_handle_t::PRIV_FLAGS_USES_UMP) {
         ALOGD_IF(debug_level > 1, "%s: ump_id:%d ump_mem_handle:%08x", __func__, hnd->ump_id, hnd->ump_mem_handle);
 
+        if (reap_reuse(hnd)) {
+            pthread_mutex_unlock(&s_map_lock);
+            return 0;
+        }
+
         hnd->ump_mem_handle = (int)ump_handle_create_from_secure_id(hnd->ump_id);
         ALOGD_IF(debug_partial_flush > 0, "%s: PARTIAL_FLUSH ump_id:%d ump_mem_handle:%08x flags=%x usage=%x count:%d backing_store:%d", __func__, hnd->ump_id, hnd->ump_mem_handle, hnd->flags, hnd->usage, count_rect(hnd->ump_id), hnd->backing_store);
 
@@ -600,17 +684,6 @@ static int unregister_buffer(private_handle_t* hnd) {
     return 0;
 }
 
-void* gralloc_unregister_buffer_thread(void *data) {
-    private_handle_t* hnd = (private_handle_t*)data;
-
-    ALOGD_IF(debug_level > 1, "%s: ump_id:%d START", __func__, hnd->ump_id);
-    usleep(1000000); // 1000ms
-    unregister_buffer(hnd);
-    ALOGD_IF(debug_level > 1, "%s: ump_id:%d END", __func__, hnd->ump_id);
-    delete hnd;
-    return NULL;
-}
-
 static private_handle_t* clone_private_handle(private_handle_t* hnd) {
     private_handle_t* result = new private_handle_t(
         hnd->flags,
@@ -653,18 +726,13 @@ static int gralloc_unregister_buffer(gralloc_module_t const* module, buffer_hand
     private_handle_t* hnd = (private_handle_t*)handle;
     ALOGD_IF(debug_level > 1, "%s: ump_id:%d", __func__, hnd->ump_id);
     if (hnd->flags & private_handle_t::PRIV_FLAGS_GRAPHICBUFFER) {
-        pthread_attr_t thread_attr;
-        pthread_t unreg_buffer_thread;
-
-        pthread_attr_init(&thread_attr);
-        pthread_attr_setdetachstate(&thread_attr, PTHREAD_CREATE_DETACHED);
-        int rc = pthread_create(&unreg_buffer_thread, &thread_attr,
-	    gralloc_unregister_buffer_thread, (void *) clone_private_handle(hnd));
-        if (rc < 0) {
-            ALOGE("%s: Unable to create thread", __func__);
-            return -1;
-        }
-        return 0;
+        private_handle_t* clone = clone_private_handle(hnd);
+
+        if (reap_defer(clone) == 0)
+            return 0;
+
+        ALOGE("%s: ump_id:%d deferral failed, unregistering now", __func__, hnd->ump_id);
+        delete clone;
     }
 
     return unregister_buffer(hnd);
@@ -688,15 +756,7 @@ static int gralloc_lock(gralloc_module_t const* module __unused, buffer_handle_t
         ALOGD_IF(debug_level > 0, "%s private_handle_t::PRIV_FLAGS_USES_UMP hnd->ump_id=%d ", __func__, hnd->ump_id);
 
 #ifdef USE_PARTIAL_FLUSH
-        private_handle_rect *psRect;
-        psRect = find_rect((int)hnd->ump_id);
-        if (psRect) {
-            psRect->l = l;
-            psRect->t = t;
-            psRect->w = w;
-            psRect->h= h;
-            psRect->locked = 1;
-        }
+        mark_rect((int)hnd->ump_id, l, t, w, h);
 #endif
 
         hnd->writeOwner = usage & GRALLOC_USAGE_SW_WRITE_MASK;
@@ -752,14 +812,16 @@ static int gralloc_unlock(gralloc_module_t const* module, buffer_handle_t handle
             }
         } else {
 #ifdef USE_PARTIAL_FLUSH
-            private_handle_rect *psRect;
+            struct rect_span spans[PARTIAL_FLUSH_MAX_DIRTY];
+            int num_spans = take_dirty_spans((int)hnd->ump_id, hnd->size, spans);
 
-            psRect = find_rect((int)hnd->ump_id);
-            if (psRect) {
-                ALOGD_IF(debug_level > 0, "%s rect found hnd->base=%x (psRect->stride(%d) * psRect->t(%d))=%d psRect->stride * psRect->h(%d)=%d", __func__, hnd->base, psRect->stride, psRect->t, (psRect->stride * psRect->t), psRect->h, (psRect->stride * psRect->h));
+            if (num_spans >= 0) {
+                for (int i = 0; i < num_spans; i++) {
+                    ALOGD_IF(debug_level > 0, "%s dirty span hnd->base=%x start=%lld end=%lld", __func__, hnd->base, spans[i].start, spans[i].end);
 
-                ump_cpu_msync_now((ump_handle)hnd->ump_mem_handle, UMP_MSYNC_CLEAN_AND_INVALIDATE,
-                        (void *)(hnd->base + (psRect->stride * psRect->t)), psRect->stride * psRect->h );
+                    ump_cpu_msync_now((ump_handle)hnd->ump_mem_handle, UMP_MSYNC_CLEAN_AND_INVALIDATE,
+                            (void *)(hnd->base + (int)spans[i].start), (int)(spans[i].end - spans[i].start));
+                }
             } else {
                 ump_cpu_msync_now((ump_handle)hnd->ump_mem_handle, UMP_MSYNC_CLEAN_AND_INVALIDATE, NULL, 0);
             }
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2010 ARM Limited. All rights reserved.
+ *
+ * Copyright (C) 2008 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cutils/log.h>
+
+#include "partial_flush.h"
+
+#define debug_level 0
+#define debug_partial_flush 0
+
+/*
+ * Partial flush registry: one private_handle_rect per UMP secure id, hashed
+ * into buckets that each have their own lock. gralloc_lock() adds the locked
+ * region to the dirty rects, merging overlapping ones, and gralloc_unlock()
+ * only cleans the cache lines covering them.
+ */
+#define RECT_HASH_SIZE              64
+#define PARTIAL_FLUSH_CACHE_LINE    32
+
+struct rect_bucket {
+    pthread_mutex_t lock;
+    struct private_handle_rect *head;
+};
+
+static struct rect_bucket rect_hash[RECT_HASH_SIZE];
+static pthread_once_t rect_hash_once = PTHREAD_ONCE_INIT;
+
+static void rect_hash_init(void)
+{
+    for (int i = 0; i < RECT_HASH_SIZE; i++) {
+        pthread_mutex_init(&rect_hash[i].lock, NULL);
+        rect_hash[i].head = NULL;
+    }
+}
+
+static struct rect_bucket *rect_bucket_get(int secure_id)
+{
+    pthread_once(&rect_hash_once, rect_hash_init);
+    return &rect_hash[(unsigned int)secure_id % RECT_HASH_SIZE];
+}
+
+/* called with the bucket lock held */
+static private_handle_rect *find_rect_l(struct rect_bucket *bucket, int secure_id)
+{
+    private_handle_rect *psRect;
+
+    for (psRect = bucket->head; psRect; psRect = psRect->next)
+        if (psRect->handle == secure_id)
+            break;
+
+    return psRect;
+}
+
+void register_rect(int secure_id, int stride, int bpp)
+{
+    struct rect_bucket *bucket = rect_bucket_get(secure_id);
+    private_handle_rect *psRect;
+
+    ALOGD_IF(debug_level > 0, "%s secure_id=%d stride=%d bpp=%d", __func__, secure_id, stride, bpp);
+
+    pthread_mutex_lock(&bucket->lock);
+    psRect = find_rect_l(bucket, secure_id);
+    if (psRect) {
+        psRect->refs++;
+    } else {
+        psRect = (private_handle_rect *)calloc(1, sizeof(private_handle_rect));
+        if (psRect) {
+            psRect->handle = secure_id;
+            psRect->stride = stride;
+            psRect->bpp = bpp;
+            psRect->refs = 1;
+            psRect->next = bucket->head;
+            bucket->head = psRect;
+        } else {
+            ALOGE("%s secure_id=%d out of memory", __func__, secure_id);
+        }
+    }
+    pthread_mutex_unlock(&bucket->lock);
+}
+
+int count_rect(int secure_id)
+{
+    struct rect_bucket *bucket = rect_bucket_get(secure_id);
+    private_handle_rect *psRect;
+    int count = 0;
+
+    pthread_mutex_lock(&bucket->lock);
+    psRect = find_rect_l(bucket, secure_id);
+    if (psRect)
+        count = psRect->refs;
+    pthread_mutex_unlock(&bucket->lock);
+
+    return count;
+}
+
+void dump_rect()
+{
+    private_handle_rect *psRect;
+
+    pthread_once(&rect_hash_once, rect_hash_init);
+    for (int i = 0; i < RECT_HASH_SIZE; i++) {
+        pthread_mutex_lock(&rect_hash[i].lock);
+        for (psRect = rect_hash[i].head; psRect; psRect = psRect->next) {
+            ALOGD_IF(debug_partial_flush > 0, "%s:PARTIAL_FLUSH bucket:%d handle/ump_id:%d refs:%d stride:%d bpp:%d dirty:%d, psRect:%p",
+                __func__, i, psRect->handle, psRect->refs, psRect->stride, psRect->bpp, psRect->num_dirty, psRect);
+        }
+        pthread_mutex_unlock(&rect_hash[i].lock);
+    }
+}
+
+int release_rect(int secure_id)
+{
+    struct rect_bucket *bucket = rect_bucket_get(secure_id);
+    private_handle_rect **ppRect;
+    private_handle_rect *psRect;
+    int rc = 0;
+
+    ALOGD_IF(debug_level > 0, "%s secure_id=%d",__func__,secure_id);
+
+    pthread_mutex_lock(&bucket->lock);
+    for (ppRect = &bucket->head; (psRect = *ppRect) != NULL; ppRect = &psRect->next) {
+        if (psRect->handle == secure_id) {
+            if (--psRect->refs == 0) {
+                *ppRect = psRect->next;
+                free(psRect);
+            }
+            rc = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&bucket->lock);
+
+    return rc;
+}
+
+static int64_t dirty_area(const struct private_handle_dirty *d)
+{
+    return (int64_t)(d->r - d->l) * (d->b - d->t);
+}
+
+static void dirty_union(struct private_handle_dirty *d, const struct private_handle_dirty *o)
+{
+    if (o->l < d->l) d->l = o->l;
+    if (o->t < d->t) d->t = o->t;
+    if (o->r > d->r) d->r = o->r;
+    if (o->b > d->b) d->b = o->b;
+}
+
+/* called with the bucket lock held */
+static void rect_add_dirty_l(private_handle_rect *psRect, struct private_handle_dirty d)
+{
+    for (;;) {
+        int i, merged = 0;
+
+        /* absorb every rect that overlaps or touches d */
+        for (i = 0; i < psRect->num_dirty; i++) {
+            struct private_handle_dirty *o = &psRect->dirty[i];
+            if (o->l <= d.r && d.l <= o->r && o->t <= d.b && d.t <= o->b) {
+                dirty_union(&d, o);
+                psRect->dirty[i] = psRect->dirty[--psRect->num_dirty];
+                merged = 1;
+                break;
+            }
+        }
+        if (merged)
+            continue;
+
+        if (psRect->num_dirty < PARTIAL_FLUSH_MAX_DIRTY)
+            break;
+
+        /* full: fold d into the rect whose bounding box grows least */
+        int best = 0;
+        int64_t best_growth = -1;
+        for (i = 0; i < psRect->num_dirty; i++) {
+            struct private_handle_dirty u = psRect->dirty[i];
+            dirty_union(&u, &d);
+            int64_t growth = dirty_area(&u) - dirty_area(&psRect->dirty[i]);
+            if (best_growth < 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        dirty_union(&d, &psRect->dirty[best]);
+        psRect->dirty[best] = psRect->dirty[--psRect->num_dirty];
+    }
+
+    psRect->dirty[psRect->num_dirty++] = d;
+}
+
+int mark_rect(int secure_id, int l, int t, int w, int h)
+{
+    struct rect_bucket *bucket = rect_bucket_get(secure_id);
+    private_handle_rect *psRect;
+    struct private_handle_dirty d;
+
+    if (w <= 0 || h <= 0 || l < 0 || t < 0) {
+        /* no usable region, treat the whole buffer as dirty */
+        d.l = 0;
+        d.t = 0;
+        d.r = INT_MAX;
+        d.b = INT_MAX;
+    } else {
+        d.l = l;
+        d.t = t;
+        d.r = l + w;
+        d.b = t + h;
+    }
+
+    pthread_mutex_lock(&bucket->lock);
+    psRect = find_rect_l(bucket, secure_id);
+    if (psRect) {
+        rect_add_dirty_l(psRect, d);
+        psRect->locked = 1;
+    }
+    pthread_mutex_unlock(&bucket->lock);
+
+    return psRect != NULL;
+}
+
+/*
+ * Turns the dirty rects of secure_id into cache line aligned byte ranges
+ * within [0, size), sorted and coalesced, and clears them.
+ * Returns the number of ranges, or -1 if there is nothing to go by.
+ */
+int take_dirty_spans(int secure_id, int size, struct rect_span *spans)
+{
+    struct rect_bucket *bucket = rect_bucket_get(secure_id);
+    private_handle_rect *psRect;
+    struct private_handle_dirty dirty[PARTIAL_FLUSH_MAX_DIRTY];
+    int num_dirty = 0, stride = 0, bpp = 0;
+    int i, j, n = 0;
+
+    pthread_mutex_lock(&bucket->lock);
+    psRect = find_rect_l(bucket, secure_id);
+    if (psRect) {
+        num_dirty = psRect->num_dirty;
+        memcpy(dirty, psRect->dirty, num_dirty * sizeof(dirty[0]));
+        stride = psRect->stride;
+        bpp = psRect->bpp;
+        psRect->num_dirty = 0;
+        psRect->locked = 0;
+    }
+    pthread_mutex_unlock(&bucket->lock);
+
+    if (num_dirty == 0 || stride <= 0)
+        return -1;
+
+    for (i = 0; i < num_dirty; i++) {
+        int64_t l = 0, r = stride;
+        struct rect_span span;
+
+        if (bpp > 0) {
+            l = (int64_t)dirty[i].l * bpp;
+            if ((int64_t)dirty[i].r * bpp < r)
+                r = (int64_t)dirty[i].r * bpp;
+        }
+
+        span.start = (int64_t)dirty[i].t * stride + l;
+        span.end = (int64_t)(dirty[i].b - 1) * stride + r;
+        if (span.end > size)
+            span.end = size;
+        span.start &= ~(int64_t)(PARTIAL_FLUSH_CACHE_LINE - 1);
+        span.end = (span.end + PARTIAL_FLUSH_CACHE_LINE - 1) & ~(int64_t)(PARTIAL_FLUSH_CACHE_LINE - 1);
+        if (span.end > size)
+            span.end = size;
+        if (span.start >= span.end)
+            continue;
+
+        /* insertion sort by start */
+        for (j = n; j > 0 && spans[j - 1].start > span.start; j--)
+            spans[j] = spans[j - 1];
+        spans[j] = span;
+        n++;
+    }
+
+    for (i = 0, j = 0; i < n; i++) {
+        if (j > 0 && spans[i].start <= spans[j - 1].end) {
+            if (spans[i].end > spans[j - 1].end)
+                spans[j - 1].end = spans[i].end;
+        } else {
+            spans[j++] = spans[i];
+        }
+    }
+
+    return j;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2010 ARM Limited. All rights reserved.
+ *
+ * Copyright (C) 2008 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARTIAL_FLUSH_H_
+#define PARTIAL_FLUSH_H_
+
+#include <stdint.h>
+
+/*
+ * Partial flush registry of UMP buffers, keyed by secure id. Kept free of
+ * the gralloc and UMP headers so partial_flush_bench can build it on the
+ * host.
+ */
+#define PARTIAL_FLUSH_MAX_DIRTY 4
+
+struct private_handle_dirty {
+    int l;
+    int t;
+    int r;
+    int b;
+};
+
+/* one per UMP secure id, shared by every registration of the buffer */
+struct private_handle_rect {
+    int handle;
+    int stride;
+    int bpp;
+    int refs;
+    int locked;
+    int num_dirty;
+    struct private_handle_dirty dirty[PARTIAL_FLUSH_MAX_DIRTY];
+    struct private_handle_rect *next;
+};
+
+/* byte range [start, end) of a buffer to clean */
+struct rect_span {
+    int64_t start;
+    int64_t end;
+};
+
+void register_rect(int secure_id, int stride, int bpp);
+int release_rect(int secure_id);
+int count_rect(int secure_id);
+void dump_rect();
+
+int mark_rect(int secure_id, int l, int t, int w, int h);
+int take_dirty_spans(int secure_id, int size, struct rect_span *spans);
+
+#endif /* PARTIAL_FLUSH_H_ */
@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2010 ARM Limited. All rights reserved.
+ *
+ * Copyright (C) 2008 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host benchmark of the partial flush registry against the single global
+ * list it replaced, driving the gralloc_lock()/gralloc_unlock() paths with
+ * a ump_cpu_msync_now() stand-in that counts cleaned bytes:
+ *   partial_flush_bench [iterations]
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "partial_flush.h"
+
+#define BUF_W       720
+#define BUF_H       1280
+#define BUF_BPP     4
+#define NUM_BUFS    128
+#define NUM_THREADS 4
+
+static const int s_size = BUF_W * BUF_H * BUF_BPP;
+static int64_t s_bytes;
+static int64_t s_calls;
+
+/* ump_cpu_msync_now(); a NULL range cleans the whole buffer */
+static void msync_count(int offset, int len)
+{
+    s_calls++;
+    s_bytes += (offset < 0) ? s_size : len;
+}
+
+/*
+ * The registry before the hash: one node per registration on a list under
+ * one lock, remembering only the last locked rect.
+ */
+struct ref_rect {
+    int handle;
+    int stride;
+    int t;
+    int h;
+    struct ref_rect *next;
+};
+
+static struct ref_rect *s_ref_list;
+static pthread_mutex_t s_ref_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct ref_rect *ref_find_rect(int secure_id)
+{
+    struct ref_rect *psRect;
+
+    pthread_mutex_lock(&s_ref_lock);
+    for (psRect = s_ref_list; psRect; psRect = psRect->next)
+        if (psRect->handle == secure_id)
+            break;
+    pthread_mutex_unlock(&s_ref_lock);
+    return psRect;
+}
+
+static void ref_register(int secure_id, int stride)
+{
+    struct ref_rect *psRect = (struct ref_rect *)calloc(1, sizeof(*psRect));
+    struct ref_rect **ppRect;
+
+    psRect->handle = secure_id;
+    psRect->stride = stride;
+    pthread_mutex_lock(&s_ref_lock);
+    for (ppRect = &s_ref_list; *ppRect; ppRect = &(*ppRect)->next)
+        ;
+    *ppRect = psRect;
+    pthread_mutex_unlock(&s_ref_lock);
+}
+
+static void ref_lock(int secure_id, int l, int t, int w, int h)
+{
+    struct ref_rect *psRect = ref_find_rect(secure_id);
+
+    (void)l;
+    (void)w;
+    if (psRect) {
+        psRect->t = t;
+        psRect->h = h;
+    }
+}
+
+static void ref_unlock(int secure_id)
+{
+    struct ref_rect *psRect = ref_find_rect(secure_id);
+
+    if (psRect)
+        msync_count(psRect->stride * psRect->t, psRect->stride * psRect->h);
+    else
+        msync_count(-1, 0);
+}
+
+static void new_lock(int secure_id, int l, int t, int w, int h)
+{
+    mark_rect(secure_id, l, t, w, h);
+}
+
+static void new_unlock(int secure_id)
+{
+    struct rect_span spans[PARTIAL_FLUSH_MAX_DIRTY];
+    int n = take_dirty_spans(secure_id, s_size, spans);
+
+    if (n < 0)
+        msync_count(-1, 0);
+    for (int i = 0; i < n; i++)
+        msync_count((int)spans[i].start, (int)(spans[i].end - spans[i].start));
+}
+
+struct registry {
+    const char *name;
+    void (*lock)(int secure_id, int l, int t, int w, int h);
+    void (*unlock)(int secure_id);
+};
+
+static const struct registry s_registries[] = {
+    { "old list", ref_lock, ref_unlock },
+    { "hashed", new_lock, new_unlock },
+};
+
+struct worker_arg {
+    const struct registry *reg;
+    int secure_id;
+    int iterations;
+};
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void *worker(void *data)
+{
+    struct worker_arg *arg = (struct worker_arg *)data;
+
+    for (int i = 0; i < arg->iterations; i++) {
+        arg->reg->lock(arg->secure_id, 0, 0, BUF_W, BUF_H);
+        arg->reg->unlock(arg->secure_id);
+    }
+    return NULL;
+}
+
+static void run(const struct registry *reg, int iterations)
+{
+    pthread_t threads[NUM_THREADS];
+    struct worker_arg args[NUM_THREADS];
+    double t0;
+
+    printf("%s\n", reg->name);
+
+    /* lookup cost: the most recently registered buffer */
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        reg->lock(NUM_BUFS, 0, 0, BUF_W, BUF_H);
+        reg->unlock(NUM_BUFS);
+    }
+    printf("  full lock+unlock, %d buffers       %8.1f ns\n", NUM_BUFS,
+            (now_ns() - t0) / iterations);
+
+    /* a clock and a cursor redrawn every frame */
+    s_bytes = s_calls = 0;
+    t0 = now_ns();
+    for (int i = 0; i < iterations; i++) {
+        reg->lock(NUM_BUFS, 600, 10, 100, 40);
+        reg->lock(NUM_BUFS, 300, 700, 32, 32);
+        reg->unlock(NUM_BUFS);
+    }
+    printf("  two small rects per frame         %8.1f ns %8.1f KiB %5.2f msync\n",
+            (now_ns() - t0) / iterations, s_bytes / 1024.0 / iterations,
+            (double)s_calls / iterations);
+
+    s_bytes = s_calls = 0;
+    for (int i = 0; i < iterations; i++) {
+        reg->lock(NUM_BUFS, 328, 600, 64, 64);
+        reg->unlock(NUM_BUFS);
+    }
+    printf("  one 64x64 rect                    %8.1f KiB\n", s_bytes / 1024.0 / iterations);
+
+    /* contention: every thread on its own buffer */
+    t0 = now_ns();
+    for (int k = 0; k < NUM_THREADS; k++) {
+        args[k].reg = reg;
+        args[k].secure_id = k * 17 + 5;
+        args[k].iterations = iterations;
+        pthread_create(&threads[k], NULL, worker, &args[k]);
+    }
+    for (int k = 0; k < NUM_THREADS; k++)
+        pthread_join(threads[k], NULL);
+    printf("  %d threads, separate buffers       %8.1f ms\n", NUM_THREADS,
+            (now_ns() - t0) / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+
+    if (iterations < 1)
+        iterations = 1;
+
+    for (int i = 1; i <= NUM_BUFS; i++) {
+        ref_register(i, BUF_W * BUF_BPP);
+        register_rect(i, BUF_W * BUF_BPP, BUF_BPP);
+    }
+
+    for (size_t i = 0; i < sizeof(s_registries) / sizeof(s_registries[0]); i++)
+        run(&s_registries[i], iterations);
+
+    return 0;
+}
@@ -17,6 +17,7 @@
 //#define LOG_NDEBUG 0
 //#define LOG_TAG "libhdmi"
 #include <cutils/log.h>
+#include <utils/String8.h>
 
 #if defined(BOARD_USE_V4L2_ION)
 #include "ion.h"
@@ -51,6 +52,25 @@ extern unsigned int cur_g2d_address;
 extern unsigned int g2d_buf_index;
 #endif
 
+static const char * const reconfigFuncName[SecHdmi::HDMI_RECONFIG_LEVELS] = {
+    "m_applyLayer", "m_resetLayer", "m_reset",
+};
+
+// formats the mixer video layer takes without FIMC
+static bool isVideoLayerFormat(int colorFormat)
+{
+    switch (colorFormat) {
+    case HAL_PIXEL_FORMAT_YCbCr_420_SP:
+    case HAL_PIXEL_FORMAT_YCrCb_420_SP:
+    case HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP:
+    case HAL_PIXEL_FORMAT_CUSTOM_YCrCb_420_SP:
+    case HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP_TILED:
+        return true;
+    default:
+        return false;
+    }
+}
+
 #if defined(BOARD_USES_CEC)
 SecHdmi::CECThread::~CECThread()
 {
@@ -282,6 +302,7 @@ SecHdmi::SecHdmi():
         mDstHeight [i] = 0;
         mPrevDstWidth  [i] = 0;
         mPrevDstHeight [i] = 0;
+        mLayerRotVal   [i] = 0;
     }
 
     mHdmiPresetId = DEFAULT_HDMI_PRESET_ID;
@@ -323,6 +344,7 @@ SecHdmi::SecHdmi():
 #endif
 
     memset(&mDstRect, 0 , sizeof(struct v4l2_rect));
+    memset(&mReconfigStats, 0, sizeof(mReconfigStats));
 }
 
 SecHdmi::~SecHdmi()
@@ -502,6 +524,7 @@ bool SecHdmi::destroy(void)
             ALOGE("%s::hdmi_deinit_layer(%d) fail \n", __func__, layer);
             goto DESTROY_FAIL;
         }
+        mHdmiFd[layer] = -1;
     }
 
 #if !defined(BOARD_USE_V4L2)
@@ -658,6 +681,7 @@ bool SecHdmi::disconnect(void)
     for (int layer = HDMI_LAYER_BASE + 1; layer < HDMI_LAYER_MAX; layer++) {
         if (hdmi_deinit_layer(layer) < 0)
             ALOGE("%s::hdmi_deinit_layer(%d) fail", __func__, layer);
+        mHdmiFd[layer] = -1;
     }
 #else
     tvout_deinit();
@@ -750,26 +774,38 @@ bool SecHdmi::flush(int srcW, int srcH, int srcColorFormat,
 #endif
 #endif
 
-    if (srcW != mSrcWidth[hdmiLayer] ||
-        srcH != mSrcHeight[hdmiLayer] ||
-        srcColorFormat != mSrcColorFormat[hdmiLayer] ||
-        mHdmiDstWidth != mHdmiResolutionWidth[hdmiLayer] ||
-        mHdmiDstHeight != mHdmiResolutionHeight[hdmiLayer] ||
-#if defined(BOARD_USE_V4L2)
-        mDstWidth[hdmiLayer] != mPrevDstWidth[hdmiLayer] ||
-        mDstHeight[hdmiLayer] != mPrevDstHeight[hdmiLayer] ||
-#endif
-        mHdmiInfoChange == true) {
+    unsigned int change = m_layerChanges(srcW, srcH, srcColorFormat, hdmiLayer);
+
+    mReconfigStats.flushes++;
+
+    if (change == 0) {
+        mReconfigStats.addr_only++;
+    } else {
+        int level = m_reconfigLevel(change, hdmiLayer);
+        nsecs_t start = systemTime();
+        bool ret;
+
 #ifdef DEBUG_MSG_ENABLE
-        ALOGD("m_reset param(%d, %d, %d, %d, %d, %d, %d)",
+        ALOGD("%s param(0x%x, %d, %d, %d, %d, %d, %d, %d)",
+            reconfigFuncName[level], change, \
             srcW, mSrcWidth[hdmiLayer], \
             srcH, mSrcHeight[hdmiLayer], \
             srcColorFormat,mSrcColorFormat[hdmiLayer], \
             hdmiLayer);
 #endif
 
-        if (m_reset(srcW, srcH, srcColorFormat, hdmiLayer, num_of_hwc_layer) == false) {
-            ALOGE("%s::m_reset(%d, %d, %d, %d, %d) fail", __func__, srcW, srcH, srcColorFormat, hdmiLayer, num_of_hwc_layer);
+        if (level == HDMI_RECONFIG_APPLY)
+            ret = m_applyLayer(srcW, srcH, srcColorFormat, hdmiLayer, num_of_hwc_layer, change);
+        else if (level == HDMI_RECONFIG_LAYER)
+            ret = m_resetLayer(srcW, srcH, srcColorFormat, hdmiLayer, num_of_hwc_layer);
+        else
+            ret = m_reset(srcW, srcH, srcColorFormat, hdmiLayer, num_of_hwc_layer, change);
+
+        m_addReconfigStat(change, level, ret, systemTime() - start);
+
+        if (ret == false) {
+            ALOGE("%s::%s(%d, %d, %d, %d, %d) fail", __func__, reconfigFuncName[level],
+                    srcW, srcH, srcColorFormat, hdmiLayer, num_of_hwc_layer);
             return false;
         }
     }
@@ -1240,25 +1276,26 @@ bool SecHdmi::setUIRotation(unsigned int rotVal, unsigned int hwcLayer)
         return false;
     }
 
+    /*
+     * Neither rotation touches the HDMI output: G2D rotates every frame,
+     * and flush() reconfigures just the layer for a new dst rect or FIMC
+     * rotation.
+     */
+
     /* G2D rotation */
-    if (rotVal != mG2DUIRotVal) {
-        mG2DUIRotVal = rotVal;
-        mHdmiInfoChange = true;
-    }
+    mG2DUIRotVal = rotVal;
 
     /* FIMC rotation */
     if (hwcLayer == 0) { /* Rotate in UI only mode */
         if (rotVal != mUIRotVal) {
             mSecFimc.setRotVal(rotVal);
             mUIRotVal = rotVal;
-            mHdmiInfoChange = true;
         }
     } else { /* Don't rotate video layer when video is played. */
         rotVal = 0;
         if (rotVal != mUIRotVal) {
             mSecFimc.setRotVal(rotVal);
             mUIRotVal = rotVal;
-            mHdmiInfoChange = true;
         }
     }
 
@@ -1273,7 +1310,98 @@ bool SecHdmi::setDisplaySize(int width, int height)
     return true;
 }
 
-bool SecHdmi::m_reset(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer)
+void SecHdmi::getReconfigStats(struct reconfig_stats *stats)
+{
+    Mutex::Autolock lock(mLock);
+
+    *stats = mReconfigStats;
+}
+
+status_t SecHdmi::dump(int fd)
+{
+    static const char * const causeName[HDMI_CHANGE_CAUSES] = {
+        "src_size", "format", "dst_rect", "rotation", "resolution", "output", "open",
+    };
+    static const char * const levelName[HDMI_RECONFIG_LEVELS] = {
+        "apply", "layer", "reset",
+    };
+    const size_t SIZE = 256;
+    char buffer[SIZE];
+    String8 result;
+    struct reconfig_stats stats;
+
+    getReconfigStats(&stats);
+
+    snprintf(buffer, SIZE, "SecHdmi flushes(%u) buffer only(%u)\n",
+             stats.flushes, stats.addr_only);
+    result.append(buffer);
+
+    result.append(" causes:");
+    for (int i = 0; i < HDMI_CHANGE_CAUSES; i++) {
+        snprintf(buffer, SIZE, " %s(%u)", causeName[i], stats.causes[i]);
+        result.append(buffer);
+    }
+    result.append("\n");
+
+    for (int level = 0; level < HDMI_RECONFIG_LEVELS; level++) {
+        unsigned int count = stats.count[level];
+
+        snprintf(buffer, SIZE, " %s: count(%u) failed(%u) avg(%lld us) max(%lld us)\n  ms:",
+                 levelName[level], count, stats.failed[level],
+                 count ? (long long)ns2us(stats.sum[level]) / count : 0LL,
+                 (long long)ns2us(stats.max[level]));
+        result.append(buffer);
+
+        for (int i = 0; i < HDMI_RECONFIG_BUCKETS; i++) {
+            if (i < HDMI_RECONFIG_BUCKETS - 1)
+                snprintf(buffer, SIZE, " <%d(%u)", 1 << i, stats.hist[level][i]);
+            else
+                snprintf(buffer, SIZE, " >=%d(%u)", 1 << (i - 1), stats.hist[level][i]);
+            result.append(buffer);
+        }
+        result.append("\n");
+    }
+
+    ::write(fd, result.string(), result.size());
+    return NO_ERROR;
+}
+
+unsigned int SecHdmi::m_layerChanges(int w, int h, int colorFormat, int hdmiLayer)
+{
+    unsigned int change = 0;
+
+    if (w != mSrcWidth[hdmiLayer] || h != mSrcHeight[hdmiLayer])
+        change |= HDMI_CHANGE_SRC_SIZE;
+
+    if (colorFormat != mSrcColorFormat[hdmiLayer])
+        change |= HDMI_CHANGE_FORMAT;
+
+#if defined(BOARD_USE_V4L2)
+    if (mDstWidth[hdmiLayer] != mPrevDstWidth[hdmiLayer] ||
+        mDstHeight[hdmiLayer] != mPrevDstHeight[hdmiLayer])
+        change |= HDMI_CHANGE_DST_RECT;
+
+    if (mHdmiFd[hdmiLayer] < 0)
+        change |= HDMI_CHANGE_OPEN;
+#endif
+
+    /* only FIMC output has the rotation baked in, G2D rotates every frame */
+    if (hdmiLayer == HDMI_LAYER_VIDEO && isVideoLayerFormat(colorFormat) == false &&
+        mUIRotVal != mLayerRotVal[hdmiLayer])
+        change |= HDMI_CHANGE_ROTATION;
+
+    if (mHdmiDstWidth != mHdmiResolutionWidth[hdmiLayer] ||
+        mHdmiDstHeight != mHdmiResolutionHeight[hdmiLayer])
+        change |= HDMI_CHANGE_RESOLUTION;
+
+    if (mHdmiInfoChange == true)
+        change |= HDMI_CHANGE_OUTPUT;
+
+    return change;
+}
+
+bool SecHdmi::m_reset(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer,
+        unsigned int change)
 {
 #ifdef DEBUG_MSG_ENABLE
     ALOGD("%s", __func__);
@@ -1283,11 +1411,9 @@ bool SecHdmi::m_reset(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer
     ALOGD("### %s called", __func__);
 #endif
     v4l2_std_id std_id = 0;
+    bool setParams = (change & (HDMI_CHANGE_LAYER_MASK | HDMI_CHANGE_RESOLUTION)) != 0;
     mFimcCurrentOutBufIndex = 0;
 
-    int srcW = w;
-    int srcH = h;
-
 #if defined(BOARD_USE_V4L2)
     if (mFlagHdmiStart[hdmiLayer] == true && m_stopHdmi(hdmiLayer) == false) {
         ALOGE("%s::m_stopHdmi: layer[%d] fail", __func__, hdmiLayer);
@@ -1313,145 +1439,14 @@ bool SecHdmi::m_reset(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer
 
     if (tvout_std_v4l2_init(mHdmiFd[hdmiLayer], mHdmiPresetId) < 0)
         ALOGE("%s::tvout_std_v4l2_init fail", __func__);
-#endif
-
-    if (w != mSrcWidth [hdmiLayer] ||
-        h != mSrcHeight [hdmiLayer] ||
-        mHdmiDstWidth != mHdmiResolutionWidth[hdmiLayer] ||
-        mHdmiDstHeight != mHdmiResolutionHeight[hdmiLayer] ||
-#if defined(BOARD_USE_V4L2)
-        mDstWidth[hdmiLayer] != mPrevDstWidth[hdmiLayer] ||
-        mDstHeight[hdmiLayer] != mPrevDstHeight[hdmiLayer] ||
-#endif
-        colorFormat != mSrcColorFormat[hdmiLayer]) {
-        int preVideoSrcColorFormat = mSrcColorFormat[hdmiLayer];
-        int videoSrcColorFormat = colorFormat;
-
-        if (preVideoSrcColorFormat != HAL_PIXEL_FORMAT_YCbCr_420_SP &&
-            preVideoSrcColorFormat != HAL_PIXEL_FORMAT_YCrCb_420_SP &&
-            preVideoSrcColorFormat != HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP &&
-            preVideoSrcColorFormat != HAL_PIXEL_FORMAT_CUSTOM_YCrCb_420_SP &&
-            preVideoSrcColorFormat != HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP_TILED) {
-                ALOGI("%s: Unsupported preVideoSrcColorFormat = 0x%x\n", __func__, preVideoSrcColorFormat);
-                preVideoSrcColorFormat = HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP_TILED;
-        }
-
-        if (hdmiLayer == HDMI_LAYER_VIDEO) {
-            if (colorFormat != HAL_PIXEL_FORMAT_YCbCr_420_SP &&
-                colorFormat != HAL_PIXEL_FORMAT_YCrCb_420_SP &&
-                colorFormat != HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP &&
-                colorFormat != HAL_PIXEL_FORMAT_CUSTOM_YCrCb_420_SP &&
-                colorFormat != HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP_TILED) {
-#ifdef DEBUG_HDMI_HW_LEVEL
-                ALOGD("### %s  call mSecFimc.setSrcParams\n", __func__);
-#endif
-                unsigned int full_wdith = ALIGN(w, 16);
-                unsigned int full_height = ALIGN(h, 2);
-
-                if (mSecFimc.setSrcParams(full_wdith, full_height, 0, 0,
-                            (unsigned int*)&w, (unsigned int*)&h, colorFormat, true) == false) {
-                    ALOGE("%s::mSecFimc.setSrcParams(%d, %d, %d) fail \n",
-                            __func__, w, h, colorFormat);
-                    return false;
-                }
-
-                mFimcDstColorFormat = HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP_TILED;
 
-#ifdef DEBUG_HDMI_HW_LEVEL
-                ALOGD("### %s  call mSecFimc.setDstParams\n", __func__);
-#endif
-                if (mUIRotVal == 0 || mUIRotVal == 180) {
-                    if (mSecFimc.setDstParams((unsigned int)w, (unsigned int)h, 0, 0,
-                                (unsigned int*)&w, (unsigned int*)&h, mFimcDstColorFormat, true) == false) {
-                        ALOGE("%s::mSecFimc.setDstParams(%d, %d, %d) fail \n",
-                                __func__, w, h, mFimcDstColorFormat);
-                        return false;
-                    }
-#if defined(BOARD_USE_V4L2)
-                    hdmi_set_v_param(mHdmiFd[hdmiLayer], hdmiLayer,
-                                    mFimcDstColorFormat, srcW, srcH,
-                                    &mMixerBuffer[hdmiLayer][0],
-                                    0, 0, mHdmiDstWidth, mHdmiDstHeight);
-#endif
-                } else {
-                    if (mSecFimc.setDstParams((unsigned int)h, (unsigned int)w, 0, 0,
-                                (unsigned int*)&h, (unsigned int*)&w, mFimcDstColorFormat, true) == false) {
-                        ALOGE("%s::mSecFimc.setDstParams(%d, %d, %d) fail \n",
-                                __func__, w, h, mFimcDstColorFormat);
-                        return false;
-                    }
-#if defined(BOARD_USE_V4L2)
-                    hdmi_set_v_param(mHdmiFd[hdmiLayer], hdmiLayer,
-                                    mFimcDstColorFormat, srcH, srcW,
-                                    &mMixerBuffer[hdmiLayer][0],
-                                    0, 0, mHdmiDstWidth, mHdmiDstHeight);
+    /* the node was just reopened, without a format or buffers */
+    setParams = true;
 #endif
-                }
-            }
-#if defined(BOARD_USE_V4L2)
-            else {
-                hdmi_set_v_param(mHdmiFd[hdmiLayer], hdmiLayer,
-                                colorFormat, srcW, srcH,
-                                &mMixerBuffer[hdmiLayer][0],
-                                0, 0, mHdmiDstWidth, mHdmiDstHeight);
-            }
-#endif
-            mPrevDstWidth[hdmiLayer] = mHdmiDstWidth;
-            mPrevDstHeight[hdmiLayer] = mHdmiDstHeight;
-        } else {
-#if defined(BOARD_USE_V4L2)
-            struct v4l2_rect rect;
-            int tempSrcW, tempSrcH;
 
-            if (mG2DUIRotVal == 0 || mG2DUIRotVal == 180) {
-                tempSrcW = srcW;
-                tempSrcH = srcH;
-            } else {
-                tempSrcW = srcH;
-                tempSrcH = srcW;
-            }
-
-            hdmi_cal_rect(tempSrcW, tempSrcH, mHdmiDstWidth, mHdmiDstHeight, &rect);
-            rect.left = ALIGN(rect.left, 16);
-
-            if (hwcLayer == 0) { /* UI only mode */
-                hdmi_set_g_param(mHdmiFd[hdmiLayer], hdmiLayer,
-                                colorFormat, srcW, srcH,
-                                &mMixerBuffer[hdmiLayer][0],
-                                rect.left, rect.top, rect.width, rect.height);
-                mPrevDstWidth[hdmiLayer] = rect.width;
-                mPrevDstHeight[hdmiLayer] = rect.height;
-                mPrevDstWidth[HDMI_LAYER_VIDEO] = 0;
-                mPrevDstHeight[HDMI_LAYER_VIDEO] = 0;
-            } else { /* Video Playback + UI Mode */
-                hdmi_set_g_param(mHdmiFd[hdmiLayer], hdmiLayer,
-                                colorFormat, srcW, srcH,
-                                &mMixerBuffer[hdmiLayer][0],
-                                0, 0, mHdmiDstWidth, mHdmiDstHeight);
-                mPrevDstWidth[hdmiLayer] = mHdmiDstWidth;
-                mPrevDstHeight[hdmiLayer] = mHdmiDstHeight;
-            }
-#endif
-        }
-
-        if (preVideoSrcColorFormat != videoSrcColorFormat)
-            mHdmiInfoChange = true;
-
-        mSrcWidth[hdmiLayer] = srcW;
-        mSrcHeight[hdmiLayer] = srcH;
-        mSrcColorFormat[hdmiLayer] = colorFormat;
-
-        mHdmiResolutionWidth[hdmiLayer] = mHdmiDstWidth;
-        mHdmiResolutionHeight[hdmiLayer] = mHdmiDstHeight;
-
-#ifdef DEBUG_MSG_ENABLE
-        ALOGD("m_reset saved param(%d, %d, %d, %d, %d, %d, %d) \n",
-            srcW, mSrcWidth[hdmiLayer], \
-            srcH, mSrcHeight[hdmiLayer], \
-            colorFormat,mSrcColorFormat[hdmiLayer], \
-            hdmiLayer);
-#endif
-    }
+    if (setParams == true &&
+        m_setLayerParams(w, h, colorFormat, hdmiLayer, hwcLayer) == false)
+        return false;
 
     if (mHdmiInfoChange == true) {
 #ifdef DEBUG_HDMI_HW_LEVEL
@@ -1522,15 +1517,271 @@ bool SecHdmi::m_reset(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer
         }
 
         mHdmiInfoChange = false;
+    }
+
+    return true;
+}
+
+int SecHdmi::m_reconfigLevel(unsigned int change, int hdmiLayer)
+{
+    if (change & ~HDMI_CHANGE_LAYER_MASK)
+        return HDMI_RECONFIG_RESET;
+
+    /* a new mixer input format needs S_FMT and REQBUFS on a stopped layer */
+    if (change & (HDMI_CHANGE_SRC_SIZE | HDMI_CHANGE_FORMAT))
+        return HDMI_RECONFIG_LAYER;
+
+    /* a quarter turn swaps the size of the FIMC output the mixer reads */
+    if ((change & HDMI_CHANGE_ROTATION) &&
+        (mUIRotVal % 180) != (mLayerRotVal[hdmiLayer] % 180))
+        return HDMI_RECONFIG_LAYER;
+
+#if defined(BOARD_USES_FIMGAPI)
+    /* G2D scales into a dst sized buffer, so the graphic layer format follows dst */
+    if (hdmiLayer != HDMI_LAYER_VIDEO && (change & HDMI_CHANGE_DST_RECT))
+        return HDMI_RECONFIG_LAYER;
+#endif
+
+    return HDMI_RECONFIG_APPLY;
+}
+
+bool SecHdmi::m_applyLayer(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer,
+        unsigned int change)
+{
+#ifdef DEBUG_HDMI_HW_LEVEL
+    ALOGD("### %s called", __func__);
+#endif
+
+    /* only the FIMC conversion has the rotation in it, the mixer keeps running */
+    if ((change & HDMI_CHANGE_ROTATION) &&
+        m_setFimcParams(w, h, colorFormat) == false)
+        return false;
+
+#if defined(BOARD_USE_V4L2)
+    if ((change & HDMI_CHANGE_DST_RECT) &&
+        m_setLayerCrop(w, h, colorFormat, hdmiLayer, hwcLayer) == false)
+        return false;
+#endif
+
+    mLayerRotVal[hdmiLayer] = mUIRotVal;
+
+    return true;
+}
+
+bool SecHdmi::m_resetLayer(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer)
+{
+#ifdef DEBUG_HDMI_HW_LEVEL
+    ALOGD("### %s called", __func__);
+#endif
+    mFimcCurrentOutBufIndex = 0;
+
+#if defined(BOARD_USE_V4L2)
+    if (mFlagHdmiStart[hdmiLayer] == true && m_stopHdmi(hdmiLayer) == false) {
+        ALOGE("%s::m_stopHdmi: layer[%d] fail", __func__, hdmiLayer);
+        return false;
+    }
+#else
+    // stop all.. the legacy tvout overlay is reconfigured with every layer off, as in m_reset()
+    for (int layer = HDMI_LAYER_BASE + 1; layer < HDMI_LAYER_MAX; layer++) {
+        if (mFlagHdmiStart[layer] == true && m_stopHdmi(layer) == false) {
+            ALOGE("%s::m_stopHdmi: layer[%d] fail", __func__, layer);
+            return false;
+        }
+    }
+#endif
+
+    return m_setLayerParams(w, h, colorFormat, hdmiLayer, hwcLayer);
+}
+
+bool SecHdmi::m_setFimcParams(int w, int h, int colorFormat)
+{
+#ifdef DEBUG_HDMI_HW_LEVEL
+    ALOGD("### %s  call mSecFimc.setSrcParams\n", __func__);
+#endif
+    unsigned int full_wdith = ALIGN(w, 16);
+    unsigned int full_height = ALIGN(h, 2);
+
+    if (mSecFimc.setSrcParams(full_wdith, full_height, 0, 0,
+                (unsigned int*)&w, (unsigned int*)&h, colorFormat, true) == false) {
+        ALOGE("%s::mSecFimc.setSrcParams(%d, %d, %d) fail \n",
+                __func__, w, h, colorFormat);
+        return false;
+    }
+
+    mFimcDstColorFormat = HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP_TILED;
+
+#ifdef DEBUG_HDMI_HW_LEVEL
+    ALOGD("### %s  call mSecFimc.setDstParams\n", __func__);
+#endif
+    if (mUIRotVal == 0 || mUIRotVal == 180) {
+        if (mSecFimc.setDstParams((unsigned int)w, (unsigned int)h, 0, 0,
+                    (unsigned int*)&w, (unsigned int*)&h, mFimcDstColorFormat, true) == false) {
+            ALOGE("%s::mSecFimc.setDstParams(%d, %d, %d) fail \n",
+                    __func__, w, h, mFimcDstColorFormat);
+            return false;
+        }
+    } else {
+        if (mSecFimc.setDstParams((unsigned int)h, (unsigned int)w, 0, 0,
+                    (unsigned int*)&h, (unsigned int*)&w, mFimcDstColorFormat, true) == false) {
+            ALOGE("%s::mSecFimc.setDstParams(%d, %d, %d) fail \n",
+                    __func__, w, h, mFimcDstColorFormat);
+            return false;
+        }
+    }
+
 #ifdef BOARD_USE_V4L2
-        for (int i = 0; i < HDMI_FIMC_OUTPUT_BUF_NUM; i++)
-            mFimcReservedMem[i] = *(mSecFimc.getMemAddr(i));
+    /* setDstParams reallocates the FIMC output buffers */
+    for (int i = 0; i < HDMI_FIMC_OUTPUT_BUF_NUM; i++)
+        mFimcReservedMem[i] = *(mSecFimc.getMemAddr(i));
+#endif
+
+    return true;
+}
+
+bool SecHdmi::m_setLayerParams(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer)
+{
+    if (hdmiLayer == HDMI_LAYER_VIDEO) {
+        if (isVideoLayerFormat(colorFormat) == false) {
+            if (m_setFimcParams(w, h, colorFormat) == false)
+                return false;
+
+#if defined(BOARD_USE_V4L2)
+            if (mUIRotVal == 0 || mUIRotVal == 180)
+                hdmi_set_v_param(mHdmiFd[hdmiLayer], hdmiLayer,
+                                mFimcDstColorFormat, w, h,
+                                &mMixerBuffer[hdmiLayer][0],
+                                0, 0, mHdmiDstWidth, mHdmiDstHeight);
+            else
+                hdmi_set_v_param(mHdmiFd[hdmiLayer], hdmiLayer,
+                                mFimcDstColorFormat, h, w,
+                                &mMixerBuffer[hdmiLayer][0],
+                                0, 0, mHdmiDstWidth, mHdmiDstHeight);
+#endif
+        }
+#if defined(BOARD_USE_V4L2)
+        else {
+            hdmi_set_v_param(mHdmiFd[hdmiLayer], hdmiLayer,
+                            colorFormat, w, h,
+                            &mMixerBuffer[hdmiLayer][0],
+                            0, 0, mHdmiDstWidth, mHdmiDstHeight);
+        }
+#endif
+        mPrevDstWidth[hdmiLayer] = mHdmiDstWidth;
+        mPrevDstHeight[hdmiLayer] = mHdmiDstHeight;
+    } else {
+#if defined(BOARD_USE_V4L2)
+        struct v4l2_rect rect;
+
+        m_graphicDstRect(w, h, hwcLayer, &rect);
+        hdmi_set_g_param(mHdmiFd[hdmiLayer], hdmiLayer,
+                        colorFormat, w, h,
+                        &mMixerBuffer[hdmiLayer][0],
+                        rect.left, rect.top, rect.width, rect.height);
+        mPrevDstWidth[hdmiLayer] = rect.width;
+        mPrevDstHeight[hdmiLayer] = rect.height;
+        if (hwcLayer == 0) { /* UI only mode */
+            mPrevDstWidth[HDMI_LAYER_VIDEO] = 0;
+            mPrevDstHeight[HDMI_LAYER_VIDEO] = 0;
+        }
 #endif
     }
 
+    mLayerRotVal[hdmiLayer] = mUIRotVal;
+    mSrcWidth[hdmiLayer] = w;
+    mSrcHeight[hdmiLayer] = h;
+    mSrcColorFormat[hdmiLayer] = colorFormat;
+
+    mHdmiResolutionWidth[hdmiLayer] = mHdmiDstWidth;
+    mHdmiResolutionHeight[hdmiLayer] = mHdmiDstHeight;
+
+#ifdef DEBUG_MSG_ENABLE
+    ALOGD("m_setLayerParams saved param(%d, %d, %d, %d, %d, %d, %d) \n",
+        w, mSrcWidth[hdmiLayer], \
+        h, mSrcHeight[hdmiLayer], \
+        colorFormat,mSrcColorFormat[hdmiLayer], \
+        hdmiLayer);
+#endif
+
     return true;
 }
 
+#if defined(BOARD_USE_V4L2)
+void SecHdmi::m_graphicDstRect(int w, int h, int hwcLayer, struct v4l2_rect *rect)
+{
+    if (hwcLayer == 0) { /* UI only mode */
+        if (mG2DUIRotVal == 0 || mG2DUIRotVal == 180)
+            hdmi_cal_rect(w, h, mHdmiDstWidth, mHdmiDstHeight, rect);
+        else
+            hdmi_cal_rect(h, w, mHdmiDstWidth, mHdmiDstHeight, rect);
+        rect->left = ALIGN(rect->left, 16);
+    } else { /* Video Playback + UI Mode */
+        rect->left = 0;
+        rect->top = 0;
+        rect->width = mHdmiDstWidth;
+        rect->height = mHdmiDstHeight;
+    }
+}
+
+bool SecHdmi::m_setLayerCrop(int w, int h, int colorFormat, int hdmiLayer, int hwcLayer)
+{
+    if (hdmiLayer == HDMI_LAYER_VIDEO) {
+        /* the mixer reads the FIMC output, which already has the rotation */
+        if (isVideoLayerFormat(colorFormat) == false &&
+            (mUIRotVal == 90 || mUIRotVal == 270)) {
+            int tmp = w;
+            w = h;
+            h = tmp;
+        }
+
+        if (hdmi_set_v_crop(mHdmiFd[hdmiLayer], hdmiLayer, w, h,
+                            mHdmiDstWidth, mHdmiDstHeight) < 0)
+            return false;
+
+        mPrevDstWidth[hdmiLayer] = mHdmiDstWidth;
+        mPrevDstHeight[hdmiLayer] = mHdmiDstHeight;
+    } else {
+        struct v4l2_rect rect;
+
+        m_graphicDstRect(w, h, hwcLayer, &rect);
+        if (hdmi_set_g_crop(mHdmiFd[hdmiLayer], hdmiLayer, w, h,
+                            rect.left, rect.top, rect.width, rect.height) < 0)
+            return false;
+
+        mPrevDstWidth[hdmiLayer] = rect.width;
+        mPrevDstHeight[hdmiLayer] = rect.height;
+        if (hwcLayer == 0) { /* UI only mode */
+            mPrevDstWidth[HDMI_LAYER_VIDEO] = 0;
+            mPrevDstHeight[HDMI_LAYER_VIDEO] = 0;
+        }
+    }
+
+    return true;
+}
+#endif
+
+void SecHdmi::m_addReconfigStat(unsigned int change, int level, bool ok, nsecs_t time)
+{
+    struct reconfig_stats *stats = &mReconfigStats;
+    nsecs_t ms = ns2ms(time);
+    int bucket = 0;
+
+    for (int i = 0; i < HDMI_CHANGE_CAUSES; i++) {
+        if (change & (1 << i))
+            stats->causes[i]++;
+    }
+
+    while (bucket < HDMI_RECONFIG_BUCKETS - 1 && ms >= (1LL << bucket))
+        bucket++;
+
+    stats->count[level]++;
+    if (ok == false)
+        stats->failed[level]++;
+    stats->hist[level][bucket]++;
+    stats->sum[level] += time;
+    if (time > stats->max[level])
+        stats->max[level] = time;
+}
+
 #if defined(BOARD_USE_V4L2)
 bool SecHdmi::m_startHdmi(int hdmiLayer, unsigned int num_of_plane)
 {
@@ -1286,6 +1286,76 @@ int hdmi_get_src_plane(int srcColorFormat, unsigned int *num_of_plane)
 #endif
 
 #if defined(BOARD_USE_V4L2)
+/* the mixer graphic layer takes the G2D output, which is scaled to dst */
+static void hdmi_cal_g_rect(int src_w, int src_h,
+                      int dst_x, int dst_y, int dst_w, int dst_h,
+                      struct v4l2_rect *rect)
+{
+    rect->left   = dst_x;
+    rect->top    = dst_y;
+
+#if defined(BOARD_USES_FIMGAPI)
+    rect->width  = dst_w;
+    rect->height = dst_h;
+#else
+    rect->width  = src_w;
+    rect->height = src_h;
+#endif
+}
+
+/*
+ * The crop helpers only move the layer window, so unlike the
+ * hdmi_set_*_param() calls they also work on a streaming layer.
+ */
+int hdmi_set_v_crop(int fd, int layer,
+                      int src_w, int src_h,
+                      int dst_w, int dst_h)
+{
+#ifdef DEBUG_HDMI_HW_LEVEL
+    ALOGD("%s", __func__);
+#endif
+
+    struct v4l2_rect rect;
+
+    hdmi_cal_rect(src_w, src_h, dst_w, dst_h, &rect);
+    rect.left = ALIGN(rect.left, 16);
+
+    /* set crop for VP input */
+    if (tvout_std_v4l2_s_crop(fd, V4L2_BUF_TYPE_VIDEO_OVERLAY, V4L2_FIELD_ANY, 0, 0, src_w, src_h) < 0) {
+        ALOGE("%s::tvout_std_v4l2_s_crop()[video layer] failed", __func__);
+        return -1;
+    }
+
+    /* set crop for VP output */
+    if (tvout_std_v4l2_s_crop(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, V4L2_FIELD_ANY, rect.left, rect.top, rect.width, rect.height) < 0) {
+        ALOGE("%s::tvout_std_v4l2_s_crop()[video layer] failed", __func__);
+        return -1;
+    }
+
+    return 0;
+}
+
+int hdmi_set_g_crop(int fd, int layer,
+                      int src_w, int src_h,
+                      int dst_x, int dst_y, int dst_w, int dst_h)
+{
+#ifdef DEBUG_HDMI_HW_LEVEL
+    ALOGD("%s", __func__);
+#endif
+
+    struct v4l2_rect rect;
+
+    hdmi_cal_g_rect(src_w, src_h, dst_x, dst_y, dst_w, dst_h, &rect);
+
+    /* set crop for mixer graphic layer input device*/
+    if (tvout_std_v4l2_s_crop(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, V4L2_FIELD_ANY, rect.left, rect.top, rect.width, rect.height) < 0) {
+        ALOGE("%s::tvout_std_v4l2_s_crop() [layer=%d] failed", __func__, layer);
+        return -1;
+    }
+
+    return 0;
+}
+
 int hdmi_set_v_param(int fd, int layer,
                       int srcColorFormat,
                       int src_w, int src_h,
@@ -1300,7 +1370,6 @@ int hdmi_set_v_param(int fd, int layer,
     int round_up_src_w;
     int round_up_src_h;
     unsigned int num_of_plane;
-    struct v4l2_rect rect;
 
     /* src_w, src_h round up to DWORD because of VP restriction */
 #if defined(SAMSUNG_EXYNOS4x12)
@@ -1329,26 +1398,14 @@ int hdmi_set_v_param(int fd, int layer,
         break;
     }
 
-    hdmi_cal_rect(src_w, src_h, dst_w, dst_h, &rect);
-    rect.left = ALIGN(rect.left, 16);
-
     /* set format for VP input */
     if (tvout_std_v4l2_s_fmt(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, V4L2_FIELD_ANY, round_up_src_w, round_up_src_h, v4l2ColorFormat, num_of_plane) < 0) {
         ALOGE("%s::tvout_std_v4l2_s_fmt()[video layer] failed", __func__);
         return -1;
     }
 
-    /* set crop for VP input */
-    if (tvout_std_v4l2_s_crop(fd, V4L2_BUF_TYPE_VIDEO_OVERLAY, V4L2_FIELD_ANY, 0, 0, src_w, src_h) < 0) {
-        ALOGE("%s::tvout_std_v4l2_s_crop()[video layer] failed", __func__);
+    if (hdmi_set_v_crop(fd, layer, src_w, src_h, dst_w, dst_h) < 0)
         return -1;
-    }
-
-    /* set crop for VP output */
-    if (tvout_std_v4l2_s_crop(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, V4L2_FIELD_ANY, rect.left, rect.top, rect.width, rect.height) < 0) {
-        ALOGE("%s::tvout_std_v4l2_s_crop()[video layer] failed", __func__);
-        return -1;
-    }
 
     /* request buffer for VP input */
     if (tvout_std_v4l2_reqbuf(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, V4L2_MEMORY_USERPTR, HDMI_NUM_MIXER_BUF) < 0) {
@@ -1372,16 +1429,7 @@ int hdmi_set_g_param(int fd, int layer,
     struct v4l2_rect rect;
     int v4l2ColorFormat = HAL_PIXEL_FORMAT_2_V4L2_PIX(srcColorFormat);
 
-    rect.left   = dst_x;
-    rect.top    = dst_y;
-
-#if defined(BOARD_USES_FIMGAPI)
-    rect.width  = dst_w;
-    rect.height = dst_h;
-#else
-    rect.width  = src_w;
-    rect.height = src_h;
-#endif
+    hdmi_cal_g_rect(src_w, src_h, dst_x, dst_y, dst_w, dst_h, &rect);
 
     switch (v4l2ColorFormat) {
     case V4L2_PIX_FMT_BGR32:
@@ -1403,11 +1451,8 @@ int hdmi_set_g_param(int fd, int layer,
         return -1;
     }
 
-    /* set crop for mixer graphic layer input device*/
-    if (tvout_std_v4l2_s_crop(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, V4L2_FIELD_ANY, rect.left, rect.top, rect.width, rect.height) < 0) {
-        ALOGE("%s::tvout_std_v4l2_s_crop() [layer=%d] failed", __func__, layer);
+    if (hdmi_set_g_crop(fd, layer, src_w, src_h, dst_x, dst_y, dst_w, dst_h) < 0)
         return -1;
-    }
 
     /* request buffer for mixer graphic layer input device */
     if (tvout_std_v4l2_reqbuf(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, V4L2_MEMORY_USERPTR, HDMI_NUM_MIXER_BUF) < 0) {
@@ -85,6 +85,12 @@ int hdmi_set_g_param(int fd, int layer,
                       int src_w, int src_h,
                       SecBuffer * dstBuffer,
                       int dst_x, int dst_y, int dst_w, int dst_h);
+int hdmi_set_v_crop(int fd, int layer,
+                      int src_w, int src_h,
+                      int dst_w, int dst_h);
+int hdmi_set_g_crop(int fd, int layer,
+                      int src_w, int src_h,
+                      int dst_x, int dst_y, int dst_w, int dst_h);
 int hdmi_set_g_scaling(int layer,
         int srcColorFormat,
         int src_w, int src_h,
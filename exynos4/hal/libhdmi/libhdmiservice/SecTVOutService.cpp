@@ -24,6 +24,7 @@
 
 #define LOG_TAG "SecTVOutService"
 
+#include <binder/IPCThreadState.h>
 #include <binder/IServiceManager.h>
 #include <utils/RefBase.h>
 #include <binder/IInterface.h>
@@ -185,6 +186,25 @@ namespace android {
         return NO_ERROR;
     }
 
+    status_t SecTVOutService::dump(int fd, const Vector<String16>& args)
+    {
+        if (!checkCallingPermission(String16("android.permission.DUMP"))) {
+            String8 result;
+            result.appendFormat("Permission Denial: can't dump SecTVOutService from pid=%d, uid=%d\n",
+                    IPCThreadState::self()->getCallingPid(),
+                    IPCThreadState::self()->getCallingUid());
+            ::write(fd, result.string(), result.size());
+            return NO_ERROR;
+        }
+
+        String8 result;
+        result.appendFormat("SecTVOutService cable(%d) ui layer(%d) hwc layers(%u)\n",
+                mHdmiCableInserted, mUILayerMode, mHwcLayer);
+        ::write(fd, result.string(), result.size());
+
+        return mSecHdmi.dump(fd);
+    }
+
     void SecTVOutService::setHdmiStatus(uint32_t status)
     {
 
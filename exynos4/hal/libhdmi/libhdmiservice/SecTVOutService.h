@@ -75,6 +75,7 @@ namespace android {
             SecTVOutService();
             static int instantiate ();
             virtual status_t onTransact(uint32_t, const Parcel &, Parcel *, uint32_t);
+            virtual status_t dump(int fd, const Vector<String16>& args);
             virtual ~SecTVOutService ();
 
             virtual void                        setHdmiStatus(uint32_t status);
@@ -37,6 +37,7 @@ endif
 
 LOCAL_SRC_FILES := hwcomposer.cpp \
                    hwcomposer_vsync.cpp \
+                   bandwidth.cpp \
                    window.cpp \
                    utils.cpp \
                    v4l2.cpp
@@ -49,3 +50,18 @@ LOCAL_CFLAGS += -DLOG_TAG=\"hwcomposer\"
 LOCAL_CFLAGS += -Wno-error
 LOCAL_MODULE_TAGS := optional
 include $(BUILD_SHARED_LIBRARY)
+
+# window assignment solver alone, for replaying recorded layer stacks on the host
+include $(CLEAR_VARS)
+LOCAL_SRC_FILES := bandwidth.cpp
+LOCAL_MODULE := libhwcbandwidth
+LOCAL_MODULE_TAGS := optional
+include $(BUILD_HOST_STATIC_LIBRARY)
+
+# replays recorded stacks (and bandwidth_stacks.txt) through the solver
+include $(CLEAR_VARS)
+LOCAL_SRC_FILES := bandwidth_replay.cpp
+LOCAL_STATIC_LIBRARIES := libhwcbandwidth
+LOCAL_MODULE := hwc_bw_replay
+LOCAL_MODULE_TAGS := optional
+include $(BUILD_HOST_EXECUTABLE)
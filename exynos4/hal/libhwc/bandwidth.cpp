@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2017 The NamelessRom Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bandwidth.h"
+
+/*
+ * Cost model, in bytes moved through DRAM per frame:
+ *  - a FIMD window reads its source once during scanout, blending in FIMD
+ *    is free;
+ *  - FIMC and FIMG read the source, write a window buffer at fb_bpp, which
+ *    FIMD then reads again;
+ *  - GLES reads each framebuffer layer and writes its display frame into
+ *    the framebuffer target, reading the destination first if it blends;
+ *  - the framebuffer target itself is scanned out once, full screen.
+ * Scaling is covered by costing the source crop and the display frame
+ * separately.
+ *
+ * Bytes alone undercount GLES: once the framebuffer is needed anyway, a
+ * video layer looks cheaper composed by the GPU (src + dst) than converted
+ * by FIMC (src + 2 * dst), but the GPU then samples and colour converts
+ * every video frame and recomposes the framebuffer at the video rate. So
+ * the number of FIMC/FIMG capable HWC_BW_YUV layers left to GLES is
+ * minimised first, and bytes only decide between equal counts.
+ */
+
+static uint64_t src_bytes(const struct hwc_bw_layer_t &layer)
+{
+    return (uint64_t) layer.src_w * layer.src_h * layer.bpp / 8;
+}
+
+static uint64_t dst_pixels(const struct hwc_bw_layer_t &layer)
+{
+    return (uint64_t) layer.dst_w * layer.dst_h;
+}
+
+static uint64_t path_bytes(const struct hwc_bw_config_t &cfg,
+        const struct hwc_bw_layer_t &layer, enum hwc_bw_path path)
+{
+    uint64_t dst_bytes = dst_pixels(layer) * cfg.fb_bpp / 8;
+
+    switch (path) {
+    case HWC_BW_DIRECT:
+        return src_bytes(layer);
+    case HWC_BW_FIMC:
+    case HWC_BW_FIMG:
+        return src_bytes(layer) + 2 * dst_bytes;
+    case HWC_BW_FB:
+        return src_bytes(layer) + dst_bytes +
+                ((layer.flags & HWC_BW_BLENDED) ? dst_bytes : 0);
+    default:
+        return 0;
+    }
+}
+
+struct hwc_bw_search {
+    const struct hwc_bw_config_t *cfg;
+    const struct hwc_bw_layer_t *layers;
+    size_t num_layers;
+
+    enum hwc_bw_path cur[HWC_BW_MAX_LAYERS];
+    size_t pending[HWC_BW_MAX_LAYERS];   // overlays that need FIMC or FIMG
+
+    enum hwc_bw_path *best;
+    struct hwc_bw_result_t *result;
+    uint64_t best_bytes;
+    size_t best_fb_layers;
+    size_t best_fb_yuv;
+    bool found;
+};
+
+/*
+ * Tries to place FIMC on pending[fimc] (or on nothing if fimc == num_pending)
+ * and FIMG on the rest of the pending overlays.
+ */
+static bool place_converters(struct hwc_bw_search &s, size_t num_pending, size_t fimc,
+        uint64_t *bytes)
+{
+    const struct hwc_bw_config_t &cfg = *s.cfg;
+    size_t fimc_layer = s.num_layers;
+    size_t fimg_count = 0;
+
+    if (fimc < num_pending) {
+        fimc_layer = s.pending[fimc];
+        if (!(s.layers[fimc_layer].caps & HWC_BW_CAP_FIMC))
+            return false;
+    }
+
+    for (size_t j = 0; j < num_pending; j++) {
+        size_t i = s.pending[j];
+
+        if (i == fimc_layer) {
+            s.cur[i] = HWC_BW_FIMC;
+        } else if (s.layers[i].caps & HWC_BW_CAP_FIMG) {
+            s.cur[i] = HWC_BW_FIMG;
+            fimg_count++;
+        } else {
+            return false;
+        }
+        *bytes += path_bytes(cfg, s.layers[i], s.cur[i]);
+    }
+
+    if (fimg_count > 1 && !cfg.multi_fimg)
+        return false;
+
+    // FIMC output can't take more than one FIMG layer on top of it
+    if (fimc_layer < s.num_layers) {
+        size_t fimg_over = 0;
+        for (size_t j = 0; j < num_pending; j++) {
+            if (s.pending[j] > fimc_layer && s.cur[s.pending[j]] == HWC_BW_FIMG)
+                fimg_over++;
+        }
+        if (fimg_over > 1)
+            return false;
+    }
+
+    return true;
+}
+
+// costs every way of filling the windows around framebuffer range [first, last]
+static void try_range(struct hwc_bw_search &s, bool fb_needed, size_t first, size_t last)
+{
+    const struct hwc_bw_config_t &cfg = *s.cfg;
+    uint64_t fb_pixels = (uint64_t) cfg.xres * cfg.yres;
+    uint64_t base_bytes = 0;
+    uint64_t pixels = 0;
+    size_t windows = 0;
+    size_t fb_layers = 0;
+    size_t fb_yuv = 0;
+    size_t num_pending = 0;
+
+    if (fb_needed) {
+        windows = 1;
+        pixels = fb_pixels;
+        base_bytes = fb_pixels * cfg.fb_bpp / 8;
+    }
+
+    for (size_t i = 0; i < s.num_layers; i++) {
+        const struct hwc_bw_layer_t &layer = s.layers[i];
+
+        if (layer.flags & HWC_BW_TARGET) {
+            s.cur[i] = HWC_BW_NONE;
+            continue;
+        }
+
+        if (fb_needed && i >= first && i <= last) {
+            if (layer.flags & HWC_BW_BACKGROUND)
+                return;
+            s.cur[i] = HWC_BW_FB;
+            base_bytes += path_bytes(cfg, layer, HWC_BW_FB);
+            fb_layers++;
+            if ((layer.flags & HWC_BW_YUV) && layer.caps)
+                fb_yuv++;
+            continue;
+        }
+
+        if (++windows > cfg.num_windows)
+            return;
+
+        if (layer.flags & HWC_BW_BACKGROUND) {
+            s.cur[i] = HWC_BW_WINDOW;
+            continue;
+        }
+
+        pixels += dst_pixels(layer);
+
+        if (layer.caps & HWC_BW_CAP_DIRECT) {
+            s.cur[i] = HWC_BW_DIRECT;
+            base_bytes += path_bytes(cfg, layer, HWC_BW_DIRECT);
+        } else if (layer.caps) {
+            s.pending[num_pending++] = i;
+        } else {
+            return;
+        }
+    }
+
+    if (pixels > cfg.max_pixels)
+        return;
+
+    // FIMC on each candidate first, then on nothing: at equal cost FIMC wins
+    for (size_t fimc = 0; fimc <= num_pending; fimc++) {
+        uint64_t bytes = base_bytes;
+
+        if (!place_converters(s, num_pending, fimc, &bytes))
+            continue;
+
+        s.result->evaluated++;
+
+        if (s.found && (fb_yuv > s.best_fb_yuv ||
+                (fb_yuv == s.best_fb_yuv && (bytes > s.best_bytes ||
+                (bytes == s.best_bytes && fb_layers >= s.best_fb_layers)))))
+            continue;
+
+        s.found = true;
+        s.best_bytes = bytes;
+        s.best_fb_layers = fb_layers;
+        s.best_fb_yuv = fb_yuv;
+        memcpy(s.best, s.cur, s.num_layers * sizeof(s.cur[0]));
+        s.result->fb_needed = fb_needed;
+        s.result->first_fb = fb_needed ? first : 0;
+        s.result->last_fb = fb_needed ? last : 0;
+        s.result->bytes = bytes;
+        s.result->pixels = pixels;
+    }
+}
+
+int hwc_bw_solve(const struct hwc_bw_config_t &cfg, const struct hwc_bw_layer_t *layers,
+        size_t num_layers, enum hwc_bw_path *path, struct hwc_bw_result_t &result)
+{
+    struct hwc_bw_search s;
+    bool forced = false;
+    size_t forced_first = 0;
+    size_t forced_last = 0;
+
+    memset(&result, 0, sizeof(result));
+
+    if (num_layers > HWC_BW_MAX_LAYERS)
+        return -1;
+
+    s.cfg = &cfg;
+    s.layers = layers;
+    s.num_layers = num_layers;
+    s.best = path;
+    s.result = &result;
+    s.best_bytes = 0;
+    s.best_fb_layers = 0;
+    s.best_fb_yuv = 0;
+    s.found = false;
+
+    // layers no window can take have to be inside the framebuffer range
+    for (size_t i = 0; i < num_layers; i++) {
+        if (layers[i].caps || (layers[i].flags & (HWC_BW_TARGET | HWC_BW_BACKGROUND)))
+            continue;
+        if (!forced)
+            forced_first = i;
+        forced_last = i;
+        forced = true;
+    }
+
+    if (!forced)
+        try_range(s, false, 0, 0);
+
+    for (size_t first = 0; first < num_layers; first++) {
+        if (forced && first > forced_first)
+            break;
+        if (layers[first].flags & (HWC_BW_TARGET | HWC_BW_BACKGROUND))
+            continue;
+
+        for (size_t last = forced ? forced_last : first; last < num_layers; last++) {
+            if (layers[last].flags & HWC_BW_TARGET)
+                break;
+            try_range(s, true, first, last);
+        }
+    }
+
+    return s.found ? 0 : -1;
+}
+
+uint64_t hwc_bw_cost(const struct hwc_bw_config_t &cfg, const struct hwc_bw_layer_t *layers,
+        size_t num_layers, const enum hwc_bw_path *path)
+{
+    uint64_t bytes = 0;
+    bool fb_needed = false;
+
+    for (size_t i = 0; i < num_layers; i++) {
+        bytes += path_bytes(cfg, layers[i], path[i]);
+        if (path[i] == HWC_BW_FB)
+            fb_needed = true;
+    }
+
+    if (fb_needed)
+        bytes += (uint64_t) cfg.xres * cfg.yres * cfg.fb_bpp / 8;
+
+    return bytes;
+}
+
+int hwc_bw_format_config(char *buf, size_t len, const struct hwc_bw_config_t &cfg)
+{
+    return snprintf(buf, len, "cfg %u %u %u %u %u %d", cfg.xres, cfg.yres, cfg.fb_bpp,
+            cfg.max_pixels, cfg.num_windows, cfg.multi_fimg ? 1 : 0);
+}
+
+int hwc_bw_format_layer(char *buf, size_t len, const struct hwc_bw_layer_t &layer)
+{
+    return snprintf(buf, len, "layer %u %u %u %u %u %x %x", layer.src_w, layer.src_h,
+            layer.dst_w, layer.dst_h, layer.bpp, layer.caps, layer.flags);
+}
+
+bool hwc_bw_parse_config(const char *line, struct hwc_bw_config_t &cfg)
+{
+    const char *p = strstr(line, "cfg ");
+    int multi_fimg;
+
+    if (!p || sscanf(p, "cfg %u %u %u %u %u %d", &cfg.xres, &cfg.yres, &cfg.fb_bpp,
+            &cfg.max_pixels, &cfg.num_windows, &multi_fimg) != 6)
+        return false;
+
+    cfg.multi_fimg = multi_fimg != 0;
+    return true;
+}
+
+bool hwc_bw_parse_layer(const char *line, struct hwc_bw_layer_t &layer)
+{
+    const char *p = strstr(line, "layer ");
+
+    return p && sscanf(p, "layer %u %u %u %u %u %x %x", &layer.src_w, &layer.src_h,
+            &layer.dst_w, &layer.dst_h, &layer.bpp, &layer.caps, &layer.flags) == 7;
+}
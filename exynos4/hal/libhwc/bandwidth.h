@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2017 The NamelessRom Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_HWCOMPOSER_BANDWIDTH_H
+#define ANDROID_HWCOMPOSER_BANDWIDTH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Layer to window assignment as a pure function of the layer stack, so it
+ * can be run on the host against recorded stacks (see debug.hwc.bw_record
+ * and hwc_bw_replay).
+ */
+
+const size_t HWC_BW_MAX_LAYERS = 32;
+
+enum hwc_bw_path {
+    HWC_BW_FB = 0,      // composed by GLES into the framebuffer target
+    HWC_BW_DIRECT,      // scanned out by a FIMD window
+    HWC_BW_FIMC,        // converted by FIMC into a window buffer
+    HWC_BW_FIMG,        // blitted by FIMG2D into a window buffer
+    HWC_BW_WINDOW,      // background layer, takes a window but no memory
+    HWC_BW_NONE,        // framebuffer target, not part of the problem
+};
+
+// hwc_bw_layer_t::caps
+#define HWC_BW_CAP_DIRECT   (1 << 0)
+#define HWC_BW_CAP_FIMC     (1 << 1)
+#define HWC_BW_CAP_FIMG     (1 << 2)
+
+// hwc_bw_layer_t::flags
+#define HWC_BW_BLENDED      (1 << 0)    // needs the pixels below it
+#define HWC_BW_BACKGROUND   (1 << 1)    // always a window, never the framebuffer
+#define HWC_BW_TARGET       (1 << 2)    // the framebuffer target itself
+#define HWC_BW_YUV          (1 << 3)    // video, kept off GLES while FIMC/FIMG can take it
+
+struct hwc_bw_layer_t {
+    uint32_t src_w;     // source crop
+    uint32_t src_h;
+    uint32_t dst_w;     // display frame
+    uint32_t dst_h;
+    uint32_t bpp;       // source bits per pixel
+    uint32_t caps;      // 0: framebuffer only
+    uint32_t flags;
+};
+
+struct hwc_bw_config_t {
+    uint32_t xres;
+    uint32_t yres;
+    uint32_t fb_bpp;        // framebuffer target and FIMC/FIMG window buffers
+    uint32_t max_pixels;    // FIMD fetch limit over all windows
+    uint32_t num_windows;
+    bool     multi_fimg;    // more than one FIMG layer per frame
+};
+
+struct hwc_bw_result_t {
+    bool     fb_needed;
+    size_t   first_fb;
+    size_t   last_fb;
+    uint64_t bytes;         // estimated DRAM traffic per frame
+    uint64_t pixels;        // FIMD window pixels
+    uint32_t evaluated;     // candidate assignments costed
+};
+
+/*
+ * Chooses a path for every layer so that the estimated DRAM traffic per
+ * frame is minimal, under the FIMD window, pixel and FIMC/FIMG limits and
+ * with the framebuffer layers forming one contiguous range. Among the
+ * assignments, those with the fewest HWC_BW_YUV layers in the framebuffer
+ * come first. Returns 0 and fills path[0..num_layers) and result, or -1 if
+ * no assignment exists.
+ */
+int hwc_bw_solve(const struct hwc_bw_config_t &cfg, const struct hwc_bw_layer_t *layers,
+        size_t num_layers, enum hwc_bw_path *path, struct hwc_bw_result_t &result);
+
+// estimated DRAM traffic per frame of a given assignment, with the solver's cost model
+uint64_t hwc_bw_cost(const struct hwc_bw_config_t &cfg, const struct hwc_bw_layer_t *layers,
+        size_t num_layers, const enum hwc_bw_path *path);
+
+// one line per config/layer for recording stacks, and back
+int hwc_bw_format_config(char *buf, size_t len, const struct hwc_bw_config_t &cfg);
+int hwc_bw_format_layer(char *buf, size_t len, const struct hwc_bw_layer_t &layer);
+bool hwc_bw_parse_config(const char *line, struct hwc_bw_config_t &cfg);
+bool hwc_bw_parse_layer(const char *line, struct hwc_bw_layer_t &layer);
+
+#endif //ANDROID_HWCOMPOSER_BANDWIDTH_H
@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2017 The NamelessRom Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Replays layer stacks recorded with debug.hwc.bw_record through the
+ * window assignment solver, and through the greedy pass it replaced:
+ *
+ *   adb logcat -s hwcomposer | hwc_bw_replay -
+ *   hwc_bw_replay bandwidth_stacks.txt
+ *   hwc_bw_replay --random 20000
+ *
+ * Every "cfg" line starts a stack and the "layer" lines after it fill it;
+ * the "hwc_bw: " logcat prefix is ignored. A stack may be followed by an
+ * "expect" line with one letter per layer (F framebuffer, D direct,
+ * C FIMC, G FIMG, W window, - target); a mismatch fails the run.
+ *
+ * --random generates 800x1280 stacks of 2 to 10 layers plus the target,
+ * mixing video, scaled, 16/32bpp, blended and GLES-only layers.
+ *
+ * Both are timed per stack, averaged over REPLAY_RUNS runs, and costed with
+ * hwc_bw_cost(). The totals compare the traffic of the two.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bandwidth.h"
+
+#define REPLAY_RUNS 100
+
+static const char path_letter[] = { 'F', 'D', 'C', 'G', 'W', '-' };
+
+struct replay_stack {
+    struct hwc_bw_config_t cfg;
+    struct hwc_bw_layer_t layers[HWC_BW_MAX_LAYERS];
+    size_t num_layers;
+    bool valid;
+};
+
+struct replay_totals {
+    unsigned int stacks;
+    unsigned int infeasible;
+    unsigned int checked;
+    unsigned int failed;
+    unsigned int improved;      // solver below greedy
+    unsigned int worse;         // solver above greedy
+    unsigned int worse_video;   // of which to keep more video off GLES
+    unsigned long long bytes;
+    unsigned long long greedy_bytes;
+    double solve_ns;
+    double greedy_ns;
+};
+
+/*
+ * determineSupportedOverlays() and determineBandwidthSupport() before the
+ * solver: walk the stack bottom-up, push the first layer that breaks a
+ * window, pixel or FIMC/FIMG limit to the framebuffer, fill the gaps of
+ * the framebuffer range and start over. assignWindows() then gave FIMC to
+ * the first FIMC capable overlay and FIMG to the rest.
+ */
+static void greedy_solve(const struct hwc_bw_config_t &cfg, const struct hwc_bw_layer_t *layers,
+        size_t num_layers, enum hwc_bw_path *path)
+{
+    bool fb[HWC_BW_MAX_LAYERS];
+    bool fb_needed = false;
+    size_t first_fb = 0;
+    size_t last_fb = 0;
+    bool changed;
+
+    for (size_t i = 0; i < num_layers; i++) {
+        fb[i] = false;
+        if (layers[i].caps || (layers[i].flags & (HWC_BW_TARGET | HWC_BW_BACKGROUND)))
+            continue;
+        if (!fb_needed) {
+            first_fb = i;
+            fb_needed = true;
+        }
+        last_fb = i;
+        fb[i] = true;
+    }
+
+    do {
+        first_fb = first_fb < cfg.num_windows - 1 ? first_fb : cfg.num_windows - 1;
+        if (fb_needed) {
+            for (size_t i = first_fb; i < last_fb; i++) {
+                if (!(layers[i].flags & HWC_BW_TARGET))
+                    fb[i] = true;
+            }
+        }
+
+        uint64_t pixels_left = cfg.max_pixels;
+        int windows_left = cfg.num_windows;
+        bool fimc_used = false;
+        bool fimg_used = false;
+        int yuv_layer = -1;
+        int rgb_over_yuv = 0;
+
+        if (fb_needed) {
+            pixels_left -= (uint64_t) cfg.xres * cfg.yres;
+            windows_left--;
+        }
+
+        changed = false;
+
+        for (size_t i = 0; i < num_layers; i++) {
+            const struct hwc_bw_layer_t &layer = layers[i];
+            uint64_t pixels_needed = (uint64_t) layer.dst_w * layer.dst_h;
+            bool can_compose;
+
+            if ((layer.flags & HWC_BW_TARGET) || fb[i])
+                continue;
+
+            if (layer.flags & HWC_BW_BACKGROUND) {
+                windows_left--;
+                continue;
+            }
+
+            can_compose = windows_left > 0 && pixels_needed <= pixels_left;
+
+            if (can_compose && !(layer.caps & HWC_BW_CAP_DIRECT)) {
+                bool fimg = !(layer.caps & HWC_BW_CAP_FIMC);
+
+                if (!fimg) {
+                    can_compose = !fimc_used;
+                    fimc_used = true;
+                    if (!can_compose && (layer.caps & HWC_BW_CAP_FIMG)) {
+                        can_compose = true;
+                        fimg = true;
+                    } else {
+                        yuv_layer = i;
+                    }
+                }
+
+                if (fimg) {
+                    if (yuv_layer >= 0 && (int) i > yuv_layer && ++rgb_over_yuv > 1)
+                        can_compose = false;
+                    if (can_compose) {
+                        if (!cfg.multi_fimg)
+                            can_compose = !fimg_used;
+                        fimg_used = true;
+                    }
+                }
+            }
+
+            if (!can_compose) {
+                fb[i] = true;
+                if (!fb_needed) {
+                    first_fb = last_fb = i;
+                    fb_needed = true;
+                } else {
+                    first_fb = i < first_fb ? i : first_fb;
+                    last_fb = i > last_fb ? i : last_fb;
+                }
+                changed = true;
+                break;
+            }
+
+            pixels_left -= pixels_needed;
+            windows_left--;
+        }
+    } while (changed);
+
+    bool fimc_used = false;
+
+    for (size_t i = 0; i < num_layers; i++) {
+        const struct hwc_bw_layer_t &layer = layers[i];
+
+        if (layer.flags & HWC_BW_TARGET)
+            path[i] = HWC_BW_NONE;
+        else if (fb[i])
+            path[i] = HWC_BW_FB;
+        else if (layer.flags & HWC_BW_BACKGROUND)
+            path[i] = HWC_BW_WINDOW;
+        else if (layer.caps & HWC_BW_CAP_DIRECT)
+            path[i] = HWC_BW_DIRECT;
+        else if ((layer.caps & HWC_BW_CAP_FIMC) && !fimc_used) {
+            path[i] = HWC_BW_FIMC;
+            fimc_used = true;
+        } else
+            path[i] = HWC_BW_FIMG;
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void path_string(char *buf, const enum hwc_bw_path *path, size_t num_layers)
+{
+    for (size_t i = 0; i < num_layers; i++)
+        buf[i] = path_letter[path[i]];
+    buf[num_layers] = '\0';
+}
+
+static size_t fb_video(const struct hwc_bw_layer_t *layers, size_t num_layers,
+        const enum hwc_bw_path *path)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < num_layers; i++) {
+        if ((layers[i].flags & HWC_BW_YUV) && path[i] == HWC_BW_FB)
+            count++;
+    }
+    return count;
+}
+
+static void solve_stack(struct replay_stack &stack, const char *expect,
+        struct replay_totals &totals, bool verbose)
+{
+    enum hwc_bw_path path[HWC_BW_MAX_LAYERS];
+    enum hwc_bw_path greedy[HWC_BW_MAX_LAYERS];
+    struct hwc_bw_result_t result;
+    char got[HWC_BW_MAX_LAYERS + 1];
+    char greedy_got[HWC_BW_MAX_LAYERS + 1];
+    uint64_t greedy_bytes;
+    double t0, solve_ns, greedy_ns;
+    int err = 0;
+
+    if (!stack.valid || !stack.num_layers)
+        return;
+
+    t0 = now_ns();
+    for (int run = 0; run < REPLAY_RUNS; run++)
+        err = hwc_bw_solve(stack.cfg, stack.layers, stack.num_layers, path, result);
+    solve_ns = (now_ns() - t0) / REPLAY_RUNS;
+
+    t0 = now_ns();
+    for (int run = 0; run < REPLAY_RUNS; run++)
+        greedy_solve(stack.cfg, stack.layers, stack.num_layers, greedy);
+    greedy_ns = (now_ns() - t0) / REPLAY_RUNS;
+
+    greedy_bytes = hwc_bw_cost(stack.cfg, stack.layers, stack.num_layers, greedy);
+    path_string(greedy_got, greedy, stack.num_layers);
+
+    totals.stacks++;
+    totals.solve_ns += solve_ns;
+    totals.greedy_ns += greedy_ns;
+
+    if (err) {
+        totals.infeasible++;
+        if (verbose)
+            printf("stack %u: no assignment, greedy %s %llu bytes\n", totals.stacks,
+                    greedy_got, (unsigned long long) greedy_bytes);
+        strcpy(got, "none");
+    } else {
+        path_string(got, path, stack.num_layers);
+        totals.bytes += result.bytes;
+        totals.greedy_bytes += greedy_bytes;
+        if (result.bytes < greedy_bytes)
+            totals.improved++;
+        else if (result.bytes > greedy_bytes) {
+            totals.worse++;
+            if (fb_video(stack.layers, stack.num_layers, path) <
+                    fb_video(stack.layers, stack.num_layers, greedy))
+                totals.worse_video++;
+        }
+        if (verbose)
+            printf("stack %u: %s %llu bytes, %u candidates, %.2f us; greedy %s %llu bytes, %.2f us\n",
+                    totals.stacks, got, (unsigned long long) result.bytes, result.evaluated,
+                    solve_ns / 1e3, greedy_got, (unsigned long long) greedy_bytes,
+                    greedy_ns / 1e3);
+    }
+
+    if (expect) {
+        totals.checked++;
+        if (strcmp(expect, got)) {
+            totals.failed++;
+            printf("stack %u: expected %s\n", totals.stacks, expect);
+        }
+    }
+
+    stack.valid = false;
+}
+
+static int replay(FILE *in, struct replay_totals &totals)
+{
+    struct replay_stack stack;
+    char line[256];
+    char expect[HWC_BW_MAX_LAYERS + 1];
+
+    stack.valid = false;
+    stack.num_layers = 0;
+
+    while (fgets(line, sizeof(line), in)) {
+        const char *p;
+
+        if (hwc_bw_parse_config(line, stack.cfg)) {
+            solve_stack(stack, NULL, totals, true);
+            stack.valid = true;
+            stack.num_layers = 0;
+        } else if (strstr(line, "layer ")) {
+            if (!stack.valid)
+                continue;
+            if (stack.num_layers == HWC_BW_MAX_LAYERS ||
+                    !hwc_bw_parse_layer(line, stack.layers[stack.num_layers])) {
+                fprintf(stderr, "bad layer line: %s", line);
+                return -1;
+            }
+            stack.num_layers++;
+        } else if ((p = strstr(line, "expect ")) != NULL) {
+            if (sscanf(p, "expect %32s", expect) != 1) {
+                fprintf(stderr, "bad expect line: %s", line);
+                return -1;
+            }
+            solve_stack(stack, expect, totals, true);
+        }
+    }
+
+    solve_stack(stack, NULL, totals, true);
+    return 0;
+}
+
+static uint32_t random_size(unsigned int *seed, uint32_t max)
+{
+    return 32 + rand_r(seed) % (max - 31);
+}
+
+static void random_stack(struct replay_stack &stack, unsigned int *seed)
+{
+    size_t n = 2 + rand_r(seed) % 9;
+
+    stack.cfg.xres = 800;
+    stack.cfg.yres = 1280;
+    stack.cfg.fb_bpp = 32;
+    stack.cfg.max_pixels = 12288000;
+    stack.cfg.num_windows = 5;
+    stack.cfg.multi_fimg = false;
+
+    for (size_t i = 0; i < n; i++) {
+        struct hwc_bw_layer_t &layer = stack.layers[i];
+        unsigned int kind = rand_r(seed) % 100;
+
+        memset(&layer, 0, sizeof(layer));
+
+        if (i == 0 && kind < 10) {
+            layer.flags = HWC_BW_BACKGROUND;
+            continue;
+        }
+
+        if (kind < 20) {
+            // video, letterboxed to the screen width
+            static const uint32_t video[][2] = { { 1920, 1080 }, { 1280, 720 }, { 640, 480 } };
+            const uint32_t *v = video[rand_r(seed) % 3];
+
+            layer.src_w = v[0];
+            layer.src_h = v[1];
+            layer.dst_w = stack.cfg.xres;
+            layer.dst_h = stack.cfg.xres * v[1] / v[0];
+            layer.bpp = 12;
+            layer.caps = HWC_BW_CAP_FIMC | HWC_BW_CAP_FIMG;
+            layer.flags = HWC_BW_YUV;
+            continue;
+        }
+
+        if (rand_r(seed) % 3 == 0) {
+            layer.dst_w = stack.cfg.xres;
+            layer.dst_h = stack.cfg.yres;
+        } else {
+            layer.dst_w = random_size(seed, stack.cfg.xres);
+            layer.dst_h = random_size(seed, stack.cfg.yres);
+        }
+        layer.src_w = layer.dst_w;
+        layer.src_h = layer.dst_h;
+        layer.bpp = rand_r(seed) % 3 == 0 ? 16 : 32;
+        if (rand_r(seed) % 2)
+            layer.flags |= HWC_BW_BLENDED;
+
+        if (kind < 35) {
+            // GLES only: unsupported format or transform
+            layer.caps = 0;
+        } else if (kind < 55) {
+            // scaled, needs FIMG
+            layer.src_w = random_size(seed, stack.cfg.xres);
+            layer.src_h = random_size(seed, stack.cfg.yres);
+            layer.caps = HWC_BW_CAP_FIMG;
+        } else {
+            layer.caps = HWC_BW_CAP_DIRECT;
+        }
+    }
+
+    memset(&stack.layers[n], 0, sizeof(stack.layers[n]));
+    stack.layers[n].flags = HWC_BW_TARGET;
+    stack.num_layers = n + 1;
+    stack.valid = true;
+}
+
+int main(int argc, char **argv)
+{
+    struct replay_totals totals;
+    size_t feasible;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <recorded stacks | -> ...\n"
+                "       %s --random <stacks>\n", argv[0], argv[0]);
+        return 2;
+    }
+
+    memset(&totals, 0, sizeof(totals));
+
+    if (!strcmp(argv[1], "--random")) {
+        struct replay_stack stack;
+        unsigned int seed = 1;
+        int count = argc > 2 ? atoi(argv[2]) : 20000;
+
+        for (int i = 0; i < count; i++) {
+            random_stack(stack, &seed);
+            solve_stack(stack, NULL, totals, false);
+        }
+    } else {
+        for (int i = 1; i < argc; i++) {
+            FILE *in = strcmp(argv[i], "-") ? fopen(argv[i], "r") : stdin;
+            int ret;
+
+            if (!in) {
+                perror(argv[i]);
+                return 2;
+            }
+            ret = replay(in, totals);
+            if (in != stdin)
+                fclose(in);
+            if (ret)
+                return 2;
+        }
+    }
+
+    feasible = totals.stacks - totals.infeasible;
+
+    printf("%u stacks, %u infeasible, %.1f MB/frame average",
+            totals.stacks, totals.infeasible,
+            feasible ? totals.bytes / 1e6 / feasible : 0.0);
+    if (totals.checked)
+        printf(", %u/%u expectations met", totals.checked - totals.failed, totals.checked);
+    printf("\n");
+
+    if (feasible) {
+        printf("greedy %.1f MB/frame, solver %+.1f%%, %u improved (%.1f%%), "
+                "%u worse (%u keeping video off GLES)\n",
+                totals.greedy_bytes / 1e6 / feasible,
+                totals.greedy_bytes ?
+                    100.0 * ((double) totals.bytes - totals.greedy_bytes) / totals.greedy_bytes : 0.0,
+                totals.improved, 100.0 * totals.improved / feasible, totals.worse,
+                totals.worse_video);
+    }
+    if (totals.stacks) {
+        printf("solver %.2f us/stack, greedy %.2f us/stack\n",
+                totals.solve_ns / 1e3 / totals.stacks, totals.greedy_ns / 1e3 / totals.stacks);
+    }
+
+    return totals.failed ? 1 : 0;
+}
@@ -459,168 +459,129 @@ void determineSupportedOverlays(hwc_context_t *ctx, hwc_display_contents_1_t *co
 #endif
 }
 
-void determineBandwidthSupport(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
+static void bw_layer_from_hwc(hwc_layer_1_t &layer, struct hwc_bw_layer_t &bw)
 {
-#if DEBUG_SPAMMY
-    for (size_t i=0 ; i < contents->numHwLayers ; i++)
-        dump_layer(&contents->hwLayers[i], __FUNCTION__);
-#endif
-
-    // Incrementally try to add our supported layers to hardware windows.
-    // If adding a layer would violate a hardware constraint, force it
-    // into the framebuffer and try again.  (Revisiting the entire list is
-    // necessary because adding a layer to the framebuffer can cause other
-    // windows to retroactively violate constraints.)
-    bool changed;
-    bool fimg_used;
-    bool fimc_used;
-    int yuv_layer; //which layer has yuv content
-    int rgb_over_yuv_layer; //number of rgb layers over a yuv layer
-
-    do {
-        size_t pixels_left, windows_left;
-
-        if (ctx->fb_needed) {
-            pixels_left = MAX_PIXELS - (ctx->xres * ctx->yres);
-            windows_left = NUM_HW_WINDOWS - 1;
-        } else {
-            pixels_left = MAX_PIXELS;
-            windows_left = NUM_HW_WINDOWS;
-        }
-
-        changed = false;
-#ifdef NO_FIMG
-        // disable HW composition using FIMG
-        fimg_used = true;
-#else
-        fimg_used = false;
-#endif
-        fimc_used = false;
-        yuv_layer = -1;
-        rgb_over_yuv_layer = 0;
-
-        for (size_t i = 0; i < contents->numHwLayers; i++) {
-            hwc_layer_1_t &layer = contents->hwLayers[i];
-
-            if (layer.flags & HWC_SKIP_LAYER) {
-                ALOGV("%s: layer %u skipping", __FUNCTION__, i);
-                continue;
-            }
-
-            if (layer.compositionType == HWC_FRAMEBUFFER_TARGET) {
-                ALOGV("%s: layer %u HWC_FRAMEBUFFER_TARGET", __FUNCTION__, i);
-                continue;
-            }
-
-            // we've already accounted for the framebuffer above
-            if (layer.compositionType == HWC_FRAMEBUFFER) {
-                ALOGV("%s: layer %u HWC_FRAMEBUFFER", __FUNCTION__, i);
-                continue;
-            }
-
-            // only layer 0 can be HWC_BACKGROUND, so we can unconditionally allow it without extra checks
-            if (layer.compositionType == HWC_BACKGROUND) {
-                ALOGV("%s: layer %u HWC_BACKGROUND", __FUNCTION__, i);
-                windows_left--;
-                continue;
-            }
+    memset(&bw, 0, sizeof(bw));
 
-            size_t pixels_needed = WIDTH(layer.displayFrame) * HEIGHT(layer.displayFrame);
-            bool can_compose = true;
-            bool gsc_required = false;
+    if (layer.compositionType == HWC_FRAMEBUFFER_TARGET) {
+        bw.flags = HWC_BW_TARGET;
+        return;
+    }
 
-            do {
-                can_compose = windows_left && pixels_needed <= pixels_left;
-                if (!can_compose) {
-                    ALOGV("%s: can't compose layer %d, %s, pixels_needed(%d) pixels_left(%d)", 
-                            __FUNCTION__, i, windows_left ? "no more pixels left" : "no more windows left", pixels_needed, pixels_left);
-                    break;
-                }
+    // only layer 0 can be HWC_BACKGROUND, it needs a window but no memory
+    if (layer.compositionType == HWC_BACKGROUND) {
+        bw.flags = HWC_BW_BACKGROUND;
+        return;
+    }
 
-                enum gsc_map_t::mode mode = layer_requires_process(layer);
-                private_handle_t *handle = private_handle_t::dynamicCast(layer.handle);
+    hwc_rect_t crop = integerizeSourceCrop(layer.sourceCropf);
+    private_handle_t *handle = private_handle_t::dynamicCast(layer.handle);
 
-                switch (mode) {
-                    case gsc_map_t::FIMC:
-                        ALOGV("%s: layer %u: mode=FIMC", __FUNCTION__, i);
-                        can_compose = can_compose && !fimc_used;
-                        fimc_used = true;
-                        if (!can_compose && format_is_supported_by_fimg(handle->format)) {
-                            can_compose = true;
-                            // fall through to FIMG
-                            mode = gsc_map_t::FIMG;
-                        } else {
-                            yuv_layer = i;
-                            break;
-                        }
+    bw.src_w = max(WIDTH(crop), 0);
+    bw.src_h = max(HEIGHT(crop), 0);
+    bw.dst_w = max(WIDTH(layer.displayFrame), 0);
+    bw.dst_h = max(HEIGHT(layer.displayFrame), 0);
+    bw.bpp = handle ? format_to_bpp(handle->format) : 0;
+    if (!bw.bpp)
+        bw.bpp = 32;
+    if (layer.blending != HWC_BLENDING_NONE)
+        bw.flags |= HWC_BW_BLENDED;
+    if (handle && is_yuv_format(handle->format))
+        bw.flags |= HWC_BW_YUV;
+
+    // anything determineSupportedOverlays() rejected stays in the framebuffer
+    if (layer.compositionType != HWC_OVERLAY)
+        return;
+
+    switch (layer_requires_process(layer)) {
+    case gsc_map_t::FIMC:
+        bw.caps = HWC_BW_CAP_FIMC;
+#ifndef NO_FIMG
+        if (format_is_supported_by_fimg(handle->format))
+            bw.caps |= HWC_BW_CAP_FIMG;
+#endif
+        break;
 
-                    case gsc_map_t::FIMG:
-                        ALOGV("%s: layer %u: mode=FIMG can_compose(%d) fimg_used(%d)", __FUNCTION__, i, can_compose, fimg_used);
+    case gsc_map_t::FIMG:
+#ifndef NO_FIMG
+        bw.caps = HWC_BW_CAP_FIMG;
+#endif
+        break;
 
-                        if (yuv_layer >= 0 && i > yuv_layer) {
-                            ++rgb_over_yuv_layer;
+    default:
+        bw.caps = HWC_BW_CAP_DIRECT;
+        break;
+    }
+}
 
-                            if (rgb_over_yuv_layer > 1) {
-                                ALOGV("%s: layer %u can't be composed, since there are too much rgb layers over a yuv one", __FUNCTION__, i);
-                                can_compose = false;
-                            }
-                        }
+void determineBandwidthSupport(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
+{
+    struct hwc_bw_layer_t layers[HWC_BW_MAX_LAYERS];
+    struct hwc_bw_config_t cfg;
+    struct hwc_bw_result_t &result = ctx->bw_result;
+    size_t num_layers = contents->numHwLayers;
+    int err = -1;
 
-                        if (can_compose) {
-#ifndef NO_FIMG
-                            if (!ctx->multi_fimg)
+#if DEBUG_SPAMMY
+    for (size_t i=0 ; i < contents->numHwLayers ; i++)
+        dump_layer(&contents->hwLayers[i], __FUNCTION__);
 #endif
-                                can_compose = can_compose && !fimg_used;
-                            fimg_used = true;
-                        }
-
-                        break;
 
+    cfg.xres = ctx->xres;
+    cfg.yres = ctx->yres;
+    cfg.fb_bpp = 32;
+    cfg.max_pixels = MAX_PIXELS;
+    cfg.num_windows = NUM_HW_WINDOWS;
+    cfg.multi_fimg = ctx->multi_fimg;
+
+    if (num_layers <= HWC_BW_MAX_LAYERS) {
+        for (size_t i = 0; i < num_layers; i++)
+            bw_layer_from_hwc(contents->hwLayers[i], layers[i]);
+
+        if (ctx->bw_record) {
+            char line[128];
+
+            hwc_bw_format_config(line, sizeof(line), cfg);
+            ALOGD("hwc_bw: %s", line);
+            for (size_t i = 0; i < num_layers; i++) {
+                hwc_bw_format_layer(line, sizeof(line), layers[i]);
+                ALOGD("hwc_bw: %s", line);
+            }
+        }
 
-                    default:
-                        ALOGV("%s: layer %u: mode=%d", __FUNCTION__, i, mode);
-                        can_compose = true;
-                        break;
-                };
+        err = hwc_bw_solve(cfg, layers, num_layers, ctx->bw_path, result);
+    }
 
-                if (!can_compose) {
-                    ALOGV("%s: can't compose layer %d, mode(%d)", __FUNCTION__, i, (int) mode);
-                }
+    if (err) {
+        // everything but the background goes to GLES
+        ALOGW("%s: no window assignment for %u layers, using GLES", __FUNCTION__, num_layers);
+        memset(&result, 0, sizeof(result));
+        for (size_t i = 0; i < num_layers; i++) {
+            hwc_layer_1_t &layer = contents->hwLayers[i];
 
-                break; //we only want to perform the "can_compose" check once
-            } while (1);
-
-            if (!can_compose) {
-                layer.compositionType = HWC_FRAMEBUFFER;
-                if (!ctx->fb_needed) {
-                    ctx->first_fb = ctx->last_fb = i;
-                    ctx->fb_needed = true;
-                } else {
-                    ctx->first_fb = min(i, ctx->first_fb);
-                    ctx->last_fb = max(i, ctx->last_fb);
-                }
-                changed = true;
-                ctx->first_fb = min(ctx->first_fb, (size_t)NUM_HW_WINDOWS-1); // odroid has this
-                ALOGV("%s: i(%d) can't compose, fb_needed(%d) first_fb(%d) last_fb(%d)", __FUNCTION__, i, ctx->fb_needed, ctx->first_fb, ctx->last_fb);
-                break;
-            }
+            if (layer.compositionType == HWC_FRAMEBUFFER_TARGET ||
+                layer.compositionType == HWC_BACKGROUND)
+                continue;
 
-            pixels_left -= pixels_needed;
-            windows_left--;
+            layer.compositionType = HWC_FRAMEBUFFER;
+            if (!result.fb_needed)
+                result.first_fb = i;
+            result.last_fb = i;
+            result.fb_needed = true;
         }
-
-        if (changed) {
-            for (size_t i = ctx->first_fb; i < ctx->last_fb; i++) {
-                if (contents->hwLayers[i].compositionType != HWC_FRAMEBUFFER) {
-                    ALOGV("%s: changed, layer %d set to FB", __FUNCTION__, i);
-                    contents->hwLayers[i].compositionType = HWC_FRAMEBUFFER;
-                }
-            }
+    } else {
+        for (size_t i = 0; i < num_layers; i++) {
+            if (ctx->bw_path[i] == HWC_BW_FB)
+                contents->hwLayers[i].compositionType = HWC_FRAMEBUFFER;
         }
+    }
 
-    } while(changed);
+    ctx->fb_needed = result.fb_needed;
+    ctx->first_fb = result.first_fb;
+    ctx->last_fb = result.last_fb;
 
-    ALOGV("%s: fb_needed(%d) first_fb(%d) last_fb(%d)", __FUNCTION__, ctx->fb_needed, ctx->first_fb, ctx->last_fb);
+    ALOGV("%s: fb_needed(%d) first_fb(%d) last_fb(%d) bytes(%llu)", __FUNCTION__,
+            ctx->fb_needed, ctx->first_fb, ctx->last_fb, (unsigned long long) result.bytes);
 #if DEBUG_SPAMMY
     for (size_t i=0 ; i < contents->numHwLayers ; i++)
         dump_layer(&contents->hwLayers[i], __FUNCTION__);
@@ -631,7 +592,6 @@ void assignWindows(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
 {
     unsigned int nextWindow = 0;
     enum gsc_map_t::mode mode;
-    bool fimc_used = false;
     for (size_t i = 0; i < contents->numHwLayers; i++) {
         hwc_layer_1_t &layer = contents->hwLayers[i];
 
@@ -652,16 +612,22 @@ void assignWindows(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
                 ctx->win[nextWindow].src_buf = handle;
                 layer.hints = HWC_HINT_CLEAR_FB;
 
-                mode = layer_requires_process(layer);
+                // determineBandwidthSupport() picked the converter
+                switch (ctx->bw_path[i]) {
+                case HWC_BW_FIMC:
+                    mode = gsc_map_t::FIMC;
+                    break;
+                case HWC_BW_FIMG:
+                    mode = gsc_map_t::FIMG;
+                    break;
+                default:
+                    mode = gsc_map_t::NONE;
+                    break;
+                }
 
                 switch (mode) {
                 case gsc_map_t::FIMG:
                 case gsc_map_t::FIMC:
-                    if (mode == gsc_map_t::FIMC) {
-                        if (fimc_used)
-                            mode = gsc_map_t::FIMG;
-                        else fimc_used = true;
-                    }
                     ALOGV("\tlayer(%d) using FIM%c for format(%d)", i, (mode == gsc_map_t::FIMG)?'G':'C', handle->format);
                     ctx->win[nextWindow].gsc.mode = mode;
 
@@ -695,6 +661,215 @@ void assignWindows(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
     }
 }
 
+static void layer_cache_invalidate(hwc_context_t *ctx)
+{
+    ctx->layer_cache.valid = false;
+    ctx->layer_cache.cfg_valid = false;
+}
+
+static void layer_cache_make_key(const hwc_layer_1_t &layer, struct hwc_layer_key_t &key)
+{
+    private_handle_t *handle = (private_handle_t *) layer.handle;
+
+    // zero the padding too, keys are hashed and compared bytewise
+    memset(&key, 0, sizeof(key));
+
+    if (layer.compositionType == HWC_BACKGROUND ||
+        layer.compositionType == HWC_FRAMEBUFFER_TARGET)
+        key.type = layer.compositionType;
+
+    key.flags = layer.flags;
+    key.transform = layer.transform;
+    key.blending = layer.blending;
+    key.plane_alpha = layer.planeAlpha;
+    key.source_crop = layer.sourceCropf;
+    key.display_frame = layer.displayFrame;
+
+    // backgroundColor shares its storage with the handle
+    if (layer.compositionType == HWC_BACKGROUND) {
+        key.background = (layer.backgroundColor.r << 16) |
+                (layer.backgroundColor.g << 8) | layer.backgroundColor.b;
+        key.format = -1;
+    } else if (handle) {
+        key.format = handle->format;
+        key.usage = handle->usage;
+        key.width = handle->width;
+        key.height = handle->height;
+        key.stride = handle->stride;
+        key.contiguous = handle->paddr != 0;
+    } else {
+        key.format = -1;
+    }
+}
+
+static uint32_t layer_cache_hash(const struct hwc_layer_key_t *keys, size_t num_layers)
+{
+    // FNV-1a
+    const uint8_t *p = (const uint8_t *) keys;
+    const uint8_t *end = p + num_layers * sizeof(*keys);
+    uint32_t hash = 2166136261U;
+
+    while (p < end) {
+        hash ^= *p++;
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+static bool frame_on_screen(hwc_context_t *ctx, const hwc_rect_t &frame)
+{
+    return frame.left >= 0 && frame.top >= 0 &&
+            frame.right <= ctx->xres && frame.bottom <= ctx->yres;
+}
+
+/*
+ * A layer that only moved keeps its composition type and window as long as
+ * nothing the prepare passes derive from its geometry changes: the crop and
+ * frame sizes (scaling, bandwidth, FIMG/FIMC buffer sizes), the clipping
+ * against the screen and the x alignment of the frame. 32 / bpp is at most
+ * 4 pixels, so a horizontal move by a multiple of 4 keeps the alignment.
+ */
+static bool layer_cache_move_keeps_assignment(hwc_context_t *ctx,
+        const struct hwc_layer_key_t &old_key, const struct hwc_layer_key_t &new_key)
+{
+    hwc_rect_t old_crop = integerizeSourceCrop(old_key.source_crop);
+    hwc_rect_t new_crop = integerizeSourceCrop(new_key.source_crop);
+    const hwc_rect_t &old_frame = old_key.display_frame;
+    const hwc_rect_t &new_frame = new_key.display_frame;
+
+    if (WIDTH(old_crop) != WIDTH(new_crop) || HEIGHT(old_crop) != HEIGHT(new_crop) ||
+        WIDTH(old_frame) != WIDTH(new_frame) || HEIGHT(old_frame) != HEIGHT(new_frame))
+        return false;
+
+    if (!frame_on_screen(ctx, old_frame) || !frame_on_screen(ctx, new_frame))
+        return false;
+
+    return (new_frame.left - old_frame.left) % 4 == 0;
+}
+
+enum layer_cache_result {
+    LAYER_CACHE_MISS,
+    LAYER_CACHE_HIT,    // same stack, window configs can be reused too
+    LAYER_CACHE_MOVED,  // layers moved, window configs need rebuilding
+};
+
+static enum layer_cache_result layer_cache_compare(hwc_context_t *ctx,
+        const struct hwc_layer_key_t *key, size_t num_layers, uint32_t hash)
+{
+    struct hwc_layer_cache_t &cache = ctx->layer_cache;
+    const size_t geometry = offsetof(struct hwc_layer_key_t, source_crop);
+
+    if (!cache.valid || cache.num_layers != num_layers ||
+        cache.force_fb != ctx->force_fb || cache.multi_fimg != ctx->multi_fimg)
+        return LAYER_CACHE_MISS;
+
+    if (cache.hash == hash && !memcmp(cache.key, key, num_layers * sizeof(key[0])))
+        return LAYER_CACHE_HIT;
+
+    for (size_t i = 0; i < num_layers; i++) {
+        if (memcmp(&cache.key[i], &key[i], geometry))
+            return LAYER_CACHE_MISS;
+        if (memcmp(&cache.key[i], &key[i], sizeof(key[i])) &&
+            !layer_cache_move_keeps_assignment(ctx, cache.key[i], key[i]))
+            return LAYER_CACHE_MISS;
+    }
+
+    return LAYER_CACHE_MOVED;
+}
+
+/*
+ * Replays the cached composition types and window assignment if the layer
+ * stack matches the one of the last full prepare, or differs only in layer
+ * positions that don't affect the assignment. The freshly computed key is
+ * left in the cache, for layer_cache_store() on a miss.
+ */
+static enum layer_cache_result layer_cache_lookup(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
+{
+    struct hwc_layer_cache_t &cache = ctx->layer_cache;
+    struct hwc_layer_key_t key[MAX_CACHED_LAYERS];
+    size_t num_layers = contents->numHwLayers;
+    enum layer_cache_result result;
+    uint32_t hash;
+
+    if (num_layers > MAX_CACHED_LAYERS) {
+        layer_cache_invalidate(ctx);
+        return LAYER_CACHE_MISS;
+    }
+
+    for (size_t i = 0; i < num_layers; i++)
+        layer_cache_make_key(contents->hwLayers[i], key[i]);
+    hash = layer_cache_hash(key, num_layers);
+
+    result = layer_cache_compare(ctx, key, num_layers, hash);
+    if (result != LAYER_CACHE_HIT) {
+        cache.cfg_valid = false;
+        cache.hash = hash;
+        memcpy(cache.key, key, num_layers * sizeof(key[0]));
+    }
+    if (result == LAYER_CACHE_MISS) {
+        cache.valid = false;
+        cache.num_layers = num_layers;
+        cache.force_fb = ctx->force_fb;
+        cache.multi_fimg = ctx->multi_fimg;
+        return result;
+    }
+
+    for (size_t i = 0; i < num_layers; i++) {
+        hwc_layer_1_t &layer = contents->hwLayers[i];
+
+        layer.compositionType = cache.composition[i];
+        if (layer.compositionType == HWC_OVERLAY)
+            layer.hints = HWC_HINT_CLEAR_FB;
+    }
+
+    for (size_t i = 0; i < NUM_HW_WINDOWS; i++) {
+        struct hwc_win_info_t &win = ctx->win[i];
+        int layer_idx = cache.layer_index[i];
+
+        win.layer_index = layer_idx;
+        win.gsc.mode = cache.gsc_mode[i];
+        win.src_buf = NULL;
+
+        if (layer_idx != -1 && contents->hwLayers[layer_idx].compositionType == HWC_OVERLAY)
+            win.src_buf = private_handle_t::dynamicCast(contents->hwLayers[layer_idx].handle);
+
+        // same sizes, so only a missing destination buffer needs allocating
+        if ((win.gsc.mode == gsc_map_t::FIMG || win.gsc.mode == gsc_map_t::FIMC) &&
+            !win.dst_buf[win.current_buf])
+            window_buffer_allocate(ctx, &win);
+    }
+
+    ctx->fb_needed = cache.fb_needed;
+    ctx->first_fb = cache.first_fb;
+    ctx->last_fb = cache.last_fb;
+    ctx->fb_window = cache.fb_window;
+
+    return result;
+}
+
+static void layer_cache_store(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
+{
+    struct hwc_layer_cache_t &cache = ctx->layer_cache;
+
+    if (contents->numHwLayers > MAX_CACHED_LAYERS)
+        return;
+
+    for (size_t i = 0; i < contents->numHwLayers; i++)
+        cache.composition[i] = contents->hwLayers[i].compositionType;
+
+    for (size_t i = 0; i < NUM_HW_WINDOWS; i++) {
+        cache.layer_index[i] = ctx->win[i].layer_index;
+        cache.gsc_mode[i] = ctx->win[i].gsc.mode;
+    }
+
+    cache.fb_needed = ctx->fb_needed;
+    cache.first_fb = ctx->first_fb;
+    cache.last_fb = ctx->last_fb;
+    cache.fb_window = ctx->fb_window;
+    cache.valid = true;
+}
+
 static int prepare_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
 {
     ctx->force_fb = ctx->force_gpu;
@@ -703,6 +878,18 @@ static int prepare_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
         ctx->force_fb = true;
     }
 
+    switch (layer_cache_lookup(ctx, contents)) {
+    case LAYER_CACHE_HIT:
+        ctx->layer_cache.hits++;
+        return 0;
+    case LAYER_CACHE_MOVED:
+        ctx->layer_cache.moves++;
+        return 0;
+    default:
+        ctx->layer_cache.misses++;
+        break;
+    }
+
     determineSupportedOverlays(ctx, contents);
     determineBandwidthSupport(ctx, contents);
     assignWindows(ctx, contents);
@@ -712,6 +899,8 @@ static int prepare_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
     else
         ctx->fb_window = NO_FB_NEEDED;
 
+    layer_cache_store(ctx, contents);
+
     return 0;
 }
 
@@ -744,6 +933,12 @@ static int perform_fimg(hwc_context_t *ctx, const hwc_layer_1_t &layer, struct h
     struct fimg2d_image *g2d_dst_img = &win.g2d_dst_img;
     struct fimg2d_blit *fimg_cmd = &win.fimg_cmd;
     enum rotation l_rotate;
+
+    if (window_buffer_select(&win) < 0) {
+        ALOGE("%s: every destination buffer is still being written", __FUNCTION__);
+        return -1;
+    }
+
     struct private_handle_t *dst_handle = private_handle_t::dynamicCast(win.dst_buf[win.current_buf]);
     uint32_t dst_addr = (uint32_t) dst_handle->ion_memory;
 
@@ -829,7 +1024,8 @@ static int perform_fimg(hwc_context_t *ctx, const hwc_layer_1_t &layer, struct h
         sync_wait(layer.acquireFenceFd, 1000);
     }
 
-    ret = stretchFimgApi(fimg_cmd);
+    // runs on the FIMG2D queue while the remaining windows are configured
+    ret = stretchFimgApiAsync(fimg_cmd, &win.fimg_ticket);
     if (ret < 0) {
         ALOGE("%s: stretch failed", __FUNCTION__);
         dump_layer(&layer, __FUNCTION__);
@@ -847,6 +1043,11 @@ static int perform_fimc(hwc_context_t *ctx, const hwc_layer_1_t &layer, struct h
     private_handle_t *src_handle = private_handle_t::dynamicCast(layer.handle);
     int ret = 0;
 
+    if (window_buffer_select(&win) < 0) {
+        ALOGE("%s: every destination buffer is still being written", __FUNCTION__);
+        return -1;
+    }
+
     // before sending anything to FIMC
     if (layer.acquireFenceFd >= 0) {
         sync_wait(layer.acquireFenceFd, 1000);
@@ -980,6 +1181,42 @@ static int perform_fimc(hwc_context_t *ctx, const hwc_layer_1_t &layer, struct h
     return w;
 }
 
+static void wait_acquire_fence(hwc_layer_1_t &layer, s3c_fb_win_config &cfg)
+{
+    if (layer.acquireFenceFd >= 0) {
+        if (sync_wait(layer.acquireFenceFd, 1000) < 0)
+            ALOGW("sync_wait error");
+
+        close(layer.acquireFenceFd);
+        layer.acquireFenceFd = -1;
+
+        cfg.fence_fd = -1;
+    }
+}
+
+/*
+ * The layer stack is unchanged since the last post, so the window config
+ * of a direct (non FIMG/FIMC) window only differs in the buffer it scans
+ * out: refresh everything config_handle() takes from the handle. The
+ * acquire fence goes to the kernel with the config instead of being waited
+ * for here, post_fimd() closes it after the ioctl.
+ */
+static void reuse_overlay_config(const struct hwc_win_info_t &win, hwc_layer_1_t &layer, s3c_fb_win_config &cfg)
+{
+    memcpy(&cfg, &win.win_cfg, sizeof(struct s3c_fb_win_config));
+    cfg.fence_fd = -1;
+
+    if (layer.compositionType == HWC_OVERLAY ||
+        layer.compositionType == HWC_FRAMEBUFFER_TARGET) {
+        private_handle_t* hnd = (private_handle_t*) layer.handle;
+
+        cfg.fd = hnd->fd;
+        cfg.fence_fd = layer.acquireFenceFd;
+        cfg.phys_addr = hnd->paddr;
+        layer.acquireFenceFd = -1;
+    }
+}
+
 static void config_overlay(hwc_context_t *ctx, hwc_layer_1_t &layer, s3c_fb_win_config &cfg)
 {
     private_handle_t* hnd = (private_handle_t*) layer.handle;
@@ -998,16 +1235,7 @@ static void config_overlay(hwc_context_t *ctx, hwc_layer_1_t &layer, s3c_fb_win_
         cfg.format = S3C_FB_PIXEL_FORMAT_RGBA_8888;
 
         cfg.phys_addr = hnd->paddr;
-
-        if (layer.acquireFenceFd >= 0) {
-            if (sync_wait(layer.acquireFenceFd, 1000) < 0)
-                ALOGW("sync_wait error");
-
-            close(layer.acquireFenceFd);
-            layer.acquireFenceFd = -1;
-
-            cfg.fence_fd = -1;
-        }
+        wait_acquire_fence(layer, cfg);
     } else if (layer.compositionType == HWC_FRAMEBUFFER_TARGET) {
         ALOGV("%s HWC_FRAMEBUFFER_TARGET", __FUNCTION__);
         config_handle(ctx, layer, cfg);
@@ -1017,16 +1245,7 @@ static void config_overlay(hwc_context_t *ctx, hwc_layer_1_t &layer, s3c_fb_win_
         // format
         //cfg.format = S3C_FB_PIXEL_FORMAT_BGRA_8888;
         cfg.phys_addr = hnd->paddr;
-
-        if (layer.acquireFenceFd >= 0) {
-            if (sync_wait(layer.acquireFenceFd, 1000) < 0)
-                ALOGW("sync_wait error");
-
-            close(layer.acquireFenceFd);
-            layer.acquireFenceFd = -1;
-
-            cfg.fence_fd = -1;
-        }
+        wait_acquire_fence(layer, cfg);
     }
 }
 
@@ -1037,6 +1256,8 @@ static int post_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
     unsigned int window;
     struct s3c_fb_win_config_data win_data;
     struct s3c_fb_win_config *config = win_data.config;
+    bool reuse_cfg = ctx->layer_cache.cfg_valid;
+    bool cacheable = true;
     int err;
 
     memset(config, 0, sizeof(win_data.config));
@@ -1067,6 +1288,7 @@ static int post_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
                 if (err < 0) {
                     ALOGE("failed to perform FIMG for layer %u", i);
                     win.gsc.mode = gsc_map_t::NONE;
+                    cacheable = false;
                     continue;
                 }
 
@@ -1089,6 +1311,7 @@ static int post_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
                 if (err < 0) {
                     ALOGE("failed to perform FIMC for layer %u", i);
                     win.gsc.mode = gsc_map_t::NONE;
+                    cacheable = false;
                     continue;
                 }
 
@@ -1111,6 +1334,11 @@ static int post_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
                 }
                 break;
             case gsc_map_t::NONE:
+                if (reuse_cfg) {
+                    reuse_overlay_config(win, layer, config[window]);
+                    ctx->layer_cache.cfg_reuses++;
+                    break;
+                }
                 config_overlay(ctx, layer, config[window]);
                 config[window].stride = EXYNOS4_ALIGN(config[window].w, 16) * 4;
             default:
@@ -1130,6 +1358,29 @@ static int post_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
         memcpy(&win.win_cfg, &config[window], sizeof(struct s3c_fb_win_config));
     }
 
+    for (size_t i = 0; i < NUM_HW_WINDOWS; i++) {
+        struct hwc_win_info_t &win = ctx->win[i];
+
+        if (win.fimg_ticket == FIMG_ASYNC_NO_TICKET)
+            continue;
+
+        err = waitFimgApiAsync(win.fimg_ticket, 1000);
+        if (err == -ETIMEDOUT) {
+            // FIMG may still be writing it, keep the buffer out of rotation until done
+            win.dst_buf_ticket[win.current_buf] = win.fimg_ticket;
+            win.current_buf = (win.current_buf + 1) % NUM_OF_WIN_BUF;
+        }
+        win.fimg_ticket = FIMG_ASYNC_NO_TICKET;
+        if (err < 0) {
+            ALOGE("FIMG blit for window %u failed (%d), disabling it", i, err);
+            memset(&config[i], 0, sizeof(struct s3c_fb_win_config));
+            config[i].fence_fd = -1;
+            memcpy(&win.win_cfg, &config[i], sizeof(struct s3c_fb_win_config));
+            win.gsc.mode = gsc_map_t::NONE;
+            cacheable = false;
+        }
+    }
+
     dump_fb_win_cfg(win_data);
 
     int wincfg_err = ioctl(ctx->fb0_fd, S3CFB_WIN_CONFIG, &win_data);
@@ -1141,9 +1392,12 @@ static int post_fimd(hwc_context_t *ctx, hwc_display_contents_1_t* contents)
 
     if (wincfg_err < 0) {
         ALOGE("%s S3CFB_WIN_CONFIG failed: %s", __FUNCTION__, strerror(errno));
+        ctx->layer_cache.cfg_valid = false;
         return wincfg_err;
     }
 
+    ctx->layer_cache.cfg_valid = ctx->layer_cache.valid && cacheable;
+
     return win_data.fence;
 }
 
@@ -1179,6 +1433,7 @@ static int set_fimd(hwc_context_t *ctx, hwc_display_contents_1_t *contents)
 
     if (err) {
         ALOGV("%s about to clear window", __FUNCTION__);
+        ctx->layer_cache.cfg_valid = false;
         fence = window_clear(ctx);
     }
 
@@ -1228,6 +1483,9 @@ static int hwc_set(hwc_composer_device_1_t *dev,
     if (fimd_err)
         return fimd_err;
 
+    if (fimd_contents)
+        hwc_vsync_post(ctx);
+
     return 0;
 }
 
@@ -1272,6 +1530,9 @@ static int hwc_eventControl(struct hwc_composer_device_1* dev, __unused int dpy,
                 strerror(errno));
             return -errno;
         }
+        // the first event after a restart carries the last old timestamp
+        if (enabled)
+            hwc_vsync_resync(ctx);
         return rc;
     }
     return -EINVAL;
@@ -1285,6 +1546,8 @@ static int hwc_setPowerMode(struct hwc_composer_device_1 *dev, int dpy, int mode
 
     ALOGV("%s mode=%d", __FUNCTION__, mode);
 
+    layer_cache_invalidate(ctx);
+    hwc_vsync_resync(ctx);
     fence = window_clear(ctx);
     if (fence != -1)
         close(fence);
@@ -1434,6 +1697,16 @@ static void hwc_dump(struct hwc_composer_device_1* dev, char *buff, int buff_len
     android::String8 tmp("");
     tmp.appendFormat("Exynos HWC: force_fb=%d force_gpu=%d bypass_count=%d multi_fimg=%d\n", ctx->force_fb, ctx->force_gpu,
             ctx->bypass_count, ctx->multi_fimg);
+    tmp.appendFormat("layer cache: hits=%llu moves=%llu misses=%llu config reuses=%llu hash=0x%08x%s\n",
+            (unsigned long long) ctx->layer_cache.hits,
+            (unsigned long long) ctx->layer_cache.moves,
+            (unsigned long long) ctx->layer_cache.misses,
+            (unsigned long long) ctx->layer_cache.cfg_reuses,
+            ctx->layer_cache.hash, ctx->layer_cache.valid ? "" : " (invalid)");
+    tmp.appendFormat("bandwidth: %llu bytes/frame, %llu window pixels, %u assignments costed%s\n",
+            (unsigned long long) ctx->bw_result.bytes,
+            (unsigned long long) ctx->bw_result.pixels,
+            ctx->bw_result.evaluated, ctx->bw_record ? " (recording)" : "");
     tmp.appendFormat("win | mode | layer_index |    paddr    |     hnd     | alpha |\n");
     //                3-- | 4--- | 11--------- | 0x100000000 | 0x100000000 |  255  |
     int fimc_win = -1;
@@ -1467,7 +1740,11 @@ static void hwc_dump(struct hwc_composer_device_1* dev, char *buff, int buff_len
                 cfg->phys_addr, cfg->offset, cfg->stride, cfg->format, cfg->blending, cfg->plane_alpha);
     }
 
+    tmp.append("\n");
+    hwc_vsync_dump(ctx, tmp);
+
     ctx->multi_fimg = property_get_int32("persist.sys.hwc.multi_fimg", 0);
+    ctx->bw_record = property_get_int32("debug.hwc.bw_record", 0);
     strlcpy(buff, tmp.string(), buff_len);
 }
 
@@ -1532,8 +1809,8 @@ static int hwc_device_open(const struct hw_module_t* module, const char* name,
         property_get("persist.sys.hwc.multi_fimg", value, "0");
         dev->multi_fimg = atoi(value);
 
-        // Init Vsync
-        init_vsync_thread(dev);
+        property_get("debug.hwc.bw_record", value, "0");
+        dev->bw_record = atoi(value);
 
         // query LCD info
         dev->fb0_fd = open("/dev/graphics/fb0", O_RDWR);
@@ -1600,6 +1877,7 @@ static int hwc_device_open(const struct hw_module_t* module, const char* name,
 
             for (j = 0; j < NUM_OF_WIN_BUF; j++) {
                 win->dst_buf_fence[j] = -1;
+                win->dst_buf_ticket[j] = FIMG_ASYNC_NO_TICKET;
             }
         }
 
@@ -1612,6 +1890,9 @@ static int hwc_device_open(const struct hw_module_t* module, const char* name,
             dev->win[i].fimg_cmd.op = (enum blit_op) -1;
         }
 
+        // Init Vsync, once the nominal period is known
+        init_vsync_thread(dev);
+
         status = 0;
     }
     return status;
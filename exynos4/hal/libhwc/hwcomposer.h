@@ -51,6 +51,7 @@
 
 #include "window.h"
 #include "utils.h"
+#include "bandwidth.h"
 #include "v4l2.h"
 #include "FimgApi.h"
 
@@ -72,6 +73,7 @@ const size_t WIN_FB0 = 2;
 const size_t NUM_HW_WINDOWS = 5;
 const size_t NO_FB_NEEDED = NUM_HW_WINDOWS + 1;
 const size_t NUM_OF_WIN_BUF = 3;
+const size_t MAX_CACHED_LAYERS = 32;
 
 #define DEBUG 1
 #define DEBUG_SPAMMY 0
@@ -110,18 +112,98 @@ struct hwc_win_info_t {
     buffer_handle_t             dst_buf[NUM_OF_WIN_BUF];
     private_handle_t           *src_buf;
     int                         dst_buf_fence[NUM_OF_WIN_BUF];
+    unsigned int                dst_buf_ticket[NUM_OF_WIN_BUF]; // blit that timed out writing dst_buf[i]
     size_t                      current_buf;
 
     struct gsc_map_t            gsc;
     struct fimg2d_blit          fimg_cmd; //if geometry, blending hasn't changed, only buffers have to be swapped
     struct fimg2d_image         g2d_src_img;
     struct fimg2d_image         g2d_dst_img;
+    unsigned int                fimg_ticket; // queued blit, waited for before the post
     struct s3c_fb_win_config	win_cfg;
 
     int                         blending;
     int                         layer_index;
 };
 
+/*
+ * Everything prepare_fimd() looks at to decide a layer's composition type
+ * and window. Buffer handles and fences are left out, so frames that only
+ * flip buffers produce the same key. The geometry comes last so that the
+ * rest of the key can be compared on its own.
+ */
+struct hwc_layer_key_t {
+    int32_t                     type;   // BACKGROUND, FRAMEBUFFER_TARGET or 0
+    uint32_t                    flags;
+    uint32_t                    transform;
+    int32_t                     blending;
+    int32_t                     plane_alpha;
+    uint32_t                    background;
+
+    // from the buffer handle, format is -1 if there is no handle
+    int                         format;
+    int                         usage;
+    int                         width;
+    int                         height;
+    int                         stride;
+    int                         contiguous;
+
+    hwc_frect_t                 source_crop;
+    hwc_rect_t                  display_frame;
+};
+
+struct hwc_layer_cache_t {
+    bool                        valid;
+    bool                        cfg_valid;  // win[].win_cfg matches the cached assignment
+    uint32_t                    hash;
+    size_t                      num_layers;
+    bool                        force_fb;
+    bool                        multi_fimg;
+    struct hwc_layer_key_t      key[MAX_CACHED_LAYERS];
+
+    // result of the last full prepare
+    int32_t                     composition[MAX_CACHED_LAYERS];
+    int                         layer_index[NUM_HW_WINDOWS];
+    enum gsc_map_t::mode        gsc_mode[NUM_HW_WINDOWS];
+    bool                        fb_needed;
+    size_t                      first_fb;
+    size_t                      last_fb;
+    size_t                      fb_window;
+
+    uint64_t                    hits;
+    uint64_t                    moves;      // only layer positions changed, assignment kept
+    uint64_t                    misses;
+    uint64_t                    cfg_reuses;
+};
+
+struct hwc_vsync_model_t {
+    pthread_mutex_t             lock;
+    bool                        resync;     // next sample restarts the model
+    bool                        locked;     // period/phase can be used for prediction
+    bool                        filter;     // report filtered instead of raw timestamps
+    int                         lock_count; // consecutive accepted samples
+    int                         reject_run; // consecutive rejected samples
+    int64_t                     nominal_period;
+    int64_t                     period;     // filtered period (ns)
+    int64_t                     phase;      // filtered time of the last vsync (ns)
+    int64_t                     last_sample; // raw time of the last event read
+    int64_t                     offset;     // software vsync phase offset (ns)
+
+    uint64_t                    samples;
+    uint64_t                    rejected;
+    uint64_t                    missed;     // vsync events lost between two samples
+    uint64_t                    resyncs;
+    int64_t                     err_avg;    // running average of |error| (ns)
+    int64_t                     err_max;
+
+    // posts, measured against the predicted vsync grid
+    bool                        last_post_valid;
+    int64_t                     last_post;
+    uint64_t                    posts;
+    uint64_t                    late_posts; // a post that skipped at least one vsync
+    uint64_t                    skipped;    // vsyncs skipped by those posts
+};
+
 struct hwc_context_t {
     hwc_composer_device_1_t   device;
     /* our private state goes below here */
@@ -136,6 +218,7 @@ struct hwc_context_t {
     bool                      force_gpu; //value coming from settings
     bool                      force_fb;
     bool                      multi_fimg; // enable multiple fimg layers
+    bool                      bw_record;  // log every new layer stack for the host solver
     int                       bypass_count;
 
     struct hwc_win_info_t     win[NUM_HW_WINDOWS];
@@ -152,11 +235,18 @@ struct hwc_context_t {
     int       vsync_period;
     int       vsync_timestamp_fd;
     pthread_t vsync_thread;
+    struct hwc_vsync_model_t vsync;
 
     bool         fb_needed;
     size_t       first_fb;
     size_t       last_fb;
     size_t       fb_window;
+
+    // result of determineBandwidthSupport(), per layer
+    enum hwc_bw_path         bw_path[HWC_BW_MAX_LAYERS];
+    struct hwc_bw_result_t   bw_result;
+
+    struct hwc_layer_cache_t layer_cache;
 };
 
 #endif //ANDROID_HWCOMPOSER_H
@@ -22,6 +22,7 @@
 #include <utils/threads.h>
 
 #include <sys/prctl.h>
+#include <time.h>
 
 /*****************************************************************************/
 
@@ -29,6 +30,138 @@
 
 #define VSYNC_TIME_PATH "/sys/devices/platform/samsung-pd.2/s3cfb.0/vsync_time"
 
+// samples further than period / VSYNC_REJECT_DIV from the predicted grid are jitter
+#define VSYNC_REJECT_DIV    4
+// this many rejected samples in a row mean the grid itself moved
+#define VSYNC_MAX_REJECTS   4
+// a gap longer than this many periods is an interrupt that was off, not lost vsyncs
+#define VSYNC_MAX_GAP       8
+// accepted samples needed before the model is used for prediction
+#define VSYNC_LOCK_SAMPLES  8
+// loop gains: phase follows 1/4 of the error, period 1/64 of the error per period
+#define VSYNC_PHASE_GAIN    4
+#define VSYNC_PERIOD_GAIN   64
+// the filtered period never leaves nominal +- nominal / VSYNC_PERIOD_RANGE
+#define VSYNC_PERIOD_RANGE  10
+
+/*****************************************************************************/
+
+static inline int64_t vsync_abs(int64_t v)
+{
+    return v < 0 ? -v : v;
+}
+
+static int64_t vsync_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void vsync_sleep_until(int64_t when)
+{
+    struct timespec ts;
+    ts.tv_sec = when / 1000000000LL;
+    ts.tv_nsec = when % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
+
+// number of the vsync interval that contains when, counted from the model's phase
+static int64_t vsync_index(const struct hwc_vsync_model_t *m, int64_t when)
+{
+    if (when >= m->phase)
+        return (when - m->phase) / m->period;
+    return -((m->phase - when + m->period - 1) / m->period);
+}
+
+// the grid point a sample is matched to, never before the model's phase
+static int64_t vsync_grid_point(const struct hwc_vsync_model_t *m, int64_t when)
+{
+    int64_t n = (when - m->phase + m->period / 2) / m->period;
+    if (n < 1)
+        n = 1;
+    return m->phase + n * m->period;
+}
+
+static void vsync_model_restart(struct hwc_vsync_model_t *m, int64_t timestamp)
+{
+    m->phase = timestamp;
+    m->last_sample = timestamp;
+    m->locked = false;
+    m->lock_count = 0;
+    m->reject_run = 0;
+    m->resync = false;
+    m->last_post_valid = false;
+    m->resyncs++;
+}
+
+/*
+ * Feed one hardware vsync timestamp into the model. This is a second order
+ * loop: the sample is matched to the nearest point of the predicted grid
+ * phase + n * period, and the error pulls both the phase and the period.
+ * Returns false when the sample was rejected as jitter.
+ */
+static bool vsync_model_update(struct hwc_vsync_model_t *m, int64_t timestamp)
+{
+    m->samples++;
+
+    if (m->resync || m->phase == 0) {
+        vsync_model_restart(m, timestamp);
+        return true;
+    }
+
+    int64_t delta = timestamp - m->phase;
+    if (delta <= 0) {
+        // same event read twice, or an event from before the last restart
+        m->rejected++;
+        return false;
+    }
+
+    int64_t n = (delta + m->period / 2) / m->period;
+    if (n < 1)
+        n = 1;
+    if (n > VSYNC_MAX_GAP) {
+        vsync_model_restart(m, timestamp);
+        return true;
+    }
+
+    // lost events are counted against the previous event, accepted or not
+    int64_t lost = (timestamp - m->last_sample + m->period / 2) / m->period - 1;
+    if (lost > 0)
+        m->missed += lost;
+    m->last_sample = timestamp;
+
+    int64_t predicted = m->phase + n * m->period;
+    int64_t err = timestamp - predicted;
+
+    if (vsync_abs(err) > m->period / VSYNC_REJECT_DIV) {
+        m->rejected++;
+        if (++m->reject_run >= VSYNC_MAX_REJECTS)
+            vsync_model_restart(m, timestamp);
+        return false;
+    }
+
+    m->reject_run = 0;
+
+    m->phase = predicted + err / VSYNC_PHASE_GAIN;
+    m->period += err / (n * VSYNC_PERIOD_GAIN);
+
+    int64_t range = m->nominal_period / VSYNC_PERIOD_RANGE;
+    if (vsync_abs(m->period - m->nominal_period) > range)
+        m->period = m->nominal_period;
+
+    m->err_avg += (vsync_abs(err) - m->err_avg) / 16;
+    if (vsync_abs(err) > m->err_max)
+        m->err_max = vsync_abs(err);
+
+    if (m->lock_count < VSYNC_LOCK_SAMPLES)
+        m->lock_count++;
+    m->locked = m->lock_count >= VSYNC_LOCK_SAMPLES;
+
+    return true;
+}
+
 /*****************************************************************************/
 
 static void *hwc_vsync_thread(void *data)
@@ -54,12 +187,39 @@ static void *hwc_vsync_thread(void *data)
     do {
         ssize_t len = read(ctx->vsync_timestamp_fd, buf, sizeof(buf));
         timestamp = strtoull(buf, NULL, 0);
-        if (ctx->procs) {
-            if (DEBUG_VSYNC) {
-                ALOGD("%s: handling vsync, timestamp:%lld", __FUNCTION__, timestamp);
+
+        struct hwc_vsync_model_t *m = &ctx->vsync;
+        int64_t raw = timestamp;
+        int64_t wakeup = 0;
+
+        pthread_mutex_lock(&m->lock);
+        bool accepted = vsync_model_update(m, raw);
+        if (m->locked) {
+            // a rejected sample leaves the phase behind: use the grid point it stands for
+            int64_t vsync = accepted ? m->phase : vsync_grid_point(m, raw);
+            if (m->filter)
+                timestamp = vsync;
+            if (m->offset) {
+                // software vsync: report the model's vsync shifted by offset
+                timestamp = vsync + m->offset;
+                if (m->offset < 0)
+                    timestamp += m->period;
+                wakeup = timestamp;
             }
-            ctx->procs->vsync(ctx->procs, 0, timestamp);
         }
+        pthread_mutex_unlock(&m->lock);
+
+        if (DEBUG_VSYNC) {
+            ALOGD("%s: raw:%lld reported:%lld%s", __FUNCTION__,
+                    raw, timestamp, accepted ? "" : " (rejected)");
+        }
+
+        if (wakeup)
+            vsync_sleep_until(wakeup);
+
+        if (ctx->procs)
+            ctx->procs->vsync(ctx->procs, 0, timestamp);
+
         select(ctx->vsync_timestamp_fd + 1, NULL, NULL, &exceptfds, NULL);
         lseek(ctx->vsync_timestamp_fd, 0, SEEK_SET);
     } while (1);
@@ -73,6 +233,18 @@ void init_vsync_thread(hwc_context_t* ctx)
 
     ALOGD("Initializing VSYNC Thread: " HWC_VSYNC_THREAD_NAME);
 
+    struct hwc_vsync_model_t *m = &ctx->vsync;
+    pthread_mutex_init(&m->lock, NULL);
+    m->nominal_period = ctx->vsync_period;
+    m->period = ctx->vsync_period;
+    m->resync = true;
+    m->filter = property_get_int32("debug.hwc.vsync_filter", 1) != 0;
+    m->offset = property_get_int64("debug.hwc.vsync_offset_ns", 0);
+    if (vsync_abs(m->offset) >= m->period) {
+        ALOGW("%s: vsync offset %lld out of range, ignored", __FUNCTION__, m->offset);
+        m->offset = 0;
+    }
+
     ret = pthread_create(&ctx->vsync_thread, NULL, hwc_vsync_thread, (void*) ctx);
     if (ret) {
         ALOGE("%s: failed to create %s: %s", __FUNCTION__,
@@ -85,4 +257,74 @@ void close_vsync_thread(hwc_context_t* ctx)
     pthread_kill(ctx->vsync_thread, SIGTERM);
     pthread_join(ctx->vsync_thread, NULL);
     close(ctx->vsync_timestamp_fd);
+    pthread_mutex_destroy(&ctx->vsync.lock);
+}
+
+void hwc_vsync_resync(hwc_context_t* ctx)
+{
+    pthread_mutex_lock(&ctx->vsync.lock);
+    ctx->vsync.resync = true;
+    pthread_mutex_unlock(&ctx->vsync.lock);
+}
+
+int64_t hwc_vsync_predict(hwc_context_t* ctx, int64_t when)
+{
+    struct hwc_vsync_model_t *m = &ctx->vsync;
+    int64_t next = 0;
+
+    pthread_mutex_lock(&m->lock);
+    if (m->locked && when > m->phase) {
+        int64_t n = (when - m->phase + m->period - 1) / m->period;
+        next = m->phase + n * m->period;
+    } else if (m->locked) {
+        next = m->phase;
+    }
+    pthread_mutex_unlock(&m->lock);
+
+    return next;
+}
+
+/*
+ * Account one post against the predicted vsync grid. Two posts that land in
+ * consecutive vsync intervals are on time; a post that skipped one or more
+ * intervals after a recent post means the compositor missed those vsyncs.
+ * Longer gaps are an idle screen and are not counted.
+ */
+void hwc_vsync_post(hwc_context_t* ctx)
+{
+    struct hwc_vsync_model_t *m = &ctx->vsync;
+    int64_t now = vsync_now();
+
+    pthread_mutex_lock(&m->lock);
+    m->posts++;
+    if (m->locked && m->last_post_valid) {
+        // both posts are placed on the current grid, the phase moved since
+        int64_t gap = vsync_index(m, now) - vsync_index(m, m->last_post);
+        if (gap > 1 && gap <= VSYNC_MAX_GAP / 2) {
+            m->late_posts++;
+            m->skipped += gap - 1;
+        }
+    }
+    m->last_post = now;
+    m->last_post_valid = m->locked;
+    pthread_mutex_unlock(&m->lock);
+}
+
+void hwc_vsync_dump(hwc_context_t* ctx, android::String8& result)
+{
+    struct hwc_vsync_model_t *m = &ctx->vsync;
+    int64_t next = hwc_vsync_predict(ctx, vsync_now());
+
+    pthread_mutex_lock(&m->lock);
+    result.appendFormat("vsync: period=%lld ns (nominal %lld) phase=%lld next=%lld offset=%lld %s%s\n",
+            m->period, m->nominal_period, m->phase, next, m->offset,
+            m->locked ? "locked" : "unlocked", m->filter ? " filtered" : "");
+    result.appendFormat("vsync: samples=%llu rejected=%llu missed=%llu resyncs=%llu error avg=%lld max=%lld ns\n",
+            (unsigned long long) m->samples, (unsigned long long) m->rejected,
+            (unsigned long long) m->missed, (unsigned long long) m->resyncs,
+            m->err_avg, m->err_max);
+    result.appendFormat("posts: total=%llu late=%llu skipped vsyncs=%llu\n",
+            (unsigned long long) m->posts, (unsigned long long) m->late_posts,
+            (unsigned long long) m->skipped);
+    pthread_mutex_unlock(&m->lock);
 }
@@ -22,7 +22,17 @@
 
 #include "hwcomposer.h"
 
+#include <utils/String8.h>
+
 void init_vsync_thread(hwc_context_t* ctx);
 void close_vsync_thread(hwc_context_t* ctx);
 
+// restart period/phase tracking, e.g. after the panel was off
+void hwc_vsync_resync(hwc_context_t* ctx);
+// predicted vsync time at or after when, 0 while the model is not locked
+int64_t hwc_vsync_predict(hwc_context_t* ctx, int64_t when);
+// account a post for the missed frame statistics
+void hwc_vsync_post(hwc_context_t* ctx);
+void hwc_vsync_dump(hwc_context_t* ctx, android::String8& result);
+
 #endif // HWCOMPOSER_VSYNC_H
@@ -143,9 +143,33 @@ err_alloc:
     return rc;
 }
 
+/*
+ * Makes current_buf a destination buffer no timed out blit is still writing,
+ * -1 if there is none this frame.
+ */
+int window_buffer_select(struct hwc_win_info_t *win)
+{
+    for (size_t n = 0; n < NUM_OF_WIN_BUF; n++) {
+        unsigned int *ticket = &win->dst_buf_ticket[win->current_buf];
+
+        if (*ticket == FIMG_ASYNC_NO_TICKET || isDoneFimgApiAsync(*ticket)) {
+            *ticket = FIMG_ASYNC_NO_TICKET;
+            return 0;
+        }
+        win->current_buf = (win->current_buf + 1) % NUM_OF_WIN_BUF;
+    }
+
+    return -1;
+}
+
 int window_buffer_deallocate(struct hwc_context_t *ctx, struct hwc_win_info_t *win)
 {
     for (size_t i = 0; i < NUM_OF_WIN_BUF; i++) {
+        if (win->dst_buf_ticket[i] != FIMG_ASYNC_NO_TICKET) {
+            waitFimgApiAsync(win->dst_buf_ticket[i], -1);
+            win->dst_buf_ticket[i] = FIMG_ASYNC_NO_TICKET;
+        }
+
         if (win->dst_buf_fence[i] >= 0) {
             close(win->dst_buf_fence[i]);
             win->dst_buf_fence[i] = -1;
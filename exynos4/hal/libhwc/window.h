@@ -24,6 +24,7 @@ int window_clear(struct hwc_context_t *ctx);
 
 int window_buffer_allocate(struct hwc_context_t *ctx, struct hwc_win_info_t *win);
 int window_buffer_deallocate(struct hwc_context_t *ctx, struct hwc_win_info_t *win);
+int window_buffer_select(struct hwc_win_info_t *win);
 
 void config_handle(struct hwc_context_t* ctx, const hwc_layer_1_t &layer, s3c_fb_win_config &cfg);
 
@@ -20,6 +20,13 @@
 #include "HardwareConverter.h"
 
 HardwareConverter::HardwareConverter()
+    : mConfigValid(false),
+      mWidth(0),
+      mHeight(0),
+      mSrcFormat(0),
+      mDstFormat(0),
+      mFrames(0),
+      mSetups(0)
 {
     SecFimc* handle_fimc = new SecFimc();
     mSecFimc = (void *)handle_fimc;
@@ -33,6 +40,8 @@ HardwareConverter::HardwareConverter()
 HardwareConverter::~HardwareConverter()
 {
     SecFimc* handle_fimc = (SecFimc*)mSecFimc;
+
+    ALOGD("%s:: converted %u frames, %u setups", __func__, mFrames, mSetups);
     handle_fimc->destroy();
     delete handle_fimc;
 }
@@ -64,14 +73,46 @@ bool HardwareConverter::convert(
     unsigned int src_har_format = OMXtoHarPixelFomrat(src_format);
     unsigned int dst_har_format = OMXtoHarPixelFomrat(dst_format);
 
-    // set post processor configuration
-    if (!handle_fimc->setSrcParams(width, height, src_crop_x, src_crop_y,
-                                   &src_crop_width, &src_crop_height,
-                                   src_har_format)) {
-        ALOGE("%s:: setSrcParms() failed", __func__);
+    if (bHWconvert_flag == 0)
         return false;
+
+    // identical geometry and formats only need new addresses
+    if (mConfigValid == false ||
+        mWidth != width || mHeight != height ||
+        mSrcFormat != src_har_format || mDstFormat != dst_har_format) {
+        mConfigValid = false;
+
+        // set post processor configuration
+        if (!handle_fimc->setSrcParams(width, height, src_crop_x, src_crop_y,
+                                       &src_crop_width, &src_crop_height,
+                                       src_har_format)) {
+            ALOGE("%s:: setSrcParms() failed", __func__);
+            return false;
+        }
+
+        if (!handle_fimc->setRotVal(rotate_value)) {
+            ALOGE("%s:: setRotVal() failed", __func__);
+            return false;
+        }
+
+        if (!handle_fimc->setDstParams(width, height, dst_crop_x, dst_crop_y,
+                                       &dst_crop_width, &dst_crop_height,
+                                       dst_har_format)) {
+            ALOGE("%s:: setDstParams() failed", __func__);
+            return false;
+        }
+
+        mWidth = width;
+        mHeight = height;
+        mSrcFormat = src_har_format;
+        mDstFormat = dst_har_format;
+        mConfigValid = true;
+        mSetups++;
     }
 
+    // any failure below leaves FIMC in an unknown state, set it up again
+    mConfigValid = false;
+
     if (!handle_fimc->setSrcPhyAddr((unsigned int)src_addr_array[0],
                                  (unsigned int)src_addr_array[1],
                                  (unsigned int)src_addr_array[1],
@@ -80,18 +121,6 @@ bool HardwareConverter::convert(
         return false;
     }
 
-    if (!handle_fimc->setRotVal(rotate_value)) {
-        ALOGE("%s:: setRotVal() failed", __func__);
-        return false;
-    }
-
-    if (!handle_fimc->setDstParams(width, height, dst_crop_x, dst_crop_y,
-                                   &dst_crop_width, &dst_crop_height,
-                                   dst_har_format)) {
-        ALOGE("%s:: setDstParams() failed", __func__);
-        return false;
-    }
-
     switch (dst_format) {
     case OMX_COLOR_FormatYUV420SemiPlanar:
         if (!handle_fimc->setDstPhyAddr((unsigned int)(dst_addr_array[0]),
@@ -118,6 +147,8 @@ bool HardwareConverter::convert(
         return false;
     }
 
+    mConfigValid = true;
+    mFrames++;
     return true;
 }
 
@@ -132,6 +163,12 @@ unsigned int HardwareConverter::OMXtoHarPixelFomrat(OMX_COLOR_FORMATTYPE omx_for
     case OMX_COLOR_FormatYUV420SemiPlanar:
         hal_format = HAL_PIXEL_FORMAT_YCbCr_420_SP;
         break;
+    case OMX_COLOR_Format32bitARGB8888:
+        hal_format = HAL_PIXEL_FORMAT_RGBA_8888;
+        break;
+    case OMX_COLOR_Format32bitBGRA8888:
+        hal_format = HAL_PIXEL_FORMAT_BGRA_8888;
+        break;
 /*
     case OMX_SEC_COLOR_FormatNV12TPhysicalAddress:
         hal_format = HAL_PIXEL_FORMAT_CUSTOM_YCbCr_420_SP_TILED;
@@ -34,6 +34,14 @@ public:
     bool bHWconvert_flag;
 private:
     void *mSecFimc;
+    /* geometry and formats FIMC is set up for, see convert() */
+    bool mConfigValid;
+    int32_t mWidth;
+    int32_t mHeight;
+    unsigned int mSrcFormat;
+    unsigned int mDstFormat;
+    unsigned int mFrames;
+    unsigned int mSetups;
     unsigned int OMXtoHarPixelFomrat(OMX_COLOR_FORMATTYPE omx_format);
 };
 
@@ -33,3 +33,39 @@ LOCAL_MODULE:= libhwjpeg
 LOCAL_MODULE_TAGS := eng
 
 include $(BUILD_SHARED_LIBRARY)
+
+# the same job queue with jpeg_fake.c for a device, for host tests
+include $(CLEAR_VARS)
+
+LOCAL_C_INCLUDES := $(LOCAL_PATH) \
+	$(LOCAL_PATH)/../include
+
+LOCAL_SRC_FILES:= \
+	jpeg_hal_unit.cpp \
+	jpeg_fake.c \
+
+LOCAL_MODULE:= libhwjpeg_fake
+
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_STATIC_LIBRARY)
+
+include $(CLEAR_VARS)
+
+LOCAL_C_INCLUDES := $(LOCAL_PATH) \
+	$(LOCAL_PATH)/../include
+
+LOCAL_SRC_FILES:= \
+	jpeg_queue_test.cpp \
+
+LOCAL_STATIC_LIBRARIES := \
+	libhwjpeg_fake \
+	liblog \
+
+LOCAL_LDLIBS += -lpthread
+
+LOCAL_MODULE:= jpeg_queue_test
+
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_HOST_EXECUTABLE)
@@ -0,0 +1,503 @@
+/*
+ * Copyright@ Samsung Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Fake JPEG node for host tests. One instance at a time; a worker thread
+ * stands in for the hardware and takes job_time per buffer pair, in queue
+ * order, like the m2m framework does. Nothing is really coded: the output
+ * is an SOI marker followed by the first four bytes of the input, and its
+ * size is 6 plus those four bytes modulo 1024, so every output can be
+ * matched to its input. Buffers are single-plane.
+ */
+
+#define LOG_TAG "libhwjpeg_fake"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <log/log.h>
+
+#include "jpeg_hal.h"
+#include "jpeg_fake.h"
+
+#define FAKE_JPEG_FD        0x4a5047
+#define FAKE_MAX_BUFS       16
+
+struct fake_buf {
+    void *mem;
+    size_t len;
+    int mapped;                 /* mem belongs to the fake, not a USERPTR */
+    unsigned int bytesused;
+    unsigned int flags;
+};
+
+struct fake_fifo {
+    int v[FAKE_MAX_BUFS];
+    int head;
+    int n;
+};
+
+struct fake_queue {
+    struct fake_buf buf[FAKE_MAX_BUFS];
+    unsigned int count;
+    size_t size;                /* from S_FMT */
+    int on;
+    struct fake_fifo queued;
+    struct fake_fifo done;
+};
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t thread;
+    int opened;
+    int nonblock;
+    int exiting;
+
+    unsigned int job_time;
+    int no_payload;
+    unsigned long fail_request;
+    enum v4l2_buf_type fail_type;
+    unsigned int last_size;
+    struct fake_queue src;
+    struct fake_queue dst;
+    struct jpeg_fake_stats stats;
+} s_fake = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+};
+
+static void fifo_push(struct fake_fifo *f, int v)
+{
+    f->v[(f->head + f->n) % FAKE_MAX_BUFS] = v;
+    f->n++;
+}
+
+static int fifo_pop(struct fake_fifo *f)
+{
+    int v = f->v[f->head];
+
+    f->head = (f->head + 1) % FAKE_MAX_BUFS;
+    f->n--;
+    return v;
+}
+
+static struct fake_queue *fake_queue(enum v4l2_buf_type type)
+{
+    return (type == V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE) ? &s_fake.src : &s_fake.dst;
+}
+
+static void fake_free(struct fake_queue *q)
+{
+    unsigned int i;
+
+    for (i = 0; i < q->count; i++) {
+        if (q->buf[i].mapped && q->buf[i].mem != NULL)
+            munmap(q->buf[i].mem, q->buf[i].len);
+        memset(&q->buf[i], 0, sizeof(struct fake_buf));
+    }
+    q->count = 0;
+}
+
+/* codes one pair; lock held, dropped while the "hardware" is busy */
+static void fake_job(struct fake_buf *src, struct fake_buf *dst)
+{
+    struct timeval t1, t2;
+    unsigned char tag[4] = { 0, 0, 0, 0 };
+    unsigned int size;
+
+    pthread_mutex_unlock(&s_fake.lock);
+    gettimeofday(&t1, NULL);
+    if (s_fake.job_time)
+        usleep(s_fake.job_time);
+
+    if (src->mem != NULL)
+        memcpy(tag, src->mem, (src->len < 4) ? src->len : 4);
+    size = 6 + ((tag[0] | tag[1] << 8 | tag[2] << 16 | (unsigned int)tag[3] << 24) % 1024);
+
+    if (dst->mem != NULL && dst->len >= size) {
+        ((unsigned char *)dst->mem)[0] = 0xff;
+        ((unsigned char *)dst->mem)[1] = 0xd8;
+        memcpy((unsigned char *)dst->mem + 2, tag, 4);
+        dst->bytesused = size;
+        dst->flags = 0;
+    } else {
+        dst->bytesused = 0;
+        dst->flags = V4L2_BUF_FLAG_ERROR;
+    }
+    src->flags = dst->flags;
+
+    gettimeofday(&t2, NULL);
+    pthread_mutex_lock(&s_fake.lock);
+
+    s_fake.stats.busy_us += (t2.tv_sec - t1.tv_sec) * 1000000ULL + t2.tv_usec - t1.tv_usec;
+    s_fake.last_size = dst->bytesused;
+}
+
+static void *fake_hw_thread(void *arg)
+{
+    int src, dst;
+
+    pthread_mutex_lock(&s_fake.lock);
+    while (!s_fake.exiting) {
+        if (!s_fake.src.on || !s_fake.dst.on ||
+            s_fake.src.queued.n == 0 || s_fake.dst.queued.n == 0) {
+            pthread_cond_wait(&s_fake.cond, &s_fake.lock);
+            continue;
+        }
+
+        src = s_fake.src.queued.v[s_fake.src.queued.head];
+        dst = s_fake.dst.queued.v[s_fake.dst.queued.head];
+
+        fake_job(&s_fake.src.buf[src], &s_fake.dst.buf[dst]);
+
+        /* streamed off while busy: the buffers went back already */
+        if (!s_fake.src.on || !s_fake.dst.on)
+            continue;
+
+        fifo_pop(&s_fake.src.queued);
+        fifo_pop(&s_fake.dst.queued);
+        fifo_push(&s_fake.src.done, src);
+        fifo_push(&s_fake.dst.done, dst);
+        s_fake.stats.jobs++;
+        pthread_cond_broadcast(&s_fake.cond);
+    }
+    pthread_mutex_unlock(&s_fake.lock);
+
+    return NULL;
+}
+
+void jpeg_fake_set_job_time(unsigned int usec)
+{
+    s_fake.job_time = usec;
+}
+
+void jpeg_fake_set_payload(int on)
+{
+    s_fake.no_payload = !on;
+}
+
+void jpeg_fake_fail_next(unsigned long request, enum v4l2_buf_type type)
+{
+    pthread_mutex_lock(&s_fake.lock);
+    s_fake.fail_request = request;
+    s_fake.fail_type = type;
+    pthread_mutex_unlock(&s_fake.lock);
+}
+
+void jpeg_fake_get_stats(struct jpeg_fake_stats *stats)
+{
+    pthread_mutex_lock(&s_fake.lock);
+    *stats = s_fake.stats;
+    pthread_mutex_unlock(&s_fake.lock);
+}
+
+static int fake_open(const char *path, int flags)
+{
+    pthread_mutex_lock(&s_fake.lock);
+    if (s_fake.opened) {
+        pthread_mutex_unlock(&s_fake.lock);
+        errno = EBUSY;
+        return -1;
+    }
+
+    s_fake.opened = 1;
+    s_fake.nonblock = (flags & O_NONBLOCK) != 0;
+    s_fake.exiting = 0;
+    s_fake.last_size = 0;
+    memset(&s_fake.src, 0, sizeof(struct fake_queue));
+    memset(&s_fake.dst, 0, sizeof(struct fake_queue));
+    memset(&s_fake.stats, 0, sizeof(s_fake.stats));
+    pthread_create(&s_fake.thread, NULL, fake_hw_thread, NULL);
+    pthread_mutex_unlock(&s_fake.lock);
+
+    return FAKE_JPEG_FD;
+}
+
+static int fake_close(int fd)
+{
+    if (fd != FAKE_JPEG_FD)
+        return close(fd);
+
+    pthread_mutex_lock(&s_fake.lock);
+    s_fake.exiting = 1;
+    pthread_cond_broadcast(&s_fake.cond);
+    pthread_mutex_unlock(&s_fake.lock);
+    pthread_join(s_fake.thread, NULL);
+
+    fake_free(&s_fake.src);
+    fake_free(&s_fake.dst);
+    s_fake.opened = 0;
+
+    return 0;
+}
+
+static void *fake_mmap(void *addr, size_t len, int prot, int flags, int fd, off_t offset)
+{
+    struct fake_queue *q = (offset & (1 << 24)) ? &s_fake.dst : &s_fake.src;
+    unsigned int index = (offset >> 12) & 0xff;
+
+    if (fd != FAKE_JPEG_FD)
+        return mmap(addr, len, prot, flags, fd, offset);
+
+    return (index < q->count && q->buf[index].mapped) ? q->buf[index].mem : MAP_FAILED;
+}
+
+static int fake_munmap(void *addr, size_t len)
+{
+    /* buffers belong to the fake device until REQBUFS or close */
+    return 0;
+}
+
+static int fake_reqbufs(struct v4l2_requestbuffers *req)
+{
+    struct fake_queue *q = fake_queue((enum v4l2_buf_type)req->type);
+    unsigned int i;
+
+    if (q->on)
+        return -EBUSY;
+
+    fake_free(q);
+    q->count = (req->count < FAKE_MAX_BUFS) ? req->count : FAKE_MAX_BUFS;
+    for (i = 0; i < q->count; i++) {
+        if (req->memory != V4L2_MEMORY_MMAP)
+            continue;
+        q->buf[i].len = q->size;
+        q->buf[i].mem = mmap(NULL, q->size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (q->buf[i].mem == MAP_FAILED) {
+            q->buf[i].mem = NULL;
+            return -ENOMEM;
+        }
+        q->buf[i].mapped = 1;
+    }
+    req->count = q->count;
+
+    return 0;
+}
+
+static int fake_querybuf(struct v4l2_buffer *buf)
+{
+    struct fake_queue *q = fake_queue((enum v4l2_buf_type)buf->type);
+
+    if (buf->m.planes == NULL || buf->index >= q->count || !q->buf[buf->index].mapped)
+        return -EINVAL;
+
+    buf->m.planes[0].length = q->buf[buf->index].len;
+    buf->m.planes[0].m.mem_offset = ((q == &s_fake.dst) << 24) | (buf->index << 12);
+
+    return 0;
+}
+
+static int fake_qbuf(struct v4l2_buffer *buf)
+{
+    struct fake_queue *q = fake_queue((enum v4l2_buf_type)buf->type);
+    struct fake_buf *b;
+    int i;
+
+    if (buf->m.planes == NULL || buf->index >= q->count)
+        return -EINVAL;
+
+    /* a buffer can only be queued once */
+    for (i = 0; i < q->queued.n; i++) {
+        if (q->queued.v[(q->queued.head + i) % FAKE_MAX_BUFS] == (int)buf->index)
+            return -EINVAL;
+    }
+
+    b = &q->buf[buf->index];
+    if (buf->memory == V4L2_MEMORY_USERPTR) {
+        b->mem = (void *)buf->m.planes[0].m.userptr;
+        b->len = buf->m.planes[0].length;
+    }
+    fifo_push(&q->queued, buf->index);
+
+    if (q == &s_fake.src && (unsigned int)q->queued.n > s_fake.stats.max_queued)
+        s_fake.stats.max_queued = q->queued.n;
+
+    pthread_cond_broadcast(&s_fake.cond);
+    return 0;
+}
+
+static int fake_dqbuf(struct v4l2_buffer *buf)
+{
+    struct fake_queue *q = fake_queue((enum v4l2_buf_type)buf->type);
+
+    if (buf->m.planes == NULL || buf->length < 1)
+        return -EINVAL;
+
+    /* blocking like vb2: until a buffer is done or the queue stops */
+    while (q->done.n == 0) {
+        if (s_fake.nonblock)
+            return -EAGAIN;
+        if (!q->on || q->queued.n == 0)
+            return -EINVAL;
+        pthread_cond_wait(&s_fake.cond, &s_fake.lock);
+    }
+
+    buf->index = fifo_pop(&q->done);
+    buf->flags = q->buf[buf->index].flags;
+    buf->m.planes[0].bytesused = (q == &s_fake.dst && !s_fake.no_payload) ?
+                                 q->buf[buf->index].bytesused : 0;
+
+    return 0;
+}
+
+static int fake_streamon(enum v4l2_buf_type type)
+{
+    struct fake_queue *q = fake_queue(type);
+
+    if (!q->on) {
+        q->on = 1;
+        s_fake.stats.streamons++;
+    }
+
+    pthread_cond_broadcast(&s_fake.cond);
+    return 0;
+}
+
+static int fake_streamoff(enum v4l2_buf_type type)
+{
+    struct fake_queue *q = fake_queue(type);
+
+    q->on = 0;
+    memset(&q->queued, 0, sizeof(struct fake_fifo));
+    memset(&q->done, 0, sizeof(struct fake_fifo));
+
+    pthread_cond_broadcast(&s_fake.cond);
+    return 0;
+}
+
+static int fake_ioctl(int fd, unsigned long request, void *arg)
+{
+    struct v4l2_format *fmt = (struct v4l2_format *)arg;
+    struct v4l2_control *ctrl = (struct v4l2_control *)arg;
+    struct fake_queue *q;
+    int ret = 0;
+
+    if (fd != FAKE_JPEG_FD)
+        return ioctl(fd, request, arg);
+
+    pthread_mutex_lock(&s_fake.lock);
+    if (request == s_fake.fail_request && request != 0 &&
+        ((struct v4l2_buffer *)arg)->type == s_fake.fail_type) {
+        s_fake.fail_request = 0;
+        pthread_mutex_unlock(&s_fake.lock);
+        errno = EIO;
+        return -1;
+    }
+
+    switch (request) {
+    case VIDIOC_QUERYCAP:
+        memset(arg, 0, sizeof(struct v4l2_capability));
+        ((struct v4l2_capability *)arg)->capabilities =
+            V4L2_CAP_VIDEO_CAPTURE | V4L2_CAP_VIDEO_OUTPUT | V4L2_CAP_STREAMING;
+        break;
+    case VIDIOC_S_FMT:
+        q = fake_queue((enum v4l2_buf_type)fmt->type);
+        if (q->on) {
+            ret = -EBUSY;
+            break;
+        }
+        q->size = fmt->fmt.pix_mp.plane_fmt[0].sizeimage;
+        if (q->size == 0)
+            q->size = fmt->fmt.pix_mp.width * fmt->fmt.pix_mp.height * 2;
+        break;
+    case VIDIOC_S_JPEGCOMP:
+        break;
+    case VIDIOC_REQBUFS:
+        ret = fake_reqbufs((struct v4l2_requestbuffers *)arg);
+        break;
+    case VIDIOC_QUERYBUF:
+        ret = fake_querybuf((struct v4l2_buffer *)arg);
+        break;
+    case VIDIOC_QBUF:
+        ret = fake_qbuf((struct v4l2_buffer *)arg);
+        break;
+    case VIDIOC_DQBUF:
+        ret = fake_dqbuf((struct v4l2_buffer *)arg);
+        break;
+    case VIDIOC_STREAMON:
+        ret = fake_streamon(*(enum v4l2_buf_type *)arg);
+        break;
+    case VIDIOC_STREAMOFF:
+        ret = fake_streamoff(*(enum v4l2_buf_type *)arg);
+        break;
+    case VIDIOC_G_CTRL:
+        /* V4L2_CID_CAM_JPEG_ENCODEDSIZE and friends: size of the last job */
+        ctrl->value = s_fake.last_size;
+        break;
+    case VIDIOC_S_CTRL:
+        break;
+    default:
+        ret = -ENOTTY;
+        break;
+    }
+    pthread_mutex_unlock(&s_fake.lock);
+
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+    return 0;
+}
+
+static int fake_poll(struct pollfd *fds, nfds_t nfds, int timeout)
+{
+    struct timespec deadline;
+
+    if (nfds != 1 || fds[0].fd != FAKE_JPEG_FD)
+        return poll(fds, nfds, timeout);
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    if (timeout > 0) {
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (timeout % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&s_fake.lock);
+    for (;;) {
+        fds[0].revents = 0;
+        if (s_fake.src.done.n > 0)
+            fds[0].revents |= POLLOUT;
+        if (s_fake.dst.done.n > 0)
+            fds[0].revents |= POLLIN;
+        fds[0].revents &= fds[0].events | POLLERR;
+
+        if (fds[0].revents != 0 || timeout == 0)
+            break;
+        if (timeout < 0)
+            pthread_cond_wait(&s_fake.cond, &s_fake.lock);
+        else if (pthread_cond_timedwait(&s_fake.cond, &s_fake.lock, &deadline) == ETIMEDOUT)
+            break;
+    }
+    pthread_mutex_unlock(&s_fake.lock);
+
+    return fds[0].revents ? 1 : 0;
+}
+
+const struct jpeg_dev_ops jpeg_fake_dev_ops = {
+    fake_open, fake_close, fake_ioctl, fake_poll, fake_mmap, fake_munmap,
+};
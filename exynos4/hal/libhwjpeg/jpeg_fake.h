@@ -0,0 +1,52 @@
+/*
+ * Copyright@ Samsung Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Fake JPEG V4L2 mem2mem node for host tests, handed to libhwjpeg with
+ * jpeghal_set_dev_ops(&jpeg_fake_dev_ops).
+ */
+
+#ifndef _JPEG_FAKE_H_
+#define _JPEG_FAKE_H_
+
+#include "videodev2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct jpeg_fake_stats {
+    unsigned int jobs;          /* buffer pairs processed */
+    unsigned int streamons;     /* VIDIOC_STREAMON calls that started a queue */
+    unsigned int max_queued;    /* deepest input queue seen */
+    unsigned long long busy_us; /* time the fake hardware spent on jobs */
+};
+
+struct jpeg_dev_ops;
+
+extern const struct jpeg_dev_ops jpeg_fake_dev_ops;
+
+/* knobs, read for every job or call */
+void jpeg_fake_set_job_time(unsigned int usec);
+void jpeg_fake_set_payload(int on);             /* 0: bytesused stays 0, like some drivers */
+void jpeg_fake_fail_next(unsigned long request, enum v4l2_buf_type type); /* next QBUF/DQBUF */
+void jpeg_fake_get_stats(struct jpeg_fake_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _JPEG_FAKE_H_ */
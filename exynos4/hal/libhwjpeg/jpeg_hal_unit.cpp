@@ -36,9 +36,31 @@
 #include <log/log.h>
 
 #include "jpeg_hal.h"
+#include "videodev2_exynos_media.h"
 
 #pragma clang diagnostic ignored "-Wunused-function"
 
+static int sys_open(const char *path, int flags)
+{
+    return open(path, flags, 0);
+}
+
+static int sys_ioctl(int fd, unsigned long request, void *arg)
+{
+    return ioctl(fd, request, arg);
+}
+
+static const struct jpeg_dev_ops sys_dev_ops = {
+    sys_open, close, sys_ioctl, poll, mmap, munmap,
+};
+
+static const struct jpeg_dev_ops *dev = &sys_dev_ops;
+
+void jpeghal_set_dev_ops(const struct jpeg_dev_ops *ops)
+{
+    dev = (ops != NULL) ? ops : &sys_dev_ops;
+}
+
 #ifdef JPEG_PERF_MEAS
 unsigned long measure_time(struct timeval *start, struct timeval *stop)
 {
@@ -64,7 +86,7 @@ static int jpeg_v4l2_querycap(int fd)
     struct v4l2_capability cap;
     int ret = 0;
 
-    ret = ioctl(fd, VIDIOC_QUERYCAP, &cap);
+    ret = dev->ioctl(fd, VIDIOC_QUERYCAP, &cap);
 
     if (!(cap.capabilities & V4L2_CAP_STREAMING))
         ALOGE("[%s]: does not support streaming", __func__);
@@ -85,7 +107,7 @@ static int jpeg_v4l2_s_jpegcomp(int fd, int quality)
 
     arg.quality = quality;
 
-    ret = ioctl(fd, VIDIOC_S_JPEGCOMP, &arg);
+    ret = dev->ioctl(fd, VIDIOC_S_JPEGCOMP, &arg);
 
     return ret;
 }
@@ -95,6 +117,8 @@ static int jpeg_v4l2_s_fmt(int fd, enum v4l2_buf_type type, struct jpeg_config *
     struct v4l2_format fmt;
     int ret = 0;
 
+    memset(&fmt, 0, sizeof(struct v4l2_format));
+
     fmt.type = type;
     fmt.fmt.pix_mp.width = config->width;
     fmt.fmt.pix_mp.height = config->height;
@@ -130,7 +154,7 @@ static int jpeg_v4l2_s_fmt(int fd, enum v4l2_buf_type type, struct jpeg_config *
             return -1;
     }
 
-    ret = ioctl(fd, VIDIOC_S_FMT, &fmt);
+    ret = dev->ioctl(fd, VIDIOC_S_FMT, &fmt);
 
     return ret;
 }
@@ -141,7 +165,7 @@ static int jpeg_v4l2_g_fmt(int fd, enum v4l2_buf_type type, struct jpeg_config *
     int ret = 0;
 
     fmt.type = type;
-    ret = ioctl(fd, VIDIOC_G_FMT, &fmt);
+    ret = dev->ioctl(fd, VIDIOC_G_FMT, &fmt);
     if (ret < 0)
         return -1;
 
@@ -201,12 +225,12 @@ static int jpeg_v4l2_reqbufs(int fd, int buf_cnt, struct jpeg_buf *buf)
 
     req.count = buf_cnt;
 
-    ret = ioctl(fd, VIDIOC_REQBUFS, &req);
+    ret = dev->ioctl(fd, VIDIOC_REQBUFS, &req);
 
     return ret;
 }
 
-static int jpeg_v4l2_querybuf(int fd, struct jpeg_buf *buf)
+static int jpeg_v4l2_querybuf(int fd, struct jpeg_buf *buf, int index)
 {
     struct v4l2_buffer v4l2_buf;
     struct v4l2_plane plane[JPEG_MAX_PLANE_CNT];
@@ -215,13 +239,13 @@ static int jpeg_v4l2_querybuf(int fd, struct jpeg_buf *buf)
 
     memset(plane, 0, (int)JPEG_MAX_PLANE_CNT * sizeof(struct v4l2_plane));
 
-    v4l2_buf.index = 0;
+    v4l2_buf.index = index;
     v4l2_buf.type = buf->buf_type;
     v4l2_buf.memory = buf->memory;
     v4l2_buf.length = buf->num_planes;
     v4l2_buf.m.planes = plane;
 
-    ret = ioctl(fd, VIDIOC_QUERYBUF, &v4l2_buf);
+    ret = dev->ioctl(fd, VIDIOC_QUERYBUF, &v4l2_buf);
     if (ret < 0) {
         ALOGE("[%s:%d]: VIDIOC_QUERYBUF failed", __func__, ret);
         return ret;
@@ -229,12 +253,12 @@ static int jpeg_v4l2_querybuf(int fd, struct jpeg_buf *buf)
 
     for (i= 0; i < buf->num_planes; i++) {
         buf->length[i] = v4l2_buf.m.planes[i].length;
-        buf->start[i] = (char *) mmap(0, buf->length[i],
+        buf->start[i] = (char *) dev->mmap(0, buf->length[i],
                     PROT_READ | PROT_WRITE, MAP_SHARED, fd,
                     v4l2_buf.m.planes[i].m.mem_offset);
 
         //ALOGI("[%s]: buf.start[%d] = %p, length = %d", __func__, 0, buf->start[0], buf->length[0]);
-        if (buf->start[0] == MAP_FAILED) {
+        if (buf->start[i] == MAP_FAILED) {
             ALOGE("[%s]: mmap failed", __func__);
             return -1;
         }
@@ -243,7 +267,7 @@ static int jpeg_v4l2_querybuf(int fd, struct jpeg_buf *buf)
     return ret;
 }
 
-static int jpeg_v4l2_qbuf(int fd, struct jpeg_buf *buf)
+static int jpeg_v4l2_qbuf(int fd, struct jpeg_buf *buf, int index)
 {
     struct v4l2_buffer v4l2_buf;
     struct v4l2_plane plane[JPEG_MAX_PLANE_CNT];
@@ -253,7 +277,7 @@ static int jpeg_v4l2_qbuf(int fd, struct jpeg_buf *buf)
     memset(&v4l2_buf, 0, sizeof(struct v4l2_buffer));
     memset(plane, 0, (int)JPEG_MAX_PLANE_CNT * sizeof(struct v4l2_plane));
 
-    v4l2_buf.index = 0;
+    v4l2_buf.index = index;
     v4l2_buf.type = buf->buf_type;
     v4l2_buf.memory = buf->memory;
     v4l2_buf.length = buf->num_planes;
@@ -266,7 +290,7 @@ static int jpeg_v4l2_qbuf(int fd, struct jpeg_buf *buf)
         }
     }
 
-    ret = ioctl(fd, VIDIOC_QBUF, &v4l2_buf);
+    ret = dev->ioctl(fd, VIDIOC_QBUF, &v4l2_buf);
     if (ret < 0) {
         ALOGE("[%s:%d] QBUF failed", __func__, ret);
         return -1;
@@ -285,7 +309,7 @@ static int jpeg_v4l2_dqbuf(int fd, enum v4l2_buf_type type, enum v4l2_memory mem
     buf.type = type;
     buf.memory = memory;
 
-    ret = ioctl(fd, VIDIOC_DQBUF, &buf);
+    ret = dev->ioctl(fd, VIDIOC_DQBUF, &buf);
     if (ret < 0) {
         ALOGE("[%s:%d] DQBUF failed", __func__, ret);
         return -1;
@@ -298,7 +322,7 @@ static int jpeg_v4l2_streamon(int fd, enum v4l2_buf_type type)
 {
     int ret = 0;
 
-    ret = ioctl(fd, VIDIOC_STREAMON, &type);
+    ret = dev->ioctl(fd, VIDIOC_STREAMON, &type);
     if (ret < 0) {
         ALOGE("[%s:%d] STREAMON failed", __func__, ret);
         return -1;
@@ -311,7 +335,7 @@ static int jpeg_v4l2_streamoff(int fd, enum v4l2_buf_type type)
 {
     int ret = 0;
 
-    ret = ioctl(fd, VIDIOC_STREAMOFF, &type);
+    ret = dev->ioctl(fd, VIDIOC_STREAMOFF, &type);
     if (ret < 0) {
         ALOGE("[%s:%d] STREAMOFF failed", __func__, ret);
         return -1;
@@ -325,7 +349,7 @@ int jpeghal_dec_init()
     int fd;
     int ret = 0;
 
-    fd = open(JPEG_DEC_NODE, O_RDWR, 0);
+    fd = dev->open(JPEG_DEC_NODE, O_RDWR);
 
     if (fd < 0) {
         ALOGE("[%s]: JPEG dec open failed", __func__);
@@ -346,7 +370,7 @@ int jpeghal_enc_init()
     int fd;
     int ret = 0;
 
-    fd = open(JPEG_ENC_NODE, O_RDWR, 0);
+    fd = dev->open(JPEG_ENC_NODE, O_RDWR);
     if (fd < 0) {
         ALOGE("[%s]: JPEG enc open failed", __func__);
         return -1;
@@ -440,7 +464,7 @@ int jpeghal_set_inbuf(int fd, struct jpeg_buf *buf)
     }
 
     if (buf->memory == V4L2_MEMORY_MMAP) {
-        ret = jpeg_v4l2_querybuf(fd, buf);
+        ret = jpeg_v4l2_querybuf(fd, buf, 0);
         if (ret < 0) {
             ALOGE("[%s:%d]: Input QUERYBUF failed", __func__, ret);
             return -1;
@@ -463,7 +487,7 @@ int jpeghal_set_outbuf(int fd, struct jpeg_buf *buf)
     }
 
     if (buf->memory == V4L2_MEMORY_MMAP) {
-        ret = jpeg_v4l2_querybuf(fd, buf);
+        ret = jpeg_v4l2_querybuf(fd, buf, 0);
         if (ret < 0) {
             ALOGE("[%s:%d]: Output QUERYBUF failed", __func__, ret);
             return -1;
@@ -477,13 +501,13 @@ static int jpeg_exe(int fd, struct jpeg_buf *in_buf, struct jpeg_buf *out_buf)
 {
     int ret = 0;
 
-    ret = jpeg_v4l2_qbuf(fd, in_buf);
+    ret = jpeg_v4l2_qbuf(fd, in_buf, 0);
     if (ret < 0) {
         ALOGE("[%s:%d]: Input QBUF failed", __func__, ret);
         return -1;
     }
 
-    ret = jpeg_v4l2_qbuf(fd, out_buf);
+    ret = jpeg_v4l2_qbuf(fd, out_buf, 0);
     if (ret < 0) {
         ALOGE("[%s:%d]: Output QBUF failed", __func__, ret);
         return -1;
@@ -528,16 +552,345 @@ int jpeghal_deinit(int fd, struct jpeg_buf *in_buf, struct jpeg_buf *out_buf)
     jpeg_v4l2_streamoff(fd, out_buf->buf_type);
 
     if (in_buf->memory == V4L2_MEMORY_MMAP)
-        munmap((char *)(in_buf->start[0]), in_buf->length[0]);
+        dev->munmap((char *)(in_buf->start[0]), in_buf->length[0]);
 
     if (out_buf->memory == V4L2_MEMORY_MMAP)
-        munmap((char *)(out_buf->start[0]), out_buf->length[0]);
+        dev->munmap((char *)(out_buf->start[0]), out_buf->length[0]);
 
     jpeg_v4l2_reqbufs(fd, 0, in_buf);
 
     jpeg_v4l2_reqbufs(fd, 0, out_buf);
 
-    ret = close(fd);
+    ret = dev->close(fd);
+
+    return ret;
+}
+
+static int jpeg_v4l2_dqbuf_job(int fd, struct jpeg_buf *buf, int *index, int *size)
+{
+    struct v4l2_buffer v4l2_buf;
+    struct v4l2_plane plane[JPEG_MAX_PLANE_CNT];
+    int i;
+    int ret = 0;
+
+    memset(&v4l2_buf, 0, sizeof(struct v4l2_buffer));
+    memset(plane, 0, (int)JPEG_MAX_PLANE_CNT * sizeof(struct v4l2_plane));
+
+    v4l2_buf.type = buf->buf_type;
+    v4l2_buf.memory = buf->memory;
+    v4l2_buf.length = buf->num_planes;
+    v4l2_buf.m.planes = plane;
+
+    ret = dev->ioctl(fd, VIDIOC_DQBUF, &v4l2_buf);
+    if (ret < 0) {
+        ALOGE("[%s:%d] DQBUF failed", __func__, ret);
+        return -1;
+    }
+
+    *index = v4l2_buf.index;
+    *size = 0;
+    for (i = 0; i < buf->num_planes; i++)
+        *size += plane[i].bytesused;
+    if (v4l2_buf.flags & V4L2_BUF_FLAG_ERROR)
+        *size = -1;
+
+    return ret;
+}
+
+int jpeghal_queue_init(struct jpeg_queue *queue, int fd, int count,
+                       struct jpeg_buf_info *in_info, struct jpeg_buf_info *out_info)
+{
+    struct v4l2_requestbuffers req;
+    int i;
+    int ret = 0;
+
+    memset(queue, 0, sizeof(*queue));
+    queue->fd = fd;
+
+    if (count < 1 || count > JPEG_MAX_JOBS) {
+        ALOGE("[%s]: invalid job count %d", __func__, count);
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        queue->in_bufs[i].num_planes = in_info->num_planes;
+        queue->in_bufs[i].memory = in_info->memory;
+        queue->in_bufs[i].buf_type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+
+        queue->out_bufs[i].num_planes = out_info->num_planes;
+        queue->out_bufs[i].memory = out_info->memory;
+        queue->out_bufs[i].buf_type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    }
+
+    /* the driver may grant fewer buffers than asked for */
+    memset(&req, 0, sizeof(req));
+    req.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+    req.memory = in_info->memory;
+    req.count = count;
+    ret = dev->ioctl(fd, VIDIOC_REQBUFS, &req);
+    if (ret < 0 || req.count < 1) {
+        ALOGE("[%s:%d]: Input REQBUFS failed", __func__, ret);
+        return -1;
+    }
+    if ((int)req.count < count)
+        count = req.count;
+
+    memset(&req, 0, sizeof(req));
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+    req.memory = out_info->memory;
+    req.count = count;
+    ret = dev->ioctl(fd, VIDIOC_REQBUFS, &req);
+    if (ret < 0 || req.count < 1) {
+        ALOGE("[%s:%d]: Output REQBUFS failed", __func__, ret);
+        return -1;
+    }
+    if ((int)req.count < count)
+        count = req.count;
+
+    queue->count = count;
+
+    for (i = 0; i < count; i++) {
+        if (in_info->memory == V4L2_MEMORY_MMAP &&
+            jpeg_v4l2_querybuf(fd, &queue->in_bufs[i], i) < 0) {
+            ALOGE("[%s]: Input QUERYBUF %d failed", __func__, i);
+            return -1;
+        }
+        if (out_info->memory == V4L2_MEMORY_MMAP &&
+            jpeg_v4l2_querybuf(fd, &queue->out_bufs[i], i) < 0) {
+            ALOGE("[%s]: Output QUERYBUF %d failed", __func__, i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int jpeghal_queue_get_free(struct jpeg_queue *queue)
+{
+    int i;
+
+    if (queue->no_payload && queue->queued > 0)
+        return -1;
+
+    for (i = 0; i < queue->count; i++) {
+        if (queue->state[i] == JPEG_PAIR_FREE)
+            return i;
+    }
+
+    return -1;
+}
+
+/*
+ * An input the driver still holds would be paired with the output of the
+ * next job, or come back in place of the input of another one. V4L2 only
+ * gives a buffer back on STREAMOFF, so once the jobs ahead of it are done,
+ * both queues are cycled off to drop it.
+ */
+static int jpeg_queue_reset(struct jpeg_queue *queue)
+{
+    int i;
+
+    if (queue->queued > 0) {
+        ALOGE("[%s]: %d jobs still in flight", __func__, queue->queued);
+        return -1;
+    }
+
+    /* STREAMOFF on a queue that never streamed keeps its buffers */
+    if (!queue->streaming) {
+        jpeg_v4l2_streamon(queue->fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE);
+        jpeg_v4l2_streamon(queue->fd, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE);
+    }
+
+    if (jpeg_v4l2_streamoff(queue->fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE) < 0 ||
+        jpeg_v4l2_streamoff(queue->fd, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) < 0) {
+        ALOGE("[%s]: STREAMOFF failed", __func__);
+        return -1;
+    }
+
+    queue->streaming = 0;
+    for (i = 0; i < queue->count; i++) {
+        if (queue->state[i] == JPEG_PAIR_ORPHAN)
+            queue->state[i] = JPEG_PAIR_FREE;
+    }
+    queue->orphans = 0;
+
+    return 0;
+}
+
+int jpeghal_queue_job(struct jpeg_queue *queue, int index)
+{
+    int ret = 0;
+
+    if (queue->orphans > 0 && jpeg_queue_reset(queue) < 0)
+        return -1;
+
+    if (index < 0 || index >= queue->count || queue->state[index] != JPEG_PAIR_FREE) {
+        ALOGE("[%s]: buffer pair %d is not free", __func__, index);
+        return -1;
+    }
+
+    if (queue->no_payload && queue->queued > 0) {
+        ALOGE("[%s]: no payload from the driver, one job at a time", __func__);
+        return -1;
+    }
+
+    ret = jpeg_v4l2_qbuf(queue->fd, &queue->in_bufs[index], index);
+    if (ret < 0) {
+        ALOGE("[%s:%d]: Input QBUF failed", __func__, ret);
+        return -1;
+    }
+
+    ret = jpeg_v4l2_qbuf(queue->fd, &queue->out_bufs[index], index);
+    if (ret < 0) {
+        ALOGE("[%s:%d]: Output QBUF failed", __func__, ret);
+        /* the input is the driver's until the reset, keep the pair out of use */
+        queue->state[index] = JPEG_PAIR_ORPHAN;
+        queue->orphans++;
+        return -1;
+    }
+
+    queue->state[index] = JPEG_PAIR_QUEUED;
+    queue->queued++;
+
+    if (!queue->streaming) {
+        if (jpeg_v4l2_streamon(queue->fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE) < 0 ||
+            jpeg_v4l2_streamon(queue->fd, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) < 0)
+            return -1;
+        queue->streaming = 1;
+    }
+
+    return ret;
+}
+
+int jpeghal_dequeue_job(struct jpeg_queue *queue, int timeout, int *index, int *size)
+{
+    struct pollfd pfd;
+    int in_index, in_size;
+    int ret = 0;
+
+    if (queue->queued == 0)
+        return 0;
+
+    pfd.fd = queue->fd;
+    pfd.events = POLLIN | POLLERR;
+    pfd.revents = 0;
+
+    ret = dev->poll(&pfd, 1, timeout);
+    if (ret < 0) {
+        ALOGE("[%s]: poll failed", __func__);
+        return -1;
+    }
+    if (ret == 0 || !(pfd.revents & POLLIN))
+        return 0;
+
+    if (jpeg_v4l2_dqbuf_job(queue->fd, &queue->out_bufs[0], index, size) < 0)
+        return -1;
+
+    if (*index < 0 || *index >= queue->count || queue->state[*index] != JPEG_PAIR_QUEUED) {
+        ALOGE("[%s]: output %d was not queued", __func__, *index);
+        return -1;
+    }
+
+    /*
+     * Not every driver sets the payload of a capture buffer. For an encode
+     * the size is in V4L2_CID_CAM_JPEG_ENCODEDSIZE then, like in the
+     * blocking path, but that holds the size of the last finished job: it
+     * is only this job's while no other job is in flight. Fail the job if
+     * others are, and run one job at a time from now on.
+     */
+    if (*size == 0) {
+        struct v4l2_control ctrl;
+
+        if (!queue->no_payload)
+            ALOGI("[%s]: no payload from the driver, one job at a time", __func__);
+        queue->no_payload = 1;
+
+        ctrl.id = V4L2_CID_CAM_JPEG_ENCODEDSIZE;
+        ctrl.value = 0;
+        if (queue->queued > 1)
+            *size = -1;
+        else if (dev->ioctl(queue->fd, VIDIOC_G_CTRL, &ctrl) == 0)
+            *size = ctrl.value;
+    }
+
+    queue->queued--;
+
+    if (jpeg_v4l2_dqbuf_job(queue->fd, &queue->in_bufs[0], &in_index, &in_size) < 0) {
+        /* the job is done, only its input is still the driver's */
+        queue->state[*index] = JPEG_PAIR_ORPHAN;
+        queue->orphans++;
+        return 1;
+    }
+
+    if (in_index != *index && in_index >= 0 && in_index < queue->count &&
+        queue->state[in_index] == JPEG_PAIR_ORPHAN) {
+        /* a late input of an earlier job; this job's input takes its place */
+        queue->state[in_index] = JPEG_PAIR_FREE;
+        queue->state[*index] = JPEG_PAIR_ORPHAN;
+        return 1;
+    }
+
+    if (in_index != *index)
+        ALOGE("[%s]: input %d completed with output %d", __func__, in_index, *index);
+
+    queue->state[*index] = JPEG_PAIR_FREE;
+
+    return 1;
+}
+
+int jpeghal_poll_jobs(struct jpeg_queue *queue, int timeout)
+{
+    int index, size;
+    int done = 0;
+    int ret = 0;
+
+    /* wait for the first completion only, then take what is already done */
+    while ((ret = jpeghal_dequeue_job(queue, done ? 0 : timeout, &index, &size)) > 0) {
+        done++;
+        if (queue->cb)
+            queue->cb(queue->cookie, index, size);
+    }
+
+    return (ret < 0) ? -1 : done;
+}
+
+int jpeghal_queue_deinit(struct jpeg_queue *queue)
+{
+    struct jpeg_buf *buf;
+    int i, j;
+    int ret = 0;
+
+    if (queue->streaming) {
+        jpeg_v4l2_streamoff(queue->fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE);
+        jpeg_v4l2_streamoff(queue->fd, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE);
+    }
+
+    for (i = 0; i < JPEG_MAX_JOBS; i++) {
+        buf = &queue->in_bufs[i];
+        for (j = 0; buf->memory == V4L2_MEMORY_MMAP && j < buf->num_planes; j++) {
+            if (buf->start[j] != NULL && buf->start[j] != MAP_FAILED)
+                dev->munmap((char *)buf->start[j], buf->length[j]);
+        }
+
+        buf = &queue->out_bufs[i];
+        for (j = 0; buf->memory == V4L2_MEMORY_MMAP && j < buf->num_planes; j++) {
+            if (buf->start[j] != NULL && buf->start[j] != MAP_FAILED)
+                dev->munmap((char *)buf->start[j], buf->length[j]);
+        }
+    }
+
+    jpeg_v4l2_reqbufs(queue->fd, 0, &queue->in_bufs[0]);
+    jpeg_v4l2_reqbufs(queue->fd, 0, &queue->out_bufs[0]);
+
+    ret = dev->close(queue->fd);
+
+    queue->fd = -1;
+    queue->count = 0;
+    queue->queued = 0;
+    queue->streaming = 0;
+    queue->orphans = 0;
+    queue->no_payload = 0;
+    memset(queue->state, 0, sizeof(queue->state));
 
     return ret;
 }
@@ -550,7 +903,7 @@ int jpeghal_s_ctrl(int fd, int cid, int value)
     vc.id = cid;
     vc.value = value;
 
-    ret = ioctl(fd, VIDIOC_S_CTRL, &vc);
+    ret = dev->ioctl(fd, VIDIOC_S_CTRL, &vc);
     if (ret != 0) {
         ALOGE("[%s] ioctl : cid(%d), value(%d)\n", __func__, cid, value);
         return -1;
@@ -566,7 +919,7 @@ int jpeghal_g_ctrl(int fd, int id)
 
     ctrl.id = id;
 
-    ret = ioctl(fd, VIDIOC_G_CTRL, &ctrl);
+    ret = dev->ioctl(fd, VIDIOC_G_CTRL, &ctrl);
     if (ret < 0) {
         ALOGE("[%s] ioctl : cid(%d)\n", __func__, ctrl.id);
         return -1;
@@ -0,0 +1,330 @@
+/*
+ * Copyright@ Samsung Electronics Co. LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host test of the libhwjpeg job queue on top of the fake node:
+ *   jpeg_queue_test
+ * The fake answers every job with SOI plus the first four input bytes, in
+ * 6 + (those bytes % 1024) bytes. Exits non-zero on the first failed check.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "jpeg_hal.h"
+#include "jpeg_fake.h"
+
+#define JOB_TIME_US     2000
+#define FILL_TIME_US    1500
+#define NUM_JOBS        40
+
+#define CHECK(cond)                                                     \
+    do {                                                                \
+        if (!(cond)) {                                                  \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+            return 1;                                                   \
+        }                                                               \
+    } while (0)
+
+static int s_order[NUM_JOBS];
+static int s_done;
+
+static long long nowUs(void)
+{
+    struct timeval t;
+
+    gettimeofday(&t, NULL);
+    return t.tv_sec * 1000000LL + t.tv_usec;
+}
+
+/* stands in for the CPU work of producing one input */
+static void fillInput(void)
+{
+    long long start = nowUs();
+
+    while (nowUs() - start < FILL_TIME_US)
+        ;
+}
+
+static void onJob(void *cookie, int index, int size)
+{
+    if (s_done < NUM_JOBS)
+        s_order[s_done] = index;
+    s_done++;
+}
+
+static int openQueue(struct jpeg_queue *queue, int count, enum v4l2_memory memory)
+{
+    struct jpeg_config config;
+    struct jpeg_buf_info in_info, out_info;
+    int fd = jpeghal_enc_init();
+
+    memset(&config, 0, sizeof(config));
+    config.mode = JPEG_ENCODE;
+    config.enc_qual = QUALITY_LEVEL_1;
+    config.width = 64;
+    config.height = 32;
+    config.num_planes = 1;
+    config.pix.enc_fmt.in_fmt = V4L2_PIX_FMT_YUYV;
+    config.pix.enc_fmt.out_fmt = V4L2_PIX_FMT_JPEG;
+    if (fd < 0 || jpeghal_enc_setconfig(fd, &config) < 0)
+        return -1;
+
+    memset(&in_info, 0, sizeof(in_info));
+    in_info.num_planes = 1;
+    in_info.memory = memory;
+    out_info = in_info;
+
+    return jpeghal_queue_init(queue, fd, count, &in_info, &out_info);
+}
+
+static void setTag(struct jpeg_queue *queue, int index, unsigned int tag)
+{
+    memcpy(queue->in_bufs[index].start[0], &tag, 4);
+}
+
+static int tagOf(struct jpeg_queue *queue, int index)
+{
+    unsigned char *out = (unsigned char *)queue->out_bufs[index].start[0];
+    unsigned int tag;
+
+    if (out[0] != 0xff || out[1] != 0xd8)
+        return -1;
+    memcpy(&tag, out + 2, 4);
+    return tag;
+}
+
+/* several pairs in flight complete in order, on a node streamed on once */
+static int testPipeline(void)
+{
+    struct jpeg_queue queue;
+    struct jpeg_fake_stats stats;
+    int index, size, sent = 0;
+    long long start, pipelined, serial;
+
+    CHECK(openQueue(&queue, 4, V4L2_MEMORY_MMAP) == 0);
+    CHECK(queue.count == 4);
+
+    for (int i = 0; i < 4; i++) {
+        index = jpeghal_queue_get_free(&queue);
+        CHECK(index == i);
+        setTag(&queue, index, 100 + i);
+        CHECK(jpeghal_queue_job(&queue, index) == 0);
+    }
+    CHECK(jpeghal_queue_get_free(&queue) == -1);
+    CHECK(jpeghal_queue_job(&queue, 0) < 0);
+
+    for (int i = 0; i < 4; i++) {
+        CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+        CHECK(index == i);
+        CHECK(size == 6 + 100 + i);
+        CHECK(tagOf(&queue, index) == 100 + i);
+    }
+    CHECK(jpeghal_dequeue_job(&queue, 10, &index, &size) == 0);
+
+    /* more jobs than pairs, refilled from the callback results */
+    queue.cb = onJob;
+    s_done = 0;
+    start = nowUs();
+    while (s_done < NUM_JOBS) {
+        while (sent < NUM_JOBS && (index = jpeghal_queue_get_free(&queue)) >= 0) {
+            fillInput();
+            setTag(&queue, index, sent++);
+            CHECK(jpeghal_queue_job(&queue, index) == 0);
+        }
+        CHECK(jpeghal_poll_jobs(&queue, 1000) > 0);
+    }
+    pipelined = nowUs() - start;
+
+    CHECK(s_done == NUM_JOBS);
+    for (int i = 0; i < NUM_JOBS; i++)
+        CHECK(s_order[i] == i % 4);
+
+    jpeg_fake_get_stats(&stats);
+    CHECK(stats.streamons == 2);
+    CHECK(stats.jobs == 4 + NUM_JOBS);
+    CHECK(stats.max_queued == 4);
+    CHECK(jpeghal_queue_deinit(&queue) == 0);
+
+    /* the same jobs one at a time, as the blocking path runs them */
+    CHECK(openQueue(&queue, 1, V4L2_MEMORY_MMAP) == 0);
+    start = nowUs();
+    for (int i = 0; i < NUM_JOBS; i++) {
+        fillInput();
+        setTag(&queue, 0, i);
+        CHECK(jpeghal_queue_job(&queue, 0) == 0);
+        CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+        CHECK(tagOf(&queue, 0) == i);
+    }
+    serial = nowUs() - start;
+    CHECK(jpeghal_queue_deinit(&queue) == 0);
+
+    printf("%d jobs, %d us fill + %d us coding each: %lld us pipelined, %lld us serial\n",
+           NUM_JOBS, FILL_TIME_US, JOB_TIME_US, pipelined, serial);
+
+    return 0;
+}
+
+/* caller-owned buffers, and the pair count is capped at JPEG_MAX_JOBS */
+static int testUserptr(void)
+{
+    static unsigned char src[JPEG_MAX_JOBS][4096];
+    static unsigned char dst[JPEG_MAX_JOBS][8192];
+    struct jpeg_queue queue;
+    int index, size;
+
+    CHECK(openQueue(&queue, JPEG_MAX_JOBS, V4L2_MEMORY_USERPTR) == 0);
+    for (int i = 0; i < JPEG_MAX_JOBS; i++) {
+        queue.in_bufs[i].start[0] = src[i];
+        queue.in_bufs[i].length[0] = sizeof(src[i]);
+        queue.out_bufs[i].start[0] = dst[i];
+        queue.out_bufs[i].length[0] = sizeof(dst[i]);
+        setTag(&queue, i, i);
+        CHECK(jpeghal_queue_job(&queue, i) == 0);
+    }
+    for (int i = 0; i < JPEG_MAX_JOBS; i++) {
+        CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+        CHECK(index == i && size == 6 + i && tagOf(&queue, i) == i);
+    }
+    CHECK(jpeghal_queue_deinit(&queue) == 0);
+
+    CHECK(openQueue(&queue, JPEG_MAX_JOBS + 1, V4L2_MEMORY_MMAP) < 0);
+    jpeghal_queue_deinit(&queue);
+
+    return 0;
+}
+
+/* without bytesused a size is only trusted with one job in flight */
+static int testNoPayload(void)
+{
+    struct jpeg_queue queue;
+    int index, size;
+
+    jpeg_fake_set_payload(0);
+    CHECK(openQueue(&queue, 2, V4L2_MEMORY_MMAP) == 0);
+
+    setTag(&queue, 0, 10);
+    setTag(&queue, 1, 20);
+    CHECK(jpeghal_queue_job(&queue, 0) == 0);
+    CHECK(jpeghal_queue_job(&queue, 1) == 0);
+
+    /* the control would already hold the size of job 1 */
+    CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+    CHECK(index == 0 && size == -1);
+    CHECK(queue.no_payload == 1);
+    CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+    CHECK(index == 1 && size == 6 + 20);
+
+    for (int i = 0; i < 3; i++) {
+        index = jpeghal_queue_get_free(&queue);
+        CHECK(index >= 0);
+        setTag(&queue, index, 30 + i);
+        CHECK(jpeghal_queue_job(&queue, index) == 0);
+        CHECK(jpeghal_queue_get_free(&queue) == -1);
+        CHECK(jpeghal_queue_job(&queue, index ^ 1) < 0);
+        CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+        CHECK(size == 6 + 30 + i);
+    }
+
+    CHECK(jpeghal_queue_deinit(&queue) == 0);
+    jpeg_fake_set_payload(1);
+
+    return 0;
+}
+
+/* a completion is reported even if its input could not be dequeued */
+static int testInputDqbufFail(void)
+{
+    struct jpeg_queue queue;
+    struct jpeg_fake_stats stats;
+    int index, size;
+
+    CHECK(openQueue(&queue, 3, V4L2_MEMORY_MMAP) == 0);
+    for (int i = 0; i < 2; i++) {
+        setTag(&queue, i, 40 + i);
+        CHECK(jpeghal_queue_job(&queue, i) == 0);
+    }
+
+    jpeg_fake_fail_next(VIDIOC_DQBUF, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE);
+    CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+    CHECK(index == 0 && size == 6 + 40);
+    CHECK(queue.state[0] == JPEG_PAIR_ORPHAN && queue.orphans == 1);
+
+    /* the late input 0 comes back with job 1, whose input stays out */
+    CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+    CHECK(index == 1 && size == 6 + 41);
+    CHECK(queue.state[0] == JPEG_PAIR_FREE);
+    CHECK(queue.state[1] == JPEG_PAIR_ORPHAN && queue.orphans == 1);
+
+    /* the next job resets the node first */
+    setTag(&queue, 2, 42);
+    CHECK(jpeghal_queue_job(&queue, 2) == 0);
+    CHECK(queue.orphans == 0 && queue.state[1] == JPEG_PAIR_FREE);
+    CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+    CHECK(index == 2 && size == 6 + 42 && tagOf(&queue, 2) == 42);
+
+    jpeg_fake_get_stats(&stats);
+    CHECK(stats.streamons == 4);
+    CHECK(jpeghal_queue_deinit(&queue) == 0);
+
+    return 0;
+}
+
+/* an input queued without its output never pairs with a later output */
+static int testOutputQbufFail(void)
+{
+    struct jpeg_queue queue;
+    int index, size;
+
+    CHECK(openQueue(&queue, 2, V4L2_MEMORY_MMAP) == 0);
+
+    setTag(&queue, 0, 50);
+    CHECK(jpeghal_queue_job(&queue, 0) == 0);
+
+    setTag(&queue, 1, 51);
+    jpeg_fake_fail_next(VIDIOC_QBUF, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE);
+    CHECK(jpeghal_queue_job(&queue, 1) < 0);
+    CHECK(queue.state[1] == JPEG_PAIR_ORPHAN);
+
+    /* no reset while job 0 is in flight */
+    CHECK(jpeghal_queue_job(&queue, 1) < 0);
+    CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+    CHECK(index == 0 && tagOf(&queue, 0) == 50);
+
+    setTag(&queue, 0, 52);
+    CHECK(jpeghal_queue_job(&queue, 0) == 0);
+    CHECK(jpeghal_dequeue_job(&queue, 1000, &index, &size) == 1);
+    CHECK(index == 0 && size == 6 + 52 && tagOf(&queue, 0) == 52);
+    CHECK(jpeghal_dequeue_job(&queue, 10, &index, &size) == 0);
+
+    CHECK(jpeghal_queue_deinit(&queue) == 0);
+
+    return 0;
+}
+
+int main(void)
+{
+    jpeghal_set_dev_ops(&jpeg_fake_dev_ops);
+    jpeg_fake_set_job_time(JOB_TIME_US);
+
+    if (testPipeline() || testUserptr() || testNoPayload() ||
+        testInputDqbufFail() || testOutputQbufFail())
+        return 1;
+
+    printf("jpeg_queue_test: ok\n");
+    return 0;
+}
@@ -72,4 +72,22 @@ LOCAL_SANITIZE := integer
 
 include $(BUILD_SHARED_LIBRARY)
 
+# ril_event loop against the select() loop it replaced, on the host
+include $(CLEAR_VARS)
+
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_SRC_FILES := \
+    ril_event.cpp \
+    ril_event_bench.cpp
+
+LOCAL_CFLAGS += -O2 -Wno-unused-parameter
+
+LOCAL_STATIC_LIBRARIES := liblog
+LOCAL_LDLIBS += -lpthread
+
+LOCAL_MODULE := ril_event_bench
+
+include $(BUILD_HOST_EXECUTABLE)
+
 endif # BOARD_PROVIDES_LIBRIL
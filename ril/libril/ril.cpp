@@ -123,24 +123,33 @@ int s_wakelock_count = 0;
 
 static struct ril_event s_wakeupfd_event;
 
-static pthread_mutex_t s_pendingRequestsMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t s_wakeLockCountMutex = PTHREAD_MUTEX_INITIALIZER;
-static RequestInfo *s_pendingRequests = NULL;
 
-#if (SIM_COUNT >= 2)
-static pthread_mutex_t s_pendingRequestsMutex_socket2  = PTHREAD_MUTEX_INITIALIZER;
-static RequestInfo *s_pendingRequests_socket2          = NULL;
-#endif
+/*
+ * Outstanding requests of one socket. RequestInfo entries come from a fixed
+ * slab so issuing and completing a request does not touch the heap; the
+ * heap is only used if more than RIL_REQUEST_POOL_SIZE requests are in
+ * flight (or leaked by error paths).
+ *
+ * The RequestInfo address is the RIL_Token, so free slots are reused in
+ * FIFO order: a late or duplicate completion for a finished request finds
+ * its slot still idle instead of matching whatever request was issued
+ * right after it.
+ */
+#define RIL_REQUEST_POOL_SIZE 64
 
-#if (SIM_COUNT >= 3)
-static pthread_mutex_t s_pendingRequestsMutex_socket3  = PTHREAD_MUTEX_INITIALIZER;
-static RequestInfo *s_pendingRequests_socket3          = NULL;
-#endif
+typedef struct RequestInfoPool {
+    pthread_mutex_t mutex;
+    RequestInfo slots[RIL_REQUEST_POOL_SIZE];
+    int freeSlots[RIL_REQUEST_POOL_SIZE];   // ring, oldest released first
+    int freeHead;
+    int freeCount;
+    RequestInfo *overflow;
+    PendingRequestStats stats;
+} RequestInfoPool;
 
-#if (SIM_COUNT >= 4)
-static pthread_mutex_t s_pendingRequestsMutex_socket4  = PTHREAD_MUTEX_INITIALIZER;
-static RequestInfo *s_pendingRequests_socket4          = NULL;
-#endif
+static RequestInfoPool s_requestPools[SIM_COUNT];
+static pthread_once_t s_requestPoolsOnce = PTHREAD_ONCE_INIT;
 
 static const struct timeval TIMEVAL_WAKE_TIMEOUT = {ANDROID_WAKE_LOCK_SECS,ANDROID_WAKE_LOCK_USECS};
 
@@ -203,35 +212,37 @@ char * RIL_getServiceName() {
     return ril_service_name;
 }
 
+static void initRequestPools() {
+    for (int i = 0; i < SIM_COUNT; i++) {
+        RequestInfoPool *pool = &s_requestPools[i];
+
+        pthread_mutex_init(&pool->mutex, NULL);
+        for (int j = 0; j < RIL_REQUEST_POOL_SIZE; j++) {
+            pool->slots[j].slot = j;
+            pool->freeSlots[j] = j;
+        }
+        pool->freeHead = 0;
+        pool->freeCount = RIL_REQUEST_POOL_SIZE;
+        pool->overflow = NULL;
+        memset(&pool->stats, 0, sizeof(pool->stats));
+    }
+}
+
+static RequestInfoPool *getRequestPool(RIL_SOCKET_ID socket_id) {
+    pthread_once(&s_requestPoolsOnce, initRequestPools);
+
+    if ((int) socket_id < 0 || (int) socket_id >= SIM_COUNT) {
+        return &s_requestPools[RIL_SOCKET_1];
+    }
+    return &s_requestPools[socket_id];
+}
+
 RequestInfo *
 addRequestToList(int serial, int slotId, int request) {
     RequestInfo *pRI;
     int ret;
     RIL_SOCKET_ID socket_id = (RIL_SOCKET_ID) slotId;
-    /* Hook for current context */
-    /* pendingRequestsMutextHook refer to &s_pendingRequestsMutex */
-    pthread_mutex_t* pendingRequestsMutexHook = &s_pendingRequestsMutex;
-    /* pendingRequestsHook refer to &s_pendingRequests */
-    RequestInfo**    pendingRequestsHook = &s_pendingRequests;
-
-#if (SIM_COUNT >= 2)
-    if (socket_id == RIL_SOCKET_2) {
-        pendingRequestsMutexHook = &s_pendingRequestsMutex_socket2;
-        pendingRequestsHook = &s_pendingRequests_socket2;
-    }
-#if (SIM_COUNT >= 3)
-    else if (socket_id == RIL_SOCKET_3) {
-        pendingRequestsMutexHook = &s_pendingRequestsMutex_socket3;
-        pendingRequestsHook = &s_pendingRequests_socket3;
-    }
-#endif
-#if (SIM_COUNT >= 4)
-    else if (socket_id == RIL_SOCKET_4) {
-        pendingRequestsMutexHook = &s_pendingRequestsMutex_socket4;
-        pendingRequestsHook = &s_pendingRequests_socket4;
-    }
-#endif
-#endif
+    RequestInfoPool *pool = getRequestPool(socket_id);
 
     CommandInfo *pCI = NULL;
     if (request > RIL_OEM_REQUEST_BASE) {
@@ -245,28 +256,98 @@ addRequestToList(int serial, int slotId, int request) {
             pCI = &(s_commands[request]);
     }
 
-    pRI = (RequestInfo *)calloc(1, sizeof(RequestInfo));
-    if (pRI == NULL) {
-        RLOGE("Memory allocation failed for request %s", requestToString(request));
-        return NULL;
+    ret = pthread_mutex_lock(&pool->mutex);
+    assert (ret == 0);
+
+    if (pool->freeCount > 0) {
+        pRI = &pool->slots[pool->freeSlots[pool->freeHead]];
+        pool->freeHead = (pool->freeHead + 1) % RIL_REQUEST_POOL_SIZE;
+        pool->freeCount--;
+        int slot = pRI->slot;
+        memset(pRI, 0, sizeof(RequestInfo));
+        pRI->slot = slot;
+    } else {
+        pRI = (RequestInfo *)calloc(1, sizeof(RequestInfo));
+        if (pRI == NULL) {
+            pthread_mutex_unlock(&pool->mutex);
+            RLOGE("Memory allocation failed for request %s", requestToString(request));
+            return NULL;
+        }
+        pRI->slot = -1;
+        pRI->p_next = pool->overflow;
+        pool->overflow = pRI;
+        pool->stats.overflowAllocs++;
+        RLOGW("addRequestToList: request pool exhausted, %d requests outstanding",
+                pool->stats.outstanding + 1);
     }
 
     pRI->token = serial;
     pRI->pCI = pCI;
     pRI->socket_id = socket_id;
+    pRI->pending = 1;
+    pRI->startTimeMs = elapsedRealtime();
 
-    ret = pthread_mutex_lock(pendingRequestsMutexHook);
-    assert (ret == 0);
-
-    pRI->p_next = *pendingRequestsHook;
-    *pendingRequestsHook = pRI;
+    pool->stats.total++;
+    pool->stats.outstanding++;
+    if (pool->stats.outstanding > pool->stats.peakOutstanding) {
+        pool->stats.peakOutstanding = pool->stats.outstanding;
+    }
 
-    ret = pthread_mutex_unlock(pendingRequestsMutexHook);
+    ret = pthread_mutex_unlock(&pool->mutex);
     assert (ret == 0);
 
     return pRI;
 }
 
+// Returns a completed RequestInfo to its pool
+static void
+releaseRequestInfo(RequestInfo *pRI) {
+    RequestInfoPool *pool = getRequestPool(pRI->socket_id);
+
+    pthread_mutex_lock(&pool->mutex);
+    if (pRI->slot >= 0) {
+        pool->freeSlots[(pool->freeHead + pool->freeCount) % RIL_REQUEST_POOL_SIZE] = pRI->slot;
+        pool->freeCount++;
+        pthread_mutex_unlock(&pool->mutex);
+        return;
+    }
+
+    for (RequestInfo **ppCur = &pool->overflow
+        ; *ppCur != NULL
+        ; ppCur = &((*ppCur)->p_next)
+    ) {
+        if (pRI == *ppCur) {
+            *ppCur = pRI->p_next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    free(pRI);
+}
+
+void getPendingRequestStats(int slotId, PendingRequestStats *stats) {
+    RequestInfoPool *pool = getRequestPool((RIL_SOCKET_ID) slotId);
+    int64_t now = elapsedRealtime();
+    int64_t oldest = now;
+
+    pthread_mutex_lock(&pool->mutex);
+    *stats = pool->stats;
+    for (int i = 0; i < RIL_REQUEST_POOL_SIZE; i++) {
+        if (pool->slots[i].pending && pool->slots[i].startTimeMs < oldest) {
+            oldest = pool->slots[i].startTimeMs;
+        }
+    }
+    for (RequestInfo *pCur = pool->overflow; pCur != NULL; pCur = pCur->p_next) {
+        if (pCur->pending && pCur->startTimeMs < oldest) {
+            oldest = pCur->startTimeMs;
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    stats->oldestAgeMs = now - oldest;
+}
+
 static void triggerEvLoop() {
     int ret;
     if (!pthread_equal(pthread_self(), s_tid_dispatch)) {
@@ -529,56 +610,53 @@ RIL_register_socket (const RIL_RadioFunctions *(*Init)(const struct RIL_Env *, i
 static int
 checkAndDequeueRequestInfoIfAck(struct RequestInfo *pRI, bool isAck) {
     int ret = 0;
-    /* Hook for current context
-       pendingRequestsMutextHook refer to &s_pendingRequestsMutex */
-    pthread_mutex_t* pendingRequestsMutexHook = &s_pendingRequestsMutex;
-    /* pendingRequestsHook refer to &s_pendingRequests */
-    RequestInfo ** pendingRequestsHook = &s_pendingRequests;
 
     if (pRI == NULL) {
         return 0;
     }
 
-#if (SIM_COUNT >= 2)
-    if (pRI->socket_id == RIL_SOCKET_2) {
-        pendingRequestsMutexHook = &s_pendingRequestsMutex_socket2;
-        pendingRequestsHook = &s_pendingRequests_socket2;
-    }
-#if (SIM_COUNT >= 3)
-        if (pRI->socket_id == RIL_SOCKET_3) {
-            pendingRequestsMutexHook = &s_pendingRequestsMutex_socket3;
-            pendingRequestsHook = &s_pendingRequests_socket3;
+    // a stale heap token may already be freed, find its pool by address
+    RequestInfoPool *pool = NULL;
+    for (int i = 0; i < SIM_COUNT && pool == NULL; i++) {
+        RequestInfoPool *cur = getRequestPool((RIL_SOCKET_ID) i);
+
+        pthread_mutex_lock(&cur->mutex);
+        if (pRI >= &cur->slots[0] && pRI < &cur->slots[RIL_REQUEST_POOL_SIZE]) {
+            // Tokens handed out from the pool are validated in constant time
+            ret = (pRI == &cur->slots[pRI - &cur->slots[0]]) && pRI->pending;
+            pool = cur;
+        } else {
+            for (RequestInfo *pCur = cur->overflow; pCur != NULL; pCur = pCur->p_next) {
+                if (pRI == pCur) {
+                    ret = pRI->pending;
+                    pool = cur;
+                    break;
+                }
+            }
+        }
+        if (pool == NULL) {
+            pthread_mutex_unlock(&cur->mutex);
         }
-#endif
-#if (SIM_COUNT >= 4)
-    if (pRI->socket_id == RIL_SOCKET_4) {
-        pendingRequestsMutexHook = &s_pendingRequestsMutex_socket4;
-        pendingRequestsHook = &s_pendingRequests_socket4;
     }
-#endif
-#endif
-    pthread_mutex_lock(pendingRequestsMutexHook);
 
-    for(RequestInfo **ppCur = pendingRequestsHook
-        ; *ppCur != NULL
-        ; ppCur = &((*ppCur)->p_next)
-    ) {
-        if (pRI == *ppCur) {
-            ret = 1;
-            if (isAck) { // Async ack
-                if (pRI->wasAckSent == 1) {
-                    RLOGD("Ack was already sent for %s", requestToString(pRI->pCI->requestNumber));
-                } else {
-                    pRI->wasAckSent = 1;
-                }
+    if (pool == NULL) {
+        return 0;
+    }
+
+    if (ret) {
+        if (isAck) { // Async ack
+            if (pRI->wasAckSent == 1) {
+                RLOGD("Ack was already sent for %s", requestToString(pRI->pCI->requestNumber));
             } else {
-                *ppCur = (*ppCur)->p_next;
+                pRI->wasAckSent = 1;
             }
-            break;
+        } else {
+            pRI->pending = 0;
+            pool->stats.outstanding--;
         }
     }
 
-    pthread_mutex_unlock(pendingRequestsMutexHook);
+    pthread_mutex_unlock(&pool->mutex);
 
     return ret;
 }
@@ -639,7 +717,7 @@ RIL_onRequestComplete(RIL_Token t, RIL_Errno e, void *response, size_t responsel
         // response does not go back up the command socket
         RLOGD("C[locl]< %s", requestToString(pRI->pCI->requestNumber));
 
-        free(pRI);
+        releaseRequestInfo(pRI);
         return;
     }
 
@@ -677,7 +755,7 @@ RIL_onRequestComplete(RIL_Token t, RIL_Errno e, void *response, size_t responsel
         rwlockRet = pthread_rwlock_unlock(radioServiceRwlockPtr);
         assert(rwlockRet == 0);
     }
-    free(pRI);
+    releaseRequestInfo(pRI);
 }
 
 static void
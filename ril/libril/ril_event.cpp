@@ -25,6 +25,8 @@
 #include <ril_event.h>
 #include <string.h>
 #include <sys/time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 #include <time.h>
 
 #include <pthread.h>
@@ -53,25 +55,21 @@ static pthread_mutex_t listMutex;
         : (a)->tv_sec op (b)->tv_sec)
 #endif
 
-#ifndef timersub
-#define timersub(a, b, res)                           \
-    do {                                              \
-        (res)->tv_sec = (a)->tv_sec - (b)->tv_sec;    \
-        (res)->tv_usec = (a)->tv_usec - (b)->tv_usec; \
-        if ((res)->tv_usec < 0) {                     \
-            (res)->tv_usec += 1000000;                \
-            (res)->tv_sec -= 1;                       \
-        }                                             \
-    } while(0);
-#endif
+// epoll tag of the timerfd; watches are tagged with their watch_table index
+#define TIMER_FD_TAG ((uint64_t) -1)
 
-static fd_set readFds;
-static int nfds = 0;
+static int epollFd = -1;
+static int timerFd = -1;
 
 static struct ril_event * watch_table[MAX_FD_EVENTS];
-static struct ril_event timer_list;
 static struct ril_event pending_list;
 
+// Binary min-heap of timer events ordered by timeout, then insertion order
+static struct ril_event ** timer_heap = NULL;
+static int timer_count = 0;
+static int timer_capacity = 0;
+static unsigned int timer_seq = 0;
+
 #define DEBUG 0
 
 #if DEBUG
@@ -130,27 +128,91 @@ static void removeFromList(struct ril_event * ev)
     dlog("~~~~ -removeFromList ~~~~");
 }
 
+static bool timerBefore(struct ril_event * a, struct ril_event * b)
+{
+    if (timercmp(&a->timeout, &b->timeout, !=)) {
+        return timercmp(&a->timeout, &b->timeout, <);
+    }
+    // wrap-safe comparison of insertion order
+    return (int)(a->seq - b->seq) < 0;
+}
 
-static void removeWatch(struct ril_event * ev, int index)
+static void heapSiftUp(int i)
 {
-    dlog("~~~~ +removeWatch ~~~~");
-    watch_table[index] = NULL;
-    ev->index = -1;
+    struct ril_event * ev = timer_heap[i];
 
-    FD_CLR(ev->fd, &readFds);
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!timerBefore(ev, timer_heap[parent])) {
+            break;
+        }
+        timer_heap[i] = timer_heap[parent];
+        i = parent;
+    }
+    timer_heap[i] = ev;
+}
 
-    if (ev->fd+1 == nfds) {
-        int n = 0;
+static void heapSiftDown(int i)
+{
+    struct ril_event * ev = timer_heap[i];
 
-        for (int i = 0; i < MAX_FD_EVENTS; i++) {
-            struct ril_event * rev = watch_table[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= timer_count) {
+            break;
+        }
+        if ((child + 1 < timer_count)
+                && timerBefore(timer_heap[child + 1], timer_heap[child])) {
+            child++;
+        }
+        if (!timerBefore(timer_heap[child], ev)) {
+            break;
+        }
+        timer_heap[i] = timer_heap[child];
+        i = child;
+    }
+    timer_heap[i] = ev;
+}
 
-            if ((rev != NULL) && (rev->fd > n)) {
-                n = rev->fd;
-            }
+static struct ril_event * heapPop()
+{
+    struct ril_event * top = timer_heap[0];
+
+    timer_count--;
+    if (timer_count > 0) {
+        timer_heap[0] = timer_heap[timer_count];
+        heapSiftDown(0);
+    }
+    return top;
+}
+
+// Program the timerfd for the earliest timer, or disarm it. Called locked.
+static void armTimer()
+{
+    struct itimerspec its;
+
+    memset(&its, 0, sizeof(its));
+    if (timer_count > 0) {
+        its.it_value.tv_sec = timer_heap[0]->timeout.tv_sec;
+        its.it_value.tv_nsec = timer_heap[0]->timeout.tv_usec * 1000;
+        if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0) {
+            // a zero it_value would disarm the timer
+            its.it_value.tv_nsec = 1;
         }
-        nfds = n + 1;
-        dlog("~~~~ nfds = %d ~~~~", nfds);
+    }
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &its, NULL) < 0) {
+        RLOGE("ril_event: timerfd_settime error (%d)", errno);
+    }
+}
+
+static void removeWatch(struct ril_event * ev, int index)
+{
+    dlog("~~~~ +removeWatch ~~~~");
+    watch_table[index] = NULL;
+    ev->index = -1;
+
+    if (epoll_ctl(epollFd, EPOLL_CTL_DEL, ev->fd, NULL) < 0) {
+        dlog("~~~~ EPOLL_CTL_DEL fd %d error (%d) ~~~~", ev->fd, errno);
     }
     dlog("~~~~ -removeWatch ~~~~");
 }
@@ -160,38 +222,59 @@ static void processTimeouts()
     dlog("~~~~ +processTimeouts ~~~~");
     MUTEX_ACQUIRE();
     struct timeval now;
-    struct ril_event * tev = timer_list.next;
-    struct ril_event * next;
+    bool expired = false;
 
     getNow(&now);
-    // walk list, see if now >= ev->timeout for any events
+    // pop every timer with now >= ev->timeout
 
     dlog("~~~~ Looking for timers <= %ds + %dus ~~~~", (int)now.tv_sec, (int)now.tv_usec);
-    while ((tev != &timer_list) && (timercmp(&now, &tev->timeout, >))) {
+    while ((timer_count > 0) && !timercmp(&timer_heap[0]->timeout, &now, >)) {
         // Timer expired
         dlog("~~~~ firing timer ~~~~");
-        next = tev->next;
-        removeFromList(tev);
-        addToList(tev, &pending_list);
-        tev = next;
+        addToList(heapPop(), &pending_list);
+        expired = true;
+    }
+    if (expired) {
+        armTimer();
     }
     MUTEX_RELEASE();
     dlog("~~~~ -processTimeouts ~~~~");
 }
 
-static void processReadReadies(fd_set * rfds, int n)
+// Clear the timerfd before processTimeouts() looks at the clock: an
+// expiration after that read is then either handled there or re-arms the
+// timerfd in the past, which fires again at once.
+static void drainTimer(struct epoll_event * events, int n)
+{
+    for (int i = 0; i < n; i++) {
+        if (events[i].data.u64 == TIMER_FD_TAG) {
+            uint64_t expirations;
+            while (read(timerFd, &expirations, sizeof(expirations)) < 0 && errno == EINTR);
+            return;
+        }
+    }
+}
+
+static void processReadReadies(struct epoll_event * events, int n)
 {
     dlog("~~~~ +processReadReadies (%d) ~~~~", n);
     MUTEX_ACQUIRE();
 
-    for (int i = 0; (i < MAX_FD_EVENTS) && (n > 0); i++) {
-        struct ril_event * rev = watch_table[i];
-        if (rev != NULL && FD_ISSET(rev->fd, rfds)) {
+    for (int i = 0; i < n; i++) {
+        uint64_t tag = events[i].data.u64;
+
+        if (tag == TIMER_FD_TAG) {
+            // already drained, timers were handled by processTimeouts
+            continue;
+        }
+
+        // the watch may have been removed since epoll_wait returned
+        struct ril_event * rev = (tag < MAX_FD_EVENTS) ? watch_table[tag] : NULL;
+        if (rev != NULL && rev->next == NULL) {
             addToList(rev, &pending_list);
             if (rev->persist == false) {
-                removeWatch(rev, i);
+                removeWatch(rev, (int) tag);
             }
-            n--;
         }
     }
 
@@ -212,40 +295,32 @@ static void firePending()
     dlog("~~~~ -firePending ~~~~");
 }
 
-static int calcNextTimeout(struct timeval * tv)
-{
-    struct ril_event * tev = timer_list.next;
-    struct timeval now;
-
-    getNow(&now);
-
-    // Sorted list, so calc based on first node
-    if (tev == &timer_list) {
-        // no pending timers
-        return -1;
-    }
-
-    dlog("~~~~ now = %ds + %dus ~~~~", (int)now.tv_sec, (int)now.tv_usec);
-    dlog("~~~~ next = %ds + %dus ~~~~",
-            (int)tev->timeout.tv_sec, (int)tev->timeout.tv_usec);
-    if (timercmp(&tev->timeout, &now, >)) {
-        timersub(&tev->timeout, &now, tv);
-    } else {
-        // timer already expired.
-        tv->tv_sec = tv->tv_usec = 0;
-    }
-    return 0;
-}
-
 // Initialize internal data structs
 void ril_event_init()
 {
+    struct epoll_event event;
+
     MUTEX_INIT();
 
-    FD_ZERO(&readFds);
-    init_list(&timer_list);
     init_list(&pending_list);
     memset(watch_table, 0, sizeof(watch_table));
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        RLOGE("ril_event: epoll_create1 error (%d)", errno);
+    }
+
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd < 0) {
+        RLOGE("ril_event: timerfd_create error (%d)", errno);
+    }
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = TIMER_FD_TAG;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, timerFd, &event) < 0) {
+        RLOGE("ril_event: failed to watch timerfd (%d)", errno);
+    }
 }
 
 // Initialize an event
@@ -268,13 +343,19 @@ void ril_event_add(struct ril_event * ev)
     MUTEX_ACQUIRE();
     for (int i = 0; i < MAX_FD_EVENTS; i++) {
         if (watch_table[i] == NULL) {
+            struct epoll_event event;
+
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.u64 = i;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ev->fd, &event) < 0) {
+                RLOGE("ril_event: failed to watch fd %d (%d)", ev->fd, errno);
+                break;
+            }
             watch_table[i] = ev;
             ev->index = i;
             dlog("~~~~ added at %d ~~~~", i);
             dump_event(ev);
-            FD_SET(ev->fd, &readFds);
-            if (ev->fd >= nfds) nfds = ev->fd+1;
-            dlog("~~~~ nfds = %d ~~~~", nfds);
             break;
         }
     }
@@ -288,23 +369,34 @@ void ril_timer_add(struct ril_event * ev, struct timeval * tv)
     dlog("~~~~ +ril_timer_add ~~~~");
     MUTEX_ACQUIRE();
 
-    struct ril_event * list;
     if (tv != NULL) {
-        // add to timer list
-        list = timer_list.next;
         ev->fd = -1; // make sure fd is invalid
 
         struct timeval now;
         getNow(&now);
         timeradd(&now, tv, &ev->timeout);
+        ev->seq = timer_seq++;
+
+        if (timer_count == timer_capacity) {
+            int capacity = (timer_capacity > 0) ? timer_capacity * 2 : 16;
+            struct ril_event ** heap = (struct ril_event **)
+                    realloc(timer_heap, capacity * sizeof(struct ril_event *));
+            if (heap == NULL) {
+                RLOGE("ril_event: unable to grow timer heap");
+                MUTEX_RELEASE();
+                return;
+            }
+            timer_heap = heap;
+            timer_capacity = capacity;
+        }
 
-        // keep list sorted
-        while (timercmp(&list->timeout, &ev->timeout, < )
-                && (list != &timer_list)) {
-            list = list->next;
+        timer_heap[timer_count] = ev;
+        heapSiftUp(timer_count++);
+
+        if (timer_heap[0] == ev) {
+            // new earliest timer
+            armTimer();
         }
-        // list now points to the first event older than ev
-        addToList(ev, list);
     }
 
     MUTEX_RELEASE();
@@ -328,56 +420,28 @@ void ril_event_del(struct ril_event * ev)
     dlog("~~~~ -ril_event_del ~~~~");
 }
 
-#if DEBUG
-static void printReadies(fd_set * rfds)
-{
-    for (int i = 0; (i < MAX_FD_EVENTS); i++) {
-        struct ril_event * rev = watch_table[i];
-        if (rev != NULL && FD_ISSET(rev->fd, rfds)) {
-          dlog("DON: fd=%d is ready", rev->fd);
-        }
-    }
-}
-#else
-#define printReadies(rfds) do {} while(0)
-#endif
-
 void ril_event_loop()
 {
     int n;
-    fd_set rfds;
-    struct timeval tv;
-    struct timeval * ptv;
-
+    // every watch plus the timerfd
+    struct epoll_event events[MAX_FD_EVENTS + 1];
 
     for (;;) {
-
-        // make local copy of read fd_set
-        memcpy(&rfds, &readFds, sizeof(fd_set));
-        if (-1 == calcNextTimeout(&tv)) {
-            // no pending timers; block indefinitely
-            dlog("~~~~ no timers; blocking indefinitely ~~~~");
-            ptv = NULL;
-        } else {
-            dlog("~~~~ blocking for %ds + %dus ~~~~", (int)tv.tv_sec, (int)tv.tv_usec);
-            ptv = &tv;
-        }
-        printReadies(&rfds);
-        n = select(nfds, &rfds, NULL, NULL, ptv);
-        printReadies(&rfds);
+        n = epoll_wait(epollFd, events, MAX_FD_EVENTS + 1, -1);
         dlog("~~~~ %d events fired ~~~~", n);
         if (n < 0) {
             if (errno == EINTR) continue;
 
-            RLOGE("ril_event: select error (%d)", errno);
+            RLOGE("ril_event: epoll_wait error (%d)", errno);
             // bail?
             return;
         }
 
         // Check for timeouts
+        drainTimer(events, n);
         processTimeouts();
         // Check for read-ready
-        processReadReadies(&rfds, n);
+        processReadReadies(events, n);
         // Fire away
         firePending();
     }
@@ -28,6 +28,7 @@ struct ril_event {
     int index;
     bool persist;
     struct timeval timeout;
+    unsigned int seq;   // timer insertion order, keeps equal timeouts FIFO
     ril_event_cb func;
     void *param;
 };
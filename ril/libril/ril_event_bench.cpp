@@ -0,0 +1,518 @@
+/* //device/libs/telephony/ril_event_bench.cpp
+**
+** Copyright 2008, The Android Open Source Project
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+
+/*
+ * Host benchmark of the epoll/timerfd ril_event loop against the select()
+ * loop with the sorted timer list it replaced. For 100 to 10000 pending
+ * timers it reports the ril_timer_add() cost, how late timers fire and the
+ * latency of an fd wakeup while the timers are pending. Every watch_table
+ * slot is in use: MAX_FD_EVENTS caps the fds a RIL can watch, so the timer
+ * count is what grows. Usage: ril_event_bench [wakeups]
+ */
+
+#define LOG_TAG "RILC"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <utils/Log.h>
+#include <ril_event.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <time.h>
+#include <pthread.h>
+
+#ifndef timeradd
+#define timeradd(tvp, uvp, vvp)						\
+	do {								\
+		(vvp)->tv_sec = (tvp)->tv_sec + (uvp)->tv_sec;		\
+		(vvp)->tv_usec = (tvp)->tv_usec + (uvp)->tv_usec;       \
+		if ((vvp)->tv_usec >= 1000000) {			\
+			(vvp)->tv_sec++;				\
+			(vvp)->tv_usec -= 1000000;			\
+		}							\
+	} while (0)
+#endif
+
+#ifndef timercmp
+#define timercmp(a, b, op)               \
+        ((a)->tv_sec == (b)->tv_sec      \
+        ? (a)->tv_usec op (b)->tv_usec   \
+        : (a)->tv_sec op (b)->tv_sec)
+#endif
+
+#ifndef timersub
+#define timersub(a, b, res)                           \
+    do {                                              \
+        (res)->tv_sec = (a)->tv_sec - (b)->tv_sec;    \
+        (res)->tv_usec = (a)->tv_usec - (b)->tv_usec; \
+        if ((res)->tv_usec < 0) {                     \
+            (res)->tv_usec += 1000000;                \
+            (res)->tv_sec -= 1;                       \
+        }                                             \
+    } while(0);
+#endif
+
+// ril_event.cpp before epoll: select() over an fd_set, sorted timer list
+namespace ref {
+
+static pthread_mutex_t listMutex;
+#define MUTEX_ACQUIRE() pthread_mutex_lock(&listMutex)
+#define MUTEX_RELEASE() pthread_mutex_unlock(&listMutex)
+#define MUTEX_INIT() pthread_mutex_init(&listMutex, NULL)
+
+static fd_set readFds;
+static int nfds = 0;
+
+static struct ril_event * watch_table[MAX_FD_EVENTS];
+static struct ril_event timer_list;
+static struct ril_event pending_list;
+
+static void getNow(struct timeval * tv)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    tv->tv_sec = ts.tv_sec;
+    tv->tv_usec = ts.tv_nsec/1000;
+}
+
+static void init_list(struct ril_event * list)
+{
+    memset(list, 0, sizeof(struct ril_event));
+    list->next = list;
+    list->prev = list;
+    list->fd = -1;
+}
+
+static void addToList(struct ril_event * ev, struct ril_event * list)
+{
+    ev->next = list;
+    ev->prev = list->prev;
+    ev->prev->next = ev;
+    list->prev = ev;
+}
+
+static void removeFromList(struct ril_event * ev)
+{
+    ev->next->prev = ev->prev;
+    ev->prev->next = ev->next;
+    ev->next = NULL;
+    ev->prev = NULL;
+}
+
+static void removeWatch(struct ril_event * ev, int index)
+{
+    watch_table[index] = NULL;
+    ev->index = -1;
+
+    FD_CLR(ev->fd, &readFds);
+
+    if (ev->fd+1 == nfds) {
+        int n = 0;
+
+        for (int i = 0; i < MAX_FD_EVENTS; i++) {
+            struct ril_event * rev = watch_table[i];
+
+            if ((rev != NULL) && (rev->fd > n)) {
+                n = rev->fd;
+            }
+        }
+        nfds = n + 1;
+    }
+}
+
+static void processTimeouts()
+{
+    MUTEX_ACQUIRE();
+    struct timeval now;
+    struct ril_event * tev = timer_list.next;
+    struct ril_event * next;
+
+    getNow(&now);
+    while ((tev != &timer_list) && (timercmp(&now, &tev->timeout, >))) {
+        next = tev->next;
+        removeFromList(tev);
+        addToList(tev, &pending_list);
+        tev = next;
+    }
+    MUTEX_RELEASE();
+}
+
+static void processReadReadies(fd_set * rfds, int n)
+{
+    MUTEX_ACQUIRE();
+
+    for (int i = 0; (i < MAX_FD_EVENTS) && (n > 0); i++) {
+        struct ril_event * rev = watch_table[i];
+        if (rev != NULL && FD_ISSET(rev->fd, rfds)) {
+            addToList(rev, &pending_list);
+            if (rev->persist == false) {
+                removeWatch(rev, i);
+            }
+            n--;
+        }
+    }
+
+    MUTEX_RELEASE();
+}
+
+static void firePending()
+{
+    struct ril_event * ev = pending_list.next;
+    while (ev != &pending_list) {
+        struct ril_event * next = ev->next;
+        removeFromList(ev);
+        ev->func(ev->fd, 0, ev->param);
+        ev = next;
+    }
+}
+
+static int calcNextTimeout(struct timeval * tv)
+{
+    struct ril_event * tev = timer_list.next;
+    struct timeval now;
+
+    getNow(&now);
+
+    // Sorted list, so calc based on first node
+    if (tev == &timer_list) {
+        return -1;
+    }
+
+    if (timercmp(&tev->timeout, &now, >)) {
+        timersub(&tev->timeout, &now, tv);
+    } else {
+        tv->tv_sec = tv->tv_usec = 0;
+    }
+    return 0;
+}
+
+void ril_event_init()
+{
+    MUTEX_INIT();
+
+    FD_ZERO(&readFds);
+    init_list(&timer_list);
+    init_list(&pending_list);
+    memset(watch_table, 0, sizeof(watch_table));
+}
+
+void ril_event_add(struct ril_event * ev)
+{
+    MUTEX_ACQUIRE();
+    for (int i = 0; i < MAX_FD_EVENTS; i++) {
+        if (watch_table[i] == NULL) {
+            watch_table[i] = ev;
+            ev->index = i;
+            FD_SET(ev->fd, &readFds);
+            if (ev->fd >= nfds) nfds = ev->fd+1;
+            break;
+        }
+    }
+    MUTEX_RELEASE();
+}
+
+void ril_timer_add(struct ril_event * ev, struct timeval * tv)
+{
+    MUTEX_ACQUIRE();
+
+    struct ril_event * list;
+    if (tv != NULL) {
+        list = timer_list.next;
+        ev->fd = -1;
+
+        struct timeval now;
+        getNow(&now);
+        timeradd(&now, tv, &ev->timeout);
+
+        // keep list sorted
+        while (timercmp(&list->timeout, &ev->timeout, < )
+                && (list != &timer_list)) {
+            list = list->next;
+        }
+        addToList(ev, list);
+    }
+
+    MUTEX_RELEASE();
+}
+
+void ril_event_loop()
+{
+    int n;
+    fd_set rfds;
+    struct timeval tv;
+    struct timeval * ptv;
+
+    for (;;) {
+        memcpy(&rfds, &readFds, sizeof(fd_set));
+        if (-1 == calcNextTimeout(&tv)) {
+            ptv = NULL;
+        } else {
+            ptv = &tv;
+        }
+        n = select(nfds, &rfds, NULL, NULL, ptv);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+
+            RLOGE("ril_event: select error (%d)", errno);
+            return;
+        }
+
+        processTimeouts();
+        processReadReadies(&rfds, n);
+        firePending();
+    }
+}
+
+#undef MUTEX_ACQUIRE
+#undef MUTEX_RELEASE
+#undef MUTEX_INIT
+
+} // namespace ref
+
+struct backend {
+    const char * name;
+    void (*init)();
+    void (*add)(struct ril_event * ev);
+    void (*timer_add)(struct ril_event * ev, struct timeval * tv);
+    void (*loop)();
+};
+
+static const struct backend backends[] = {
+    { "select", ref::ril_event_init, ref::ril_event_add, ref::ril_timer_add, ref::ril_event_loop },
+    { "epoll", ril_event_init, ril_event_add, ril_timer_add, ril_event_loop },
+};
+
+#define NUM_BACKENDS (sizeof(backends) / sizeof(backends[0]))
+
+// every backend gets a wakeup pipe (as ril.cpp has), a ping pipe and idle pipes
+#define NUM_IDLE_FDS (MAX_FD_EVENTS - 2)
+
+struct bench_timer {
+    struct ril_event ev;
+    long long late_us;
+};
+
+struct bench_loop {
+    const struct backend * b;
+    int wake_fds[2];
+    int ping_fds[2];
+    int idle_fds[NUM_IDLE_FDS][2];
+    struct ril_event wake_ev;
+    struct ril_event ping_ev;
+    struct ril_event idle_ev[NUM_IDLE_FDS];
+    pthread_t thread;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    unsigned int fired;
+    unsigned int pings;
+    long long ping_us;
+};
+
+static long long nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+static void drainCallback(int fd, short flags, void * param)
+{
+    char buf[16];
+    while (read(fd, buf, sizeof(buf)) > 0);
+}
+
+static void pingCallback(int fd, short flags, void * param)
+{
+    struct bench_loop * l = (struct bench_loop *) param;
+    long long now = nowUs();
+    long long sent;
+
+    if (read(fd, &sent, sizeof(sent)) != sizeof(sent)) {
+        return;
+    }
+    pthread_mutex_lock(&l->lock);
+    l->ping_us = now - sent;
+    l->pings++;
+    pthread_cond_signal(&l->cond);
+    pthread_mutex_unlock(&l->lock);
+}
+
+static struct bench_loop * timer_loop;
+
+static void timerCallback(int fd, short flags, void * param)
+{
+    struct bench_timer * t = (struct bench_timer *) param;
+    struct bench_loop * l = timer_loop;
+
+    t->late_us = nowUs() - (t->ev.timeout.tv_sec * 1000000LL + t->ev.timeout.tv_usec);
+    pthread_mutex_lock(&l->lock);
+    l->fired++;
+    pthread_cond_signal(&l->cond);
+    pthread_mutex_unlock(&l->lock);
+}
+
+static void * loopThread(void * arg)
+{
+    struct bench_loop * l = (struct bench_loop *) arg;
+
+    l->b->loop();
+    return NULL;
+}
+
+static void watchPipe(struct bench_loop * l, int fds[2], struct ril_event * ev,
+        ril_event_cb func, void * param)
+{
+    if (pipe(fds) < 0) {
+        perror("pipe");
+        exit(2);
+    }
+    ril_event_set(ev, fds[0], true, func, param);
+    l->b->add(ev);
+}
+
+static void startLoop(struct bench_loop * l, const struct backend * b)
+{
+    memset(l, 0, sizeof(*l));
+    l->b = b;
+    pthread_mutex_init(&l->lock, NULL);
+    pthread_cond_init(&l->cond, NULL);
+
+    b->init();
+    watchPipe(l, l->wake_fds, &l->wake_ev, drainCallback, NULL);
+    watchPipe(l, l->ping_fds, &l->ping_ev, pingCallback, l);
+    for (int i = 0; i < NUM_IDLE_FDS; i++) {
+        watchPipe(l, l->idle_fds[i], &l->idle_ev[i], drainCallback, NULL);
+    }
+    pthread_create(&l->thread, NULL, loopThread, l);
+}
+
+// what ril.cpp does after adding a timer from another thread
+static void wakeLoop(struct bench_loop * l)
+{
+    char c = 0;
+    while (write(l->wake_fds[1], &c, 1) < 0 && errno == EINTR);
+}
+
+static int compareLongLong(const void * a, const void * b)
+{
+    long long x = *(const long long *) a;
+    long long y = *(const long long *) b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char * what, long long * v, int n)
+{
+    qsort(v, n, sizeof(*v), compareLongLong);
+    printf("    %-24s p50 %6lld us  p99 %6lld us  max %6lld us\n",
+            what, v[n / 2], v[(n * 99) / 100], v[n - 1]);
+}
+
+/*
+ * Adds num_timers timers due 200 to 700 ms from now in shuffled order, pings
+ * the loop through a pipe while they are pending and waits for all of them.
+ */
+static void runTimers(struct bench_loop * l, int num_timers, int wakeups)
+{
+    struct bench_timer * timers = (struct bench_timer *) calloc(num_timers, sizeof(*timers));
+    long long * v = (long long *) malloc((num_timers > wakeups ? num_timers : wakeups) * sizeof(*v));
+    unsigned int seed = 1;
+    long long t0, add_us;
+
+    if (timers == NULL || v == NULL) {
+        exit(2);
+    }
+
+    timer_loop = l;
+    l->fired = 0;
+
+    t0 = nowUs();
+    for (int i = 0; i < num_timers; i++) {
+        struct timeval tv;
+        long long us = 200000 + (rand_r(&seed) % 500000);
+
+        tv.tv_sec = us / 1000000;
+        tv.tv_usec = us % 1000000;
+        ril_event_set(&timers[i].ev, -1, false, timerCallback, &timers[i]);
+        l->b->timer_add(&timers[i].ev, &tv);
+    }
+    add_us = nowUs() - t0;
+    wakeLoop(l);
+
+    printf("  %d timers\n", num_timers);
+    printf("    %-24s %8.3f us per timer\n", "ril_timer_add", (double) add_us / num_timers);
+
+    // fd wakeups while the timers are pending
+    for (int i = 0; i < wakeups; i++) {
+        long long sent = nowUs();
+
+        pthread_mutex_lock(&l->lock);
+        l->pings = 0;
+        if (write(l->ping_fds[1], &sent, sizeof(sent)) != sizeof(sent)) {
+            perror("write");
+            exit(2);
+        }
+        while (l->pings == 0) {
+            pthread_cond_wait(&l->cond, &l->lock);
+        }
+        v[i] = l->ping_us;
+        pthread_mutex_unlock(&l->lock);
+    }
+    report("fd wakeup", v, wakeups);
+
+    pthread_mutex_lock(&l->lock);
+    while (l->fired < (unsigned int) num_timers) {
+        pthread_cond_wait(&l->cond, &l->lock);
+    }
+    pthread_mutex_unlock(&l->lock);
+
+    for (int i = 0; i < num_timers; i++) {
+        v[i] = timers[i].late_us;
+    }
+    report("timer lateness", v, num_timers);
+
+    free(timers);
+    free(v);
+}
+
+int main(int argc, char ** argv)
+{
+    static const int counts[] = { 100, 1000, 10000 };
+    static struct bench_loop loops[NUM_BACKENDS];
+    int wakeups = (argc > 1) ? atoi(argv[1]) : 200;
+
+    if (wakeups < 1) {
+        wakeups = 1;
+    }
+
+    for (size_t b = 0; b < NUM_BACKENDS; b++) {
+        struct bench_loop * l = &loops[b];
+
+        printf("%s, %d watched fds\n", backends[b].name, MAX_FD_EVENTS);
+        startLoop(l, &backends[b]);
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+            runTimers(l, counts[c], wakeups);
+        }
+    }
+
+    // the loop threads never return
+    return 0;
+}
@@ -77,8 +77,19 @@ typedef struct RequestInfo {
     char local;         // responses to local commands do not go back to command process
     RIL_SOCKET_ID socket_id;
     int wasAckSent;    // Indicates whether an ack was sent earlier
+    char pending;      // Waiting for RIL_onRequestComplete
+    int slot;          // Index in the per-socket request pool, -1 if heap allocated
+    int64_t startTimeMs; // elapsedRealtime() when the request was issued
 } RequestInfo;
 
+typedef struct PendingRequestStats {
+    int outstanding;          // requests waiting for a response
+    int peakOutstanding;
+    int64_t oldestAgeMs;      // age of the oldest outstanding request
+    uint32_t total;
+    uint32_t overflowAllocs;  // requests that did not fit in the pool
+} PendingRequestStats;
+
 typedef struct CommandInfo {
     int requestNumber;
     int(*responseFunction) (int slotId, int responseType, int token,
@@ -87,6 +98,8 @@ typedef struct CommandInfo {
 
 RequestInfo * addRequestToList(int serial, int slotId, int request);
 
+void getPendingRequestStats(int slotId, PendingRequestStats *stats);
+
 char * RIL_getServiceName();
 
 void releaseWakeLock();
@@ -25,6 +25,7 @@
 #include <hidl/HidlTransportSupport.h>
 #include <utils/SystemClock.h>
 #include <inttypes.h>
+#include <stdio.h>
 #include <cutils/properties.h>
 
 #define INVALID_HEX_CHAR 16
@@ -37,11 +38,13 @@ using namespace android::hardware::radio::deprecated::V1_0;
 using ::android::hardware::configureRpcThreadpool;
 using ::android::hardware::joinRpcThreadpool;
 using ::android::hardware::Return;
+using ::android::hardware::hidl_handle;
 using ::android::hardware::hidl_string;
 using ::android::hardware::hidl_vec;
 using ::android::hardware::hidl_array;
 using ::android::hardware::Void;
 using android::CommandInfo;
+using android::PendingRequestStats;
 using android::RequestInfo;
 using android::requestToString;
 using android::sp;
@@ -469,6 +472,8 @@ struct RadioImpl : public IRadio {
 
     Return<void> responseAcknowledgement();
 
+    Return<void> debug(const hidl_handle& fd, const hidl_vec<hidl_string>& options);
+
     void checkReturnStatus(Return<void>& ret);
 };
 
@@ -826,6 +831,23 @@ Return<void> RadioImpl::setResponseFunctions(
     return Void();
 }
 
+// lshal debug android.hardware.radio@1.0::IRadio/<slot>
+Return<void> RadioImpl::debug(const hidl_handle& fd, const hidl_vec<hidl_string>& /* options */) {
+    PendingRequestStats stats;
+
+    if (fd.getNativeHandle() == NULL || fd->numFds < 1) {
+        return Void();
+    }
+
+    android::getPendingRequestStats(mSlotId, &stats);
+    dprintf(fd->data[0], "slot %d requests: %d outstanding (peak %d), oldest %" PRId64
+            " ms, %u total, %u overflow allocations\n", mSlotId, stats.outstanding,
+            stats.peakOutstanding, stats.outstanding ? stats.oldestAgeMs : 0,
+            stats.total, stats.overflowAllocs);
+
+    return Void();
+}
+
 Return<void> RadioImpl::getIccCardStatus(int32_t serial) {
 #if VDBG
     RLOGD("getIccCardStatus: serial %d", serial);